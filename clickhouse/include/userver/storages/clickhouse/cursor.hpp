@@ -0,0 +1,71 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/cursor.hpp
+/// @brief @copybrief storages::clickhouse::Cursor
+
+#include <memory>
+#include <optional>
+
+#include <userver/storages/clickhouse/execution_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+class CursorImpl;
+}
+
+// clang-format off
+
+/// @brief Streams the result of a query block by block, as the blocks arrive
+/// from the server. Returned by storages::clickhouse::Cluster ExecuteStreaming
+/// methods.
+///
+/// Only a few blocks are buffered on the client side: once the buffer is full,
+/// the driver stops reading from the socket until the cursor is advanced,
+/// so huge results never have to fit into memory.
+///
+/// The connection is held by the cursor until the whole result is read or the
+/// cursor is destroyed. Destroying the cursor before the end of the result
+/// cancels the query.
+///
+/// ## Usage example:
+///
+/// @snippet storages/tests/streaming_chtest.cpp  Sample Cursor usage
+
+// clang-format on
+class Cursor final {
+public:
+    explicit Cursor(std::unique_ptr<impl::CursorImpl>&&);
+    Cursor(Cursor&&) noexcept;
+    Cursor& operator=(Cursor&&) noexcept;
+    ~Cursor();
+
+    /// @brief Waits for the next block of the result.
+    /// @returns std::nullopt once the whole result has been read
+    /// @throws the errors of the query execution
+    std::optional<ExecutionResult> FetchBlock();
+
+    /// @brief Waits for the next block of the result and converts it to
+    /// strongly-typed struct of vectors.
+    /// See @ref clickhouse_io for better understanding of `T`'s requirements.
+    /// @returns std::nullopt once the whole result has been read
+    template <typename T>
+    std::optional<T> FetchBlockAs();
+
+private:
+    std::unique_ptr<impl::CursorImpl> impl_;
+};
+
+template <typename T>
+std::optional<T> Cursor::FetchBlockAs() {
+    auto block = FetchBlock();
+    if (!block) return std::nullopt;
+
+    return std::move(*block).As<T>();
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,251 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/insert_batcher.hpp
+/// @brief @copybrief storages::clickhouse::InsertBatcher
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/fwd.hpp>
+#include <userver/storages/clickhouse/io/type_traits.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+/// Settings of storages::clickhouse::InsertBatcher
+struct InsertBatcherSettings final {
+    /// Flush the batch once it has that many rows, bigger batches are split
+    std::size_t max_rows{10'000};
+
+    /// Flush the batch once its approximate size reaches that many bytes,
+    /// bigger batches are split
+    std::size_t max_bytes{4 * 1024 * 1024};
+
+    /// Flush the batch once its first row has been waiting that long
+    std::chrono::milliseconds max_age{1000};
+
+    /// Drop the new rows while that many rows wait to be inserted,
+    /// e.g. while ClickHouse is unavailable
+    std::size_t max_buffered_rows{100'000};
+};
+
+InsertBatcherSettings Parse(const yaml_config::YamlConfig& value, formats::parse::To<InsertBatcherSettings>);
+
+namespace impl {
+
+/// @brief Approximate size of the row in memory, counting the contents of
+/// strings and vectors.
+template <typename Row>
+std::size_t ApproximateRowSize(const Row& row) {
+    std::size_t result = sizeof(Row);
+    boost::pfr::for_each_field(row, [&result](const auto& field) {
+        using Field = std::decay_t<decltype(field)>;
+        if constexpr (std::is_same_v<Field, std::string>) {
+            result += field.size();
+        } else if constexpr (io::traits::kIsReservable<Field>) {
+            result += field.size() * sizeof(typename Field::value_type);
+        }
+    });
+    return result;
+}
+
+class InsertBatcherImpl;
+
+/// Background flushing and statistics of the InsertBatcher, independent of
+/// the row type
+class InsertBatcherBase {
+public:
+    /// Write batcher statistics
+    void WriteStatistics(USERVER_NAMESPACE::utils::statistics::Writer& writer) const;
+
+protected:
+    InsertBatcherBase(
+        ClusterPtr cluster,
+        std::string table_name,
+        std::vector<std::string> column_names,
+        const InsertBatcherSettings& settings
+    );
+    ~InsertBatcherBase();
+
+    // Must be called from the constructor of the derived class
+    void StartFlusher();
+
+    // Must be called from the destructor of the derived class,
+    // flushes the rest of the rows
+    void StopFlusher() noexcept;
+
+    const InsertBatcherSettings& GetSettings() const noexcept;
+
+    // Wakes up the flusher, which flushes the batch right away
+    void WakeUpFlusher() noexcept;
+
+    // Must be called under the lock of the rows: the flusher flushes the rows
+    // InsertBatcherSettings::max_age after the first of them was buffered
+    void AccountFirstRow() noexcept;
+    void ResetFirstRow() noexcept;
+
+    void AccountDropped(std::size_t rows) noexcept;
+
+    // Inserts the batch, accounting the statistics. Exceptions are logged
+    // and the rows are accounted as dropped.
+    template <typename Container>
+    void InsertBatch(const Container& rows, std::size_t bytes) noexcept;
+
+    virtual void FlushBuffered() noexcept = 0;
+
+private:
+    void AccountFlush(std::size_t rows, std::size_t bytes, std::chrono::steady_clock::duration duration) noexcept;
+    void AccountFlushError(const std::exception& ex, std::size_t rows) noexcept;
+
+    engine::Deadline GetFlushDeadline() const noexcept;
+
+    const Cluster& GetCluster() const noexcept;
+    const std::string& GetTableName() const noexcept;
+    const std::vector<std::string_view>& GetColumnNames() const noexcept;
+
+    std::unique_ptr<InsertBatcherImpl> impl_;
+};
+
+template <typename Container>
+void InsertBatcherBase::InsertBatch(const Container& rows, std::size_t bytes) noexcept {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        GetCluster().InsertRows(GetTableName(), GetColumnNames(), rows);
+        AccountFlush(rows.size(), bytes, std::chrono::steady_clock::now() - start);
+    } catch (const std::exception& ex) {
+        AccountFlushError(ex, rows.size());
+    }
+}
+
+}  // namespace impl
+
+// clang-format off
+
+/// @brief Buffers the rows inserted from many coroutines into a single
+/// ClickHouse table and inserts them in batches.
+///
+/// A batch is inserted once it reaches InsertBatcherSettings::max_rows rows or
+/// InsertBatcherSettings::max_bytes bytes, but no later than
+/// InsertBatcherSettings::max_age after its first row was buffered.
+/// Insert() never waits for ClickHouse: while the batches can not be inserted
+/// fast enough, up to InsertBatcherSettings::max_buffered_rows rows are kept
+/// and the rest are dropped. The rows of a failed insert are dropped as well.
+///
+/// `Row` is expected to be a clickhouse-mapped type,
+/// see @ref clickhouse_io for better understanding of its requirements.
+///
+/// ## Usage example:
+///
+/// @snippet storages/tests/insert_batcher_chtest.cpp  Sample InsertBatcher usage
+
+// clang-format on
+template <typename Row>
+class InsertBatcher final : private impl::InsertBatcherBase {
+public:
+    /// @param cluster cluster to insert into
+    /// @param table_name table to insert into
+    /// @param column_names names of columns of the table
+    /// @param settings batching settings
+    InsertBatcher(
+        ClusterPtr cluster,
+        std::string table_name,
+        std::vector<std::string> column_names,
+        const InsertBatcherSettings& settings = {}
+    )
+        : InsertBatcherBase(std::move(cluster), std::move(table_name), std::move(column_names), settings) {
+        StartFlusher();
+    }
+
+    /// Flushes the rest of the rows
+    ~InsertBatcher() { StopFlusher(); }
+
+    /// @brief Buffers the row for insertion.
+    /// @returns false if the row was dropped, because too many rows are
+    /// already waiting to be inserted
+    bool Insert(Row&& row);
+
+    /// Inserts the rows buffered so far and waits for the insertion to finish
+    void Flush() { FlushBuffered(); }
+
+    using InsertBatcherBase::WriteStatistics;
+
+private:
+    void FlushBuffered() noexcept override;
+
+    engine::Mutex mutex_;
+    std::vector<Row> rows_;
+    std::size_t bytes_{0};
+};
+
+template <typename Row>
+bool InsertBatcher<Row>::Insert(Row&& row) {
+    const auto& settings = GetSettings();
+    const auto row_size = impl::ApproximateRowSize(row);
+
+    bool is_batch_full = false;
+    {
+        const std::lock_guard lock{mutex_};
+        if (rows_.size() >= settings.max_buffered_rows) {
+            AccountDropped(1);
+            return false;
+        }
+
+        if (rows_.empty()) AccountFirstRow();
+        rows_.push_back(std::move(row));
+        bytes_ += row_size;
+        is_batch_full = rows_.size() >= settings.max_rows || bytes_ >= settings.max_bytes;
+    }
+
+    if (is_batch_full) WakeUpFlusher();
+    return true;
+}
+
+template <typename Row>
+void InsertBatcher<Row>::FlushBuffered() noexcept {
+    std::vector<Row> rows;
+    {
+        const std::lock_guard lock{mutex_};
+        rows.swap(rows_);
+        bytes_ = 0;
+        ResetFirstRow();
+    }
+    if (rows.empty()) return;
+
+    // The rows buffered while ClickHouse was unavailable are inserted in
+    // batches of the configured size
+    const auto& settings = GetSettings();
+    std::vector<Row> batch;
+    batch.reserve(std::min(rows.size(), settings.max_rows));
+    std::size_t batch_bytes = 0;
+    for (auto& row : rows) {
+        const auto row_size = impl::ApproximateRowSize(row);
+        if (!batch.empty() && (batch.size() >= settings.max_rows || batch_bytes + row_size > settings.max_bytes)) {
+            InsertBatch(batch, batch_bytes);
+            batch.clear();
+            batch_bytes = 0;
+        }
+        batch.push_back(std::move(row));
+        batch_bytes += row_size;
+    }
+    InsertBatch(batch, batch_bytes);
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
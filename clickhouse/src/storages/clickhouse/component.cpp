@@ -67,8 +67,12 @@ properties:
         defaultDescription: true
     compression:
         type: string
-        description: compression method to use (none / lz4)
+        description: compression method to use (none / lz4 / zstd)
         defaultDescription: none
+        enum:
+          - none
+          - lz4
+          - zstd
 )");
 }
 
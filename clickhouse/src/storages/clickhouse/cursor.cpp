@@ -0,0 +1,49 @@
+#include <userver/storages/clickhouse/cursor.hpp>
+
+#include <userver/utils/assert.hpp>
+
+#include <storages/clickhouse/impl/block_wrapper.hpp>
+#include <storages/clickhouse/impl/cursor_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace impl {
+
+CursorImpl::CursorImpl(BlocksQueue::Consumer&& consumer, engine::TaskWithResult<void>&& task)
+    : task_{std::move(task)}, consumer_{std::move(consumer)} {}
+
+CursorImpl::~CursorImpl() = default;
+
+BlockWrapperPtr CursorImpl::FetchBlock() {
+    BlockWrapperPtr block;
+    if (consumer_.Pop(block)) return block;
+
+    // The producer is gone: either the whole result has been read or the query
+    // has failed.
+    if (task_.IsValid()) task_.Get();
+    return {};
+}
+
+}  // namespace impl
+
+Cursor::Cursor(std::unique_ptr<impl::CursorImpl>&& impl) : impl_{std::move(impl)} {}
+
+Cursor::Cursor(Cursor&&) noexcept = default;
+
+Cursor& Cursor::operator=(Cursor&&) noexcept = default;
+
+Cursor::~Cursor() = default;
+
+std::optional<ExecutionResult> Cursor::FetchBlock() {
+    UASSERT(impl_);
+    auto block = impl_->FetchBlock();
+    if (!block) return std::nullopt;
+
+    return ExecutionResult{std::move(block)};
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -100,6 +100,30 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc, const Qu
     return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteStreaming(OptionalCommandControl optional_cc, const Query& query, BlockConsumer consumer) {
+    clickhouse_cpp::Query native_query{query.QueryText()};
+
+    auto& span = tracing::Span::CurrentSpan();
+    auto scope = span.CreateScopeTime(scopes::kExec);
+
+    // Only the cancelable callback is set, so that each block is handled once
+    native_query.OnDataCancelable([this, &optional_cc, &consumer, &scope](const NativeBlock& data) {
+        if (engine::current_task::ShouldCancel()) return false;
+        // The first block only describes the columns
+        if (data.GetRowCount() == 0) return true;
+
+        scope.Reset(scopes::kExec);
+        // Columns are shared rather than copied, the driver does not reuse them
+        const auto keep_going = consumer(BlockWrapperPtr{new BlockWrapper{NativeBlock{data}}});
+
+        // The consumer may keep the socket unread for a while, which is fine
+        client_.SetDeadline(GetDeadline(optional_cc));
+        return keep_going;
+    });
+
+    DoExecute(optional_cc, native_query);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc, const InsertionRequest& request) {
     const auto& block = request.GetBlock();
 
@@ -3,8 +3,10 @@
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
 #include <userver/storages/clickhouse/options.hpp>
+#include <userver/utils/function_ref.hpp>
 
 #include <storages/clickhouse/impl/native_client_factory.hpp>
 
@@ -27,6 +29,12 @@ public:
 
     ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+    // Passes non-empty blocks to the consumer as they arrive. The consumer
+    // returns 'false' to cancel the query. The timeout of the command control
+    // applies to the wait for each block rather than to the whole query.
+    using BlockConsumer = USERVER_NAMESPACE::utils::function_ref<bool(BlockWrapperPtr&&)>;
+    void ExecuteStreaming(OptionalCommandControl, const Query&, BlockConsumer consumer);
+
     void Insert(OptionalCommandControl, const InsertionRequest&);
 
     void Ping();
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::impl {
+
+using BlocksQueue = concurrent::SpscQueue<BlockWrapperPtr>;
+
+// Max count of the blocks that have arrived from the server but have not been
+// fetched from the Cursor yet.
+inline constexpr std::size_t kMaxBufferedBlocks = 2;
+
+class CursorImpl final {
+public:
+    CursorImpl(BlocksQueue::Consumer&& consumer, engine::TaskWithResult<void>&& task);
+    ~CursorImpl();
+
+    BlockWrapperPtr FetchBlock();
+
+private:
+    // The task executes the query and pushes the blocks into the queue.
+    // It is destroyed after the consumer, so that a blocked Push is woken up.
+    engine::TaskWithResult<void> task_;
+    BlocksQueue::Consumer consumer_;
+};
+
+}  // namespace storages::clickhouse::impl
+
+USERVER_NAMESPACE_END
@@ -33,9 +33,10 @@ public:
     void Insert(const std::string& table_name, const clickhouse_cpp::Block& block, engine::Deadline deadline);
     void Ping(engine::Deadline deadline);
 
-private:
+    // Also prolongs the operation in progress
     void SetDeadline(engine::Deadline deadline);
 
+private:
     engine::Deadline operations_deadline_;
 
     std::unique_ptr<clickhouse_cpp::Client> native_client_;
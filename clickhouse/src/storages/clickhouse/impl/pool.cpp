@@ -4,9 +4,11 @@
 
 #include <userver/tracing/span.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/utils/async.hpp>
 
 #include <storages/clickhouse/impl/connection.hpp>
 #include <storages/clickhouse/impl/connection_ptr.hpp>
+#include <storages/clickhouse/impl/cursor_impl.hpp>
 #include <storages/clickhouse/impl/pool_impl.hpp>
 #include <storages/clickhouse/impl/tracing_tags.hpp>
 #include <userver/formats/json/value_builder.hpp>
@@ -43,6 +45,32 @@ ExecutionResult Pool::Execute(OptionalCommandControl optional_cc, const Query& q
     return conn_ptr->Execute(optional_cc, query);
 }
 
+Cursor Pool::ExecuteStreaming(OptionalCommandControl optional_cc, const Query& query) const {
+    auto conn_ptr = impl_->Acquire();
+
+    auto queue = BlocksQueue::Create(kMaxBufferedBlocks);
+    auto task = USERVER_NAMESPACE::utils::Async(
+        impl::scopes::kQuery,
+        [impl = impl_, conn_ptr = std::move(conn_ptr), producer = queue->GetProducer(), optional_cc, query]() mutable {
+            // The consumer should see the end of the result as soon as the query
+            // is done, not when the task is destroyed
+            const auto local_producer = std::move(producer);
+
+            auto& span = tracing::Span::CurrentSpan();
+            span.AddTag(tracing::kDatabaseInstance, impl->GetHostName());
+            query.FillSpanTags(span);
+
+            const auto timer = impl->GetExecuteTimer();
+            conn_ptr->ExecuteStreaming(optional_cc, query, [&local_producer](BlockWrapperPtr&& block) {
+                // Blocks while the buffer is full, which keeps the socket unread
+                return local_producer.Push(std::move(block));
+            });
+        }
+    );
+
+    return Cursor{std::make_unique<CursorImpl>(queue->GetConsumer(), std::move(task))};
+}
+
 void Pool::Insert(OptionalCommandControl optional_cc, const InsertionRequest& request) const {
     auto conn_ptr = impl_->Acquire();
 
@@ -0,0 +1,172 @@
+#include <userver/storages/clickhouse/insert_batcher.hpp>
+
+#include <atomic>
+#include <chrono>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <storages/clickhouse/stats/insert_batcher_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+InsertBatcherSettings Parse(const yaml_config::YamlConfig& value, formats::parse::To<InsertBatcherSettings>) {
+    InsertBatcherSettings result;
+    result.max_rows = value["max_rows"].As<std::size_t>(result.max_rows);
+    result.max_bytes = value["max_bytes"].As<std::size_t>(result.max_bytes);
+    result.max_age = value["max_age"].As<std::chrono::milliseconds>(result.max_age);
+    result.max_buffered_rows = value["max_buffered_rows"].As<std::size_t>(result.max_buffered_rows);
+
+    UINVARIANT(result.max_rows > 0, "max_rows should be positive");
+    UINVARIANT(result.max_age.count() > 0, "max_age should be positive");
+    return result;
+}
+
+namespace impl {
+
+class InsertBatcherImpl final {
+public:
+    InsertBatcherImpl(
+        ClusterPtr&& cluster,
+        std::string&& table_name,
+        std::vector<std::string>&& column_names,
+        const InsertBatcherSettings& settings
+    )
+        : cluster{std::move(cluster)},
+          table_name{std::move(table_name)},
+          column_names{std::move(column_names)},
+          column_name_views{this->column_names.begin(), this->column_names.end()},
+          settings{settings} {
+        UINVARIANT(this->cluster, "Cluster should not be null");
+    }
+
+    const ClusterPtr cluster;
+    const std::string table_name;
+    const std::vector<std::string> column_names;
+    const std::vector<std::string_view> column_name_views;
+    const InsertBatcherSettings settings;
+
+    engine::SingleConsumerEvent wakeup;
+    std::atomic<bool> is_stopping{false};
+    std::atomic<bool> is_flush_requested{false};
+    // steady_clock time of the first buffered row, zero if there are no rows
+    std::atomic<std::chrono::steady_clock::rep> first_row_at{0};
+    engine::TaskWithResult<void> flusher;
+
+    stats::InsertBatcherStatistics statistics;
+};
+
+InsertBatcherBase::InsertBatcherBase(
+    ClusterPtr cluster,
+    std::string table_name,
+    std::vector<std::string> column_names,
+    const InsertBatcherSettings& settings
+)
+    : impl_{std::make_unique<InsertBatcherImpl>(
+          std::move(cluster),
+          std::move(table_name),
+          std::move(column_names),
+          settings
+      )} {}
+
+InsertBatcherBase::~InsertBatcherBase() { UASSERT_MSG(!impl_->flusher.IsValid(), "StopFlusher was not called"); }
+
+void InsertBatcherBase::StartFlusher() {
+    impl_->flusher = USERVER_NAMESPACE::utils::CriticalAsync("clickhouse_insert_batcher", [this] {
+        while (!impl_->is_stopping && !engine::current_task::ShouldCancel()) {
+            // Flushes either once the first row gets old or once the batch is
+            // full. Waits for the first row if there are no rows.
+            const auto deadline = GetFlushDeadline();
+            [[maybe_unused]] const auto woken_up = impl_->wakeup.WaitForEventUntil(deadline);
+            if (impl_->is_flush_requested.exchange(false) || deadline.IsReached()) FlushBuffered();
+        }
+    });
+}
+
+void InsertBatcherBase::StopFlusher() noexcept {
+    if (impl_->flusher.IsValid()) {
+        // The ongoing insert is not interrupted, so that no rows are lost
+        impl_->is_stopping = true;
+        impl_->wakeup.Send();
+        const engine::TaskCancellationBlocker cancel_blocker;
+        impl_->flusher.Wait();
+        impl_->flusher = {};
+    }
+
+    FlushBuffered();
+}
+
+const InsertBatcherSettings& InsertBatcherBase::GetSettings() const noexcept { return impl_->settings; }
+
+void InsertBatcherBase::WakeUpFlusher() noexcept {
+    impl_->is_flush_requested = true;
+    impl_->wakeup.Send();
+}
+
+void InsertBatcherBase::AccountFirstRow() noexcept {
+    impl_->first_row_at = std::chrono::steady_clock::now().time_since_epoch().count();
+    // the flusher re-arms its timer
+    impl_->wakeup.Send();
+}
+
+void InsertBatcherBase::ResetFirstRow() noexcept { impl_->first_row_at = 0; }
+
+engine::Deadline InsertBatcherBase::GetFlushDeadline() const noexcept {
+    const auto first_row_at = impl_->first_row_at.load();
+    if (first_row_at == 0) return {};
+
+    const std::chrono::steady_clock::time_point first_row_time{std::chrono::steady_clock::duration{first_row_at}};
+    return engine::Deadline::FromTimePoint(first_row_time + impl_->settings.max_age);
+}
+
+void InsertBatcherBase::AccountDropped(std::size_t rows) noexcept { impl_->statistics.rows_dropped += rows; }
+
+void InsertBatcherBase::AccountFlush(
+    std::size_t rows,
+    std::size_t bytes,
+    std::chrono::steady_clock::duration duration
+) noexcept {
+    auto& statistics = impl_->statistics;
+    ++statistics.batches;
+    statistics.rows_inserted += rows;
+    statistics.bytes_inserted += bytes;
+    statistics.batch_rows.GetCurrentCounter().Account(rows);
+    statistics.timings.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()
+    );
+}
+
+void InsertBatcherBase::AccountFlushError(const std::exception& ex, std::size_t rows) noexcept {
+    auto& statistics = impl_->statistics;
+    ++statistics.batches;
+    ++statistics.batches_error;
+    statistics.rows_dropped += rows;
+
+    LOG_LIMITED_ERROR() << "Failed to insert a batch of " << rows << " rows into '" << impl_->table_name
+                        << "', the rows are dropped: " << ex;
+}
+
+const Cluster& InsertBatcherBase::GetCluster() const noexcept { return *impl_->cluster; }
+
+const std::string& InsertBatcherBase::GetTableName() const noexcept { return impl_->table_name; }
+
+const std::vector<std::string_view>& InsertBatcherBase::GetColumnNames() const noexcept {
+    return impl_->column_name_views;
+}
+
+void InsertBatcherBase::WriteStatistics(USERVER_NAMESPACE::utils::statistics::Writer& writer) const {
+    writer.ValueWithLabels(impl_->statistics, {{"clickhouse_table", impl_->table_name}});
+}
+
+}  // namespace impl
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
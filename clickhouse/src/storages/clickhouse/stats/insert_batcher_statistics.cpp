@@ -0,0 +1,21 @@
+#include "insert_batcher_statistics.hpp"
+
+#include <userver/utils/statistics/percentile_format_json.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::stats {
+
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer, const InsertBatcherStatistics& stats) {
+    writer["batches"]["total"] = stats.batches;
+    writer["batches"]["error"] = stats.batches_error;
+    writer["rows"]["inserted"] = stats.rows_inserted;
+    writer["rows"]["dropped"] = stats.rows_dropped;
+    writer["bytes"]["inserted"] = stats.bytes_inserted;
+    writer["batch_rows"] = stats.batch_rows;
+    writer["timings"] = stats.timings;
+}
+
+}  // namespace storages::clickhouse::stats
+
+USERVER_NAMESPACE_END
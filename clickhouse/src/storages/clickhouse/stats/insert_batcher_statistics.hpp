@@ -0,0 +1,28 @@
+#pragma once
+
+#include <storages/clickhouse/stats/pool_statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse::stats {
+
+// Up to 2048 rows exactly, then up to ~130k rows with a step of 1024
+using BatchSizePercentile = USERVER_NAMESPACE::utils::statistics::Percentile<2048, uint64_t, 126, 1024>;
+using BatchSizeRecentPeriod =
+    USERVER_NAMESPACE::utils::statistics::RecentPeriod<BatchSizePercentile, BatchSizePercentile>;
+
+struct InsertBatcherStatistics final {
+    Counter batches{};
+    Counter batches_error{};
+    Counter rows_inserted{};
+    Counter rows_dropped{};
+    Counter bytes_inserted{};
+    BatchSizeRecentPeriod batch_rows{};
+    RecentPeriod timings{};
+};
+
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer, const InsertBatcherStatistics& stats);
+
+}  // namespace storages::clickhouse::stats
+
+USERVER_NAMESPACE_END
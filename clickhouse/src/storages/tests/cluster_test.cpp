@@ -7,7 +7,7 @@
 USERVER_NAMESPACE_BEGIN
 
 UTEST(Cluster, NoAvailablePools) {
-    ClusterWrapper cluster{false, {{"unresolved1", 11111}, {"unresolved2", 12222}, {"unresolved3", 12333}}};
+    ClusterWrapper cluster{"none", {{"unresolved1", 11111}, {"unresolved2", 12222}, {"unresolved3", 12333}}};
 
     EXPECT_THROW(cluster->Execute("Invalid_query"), storages::clickhouse::Cluster::NoAvailablePoolError);
 }
@@ -0,0 +1,180 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/insert_batcher.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct TelemetryRow final {
+    uint64_t id;
+    std::string value;
+};
+
+struct Ids final {
+    std::vector<uint64_t> ids;
+};
+
+void RecreateTable(storages::clickhouse::Cluster& cluster) {
+    cluster.Execute("DROP TABLE IF EXISTS insert_batcher_table");
+    cluster.Execute("CREATE TABLE insert_batcher_table (id UInt64, value String) ENGINE = Memory");
+}
+
+std::size_t CountRows(storages::clickhouse::Cluster& cluster) {
+    return cluster.Execute("SELECT id FROM insert_batcher_table").GetRowsCount();
+}
+
+// The batcher does not own the cluster in the tests
+storages::clickhouse::ClusterPtr AsClusterPtr(ClusterWrapper& cluster) {
+    return storages::clickhouse::ClusterPtr{storages::clickhouse::ClusterPtr{}, &*cluster};
+}
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<TelemetryRow> final {
+    using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+template <>
+struct CppToClickhouse<Ids> final {
+    using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST_MT(InsertBatcher, ManyCoroutines, 4) {
+    ClusterWrapper cluster{};
+    RecreateTable(*cluster);
+
+    constexpr std::size_t kTasksCount = 10;
+    constexpr std::size_t kRowsPerTask = 1000;
+
+    storages::clickhouse::InsertBatcherSettings settings;
+    settings.max_rows = 1000;
+
+    {
+        /// [Sample InsertBatcher usage]
+        storages::clickhouse::InsertBatcher<TelemetryRow> batcher{
+            AsClusterPtr(cluster), "insert_batcher_table", {"id", "value"}, settings};
+
+        std::vector<engine::TaskWithResult<void>> tasks;
+        for (std::size_t i = 0; i < kTasksCount; ++i) {
+            tasks.push_back(engine::AsyncNoSpan([&batcher, i] {
+                for (std::size_t j = 0; j < kRowsPerTask; ++j) {
+                    EXPECT_TRUE(batcher.Insert({i * kRowsPerTask + j, "value"}));
+                }
+            }));
+        }
+        engine::GetAll(tasks);
+        /// [Sample InsertBatcher usage]
+
+        batcher.Flush();
+        EXPECT_EQ(CountRows(*cluster), kTasksCount * kRowsPerTask);
+
+        const auto ids = cluster->Execute("SELECT DISTINCT id FROM insert_batcher_table").As<Ids>();
+        EXPECT_EQ(ids.ids.size(), kTasksCount * kRowsPerTask);
+    }
+}
+
+UTEST(InsertBatcher, FlushesByAge) {
+    ClusterWrapper cluster{};
+    RecreateTable(*cluster);
+
+    storages::clickhouse::InsertBatcherSettings settings;
+    settings.max_age = std::chrono::milliseconds{50};
+
+    storages::clickhouse::InsertBatcher<TelemetryRow> batcher{
+        AsClusterPtr(cluster), "insert_batcher_table", {"id", "value"}, settings};
+    EXPECT_TRUE(batcher.Insert({1, "first"}));
+
+    while (CountRows(*cluster) == 0) {
+        engine::SleepFor(std::chrono::milliseconds{10});
+    }
+    EXPECT_EQ(CountRows(*cluster), 1);
+}
+
+UTEST(InsertBatcher, FlushesOnDestruction) {
+    ClusterWrapper cluster{};
+    RecreateTable(*cluster);
+
+    storages::clickhouse::InsertBatcherSettings settings;
+    settings.max_age = std::chrono::hours{1};
+
+    {
+        storages::clickhouse::InsertBatcher<TelemetryRow> batcher{
+            AsClusterPtr(cluster), "insert_batcher_table", {"id", "value"}, settings};
+        for (uint64_t i = 0; i < 10; ++i) {
+            EXPECT_TRUE(batcher.Insert({i, "value"}));
+        }
+    }
+
+    EXPECT_EQ(CountRows(*cluster), 10);
+}
+
+UTEST(InsertBatcher, DropsWhenFull) {
+    ClusterWrapper cluster{};
+    RecreateTable(*cluster);
+
+    storages::clickhouse::InsertBatcherSettings settings;
+    settings.max_age = std::chrono::hours{1};
+    settings.max_rows = 1000;
+    settings.max_buffered_rows = 5;
+
+    {
+        storages::clickhouse::InsertBatcher<TelemetryRow> batcher{
+            AsClusterPtr(cluster), "insert_batcher_table", {"id", "value"}, settings};
+        for (uint64_t i = 0; i < 5; ++i) {
+            EXPECT_TRUE(batcher.Insert({i, "value"}));
+        }
+        EXPECT_FALSE(batcher.Insert({5, "value"}));
+
+        utils::statistics::Storage statistics_storage;
+        const auto holder = statistics_storage.RegisterWriter("clickhouse_batcher", [&batcher](auto& writer) {
+            batcher.WriteStatistics(writer);
+        });
+        const auto snapshot = utils::statistics::Snapshot{statistics_storage, "clickhouse_batcher"};
+        EXPECT_EQ(snapshot.SingleMetric("rows.dropped").AsInt(), 1);
+    }
+
+    EXPECT_EQ(CountRows(*cluster), 5);
+}
+
+UTEST(InsertBatcher, SplitsBufferedRows) {
+    ClusterWrapper cluster{};
+    RecreateTable(*cluster);
+
+    storages::clickhouse::InsertBatcherSettings settings;
+    settings.max_age = std::chrono::hours{1};
+    settings.max_rows = 2;
+    settings.max_buffered_rows = 100;
+
+    storages::clickhouse::InsertBatcher<TelemetryRow> batcher{
+        AsClusterPtr(cluster), "insert_batcher_table", {"id", "value"}, settings};
+
+    utils::statistics::Storage statistics_storage;
+    const auto holder = statistics_storage.RegisterWriter("clickhouse_batcher", [&batcher](auto& writer) {
+        batcher.WriteStatistics(writer);
+    });
+
+    // all the rows are buffered before the flusher gets to run
+    for (uint64_t i = 0; i < 5; ++i) {
+        EXPECT_TRUE(batcher.Insert({i, "value"}));
+    }
+    batcher.Flush();
+
+    EXPECT_EQ(CountRows(*cluster), 5);
+    const auto snapshot = utils::statistics::Snapshot{statistics_storage, "clickhouse_batcher"};
+    EXPECT_EQ(snapshot.SingleMetric("batches.total").AsInt(), 3);
+}
+
+USERVER_NAMESPACE_END
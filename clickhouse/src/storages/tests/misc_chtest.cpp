@@ -83,7 +83,26 @@ UTEST(Query, Works) {
 }
 
 UTEST(Compression, Works) {
-    ClusterWrapper cluster{true};
+    ClusterWrapper cluster{"lz4"};
+    storages::clickhouse::Query q{
+        "SELECT c.number, randomString(10), c.number as t, NOW64() "
+        "FROM "
+        "numbers(0, 10000) c "};
+    auto res = cluster->Execute(q).As<SomeData>();
+    EXPECT_EQ(res.vec_str.size(), 10000);
+}
+
+UTEST(Compression, ZstdWorks) {
+    ClusterWrapper cluster{"zstd"};
+    cluster->Execute(
+        "CREATE TEMPORARY TABLE IF NOT EXISTS tmp_table (id UInt64, value "
+        "String, count UInt64, tp DateTime64(9))"
+    );
+
+    const auto now = std::chrono::system_clock::now();
+    std::vector<SomeDataRow> data(1000, SomeDataRow{1, std::string(100, 'a'), 2, now});
+    cluster->InsertRows("tmp_table", {"id", "value", "count", "tp"}, data);
+
     storages::clickhouse::Query q{
         "SELECT c.number, randomString(10), c.number as t, NOW64() "
         "FROM "
@@ -0,0 +1,101 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/cursor.hpp>
+#include <userver/storages/clickhouse/query.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Numbers final {
+    std::vector<uint64_t> numbers;
+};
+
+struct NumberRow final {
+    uint64_t number;
+};
+
+// Small blocks, so that the result is split into many of them
+const storages::clickhouse::Query kNumbersQuery{
+    "SELECT number FROM system.numbers LIMIT {} SETTINGS max_block_size = 1000"};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Numbers> final {
+    using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+template <>
+struct CppToClickhouse<NumberRow> final {
+    using mapped_type = std::tuple<columns::UInt64Column>;
+};
+
+}  // namespace storages::clickhouse::io
+
+UTEST(ExecuteStreaming, ReadsAllBlocks) {
+    ClusterWrapper cluster{};
+    constexpr uint64_t kRowsCount = 100'000;
+
+    /// [Sample Cursor usage]
+    auto cursor = cluster->ExecuteStreaming(kNumbersQuery, kRowsCount);
+
+    uint64_t sum = 0;
+    std::size_t blocks_count = 0;
+    while (auto block = cursor.FetchBlockAs<Numbers>()) {
+        for (const auto number : block->numbers) sum += number;
+        ++blocks_count;
+    }
+    /// [Sample Cursor usage]
+
+    EXPECT_EQ(sum, kRowsCount * (kRowsCount - 1) / 2);
+    EXPECT_GT(blocks_count, 1);
+
+    // The end of the result is sticky
+    EXPECT_FALSE(cursor.FetchBlock().has_value());
+}
+
+UTEST(ExecuteStreaming, Rows) {
+    ClusterWrapper cluster{};
+
+    auto cursor = cluster->ExecuteStreaming(kNumbersQuery, 5000);
+
+    uint64_t expected = 0;
+    while (auto block = cursor.FetchBlock()) {
+        for (const auto& row : std::move(*block).AsRows<NumberRow>()) {
+            EXPECT_EQ(row.number, expected);
+            ++expected;
+        }
+    }
+    EXPECT_EQ(expected, 5000);
+}
+
+UTEST(ExecuteStreaming, EarlyDestruction) {
+    ClusterWrapper cluster{};
+
+    {
+        // Much more data than is buffered by the cursor
+        auto cursor = cluster->ExecuteStreaming(kNumbersQuery, 100'000'000);
+        const auto block = cursor.FetchBlock();
+        ASSERT_TRUE(block.has_value());
+        EXPECT_GT(block->GetRowsCount(), 0);
+    }
+
+    // The cluster is still usable
+    const auto result = cluster->Execute(kNumbersQuery, 10).As<Numbers>();
+    EXPECT_EQ(result.numbers.size(), 10);
+}
+
+UTEST(ExecuteStreaming, Error) {
+    ClusterWrapper cluster{};
+
+    auto cursor = cluster->ExecuteStreaming(storages::clickhouse::Query{"SELECT * FROM non_existent_table"});
+    UEXPECT_THROW(cursor.FetchBlock(), std::exception);
+}
+
+USERVER_NAMESPACE_END
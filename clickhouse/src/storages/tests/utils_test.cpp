@@ -21,7 +21,7 @@ clients::dns::Resolver MakeDnsResolver() {
     return clients::dns::Resolver{engine::current_task::GetTaskProcessor(), {}};
 }
 
-components::ComponentConfig GetConfig(bool use_compression) {
+components::ComponentConfig GetConfig(std::string_view compression) {
     USERVER_NAMESPACE::formats::yaml::ValueBuilder config_builder{USERVER_NAMESPACE::formats::yaml::FromString(
         R"(
 initial_pool_size: 1
@@ -30,9 +30,7 @@ queue_timeout: 1s
 use_secure_connection: false
 use_compression: false)"
     )};
-    if (use_compression) {
-        config_builder["compression"] = "lz4";
-    }
+    config_builder["compression"] = std::string{compression};
 
     USERVER_NAMESPACE::yaml_config::YamlConfig yaml_config{config_builder.ExtractValue(), {}};
     return USERVER_NAMESPACE::components::ComponentConfig{std::move(yaml_config)};
@@ -49,14 +47,14 @@ storages::clickhouse::impl::AuthSettings GetAuthSettings() {
 
 storages::clickhouse::Cluster MakeCluster(
     clients::dns::Resolver& resolver,
-    bool use_compression,
+    std::string_view compression,
     const std::vector<storages::clickhouse::impl::EndpointSettings>& endpoints
 ) {
     storages::clickhouse::impl::ClickhouseSettings settings;
     settings.auth_settings = GetAuthSettings();
     settings.endpoints = endpoints;
 
-    return storages::clickhouse::Cluster{resolver, settings, GetConfig(use_compression)};
+    return storages::clickhouse::Cluster{resolver, settings, GetConfig(compression)};
 }
 
 }  // namespace
@@ -68,10 +66,10 @@ uint32_t GetClickhousePort() {
 }
 
 ClusterWrapper::ClusterWrapper(
-    bool use_compression,
+    std::string_view compression,
     const std::vector<storages::clickhouse::impl::EndpointSettings>& endpoints
 )
-    : resolver_{MakeDnsResolver()}, cluster_{MakeCluster(resolver_, use_compression, endpoints)} {
+    : resolver_{MakeDnsResolver()}, cluster_{MakeCluster(resolver_, compression, endpoints)} {
     stats_holder_ = statistics_storage_.RegisterWriter("clickhouse", [this](utils::statistics::Writer& writer) {
         cluster_.WriteStatistics(writer);
     });
@@ -90,7 +88,7 @@ PoolWrapper::PoolWrapper()
       pool_{std::make_shared<storages::clickhouse::impl::PoolImpl>(
           resolver_,
           storages::clickhouse::impl::PoolSettings{
-              GetConfig(false),
+              GetConfig("none"),
               {"localhost", GetClickhousePort()},
               GetAuthSettings()}
       )} {}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include <userver/utest/utest.hpp>
 
 #include <storages/clickhouse/impl/pool_impl.hpp>
@@ -16,7 +18,7 @@ std::uint32_t GetClickhousePort();
 class ClusterWrapper final {
 public:
     ClusterWrapper(
-        bool use_compression = false,
+        std::string_view compression = "none",
         const std::vector<storages::clickhouse::impl::EndpointSettings>& endpoints =
             {{"localhost", GetClickhousePort()}}
     );
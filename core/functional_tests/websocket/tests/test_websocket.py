@@ -83,6 +83,18 @@ async def test_duplex(websocket_client):
         assert response == b'ping'
 
 
+async def test_duplex_deflate(websocket_client):
+    async with websocket_client.get('duplex') as chat:
+        assert 'permessage-deflate' in chat.response_headers.get(
+            'Sec-WebSocket-Extensions', '',
+        )
+        for i in range(3):
+            msg = ('{"id": %d, "text": "hello"}' % i) * 1000
+            await chat.send(msg)
+            response = await chat.recv()
+            assert response == msg.encode()
+
+
 async def test_two(websocket_client):
     async with websocket_client.get('duplex') as chat1:
         async with websocket_client.get('duplex') as chat2:
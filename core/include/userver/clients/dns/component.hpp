@@ -33,6 +33,8 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// cache-max-stale | how long an expired network reply is served while being updated in background | 24h
+/// cache-prefetch-hits | hits of a network reply within its TTL that make it updated in background when 10% of the TTL is left, 0 disables the prefetch | 10
 ///
 /// ## Static configuration example:
 ///
@@ -53,9 +55,11 @@ public:
 
 private:
     void Write(utils::statistics::Writer& writer);
+    void WriteUpdates(utils::statistics::Writer& writer);
 
     Resolver resolver_;
     utils::statistics::Entry statistics_holder_;
+    utils::statistics::Entry update_statistics_holder_;
 };
 
 }  // namespace clients::dns
@@ -39,6 +39,13 @@ struct ResolverConfig {
 
     /// Network cache failure TTL
     std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+    /// How long an expired record may be served while it is being updated
+    std::chrono::milliseconds cache_max_stale{std::chrono::hours{24}};
+
+    /// Hits of a record within its TTL that make it refreshed in background
+    /// before the expiration, 0 disables the prefetch
+    size_t cache_prefetch_hits{10};
 };
 
 }  // namespace clients::dns
@@ -34,6 +34,13 @@ public:
         utils::statistics::RelaxedCounter<size_t> network_failure{0};
     };
 
+    struct UpdateCounters {
+        /// Background updates of expiring or stale records
+        utils::statistics::RelaxedCounter<size_t> expiring{0};
+        /// Background updates of popular records long before the expiration
+        utils::statistics::RelaxedCounter<size_t> prefetch{0};
+    };
+
     Resolver(engine::TaskProcessor& fs_task_processor, const ResolverConfig& config);
     Resolver(const Resolver&) = delete;
     Resolver(Resolver&&) = delete;
@@ -46,6 +53,12 @@ public:
     ///  - Cached network resolution results
     ///  - Network name servers
     ///
+    /// Expired network results are served for up to
+    /// ResolverConfig::cache_max_stale while being updated in background.
+    /// Records hit at least ResolverConfig::cache_prefetch_hits times are
+    /// updated before the expiration. Concurrent queries of the same name
+    /// share a single network request.
+    ///
     /// @throws clients::dns::NotResolvedException if none of the sources provide
     /// a result within the specified deadline.
     AddrVector Resolve(const std::string& name, engine::Deadline deadline);
@@ -53,6 +66,9 @@ public:
     /// Returns lookup source counters.
     const LookupSourceCounters& GetLookupSourceCounters() const;
 
+    /// Returns background update counters.
+    const UpdateCounters& GetUpdateCounters() const;
+
     /// Forces the reload of lookup table file. Waits until the reload is done.
     void ReloadHosts();
 
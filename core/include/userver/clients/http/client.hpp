@@ -42,6 +42,8 @@ class ThreadPool;
 namespace clients::http {
 namespace impl {
 class EasyWrapper;
+class Http2Pool;
+class Http2Pools;
 }  // namespace impl
 
 struct TestsuiteConfig;
@@ -94,6 +96,9 @@ public:
     // For internal use only.
     const http::DestinationStatistics& GetDestinationStatistics() const;
 
+    // For internal use only.
+    const impl::Http2Pools& GetHttp2Pools() const;
+
     // For internal use only.
     void SetTestsuiteConfig(const TestsuiteConfig& config);
 
@@ -137,6 +142,7 @@ private:
     void IncPending() noexcept { ++pending_tasks_; }
     void DecPending() noexcept { --pending_tasks_; }
     void PushIdleEasy(std::shared_ptr<curl::easy>&& easy) noexcept;
+    impl::Http2Pool* FindHttp2Pool(std::string_view url) noexcept;
 
     std::shared_ptr<curl::easy> TryDequeueIdle() noexcept;
 
@@ -149,6 +155,7 @@ private:
     std::unique_ptr<engine::ev::ThreadPool> thread_pool_;
     std::vector<Statistics> statistics_;
     std::vector<std::unique_ptr<curl::multi>> multis_;
+    std::unique_ptr<impl::Http2Pools> http2_pools_;
 
     static constexpr size_t kIdleQueueSize = 616;
     static constexpr size_t kIdleQueueAlignment = 8;
@@ -48,6 +48,15 @@ namespace components {
 /// set-deadline-propagation-header | whether to set http::common::kXYaTaxiClientTimeoutMs request header, see @ref scripts/docs/en/userver/deadline_propagation.md | true
 /// plugins | Plugin names to apply. A plugin component is called "http-client-plugin-" plus the plugin name. | []
 /// cancellation-policy | Cancellation policy for new requests. | cancel
+/// http2-pools | dedicated HTTP/2 connection pools, the keys are destination origins `scheme://host[:port]`, see below | {}
+/// http2-pools.*.max-connections | max connections to the destination | 4
+/// http2-pools.*.max-concurrent-streams | max streams multiplexed over a single connection | 100
+/// http2-pools.*.prior-knowledge | use HTTP/2 without the Upgrade for `http://` URLs (h2c prior knowledge) | false
+///
+/// Requests to a destination from `http2-pools` share a dedicated connection
+/// pool: the streams wait for a free slot on one of `max-connections`
+/// connections instead of opening new sockets. HTTP/2 is negotiated via ALPN
+/// for `https://` destinations. Requests through a proxy do not use the pools.
 ///
 /// ## Static configuration example:
 ///
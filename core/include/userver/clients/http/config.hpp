@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <string>
+#include <unordered_map>
 
 #include <userver/dynamic_config/fwd.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -26,6 +27,20 @@ enum class CancellationPolicy {
 
 CancellationPolicy Parse(yaml_config::YamlConfig value, formats::parse::To<CancellationPolicy>);
 
+/// @brief HTTP/2 connection pool of a single destination.
+///
+/// Requests to the destination share a dedicated connection pool where the
+/// streams are multiplexed over at most `max_connections` connections.
+struct Http2PoolPolicy final {
+    std::size_t max_connections{4};
+    /// Streams over a single connection, the peer may set a lower limit
+    std::size_t max_concurrent_streams{100};
+    /// Use HTTP/2 without the Upgrade for `http://` URLs (h2c prior knowledge)
+    bool prior_knowledge{false};
+};
+
+Http2PoolPolicy Parse(const yaml_config::YamlConfig& value, formats::parse::To<Http2PoolPolicy>);
+
 // Static config
 struct ClientSettings final {
     std::string thread_name_prefix{};
@@ -33,6 +48,8 @@ struct ClientSettings final {
     DeadlinePropagationConfig deadline_propagation{};
     const tracing::TracingManagerBase* tracing_manager{nullptr};
     CancellationPolicy cancellation_policy{CancellationPolicy::kCancel};
+    /// Destination origin `scheme://host[:port]` to its pool policy
+    std::unordered_map<std::string, Http2PoolPolicy> http2_pools{};
 };
 
 ClientSettings Parse(const yaml_config::YamlConfig& value, formats::parse::To<ClientSettings>);
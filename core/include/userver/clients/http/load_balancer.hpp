@@ -0,0 +1,214 @@
+#pragma once
+
+/// @file userver/clients/http/load_balancer.hpp
+/// @brief @copybrief clients::http::LoadBalancer
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/clients/http/request.hpp>
+#include <userver/clients/http/response_future.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/span.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+class RetryBudget;
+
+namespace statistics {
+class Writer;
+}  // namespace statistics
+}  // namespace utils
+
+namespace clients::http {
+
+class Response;
+
+namespace impl {
+struct EndpointState;
+}  // namespace impl
+
+struct LoadBalancerSettings final {
+    /// Time constant of the latency moving average
+    std::chrono::milliseconds latency_decay{std::chrono::seconds{10}};
+    /// Consecutive failures (network errors and 5xx) that eject an endpoint
+    std::size_t consecutive_failures{5};
+    /// Ejection time, doubles with each ejection of a flapping endpoint
+    std::chrono::milliseconds base_ejection_time{std::chrono::seconds{30}};
+    std::chrono::milliseconds max_ejection_time{std::chrono::minutes{5}};
+    /// Endpoints that may be ejected at once, in percents
+    std::size_t max_ejection_percent{50};
+};
+
+LoadBalancerSettings Parse(const yaml_config::YamlConfig& value, formats::parse::To<LoadBalancerSettings>);
+
+/// @brief An endpoint of a load balanced service
+struct Endpoint final {
+    /// URL prefix of the requests, e.g. `https://service.example.com:8443`
+    std::string base_url;
+    /// Optional CURLOPT_CONNECT_TO value `host:port:address:port`, keeps the
+    /// Host header and the TLS SNI of the base_url
+    std::string connect_to{};
+
+    bool operator==(const Endpoint& other) const noexcept {
+        return base_url == other.base_url && connect_to == other.connect_to;
+    }
+
+    bool operator!=(const Endpoint& other) const noexcept { return !(*this == other); }
+};
+
+/// @brief Makes static endpoints from the base URLs
+std::vector<Endpoint> MakeEndpoints(const std::vector<std::string>& base_urls);
+
+/// @brief Makes an endpoint for every address the host of `base_url`
+/// resolves to, the connections go to the address while the requests keep
+/// the host name.
+std::vector<Endpoint>
+ResolveEndpoints(clients::dns::Resolver& resolver, const std::string& base_url, engine::Deadline deadline);
+
+/// @brief Reads base URLs from a file, one per line, `#` starts a comment.
+std::vector<Endpoint> ReadEndpointsFile(engine::TaskProcessor& fs_task_processor, const std::string& path);
+
+class NoEndpointsException final : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// @ingroup userver_clients
+///
+/// @brief Client-side load balancer over a set of endpoints.
+///
+/// Picks endpoints with power-of-two-choices: two random endpoints are
+/// compared by `latency EWMA * (in-flight requests + 1)` and the cheaper one
+/// wins. New endpoints have no latency and are probed first.
+///
+/// An endpoint that fails LoadBalancerSettings::consecutive_failures times in
+/// a row is ejected for LoadBalancerSettings::base_ejection_time, the time
+/// doubles with each subsequent ejection. If all the endpoints are ejected,
+/// the ejections are ignored.
+///
+/// The endpoints are updated by SetEndpoints(), the state of the endpoints
+/// that are kept is preserved. Thread-safe.
+///
+/// Use LoadBalancedStrategy to perform requests with retries on other
+/// endpoints and hedging.
+class LoadBalancer final {
+public:
+    /// @brief A picked endpoint with an accounted in-flight request.
+    class Lease final {
+    public:
+        Lease(Lease&&) noexcept;
+        Lease& operator=(Lease&&) noexcept;
+        ~Lease();
+
+        const Endpoint& GetEndpoint() const noexcept;
+
+        /// Sets CURLOPT_CONNECT_TO of the request if the endpoint has it,
+        /// the Lease must outlive the request
+        void Apply(Request& request) const;
+
+        /// Accounts the latency since the pick and the outcome of the request
+        void AccountResult(bool success);
+
+    private:
+        friend class LoadBalancer;
+
+        Lease(const LoadBalancer& balancer, std::shared_ptr<impl::EndpointState> state) noexcept;
+
+        const LoadBalancer* balancer_;
+        std::shared_ptr<impl::EndpointState> state_;
+        std::chrono::steady_clock::time_point started_at_;
+        bool accounted_{false};
+    };
+
+    explicit LoadBalancer(LoadBalancerSettings settings = {});
+    LoadBalancer(LoadBalancer&&) = delete;
+    LoadBalancer& operator=(LoadBalancer&&) = delete;
+    ~LoadBalancer();
+
+    void SetEndpoints(const std::vector<Endpoint>& endpoints);
+
+    /// @brief Picks an endpoint avoiding the excluded ones if possible
+    /// @throws NoEndpointsException if there are no endpoints
+    Lease Pick(utils::span<const Endpoint> exclude = {}) const;
+
+    std::size_t GetEndpointsCount() const;
+
+private:
+    friend void DumpMetric(utils::statistics::Writer& writer, const LoadBalancer& balancer);
+
+    void AccountResult(impl::EndpointState& state, std::chrono::steady_clock::duration latency, bool success) const;
+    void TryEject(impl::EndpointState& state) const;
+
+    const LoadBalancerSettings settings_;
+    rcu::Variable<std::vector<std::shared_ptr<impl::EndpointState>>> endpoints_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const LoadBalancer& balancer);
+
+/// @brief Strategy for utils::hedging::HedgeRequest() that sends the
+/// attempts to the endpoints picked by LoadBalancer.
+///
+/// A failed attempt (network error or 5xx) is retried at once on another
+/// endpoint. Both retries and hedged attempts are made only if the
+/// utils::RetryBudget allows. If all the attempts fail, the last received
+/// response is returned.
+///
+/// @code
+/// auto response = utils::hedging::HedgeRequest(
+///     clients::http::LoadBalancedStrategy{
+///         balancer,
+///         [&](const std::string& base_url) {
+///             return http_client.CreateRequest().get(base_url + "/v1/items").timeout(std::chrono::milliseconds{200});
+///         },
+///         &retry_budget},
+///     hedging_settings
+/// );
+/// @endcode
+class LoadBalancedStrategy final {
+public:
+    using RequestFactory = std::function<Request(const std::string& base_url)>;
+
+    struct Attempt final {
+        LoadBalancer::Lease lease;
+        ResponseFuture future;
+
+        engine::impl::ContextAccessor* TryGetContextAccessor() noexcept { return future.TryGetContextAccessor(); }
+    };
+
+    /// @param retry_budget may be nullptr, must outlive the strategy otherwise
+    LoadBalancedStrategy(
+        const LoadBalancer& balancer,
+        RequestFactory request_factory,
+        utils::RetryBudget* retry_budget = nullptr
+    );
+
+    std::optional<Attempt> Create(std::size_t attempt);
+    std::optional<std::chrono::milliseconds> ProcessReply(Attempt&& attempt);
+    std::optional<std::shared_ptr<Response>> ExtractReply();
+    void Finish(Attempt&& attempt);
+
+private:
+    const LoadBalancer& balancer_;
+    RequestFactory request_factory_;
+    utils::RetryBudget* retry_budget_;
+    std::vector<Endpoint> tried_;
+    std::shared_ptr<Response> reply_;
+    bool succeeded_{false};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
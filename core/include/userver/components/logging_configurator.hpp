@@ -29,6 +29,7 @@ namespace components {
 /// ## LoggingConfigurator Dynamic config
 /// * @ref USERVER_LOG_DYNAMIC_DEBUG
 /// * @ref USERVER_NO_LOG_SPANS
+/// * @ref USERVER_TAIL_SAMPLING
 ///
 /// ## Static options:
 /// Name | Description | Default value
@@ -0,0 +1,275 @@
+#pragma once
+
+/// @file userver/concurrent/single_flight.hpp
+/// @brief @copybrief concurrent::SingleFlight
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/engine/task/shared_task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/lazy_prvalue.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace concurrent {
+
+struct SingleFlightSettings final {
+    /// Number of independently locked shards of the in-flight calls
+    std::size_t ways{16};
+    /// Default time to wait for a result, zero means no timeout
+    std::chrono::milliseconds timeout{0};
+};
+
+struct SingleFlightStatistics final {
+    /// Calls that started the work
+    utils::statistics::RateCounter executions;
+    /// Calls that joined the work of another call
+    utils::statistics::RateCounter coalesced;
+    /// Calls that stopped waiting because of the timeout
+    utils::statistics::RateCounter timeouts;
+    /// Works cancelled because all the callers have left
+    utils::statistics::RateCounter abandoned;
+    /// Works in progress
+    std::atomic<std::int64_t> in_flight{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const SingleFlightStatistics& stats);
+
+/// @brief Thrown by concurrent::SingleFlight::Execute if the result was not
+/// ready in time
+class SingleFlightTimeoutException final : public std::runtime_error {
+public:
+    SingleFlightTimeoutException() : std::runtime_error("Timed out waiting for the coalesced call") {}
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Coalesces concurrent calls with the same key into a single call.
+///
+/// The first caller of Execute() for a key starts the work in a separate task,
+/// the callers that come while the work is in progress wait for the same
+/// result. The result or the exception of the work is returned to all of them,
+/// the next call after the work is finished starts a new one.
+///
+/// The work runs in a task of its own, with a `single_flight` span. Like in
+/// utils::AsyncBackground, engine::TaskInheritedVariable instances are not
+/// propagated to it, so the deadline of the request that started the work
+/// (see server::request::GetTaskInheritedDeadline) does not cut the work
+/// short for the other callers. Pass the timeouts to the work explicitly.
+///
+/// A caller that is cancelled or times out stops waiting, the work goes on for
+/// the rest of the callers. The work is cancelled once all its callers have
+/// left, so it never outlives the Execute() calls. The work must not capture
+/// references to the locals of the caller, as the caller that started the work
+/// may leave first.
+///
+/// Keys are spread over SingleFlightSettings::ways shards that are locked
+/// independently. Thread-safe.
+///
+/// ## Example: deduplicating HTTP requests
+///
+/// @code
+/// concurrent::SingleFlight<std::string, std::string> profiles_flight;
+///
+/// std::string GetProfile(const std::string& user_id) {
+///     return profiles_flight.Execute(user_id, [&http_client = http_client_, user_id] {
+///         return http_client.CreateRequest()
+///             .get("http://profiles.example.com/v1/profile?id=" + user_id)
+///             .timeout(std::chrono::milliseconds{500})
+///             .perform()
+///             ->body();
+///     });
+/// }
+/// @endcode
+///
+/// ## Example: cache::ExpirableLruCache misses
+///
+/// cache::ExpirableLruCache::Get() serializes the concurrent misses of a key,
+/// so with a failing or a slow update the waiters call it one after another.
+/// With SingleFlight they share a single call and its outcome:
+///
+/// @code
+/// Profile GetProfile(const std::string& user_id) {
+///     if (auto profile = cache_.GetOptionalNoUpdate(user_id)) return *std::move(profile);
+///
+///     return profiles_flight_.Execute(user_id, [this, user_id] {
+///         auto profile = FetchProfile(user_id);
+///         cache_.Put(user_id, profile);
+///         return profile;
+///     });
+/// }
+/// @endcode
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class SingleFlight final {
+    static_assert(!std::is_void_v<Value> && !std::is_reference_v<Value>, "Value must be an object type");
+    static_assert(std::is_copy_constructible_v<Value>, "The result is copied to every caller");
+
+public:
+    explicit SingleFlight(SingleFlightSettings settings = {});
+
+    SingleFlight(SingleFlight&&) = delete;
+    SingleFlight& operator=(SingleFlight&&) = delete;
+
+    /// @brief Runs `func` or joins its run in progress for the `key`, waits
+    /// for SingleFlightSettings::timeout at most.
+    /// @throws anything `func` throws
+    /// @throws SingleFlightTimeoutException on timeout
+    /// @throws engine::WaitInterruptedException if the current task is
+    /// cancelled
+    template <typename Function>
+    Value Execute(const Key& key, Function&& func);
+
+    /// @overload
+    template <typename Function>
+    Value Execute(const Key& key, Function&& func, engine::Deadline deadline);
+
+    /// Number of keys with the work in progress
+    std::size_t GetInFlightCount() const noexcept;
+
+    const SingleFlightStatistics& GetStatistics() const noexcept { return stats_; }
+
+private:
+    using Task = engine::SharedTaskWithResult<Value>;
+
+    struct Flight final {
+        std::uint64_t id{0};
+        Task task;
+        std::size_t waiters{0};
+    };
+
+    struct Shard final {
+        engine::Mutex mutex;
+        std::unordered_map<Key, Flight, Hash, Equal> flights;
+        std::uint64_t last_id{0};
+    };
+
+    Shard& GetShard(const Key& key) noexcept { return shards_[Hash{}(key) % shards_.size()]; }
+
+    void Leave(Shard& shard, const Key& key, std::uint64_t id) noexcept;
+
+    const SingleFlightSettings settings_;
+    utils::FixedArray<Shard> shards_;
+    SingleFlightStatistics stats_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+SingleFlight<Key, Value, Hash, Equal>::SingleFlight(SingleFlightSettings settings)
+    : settings_(settings), shards_(settings.ways) {
+    UINVARIANT(settings_.ways > 0, "SingleFlight needs at least one way");
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Function>
+Value SingleFlight<Key, Value, Hash, Equal>::Execute(const Key& key, Function&& func) {
+    const auto deadline = settings_.timeout.count() > 0 ? engine::Deadline::FromDuration(settings_.timeout)
+                                                        : engine::Deadline{};
+    return Execute(key, std::forward<Function>(func), deadline);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Function>
+Value SingleFlight<Key, Value, Hash, Equal>::Execute(const Key& key, Function&& func, engine::Deadline deadline) {
+    auto& shard = GetShard(key);
+
+    // The last copy of the task cancels the work and waits for it, so the copy
+    // must outlive the `leave` guard below
+    Task task;
+    std::uint64_t id = 0;
+    {
+        const std::lock_guard lock{shard.mutex};
+        auto [it, inserted] = shard.flights.try_emplace(key);
+        auto& flight = it->second;
+        if (inserted) {
+            try {
+                flight.task = engine::SharedAsyncNoSpan(
+                    engine::current_task::GetTaskProcessor(),
+                    utils::LazyPrvalue([] {
+                        return utils::impl::SpanWrapCall(
+                            "single_flight", utils::impl::SpanWrapCall::InheritVariables::kNo
+                        );
+                    }),
+                    std::forward<Function>(func)
+                );
+            } catch (...) {
+                shard.flights.erase(it);
+                throw;
+            }
+            flight.id = ++shard.last_id;
+            ++stats_.executions;
+            ++stats_.in_flight;
+        } else {
+            ++stats_.coalesced;
+        }
+        ++flight.waiters;
+        id = flight.id;
+        task = flight.task;
+    }
+
+    struct LeaveGuard final {
+        ~LeaveGuard() { self.Leave(shard, key, id); }
+
+        SingleFlight& self;
+        Shard& shard;
+        const Key& key;
+        std::uint64_t id;
+    } leave{*this, shard, key, id};
+
+    task.WaitUntil(deadline);
+    if (!task.IsFinished()) {
+        ++stats_.timeouts;
+        throw SingleFlightTimeoutException{};
+    }
+    return task.Get();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void SingleFlight<Key, Value, Hash, Equal>::Leave(Shard& shard, const Key& key, std::uint64_t id) noexcept {
+    // Destroyed out of the lock, as the destruction may wait for the task
+    Task finished_task;
+
+    const std::lock_guard lock{shard.mutex};
+    const auto it = shard.flights.find(key);
+    if (it == shard.flights.end() || it->second.id != id) return;
+
+    auto& flight = it->second;
+    UASSERT(flight.waiters > 0);
+    --flight.waiters;
+
+    const bool is_finished = flight.task.IsFinished();
+    if (!is_finished && flight.waiters > 0) return;
+    if (!is_finished) ++stats_.abandoned;
+
+    finished_task = std::move(flight.task);
+    shard.flights.erase(it);
+    --stats_.in_flight;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::size_t SingleFlight<Key, Value, Hash, Equal>::GetInFlightCount() const noexcept {
+    const auto in_flight = stats_.in_flight.load();
+    return in_flight > 0 ? static_cast<std::size_t>(in_flight) : 0;
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#pragma once
+
+/// @file userver/congestion_control/controllers/factory.hpp
+/// @brief Static config and factory of the congestion control v2 controllers
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <userver/congestion_control/controllers/gradient.hpp>
+#include <userver/congestion_control/controllers/linear.hpp>
+#include <userver/congestion_control/controllers/linear_config.hpp>
+#include <userver/congestion_control/controllers/v2.hpp>
+#include <userver/congestion_control/controllers/vegas.hpp>
+#include <userver/congestion_control/limiter.hpp>
+#include <userver/dynamic_config/source.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::v2 {
+
+enum class ControllerType {
+    /// LinearController, the default
+    kLinear,
+    /// GradientController
+    kGradient,
+    /// VegasController
+    kVegas,
+};
+
+ControllerType Parse(const yaml_config::YamlConfig& value, formats::parse::To<ControllerType>);
+
+/// Static config of any of the congestion control v2 controllers
+struct ControllerStaticConfig : Controller::Config {
+    ControllerType type{ControllerType::kLinear};
+    GradientController::Settings gradient;
+    VegasController::Settings vegas;
+};
+
+ControllerStaticConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<ControllerStaticConfig>);
+
+/// Creates the controller of `config.type`
+std::unique_ptr<Controller> MakeController(
+    const std::string& name,
+    v2::Sensor& sensor,
+    Limiter& limiter,
+    Stats& stats,
+    const ControllerStaticConfig& config,
+    dynamic_config::Source config_source,
+    std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter
+);
+
+}  // namespace congestion_control::v2
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,78 @@
+#pragma once
+
+/// @file userver/congestion_control/controllers/gradient.hpp
+/// @brief @copybrief congestion_control::v2::GradientController
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include <userver/congestion_control/controllers/linear_config.hpp>
+#include <userver/congestion_control/controllers/v2.hpp>
+#include <userver/congestion_control/limiter.hpp>
+#include <userver/dynamic_config/source.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::v2 {
+
+/// @brief Latency gradient based controller, similar to Gradient2 of
+/// Netflix concurrency-limits.
+///
+/// Compares the current average timings (short RTT) with their exponential
+/// moving average over a long window (long RTT). While the short RTT exceeds
+/// the long RTT by more than `rtt_tolerance` times, the limit is multiplied by
+/// their ratio (but no less than 0.5) and is increased by a queue allowance of
+/// `sqrt(limit)` otherwise. The long RTT follows the timings slowly, so that
+/// the controller adapts to the downstreams which became slower for good.
+/// Unlike Gradient2, the RTTs are sampled once per epoch (second) rather than
+/// per request, so the default long window is much longer in samples.
+///
+/// Activation and deactivation follow LinearController: the limit is applied
+/// from the first overloaded epoch and is removed once it exceeds the current
+/// load by Config::safe_delta_limit.
+class GradientController final : public Controller {
+public:
+    struct Settings {
+        /// Weight of the new limit estimation, from 0 to 1
+        double smoothing{0.2};
+
+        /// How many times the short RTT may exceed the long RTT before
+        /// the limit is decreased
+        double rtt_tolerance{1.5};
+
+        /// Size of the long RTT window, in epochs (seconds)
+        std::size_t long_window{600};
+    };
+
+    GradientController(
+        const std::string& name,
+        v2::Sensor& sensor,
+        Limiter& limiter,
+        Stats& stats,
+        const Controller::Config& config,
+        const Settings& settings,
+        dynamic_config::Source config_source,
+        std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter
+    );
+
+    Limit Update(const Sensor::Data& current) override;
+
+private:
+    const Settings settings_;
+    std::optional<double> long_rtt_;
+    std::optional<double> estimated_limit_;
+    std::size_t epochs_passed_{0};
+
+    dynamic_config::Source config_source_;
+    std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter_;
+};
+
+GradientController::Settings
+Parse(const yaml_config::YamlConfig& value, formats::parse::To<GradientController::Settings>);
+
+}  // namespace congestion_control::v2
+
+USERVER_NAMESPACE_END
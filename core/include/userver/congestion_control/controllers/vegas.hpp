@@ -0,0 +1,81 @@
+#pragma once
+
+/// @file userver/congestion_control/controllers/vegas.hpp
+/// @brief @copybrief congestion_control::v2::VegasController
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include <userver/congestion_control/controllers/linear_config.hpp>
+#include <userver/congestion_control/controllers/v2.hpp>
+#include <userver/congestion_control/limiter.hpp>
+#include <userver/dynamic_config/source.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::v2 {
+
+/// @brief Delay based controller, similar to TCP Vegas and VegasLimit of
+/// Netflix concurrency-limits.
+///
+/// Estimates the number of queued requests as
+/// `limit * (1 - no_load_rtt / rtt)`, where `no_load_rtt` is the minimal
+/// observed timings, and keeps it between `alpha * log10(limit)` and
+/// `beta * log10(limit)`. The minimal timings are reset every
+/// `probe_interval` epochs while no limit is applied, so that the controller
+/// notices downstreams that became slower for good.
+///
+/// Activation and deactivation follow LinearController: the limit is applied
+/// from the first overloaded epoch and is removed once it exceeds the current
+/// load by Config::safe_delta_limit.
+class VegasController final : public Controller {
+public:
+    struct Settings {
+        /// Weight of the new limit estimation, from 0 to 1
+        double smoothing{1.0};
+
+        /// The limit is increased while fewer than `alpha * log10(limit)`
+        /// requests are queued
+        double alpha{3.0};
+
+        /// The limit is decreased while more than `beta * log10(limit)`
+        /// requests are queued
+        double beta{6.0};
+
+        /// Reset the minimal timings every that many epochs (seconds) while
+        /// no limit is applied
+        std::size_t probe_interval{30};
+    };
+
+    VegasController(
+        const std::string& name,
+        v2::Sensor& sensor,
+        Limiter& limiter,
+        Stats& stats,
+        const Controller::Config& config,
+        const Settings& settings,
+        dynamic_config::Source config_source,
+        std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter
+    );
+
+    Limit Update(const Sensor::Data& current) override;
+
+private:
+    const Settings settings_;
+    std::optional<double> no_load_rtt_;
+    std::optional<double> estimated_limit_;
+    std::size_t epochs_passed_{0};
+    std::size_t epochs_since_probe_{0};
+
+    dynamic_config::Source config_source_;
+    std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter_;
+};
+
+VegasController::Settings Parse(const yaml_config::YamlConfig& value, formats::parse::To<VegasController::Settings>);
+
+}  // namespace congestion_control::v2
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,8 @@
 /// @file userver/engine/io/tls_wrapper.hpp
 /// @brief TLS socket wrappers
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -17,6 +19,59 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+/// Where the TLS records are encrypted and decrypted after the handshake
+enum class TlsOffload {
+    /// In user space by OpenSSL
+    kNone,
+
+    /// In the kernel (Linux kTLS) if both the kernel and OpenSSL support the
+    /// negotiated cipher, in user space otherwise. Saves a copy of the data
+    /// between OpenSSL and the socket, see
+    /// TlsWrapper::IsKernelTlsSendActive() and
+    /// TlsWrapper::IsKernelTlsRecvActive() for the result.
+    kKernel,
+};
+
+/// @brief Storage of TLS sessions to resume them without the full handshake.
+///
+/// Servers resume the sessions from the session tickets, encrypted by the
+/// ticket keys, or from the bounded session cache for the clients that do not
+/// support the tickets. Clients offer the last session received from a server
+/// name on reconnect.
+///
+/// Thread safe. Share a single instance between all the server connections
+/// of a listener (including all its shards) or between all the connections of
+/// a client, and do not share it between servers and clients.
+class TlsSessionResumption final {
+public:
+    /// @brief Size of a session ticket key: 16 bytes of the key name, 32 bytes
+    /// of the HMAC-SHA256 key and 32 bytes of the AES-256 key, same as the
+    /// nginx `ssl_session_ticket_key` files.
+    static constexpr std::size_t kTicketKeySize = 80;
+
+    /// Creates a storage with up to `cache_size` cached sessions and a random
+    /// ticket key
+    explicit TlsSessionResumption(std::size_t cache_size);
+    ~TlsSessionResumption();
+
+    TlsSessionResumption(const TlsSessionResumption&) = delete;
+    TlsSessionResumption& operator=(const TlsSessionResumption&) = delete;
+
+    /// @brief Replaces the session ticket keys of kTicketKeySize bytes each.
+    ///
+    /// The first key encrypts the new tickets, the rest only decrypt the
+    /// tickets issued before the rotation, and such tickets are renewed.
+    /// An empty list restores a random key.
+    /// @throws TlsException if a key has invalid size
+    void SetTicketKeys(const std::vector<std::string>& keys);
+
+private:
+    friend class TlsWrapper;
+
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe. E.g. you MAY NOT read and write concurrently from multiple
@@ -26,8 +81,16 @@ namespace engine::io {
 /// @snippet src/engine/io/tls_wrapper_test.cpp TLS wrapper usage
 class [[nodiscard]] TlsWrapper final : public RwBase {
 public:
-    /// Starts a TLS client on an opened socket
-    static TlsWrapper StartTlsClient(Socket&& socket, const std::string& server_name, Deadline deadline);
+    /// @brief Starts a TLS client on an opened socket
+    /// @param session_resumption if set, the session is resumed from the one
+    ///   stored on the previous connection to `server_name`
+    static TlsWrapper StartTlsClient(
+        Socket&& socket,
+        const std::string& server_name,
+        Deadline deadline,
+        TlsOffload offload = TlsOffload::kNone,
+        TlsSessionResumption* session_resumption = nullptr
+    );
 
     /// Starts a TLS client with client cert on an opened socket
     static TlsWrapper StartTlsClient(
@@ -36,16 +99,21 @@ public:
         const crypto::Certificate& cert,
         const crypto::PrivateKey& key,
         Deadline deadline,
-        const std::vector<crypto::Certificate>& extra_cert_authorities = {}
+        const std::vector<crypto::Certificate>& extra_cert_authorities = {},
+        TlsOffload offload = TlsOffload::kNone
     );
 
-    /// Starts a TLS server on an opened socket
+    /// @brief Starts a TLS server on an opened socket
+    /// @param session_resumption if set, the client sessions are resumed with
+    ///   its session tickets and cache
     static TlsWrapper StartTlsServer(
         Socket&& socket,
         const crypto::Certificate& cert,
         const crypto::PrivateKey& key,
         Deadline deadline,
-        const std::vector<crypto::Certificate>& extra_cert_authorities = {}
+        const std::vector<crypto::Certificate>& extra_cert_authorities = {},
+        TlsOffload offload = TlsOffload::kNone,
+        TlsSessionResumption* session_resumption = nullptr
     );
 
     ~TlsWrapper() override;
@@ -81,8 +149,19 @@ public:
     /// @brief Finishes TLS session and returns the socket.
     /// @warning Wrapper becomes invalid on entry and can only be used to retry
     ///   socket extraction if interrupted.
+    /// @throws TlsException if kernel TLS offload is active, as the socket
+    ///   cannot be switched back to plain text.
     [[nodiscard]] Socket StopTls(Deadline deadline);
 
+    /// Whether the records sent are encrypted by the kernel
+    bool IsKernelTlsSendActive() const;
+
+    /// Whether the records received are decrypted by the kernel
+    bool IsKernelTlsRecvActive() const;
+
+    /// Whether the session was resumed without the full handshake
+    bool IsSessionReused() const;
+
     /// @brief Receives at least one byte from the socket.
     /// @returns 0 if connection is closed on one side and no data could be
     /// received any more, received bytes count otherwise.
@@ -104,6 +183,10 @@ public:
 
     [[nodiscard]] size_t WriteAll(std::initializer_list<IoData> list, Deadline deadline) override;
 
+    /// @brief Writes the IoData coalescing the small chunks into TLS records
+    /// of up to 4KiB.
+    [[nodiscard]] size_t WriteAll(const IoData* list, std::size_t list_size, Deadline deadline) override;
+
     int GetRawFd();
 
 private:
@@ -43,10 +43,13 @@ namespace components {
 /// ---- | ----------- | -------------
 /// file_path | path to the log file | -
 /// level | log verbosity | info
-/// format | log output format, either `tskv` or `ltsv` | tskv
+/// format | log output format, either `tskv`, `ltsv` or `binary` (see logging::Format::kBinary) | tskv
 /// flush_level | messages of this and higher levels get flushed to the file immediately | warning
 /// message_queue_size | the size of internal message queue, must be a power of 2 | 65536
 /// overflow_behavior | message handling policy while the queue is full: `discard` drops messages, `block` waits until message gets into the queue | discard
+/// file_write_mode | how records get to the log file: `buffered` writes each record into a stdio buffer, `batched` writes each batch of queued records with a single writev | buffered
+/// batch_max_size | for `batched` file_write_mode, small batches are gathered in memory until that many bytes are buffered | 65536
+/// batch_max_age | for `batched` file_write_mode, small batches are gathered in memory until the first of them gets that old | 100ms
 /// testsuite-capture | if exists, setups additional TCP log sink for testing purposes | {}
 /// fs-task-processor | task processor for disk I/O operations for this logger | fs-task-processor of the loggers component
 ///
@@ -66,6 +66,10 @@ namespace components {
 /// tls.cert | path to TLS server certificate | -
 /// tls.private-key | path to TLS server certificate private key | -
 /// tls.private-key-passphrase-name | passphrase name located in secdist's "passphrases" section | -
+/// tls.kernel-offload | encrypt and decrypt the records in the kernel (Linux kTLS) after the handshake if the kernel supports the negotiated cipher, see engine::io::TlsOffload | false
+/// tls.session-resumption | resume the TLS sessions without the full handshake, see engine::io::TlsSessionResumption | false
+/// tls.session-cache-size | max number of sessions in the cache shared by the listener shards for the clients without session tickets support, 0 to use only the tickets | 20480
+/// tls.session-ticket-keys-name | name of the session ticket keys in the secdist `tls_session_ticket_keys` entry, base64 encoded 80 byte keys with the newest first, rereads the keys on secdist update; random per process keys are used if not set | -
 /// handler-defaults.max_url_size | max path/URL size or empty to not limit | 8192
 /// handler-defaults.max_request_size | max size of the whole request | 1024 * 1024
 /// handler-defaults.max_headers_size | max request headers size | 65536
@@ -81,6 +85,11 @@ namespace components {
 /// connection.http2-session.max_concurrent_streams | max number of concurrent open streams | 100
 /// connection.http2-session.max_frame_size | max size of the HTTP/2.0 frame | 16384
 /// connection.http2-session.initial_window_size | the initial window size of the server | 65536
+/// connection.http2-session.connection_window_size | the initial window size of the connection | 65536
+/// connection.http2-session.adaptive_window | grow the windows up to the bandwidth-delay product measured with PINGs | false
+/// connection.http2-session.max_window_size | the max window size for the adaptive_window | 16777216
+/// connection.http2-session.rfc9218_priorities | schedule the streams according to the RFC 9218 priority header and PRIORITY_UPDATE frames; requires nghttp2 1.49+ | true
+/// connection.http2-session.write_buffer_size | frames of the streams are gathered into a buffer of this size and written with a single write | 65536
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 /// middleware-pipeline-builder | name of a component to build a server-wide middleware pipeline | default-server-middleware-pipeline-builder
 ///
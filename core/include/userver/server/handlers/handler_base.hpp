@@ -39,6 +39,8 @@ namespace server::handlers {
 /// max_requests_per_second | integer to limit RPS to this handler | <no limit>
 /// decompress_request | allow decompression of the requests | true
 /// throttling_enabled | allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options | true
+/// criticality | criticality class of the requests (critical, normal or sheddable), the lower classes are rejected first by the congestion control | normal
+/// criticality-header | name of the request header (e.g. X-Priority) with the criticality class that overrides the `criticality` option, enable only for the trusted clients | <criticality from the header is ignored>
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | <takes the value from components::Server config>
 /// monitor-handler | Overrides the in-code `is_monitor` flag that makes the handler run either on `server.listener` or on `server.listener-monitor` | --
 /// set_tracing_headers | whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId) | true
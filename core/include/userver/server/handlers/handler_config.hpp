@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -26,6 +27,19 @@ enum class UrlTrailingSlashOption {
     kDefault = kBoth,
 };
 
+/// @brief Criticality class of the requests. When the congestion control
+/// limits the RPS, the requests of the lower classes are rejected first.
+enum class Criticality {
+    kCritical,   ///< health checks and the most valuable requests
+    kNormal,     ///< default
+    kSheddable,  ///< batch and background requests, rejected first
+};
+
+std::string_view ToString(Criticality criticality);
+
+/// Returns std::nullopt for unknown names
+std::optional<Criticality> CriticalityFromString(std::string_view name) noexcept;
+
 struct HandlerConfig {
     std::variant<std::string, FallbackHandler> path;
     std::string task_processor;
@@ -40,6 +54,8 @@ struct HandlerConfig {
     std::optional<size_t> max_requests_per_second;
     bool decompress_request{true};
     bool throttling_enabled{true};
+    Criticality criticality{Criticality::kNormal};
+    std::optional<std::string> criticality_header;
     bool response_body_stream{false};
     std::optional<bool> set_response_server_hostname;
     bool set_tracing_headers{true};
@@ -3,6 +3,8 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <memory>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
@@ -12,7 +14,8 @@ namespace server::handlers {
 
 namespace impl {
 enum class StatsFormat;
-}
+class MetricsCache;
+}  // namespace impl
 
 // clang-format off
 
@@ -30,6 +33,24 @@ enum class StatsFormat;
 ///   utils::statistics::ToPrometheusFormatUntyped, utils::statistics::ToGraphiteFormat, utils::statistics::ToJsonFormat,
 ///   utils::statistics::ToSolomonFormat, utils::statistics::ToPrettyFormat.
 ///
+/// If 'metrics-cache-ttl' option is set, metrics are collected from
+/// utils::statistics::Storage at most once per TTL into a
+/// utils::statistics::MetricsSnapshot, and responses for identical requests
+/// are rendered once per snapshot. This makes the cost of metrics collection
+/// independent of the number of metrics scrapers. Only the responses for the
+/// first 16 distinct requests to a snapshot are kept.
+///
+/// If 'gzip-responses' option is true, responses are compressed for the
+/// clients that send `Accept-Encoding: gzip`.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// common-labels | map of label name to label value, items are added to each metric | {}
+/// format | default metrics format | -
+/// metrics-cache-ttl | reuse collected metrics for this long, 0 to collect on each request | 0
+/// gzip-responses | compress responses if the client supports gzip | false
+///
 /// ## Static configuration example:
 ///
 /// @snippet components/common_server_component_list_test.cpp  Sample handler server monitor component config
@@ -48,6 +69,7 @@ enum class StatsFormat;
 class ServerMonitor final : public HttpHandlerBase {
 public:
     ServerMonitor(const components::ComponentConfig& config, const components::ComponentContext& component_context);
+    ~ServerMonitor() override;
 
     /// @ingroup userver_component_names
     /// @brief The default name of server::handlers::ServerMonitor
@@ -69,6 +91,9 @@ private:
     using CommonLabels = std::unordered_map<std::string, std::string>;
     const CommonLabels common_labels_;
     const std::optional<impl::StatsFormat> default_format_;
+    const bool gzip_responses_;
+    // nullptr if caching is disabled
+    const std::unique_ptr<impl::MetricsCache> metrics_cache_;
 };
 
 }  // namespace server::handlers
@@ -0,0 +1,134 @@
+#pragma once
+
+/// @file userver/server/websocket/broadcast.hpp
+/// @brief @copybrief server::websocket::BroadcastGroup
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include <userver/server/websocket/server.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+/// @brief What to do with a subscriber that does not keep up with the
+/// broadcast rate
+enum class OverflowPolicy {
+    kDropOldest,  ///< drop the oldest pending message
+    kDropNewest,  ///< drop the message being broadcast
+    kDisconnect,  ///< close the connection with CloseStatus::kPolicyViolation
+};
+
+struct BroadcastConfig final {
+    /// Messages pending for a single subscriber
+    std::size_t max_pending_messages{1024};
+    OverflowPolicy overflow_policy{OverflowPolicy::kDropOldest};
+    /// Messages written with a single vectored write, at most IOV_MAX
+    std::size_t max_batch_size{64};
+    /// Compression of the messages broadcast by BroadcastText() and
+    /// BroadcastBinary(), see PreparedMessage
+    DeflateConfig deflate{};
+};
+
+struct BroadcastStatistics final {
+    using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+
+    utils::statistics::RateCounter messages;
+    utils::statistics::RateCounter sent;
+    utils::statistics::RateCounter dropped;
+    utils::statistics::RateCounter disconnected;
+    utils::statistics::RateCounter write_errors;
+    utils::statistics::RateCounter writes;
+    std::atomic<std::int64_t> subscribers{0};
+    /// Milliseconds from Broadcast() to the write of the message to a socket
+    utils::statistics::RecentPeriod<Percentile, Percentile, utils::datetime::SteadyClock> fanout_timings;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const BroadcastStatistics& stats);
+
+namespace impl {
+class BroadcastGroupImpl;
+struct BroadcastSubscriber;
+}  // namespace impl
+
+/// @brief Sends a message to many WebSocket connections, encoding it once.
+///
+/// Every subscribed connection gets a writer task that sends the pending
+/// messages in batches with a single vectored write per batch. Broadcast()
+/// never waits for the sockets, slow subscribers are handled according to
+/// BroadcastConfig::overflow_policy.
+///
+/// @code
+/// void Handle(WebSocketConnection& chat, server::request::RequestContext&) const override {
+///     auto subscription = group_.Subscribe(chat.shared_from_this());
+///     ...
+/// }
+/// @endcode
+class BroadcastGroup final {
+public:
+    /// @brief Keeps the connection subscribed to the group.
+    ///
+    /// Destruction cancels the pending writes and may interrupt a message in
+    /// the middle, so the subscription is expected to live until the
+    /// connection is closed.
+    class Subscription final {
+    public:
+        Subscription() noexcept;
+        Subscription(Subscription&&) noexcept;
+        Subscription& operator=(Subscription&&) noexcept;
+        ~Subscription();
+
+        /// Unsubscribes the connection from the group
+        void Unsubscribe() noexcept;
+
+        /// @returns false if the subscriber was dropped because of a write
+        /// error or for being too slow
+        bool IsActive() const noexcept;
+
+    private:
+        friend class BroadcastGroup;
+
+        Subscription(
+            std::shared_ptr<impl::BroadcastGroupImpl> group,
+            std::shared_ptr<impl::BroadcastSubscriber> subscriber
+        ) noexcept;
+
+        std::shared_ptr<impl::BroadcastGroupImpl> group_;
+        std::shared_ptr<impl::BroadcastSubscriber> subscriber_;
+    };
+
+    explicit BroadcastGroup(BroadcastConfig config = {});
+
+    BroadcastGroup(BroadcastGroup&&) = delete;
+    BroadcastGroup& operator=(BroadcastGroup&&) = delete;
+    ~BroadcastGroup();
+
+    /// Subscribes the connection, starting its writer task on the current
+    /// task processor
+    [[nodiscard]] Subscription Subscribe(std::shared_ptr<WebSocketConnection> connection);
+
+    /// Enqueues the message to all the subscribers
+    void Broadcast(const PreparedMessage& message);
+
+    void BroadcastText(std::string_view message);
+    void BroadcastBinary(std::string_view message);
+
+    std::size_t GetSubscribersCount() const;
+
+    const BroadcastStatistics& GetStatistics() const noexcept;
+
+private:
+    std::shared_ptr<impl::BroadcastGroupImpl> impl_;
+};
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
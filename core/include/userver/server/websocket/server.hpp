@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <optional>
+#include <string_view>
 
 #include <userver/engine/io/socket.hpp>
 #include <userver/server/http/http_request.hpp>
@@ -45,13 +46,63 @@ struct Message {
 
 class WebSocketConnectionImpl;
 
+/// @brief Settings of the permessage-deflate extension, RFC 7692
+struct DeflateConfig final {
+    bool enabled = false;
+    bool server_no_context_takeover = false;
+    bool client_no_context_takeover = false;
+    int server_max_window_bits = 15;
+    int client_max_window_bits = 15;
+    int compression_level = 6;
+    unsigned min_size = 64;  // smaller messages are sent uncompressed
+};
+
+/// @brief permessage-deflate parameters negotiated for a connection
+struct DeflateParams final {
+    bool server_no_context_takeover = false;
+    bool client_no_context_takeover = false;
+    int server_max_window_bits = 15;
+};
+
 struct Config final {
     unsigned max_remote_payload = 65536;
     unsigned fragment_size = 65536;  // 0 - do not fragment
+    DeflateConfig deflate{};
 };
 
+DeflateConfig Parse(const yaml_config::YamlConfig&, formats::parse::To<DeflateConfig>);
+
 Config Parse(const yaml_config::YamlConfig&, formats::parse::To<Config>);
 
+namespace impl {
+struct PreparedFrames;
+}  // namespace impl
+
+/// @brief A message encoded into WebSocket frames once, to be sent to many
+/// connections without per-connection serialization.
+///
+/// Copying is cheap, the frames are shared. The message is sent as a single
+/// frame regardless of the `fragment-size` of a connection.
+///
+/// If `deflate.enabled` is set, the message is also compressed without context
+/// takeover. Connections that negotiated `server_no_context_takeover` get the
+/// compressed frame, others get the uncompressed one.
+class PreparedMessage final {
+public:
+    PreparedMessage(std::string_view data, bool is_text, const DeflateConfig& deflate = {});
+
+    bool IsText() const noexcept;
+
+    /// @returns the uncompressed message
+    std::string_view GetPayload() const noexcept;
+
+    /// For internal use only
+    const impl::PreparedFrames& GetFrames() const noexcept;
+
+private:
+    std::shared_ptr<const impl::PreparedFrames> frames_;
+};
+
 struct Statistics final {
     std::atomic<int64_t> msg_sent{0};
     std::atomic<int64_t> msg_recv{0};
@@ -60,7 +111,11 @@ struct Statistics final {
 };
 
 /// @brief Main class for Websocket connection
-class WebSocketConnection {
+///
+/// Connections passed to WebsocketHandlerBase::Handle() are owned by
+/// std::shared_ptr, so shared_from_this() may be used to share them, for
+/// example with BroadcastGroup::Subscribe().
+class WebSocketConnection : public std::enable_shared_from_this<WebSocketConnection> {
 public:
     WebSocketConnection();
 
@@ -108,6 +163,11 @@ public:
         ));
     }
 
+    /// @brief Send the pre-encoded messages with a single vectored write.
+    /// @throws engine::io::IoException in case of socket errors
+    /// @note Has the same thread-safety as Send().
+    virtual void SendPrepared(utils::span<const PreparedMessage> messages);
+
     virtual void Close(CloseStatus status_code) = 0;
 
     virtual const engine::io::Sockaddr& RemoteAddr() const = 0;
@@ -119,8 +179,14 @@ protected:
     virtual void DoSendBinary(utils::span<const std::byte> message) = 0;
 };
 
-std::shared_ptr<WebSocketConnection>
-MakeWebSocket(std::unique_ptr<engine::io::RwBase>&& socket, engine::io::Sockaddr&& peer_name, const Config& config);
+/// @param deflate permessage-deflate parameters if the extension was
+/// negotiated in the handshake
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name,
+    const Config& config,
+    const std::optional<DeflateParams>& deflate = std::nullopt
+);
 
 }  // namespace server::websocket
 
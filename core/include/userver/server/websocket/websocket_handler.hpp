@@ -28,6 +28,13 @@ namespace server::websocket {
 /// status-codes-log-level | map of "status": log_level items to override span log level for specific status codes | {}
 /// max-remote-payload | max remote payload size | 65536
 /// fragment-size | max output fragment size | 65536
+/// permessage-deflate.enabled | compress the messages with the permessage-deflate extension (RFC 7692) if the client supports it | false
+/// permessage-deflate.server-no-context-takeover | compress each message from scratch, uses less memory and compresses worse | false
+/// permessage-deflate.client-no-context-takeover | ask the client to compress each message from scratch | false
+/// permessage-deflate.server-max-window-bits | base-2 logarithm of the compression window size, from 9 to 15 | 15
+/// permessage-deflate.client-max-window-bits | base-2 logarithm of the client compression window size if the client supports the limit, from 9 to 15 | 15
+/// permessage-deflate.compression-level | zlib compression level, from 0 to 9 | 6
+/// permessage-deflate.min-size | messages of smaller size are sent uncompressed | 64
 ///
 /// ## Example usage:
 ///
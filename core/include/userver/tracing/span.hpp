@@ -229,6 +229,8 @@ private:
 
         static OptionalDeleter DoNotDelete() noexcept;
 
+        bool IsOwning() const noexcept { return do_delete; }
+
     private:
         explicit OptionalDeleter(bool do_delete) : do_delete(do_delete) {}
 
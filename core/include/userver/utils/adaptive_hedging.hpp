@@ -0,0 +1,227 @@
+#pragma once
+
+/// @file userver/utils/adaptive_hedging.hpp
+/// @brief @copybrief utils::hedging::AdaptiveHedging
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include <userver/formats/json_fwd.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/hedged_request.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+class RetryBudget;
+
+namespace statistics {
+class Writer;
+}  // namespace statistics
+
+namespace hedging {
+
+struct AdaptiveHedgingSettings final {
+    /// Percentile of the recent latencies to make a hedged attempt at
+    double percentile{95.0};
+    /// Bounds of the hedging delay
+    std::chrono::milliseconds min_delay{1};
+    std::chrono::milliseconds max_delay{1000};
+    /// Delay to use until there are `min_samples` recent latencies
+    std::chrono::milliseconds default_delay{100};
+    std::size_t min_samples{100};
+    /// Extra attempts (hedges and retries) allowed per request
+    double max_extra_ratio{0.1};
+    /// Extra attempts that may be made at once after a quiet period
+    double max_extra_burst{10.0};
+    /// Destinations over the limit share the same latency statistics, reported
+    /// with the `hedging_destination=__overflow__` label
+    std::size_t max_destinations{100};
+};
+
+AdaptiveHedgingSettings Parse(const formats::json::Value& elem, formats::parse::To<AdaptiveHedgingSettings>);
+
+/// @ingroup userver_concurrency
+///
+/// @brief Hedging delays and budget derived from the live latencies of the
+/// destinations.
+///
+/// The delay of a destination is the AdaptiveHedgingSettings::percentile of
+/// its latencies over the last 30 seconds, recalculated once a second. So
+/// about `100 - percentile` percent of the requests are hedged whatever the
+/// downstream latency is.
+///
+/// Extra attempts are limited by the token bucket of the destination that
+/// gets AdaptiveHedgingSettings::max_extra_ratio tokens per request, and by
+/// the utils::RetryBudget, if any. A failing or overloaded destination thus
+/// does not get the amplified load.
+///
+/// Use AdaptiveStrategy to hedge requests of any client. Thread-safe.
+class AdaptiveHedging final {
+public:
+    /// @brief Latency statistics and the extra attempts budget of a
+    /// destination.
+    class Destination final {
+    public:
+        explicit Destination(const AdaptiveHedging& hedging);
+
+        /// Delay before the next hedged attempt
+        std::chrono::microseconds GetHedgingDelay() const;
+
+        /// Accounts the latency of an attempt
+        void AccountLatency(std::chrono::steady_clock::duration latency) noexcept;
+
+        /// Accounts a first attempt of a request, refills the budget
+        void AccountRequest() noexcept;
+
+        /// @returns whether an extra attempt fits the budgets, consumes the
+        /// budget if so
+        bool TryStartExtraAttempt() noexcept;
+
+    private:
+        friend void DumpMetric(statistics::Writer& writer, const Destination& destination);
+
+        // latencies in 100us, precise up to 100ms, with 10ms steps up to 10s
+        using Percentile = statistics::Percentile<1000, std::uint32_t, 1000, 100>;
+
+        std::chrono::microseconds CalculateDelay() const;
+
+        const AdaptiveHedging& hedging_;
+        statistics::RecentPeriod<Percentile, Percentile, datetime::SteadyClock> latencies_;
+        mutable std::atomic<std::int64_t> delay_us_;
+        mutable std::atomic<std::int64_t> delay_updated_at_us_{0};
+        std::atomic<std::int32_t> tokens_;
+
+        statistics::RateCounter requests_;
+        statistics::RateCounter extra_attempts_;
+        statistics::RateCounter denied_attempts_;
+    };
+
+    /// @param retry_budget may be nullptr, must outlive the AdaptiveHedging
+    /// otherwise
+    explicit AdaptiveHedging(AdaptiveHedgingSettings settings = {}, RetryBudget* retry_budget = nullptr);
+
+    AdaptiveHedging(AdaptiveHedging&&) = delete;
+    AdaptiveHedging& operator=(AdaptiveHedging&&) = delete;
+
+    /// @brief Returns the statistics of the destination, e.g. a host or an
+    /// RPC method name. Keep the pointer for the subsequent requests.
+    std::shared_ptr<Destination> GetDestination(const std::string& name);
+
+    const AdaptiveHedgingSettings& GetSettings() const noexcept { return settings_; }
+
+private:
+    friend void DumpMetric(statistics::Writer& writer, const AdaptiveHedging& hedging);
+
+    const AdaptiveHedgingSettings settings_;
+    RetryBudget* retry_budget_;
+    rcu::RcuMap<std::string, Destination> destinations_;
+    std::shared_ptr<Destination> overflow_destination_;
+};
+
+void DumpMetric(statistics::Writer& writer, const AdaptiveHedging::Destination& destination);
+
+void DumpMetric(statistics::Writer& writer, const AdaptiveHedging& hedging);
+
+/// @brief Wraps a RequestStrategy of utils::hedging::HedgeRequest() to make
+/// hedged attempts after the adaptive delay of the destination.
+///
+/// The extra attempts, both hedged and retried, are made only if the budgets
+/// of the AdaptiveHedging allow, HedgingSettings::hedging_delay is ignored.
+///
+/// HTTP, with clients::http::LoadBalancedStrategy:
+/// @code
+/// auto response = utils::hedging::HedgeRequest(
+///     utils::hedging::AdaptiveStrategy{
+///         clients::http::LoadBalancedStrategy{balancer, make_request, &retry_budget},
+///         profiles_destination},
+///     hedging_settings
+/// );
+/// @endcode
+///
+/// Redis, see redis::MakeAdaptiveHedgedRedisRequest(). gRPC, with a
+/// strategy that creates the RPC futures:
+/// @code
+/// auto destination = adaptive_hedging.GetDestination("/profiles.Profiles/Get");
+/// ...
+/// auto reply = utils::hedging::HedgeRequest(
+///     utils::hedging::AdaptiveStrategy{GetProfileStrategy{client, request}, destination},
+///     hedging_settings
+/// );
+/// @endcode
+template <typename RequestStrategy>
+class AdaptiveStrategy final {
+public:
+    using InnerRequestType = typename RequestTraits<RequestStrategy>::RequestType;
+    using ReplyType = typename RequestTraits<RequestStrategy>::ReplyType;
+
+    struct Attempt final {
+        InnerRequestType request;
+        std::chrono::steady_clock::time_point started_at;
+        bool accounted{false};
+
+        engine::impl::ContextAccessor* TryGetContextAccessor() { return request.TryGetContextAccessor(); }
+    };
+
+    AdaptiveStrategy(RequestStrategy strategy, std::shared_ptr<AdaptiveHedging::Destination> destination)
+        : strategy_(std::move(strategy)), destination_(std::move(destination)) {
+        UASSERT(destination_);
+    }
+
+    std::optional<Attempt> Create(std::size_t attempt) {
+        if (attempt == 0) {
+            destination_->AccountRequest();
+        } else if (!destination_->TryStartExtraAttempt()) {
+            return std::nullopt;
+        }
+
+        auto request = strategy_.Create(attempt);
+        if (!request) return std::nullopt;
+        return Attempt{std::move(*request), std::chrono::steady_clock::now(), false};
+    }
+
+    std::optional<std::chrono::milliseconds> ProcessReply(Attempt&& attempt) {
+        Account(attempt);
+        return strategy_.ProcessReply(std::move(attempt.request));
+    }
+
+    std::optional<ReplyType> ExtractReply() { return strategy_.ExtractReply(); }
+
+    void Finish(Attempt&& attempt) {
+        // The abandoned attempt would have taken at least that long, skipping
+        // it would make the percentile too optimistic
+        Account(attempt);
+        strategy_.Finish(std::move(attempt.request));
+    }
+
+    std::chrono::microseconds GetHedgingDelay() const { return destination_->GetHedgingDelay(); }
+
+private:
+    // Finish() is called for the already processed attempts as well
+    void Account(Attempt& attempt) noexcept {
+        if (attempt.accounted) return;
+        attempt.accounted = true;
+        destination_->AccountLatency(std::chrono::steady_clock::now() - attempt.started_at);
+    }
+
+    RequestStrategy strategy_;
+    std::shared_ptr<AdaptiveHedging::Destination> destination_;
+};
+
+}  // namespace hedging
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -40,6 +40,11 @@
 ///     /// for a cancellation in destructor, rather than call TryCancel() and
 ///     /// immediately wait.
 ///     void Finish(RequestType&&);
+///
+///     /// Optional. If present, the delay before the next hedged attempt is
+///     /// taken from here instead of HedgingSettings::hedging_delay, see
+///     /// utils::hedging::AdaptiveStrategy.
+///     std::chrono::microseconds GetHedgingDelay();
 /// };
 ///
 /// Then call any of these functions:
@@ -55,12 +60,14 @@
 #include <queue>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/wait_any.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/datetime.hpp>
+#include <userver/utils/meta_light.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -91,6 +98,9 @@ using TimePoint = Clock::time_point;
 
 enum class Action { StartTry, Stop };
 
+template <typename RequestStrategy>
+using HasHedgingDelay = decltype(std::declval<RequestStrategy&>().GetHedgingDelay());
+
 struct PlanEntry {
 public:
     PlanEntry(TimePoint timepoint, std::size_t request_index, std::size_t attempt_id, Action action)
@@ -248,7 +258,7 @@ struct Context {
         request_state.subrequest_indices.push_back(idx);
         input_by_subrequests_[idx] = request_index;
         attempts_made++;
-        plan_.emplace(now + settings.hedging_delay, request_index, attempts_made, Action::StartTry);
+        plan_.emplace(now + GetHedgingDelay(strategy), request_index, attempts_made, Action::StartTry);
     }
 
     /// Called on getting error in request with @param request_idx
@@ -264,6 +274,14 @@ struct Context {
     /// @}
 
 private:
+    Clock::duration GetHedgingDelay(RequestStrategy& strategy) const {
+        if constexpr (meta::kIsDetected<HasHedgingDelay, RequestStrategy>) {
+            return std::chrono::duration_cast<Clock::duration>(strategy.GetHedgingDelay());
+        } else {
+            return settings.hedging_delay;
+        }
+    }
+
     /// user provided request strategies bulk
     std::vector<RequestStrategy> inputs_;
     HedgingSettings settings;
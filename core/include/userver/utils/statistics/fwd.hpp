@@ -21,6 +21,7 @@ class Request;
 // NOLINTNEXTLINE(bugprone-forward-declaration-namespace)
 class Entry;
 class Writer;
+class MetricsSnapshot;
 
 class MetricsStorage;
 using MetricsStoragePtr = std::shared_ptr<MetricsStorage>;
@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include <userver/utils/statistics/fwd.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -17,6 +18,12 @@ std::string ToGraphiteFormat(
     const utils::statistics::Request& statistics_request = {}
 );
 
+/// @overload
+std::string ToGraphiteFormat(
+    const utils::statistics::MetricsSnapshot& statistics,
+    const utils::statistics::Request& statistics_request = {}
+);
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
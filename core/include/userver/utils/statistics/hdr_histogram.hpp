@@ -0,0 +1,150 @@
+#pragma once
+
+/// @file userver/utils/statistics/hdr_histogram.hpp
+/// @brief @copybrief utils::statistics::HdrHistogram
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/histogram_aggregator.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief Settings of utils::statistics::HdrHistogram.
+struct HdrHistogramSettings final {
+    /// Values are tracked in multiples of `unit`. Values below `unit` fall into
+    /// the lowest bucket.
+    double unit{1.0};
+
+    /// The largest value that is tracked with the requested precision. Greater
+    /// values are saturated into the last bucket.
+    double max_value{60'000'000.0};
+
+    /// Each power-of-two range of values is split into `2^significant_bits / 2`
+    /// linear sub-buckets, giving a relative error of at most
+    /// `2^(1 - significant_bits)`. Must be in [1, 16].
+    int significant_bits{5};
+
+    /// Bucket bounds used when the histogram is written to
+    /// utils::statistics::Writer. If empty, powers of 2 (multiplied by `unit`)
+    /// up to `max_value` are used.
+    std::vector<double> export_bounds{};
+};
+
+class HdrHistogram;
+
+/// @brief A non-atomic copy of utils::statistics::HdrHistogram contents.
+///
+/// Snapshots of histograms with the same settings, e.g. taken on different
+/// threads or received from different hosts, can be merged using Add.
+class HdrHistogramSnapshot final {
+public:
+    /// Returns the number of buckets.
+    std::size_t GetBucketCount() const noexcept { return counts_.size(); }
+
+    /// Returns the exclusive upper bound of the bucket, in user units.
+    double GetUpperBoundAt(std::size_t index) const;
+
+    /// Returns the occurrence count for the given bucket.
+    std::uint64_t GetValueAt(std::size_t index) const { return counts_.at(index); }
+
+    /// Returns the sum of counts from all buckets.
+    std::uint64_t GetTotalCount() const noexcept;
+
+    /// @brief Returns the value at the given percent (0-100). The result is
+    /// the upper bound of the bucket, so it overestimates the real value by no
+    /// more than the relative error of the histogram.
+    /// Returns 0 if the histogram is empty.
+    double GetPercentile(double percent) const;
+
+    /// @brief Adds the other snapshot to the current one.
+    /// @throws std::invalid_argument if snapshots have different layouts.
+    void Add(const HdrHistogramSnapshot& other);
+
+    /// Collapses the snapshot into a histogram with the given bounds.
+    HistogramAggregator ToHistogram(utils::span<const double> upper_bounds) const;
+
+private:
+    friend class HdrHistogram;
+
+    HdrHistogramSnapshot(double unit, int significant_bits, std::size_t bucket_count);
+
+    double unit_;
+    int significant_bits_;
+    std::vector<std::uint64_t> counts_;
+};
+
+/// @brief A lock-free log-linear histogram with a bounded relative error,
+/// inspired by HdrHistogram.
+///
+/// Unlike utils::statistics::Histogram, bucket bounds are not set up front:
+/// the range of [unit, max_value] is covered with buckets of exponentially
+/// growing width, so that e.g. latencies from 10us to 60s are measured with a
+/// ~6% precision using just a few hundred counters.
+///
+/// Counters are split into per-thread stripes, so Account is a single relaxed
+/// `fetch_add` on a mostly uncontended cache line. Reads sum up all stripes and
+/// are relatively slow.
+///
+/// When written to utils::statistics::Writer, the histogram is collapsed into
+/// a regular utils::statistics::HistogramView with
+/// HdrHistogramSettings::export_bounds, which keeps it summable across hosts
+/// in Prometheus, Solomon and JSON.
+///
+/// Usage example:
+/// @snippet utils/statistics/hdr_histogram_test.cpp  sample
+class HdrHistogram final {
+public:
+    explicit HdrHistogram(HdrHistogramSettings settings = {});
+
+    HdrHistogram(HdrHistogram&&) = delete;
+    HdrHistogram& operator=(HdrHistogram&&) = delete;
+    ~HdrHistogram();
+
+    /// Atomically increment the bucket corresponding to the given value.
+    void Account(double value, std::uint64_t count = 1) noexcept;
+
+    /// Atomically add the contents of another histogram with the same settings.
+    /// @throws std::invalid_argument if histograms have different layouts.
+    void Add(const HdrHistogramSnapshot& other);
+
+    /// Atomically reset all counters to zero.
+    friend void ResetMetric(HdrHistogram& histogram) noexcept;
+
+    /// Sums up all the stripes into a snapshot.
+    HdrHistogramSnapshot GetSnapshot() const;
+
+    /// Returns the bounds used by DumpMetric.
+    const std::vector<double>& GetExportBounds() const noexcept { return export_bounds_; }
+
+    /// Returns the number of buckets in a single stripe.
+    std::size_t GetBucketCount() const noexcept { return bucket_count_; }
+
+private:
+    std::size_t BucketIndex(double value) const noexcept;
+    std::atomic<std::uint64_t>* Stripe(std::size_t stripe_index) const noexcept;
+
+    const double unit_;
+    const int significant_bits_;
+    // Values greater than this (in multiples of 'unit_') are saturated.
+    const std::uint64_t max_scaled_;
+    const std::size_t bucket_count_;
+    // Number of counters in a stripe, including the padding.
+    const std::size_t stripe_stride_;
+    const std::size_t stripe_count_;
+    std::vector<double> export_bounds_;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> counters_;
+};
+
+/// Metric serialization support for HdrHistogram.
+void DumpMetric(Writer& writer, const HdrHistogram& histogram);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,69 @@
+#pragma once
+
+/// @file userver/utils/statistics/metrics_snapshot.hpp
+/// @brief @copybrief utils::statistics::MetricsSnapshot
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/labels.hpp>
+#include <userver/utils/statistics/metric_value.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// @brief An immutable copy of all the metrics of utils::statistics::Storage.
+///
+/// Walking all the registered writers could be expensive for services with
+/// lots of metrics. MetricsSnapshot allows collecting the metrics once and then
+/// serving multiple requests in different formats from the copy, e.g.:
+/// @code
+/// const utils::statistics::MetricsSnapshot snapshot{storage};
+/// auto prometheus = utils::statistics::ToPrometheusFormat(snapshot, request);
+/// auto json = utils::statistics::ToJsonFormat(snapshot, request);
+/// @endcode
+///
+/// Each call to VisitMetrics behaves exactly like Storage::VisitMetrics at the
+/// moment of snapshot creation.
+class MetricsSnapshot final {
+public:
+    /// Collects all the metrics from the `storage`.
+    explicit MetricsSnapshot(const Storage& storage);
+
+    MetricsSnapshot(MetricsSnapshot&&) = delete;
+    MetricsSnapshot& operator=(MetricsSnapshot&&) = delete;
+
+    /// Visits the metrics matching the `request` and calls `out.HandleMetric`
+    /// for each metric.
+    void VisitMetrics(BaseFormatBuilder& out, const Request& request = {}) const;
+
+    /// Returns the number of collected metrics.
+    std::size_t GetMetricsCount() const noexcept { return metrics_.size(); }
+
+    /// Returns the time point of the snapshot creation.
+    std::chrono::steady_clock::time_point GetCreationTime() const noexcept { return creation_time_; }
+
+private:
+    struct Metric final {
+        std::string path;
+        std::vector<Label> labels;
+        MetricValue value;
+    };
+
+    class Collector;
+
+    std::vector<Metric> metrics_;
+    // std::deque never relocates the elements, so the histogram views in
+    // metrics_ stay valid.
+    std::deque<Histogram> histograms_;
+    std::chrono::steady_clock::time_point creation_time_;
+};
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
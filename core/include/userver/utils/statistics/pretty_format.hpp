@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include <userver/utils/statistics/fwd.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -24,6 +25,12 @@ namespace utils::statistics {
 std::string
 ToPrettyFormat(const utils::statistics::Storage& statistics, const utils::statistics::Request& statistics_request = {});
 
+/// @overload
+std::string ToPrettyFormat(
+    const utils::statistics::MetricsSnapshot& statistics,
+    const utils::statistics::Request& statistics_request = {}
+);
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include <userver/utils/statistics/fwd.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,10 +31,20 @@ std::string ToPrometheusLabel(std::string_view name);
 std::string
 ToPrometheusFormat(const utils::statistics::Storage& statistics, const utils::statistics::Request& request = {});
 
+/// @overload
+std::string
+ToPrometheusFormat(const utils::statistics::MetricsSnapshot& statistics, const utils::statistics::Request& request = {});
+
 /// Output `statistics` in Prometheus format, without metric types.
 std::string
 ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics, const utils::statistics::Request& request = {});
 
+/// @overload
+std::string ToPrometheusFormatUntyped(
+    const utils::statistics::MetricsSnapshot& statistics,
+    const utils::statistics::Request& request = {}
+);
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
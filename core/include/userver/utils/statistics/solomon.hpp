@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include <userver/utils/statistics/fwd.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -62,6 +63,13 @@ std::string ToSolomonFormat(
     const utils::statistics::Request& statistics_request = {}
 );
 
+/// @overload
+std::string ToSolomonFormat(
+    const utils::statistics::MetricsSnapshot& statistics,
+    const std::unordered_map<std::string, std::string>& common_labels,
+    const utils::statistics::Request& statistics_request = {}
+);
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
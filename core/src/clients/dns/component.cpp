@@ -12,6 +12,7 @@ namespace clients::dns {
 namespace {
 
 constexpr std::string_view kDnsReplySource = "dns_reply_source";
+constexpr std::string_view kDnsUpdateReason = "dns_update_reason";
 
 ResolverConfig ParseResolverConfig(const components::ComponentConfig& component_config) {
     ResolverConfig config;
@@ -28,6 +29,8 @@ ResolverConfig ParseResolverConfig(const components::ComponentConfig& component_
         component_config["cache_max_reply_ttl"].As<std::chrono::milliseconds>(config.cache_max_reply_ttl);
     config.cache_failure_ttl =
         component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(config.cache_failure_ttl);
+    config.cache_max_stale = component_config["cache-max-stale"].As<std::chrono::milliseconds>(config.cache_max_stale);
+    config.cache_prefetch_hits = component_config["cache-prefetch-hits"].As<size_t>(config.cache_prefetch_hits);
     return config;
 }
 
@@ -38,6 +41,8 @@ Component::Component(const components::ComponentConfig& config, const components
       resolver_{context.GetTaskProcessor(config["fs-task-processor"].As<std::string>()), ParseResolverConfig(config)} {
     auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
     statistics_holder_ = storage.RegisterWriter(config.Name() + ".replies", [this](auto& writer) { Write(writer); });
+    update_statistics_holder_ =
+        storage.RegisterWriter(config.Name() + ".updates", [this](auto& writer) { WriteUpdates(writer); });
 }
 
 clients::dns::Resolver& Component::GetResolver() { return resolver_; }
@@ -52,6 +57,12 @@ void Component::Write(utils::statistics::Writer& writer) {
     writer.ValueWithLabels(counters.network_failure, {kDnsReplySource, "network-failure"});
 }
 
+void Component::WriteUpdates(utils::statistics::Writer& writer) {
+    const auto& counters = GetResolver().GetUpdateCounters();
+    writer.ValueWithLabels(counters.expiring, {kDnsUpdateReason, "expiring"});
+    writer.ValueWithLabels(counters.prefetch, {kDnsUpdateReason, "prefetch"});
+}
+
 yaml_config::Schema Component::GetStaticConfigSchema() {
     return yaml_config::MergeSchemas<ComponentBase>(R"(
 type: object
@@ -100,6 +111,17 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    cache-max-stale:
+        type: string
+        description: how long an expired network reply is served while being updated in background
+        defaultDescription: 24h
+    cache-prefetch-hits:
+        type: integer
+        description: |
+            hits of a network reply within its TTL that make it updated in
+            background before the expiration, 0 disables the prefetch
+        defaultDescription: 10
+        minimum: 0
 )");
 }
 
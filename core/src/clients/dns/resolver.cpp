@@ -115,6 +115,9 @@ const AddrVector& LocalhostAddrs() {
 
 enum class FailureMode { kIgnore, kCache };
 
+// Popular records are updated when this part of their TTL is left, as in Unbound
+constexpr int kPrefetchTtlDivisor = 10;
+
 class Resolver::Impl {
 public:
     struct NetCacheResult {
@@ -122,6 +125,7 @@ public:
             kMiss,
             kHitReply,
             kHitReplyWithUpdate,
+            kHitReplyWithPrefetch,
             kHitFailure,
         };
 
@@ -133,6 +137,7 @@ public:
     ~Impl();
 
     const LookupSourceCounters& GetLookupSourceCounters() const;
+    const UpdateCounters& GetUpdateCounters() const;
 
     void ReloadHosts();
     void FlushNetworkCache();
@@ -149,13 +154,21 @@ public:
     DoForegroundQuery(std::unique_lock<Mutex>& lock, Mutex&& mutex, const std::string& name, engine::Deadline deadline);
 
     template <typename Mutex>
-    void StartBackgroundQuery(std::unique_lock<Mutex>& lock, Mutex&& mutex, const std::string& name);
+    void StartBackgroundQuery(
+        std::unique_lock<Mutex>& lock,
+        Mutex&& mutex,
+        const std::string& name,
+        NetCacheResult::Status reason
+    );
 
 private:
     struct NetCacheEntry {
         AddrVector addrs;
         std::chrono::steady_clock::time_point expiration;
+        std::chrono::steady_clock::time_point updated_at;
         bool is_failure{false};
+        // hits since the last update, modified under the cache way lock
+        size_t hits{0};
     };
 
     template <typename Mutex>
@@ -177,11 +190,14 @@ private:
     );
 
     LookupSourceCounters source_counters_;
+    UpdateCounters update_counters_;
     FileResolver file_resolver_;
     NetResolver net_resolver_;
     const std::chrono::milliseconds net_cache_update_margin_;
     const std::chrono::milliseconds net_cache_max_reply_ttl_;
     const std::chrono::milliseconds net_cache_failure_ttl_;
+    const std::chrono::milliseconds net_cache_max_stale_;
+    const size_t net_cache_prefetch_hits_;
     cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
     concurrent::MutexSet<std::string> net_cache_update_mutexes_;
     utils::impl::WaitTokenStorage wait_token_storage_;
@@ -193,6 +209,8 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor, const ResolverCon
       net_cache_update_margin_{config.network_timeout},
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
+      net_cache_max_stale_{config.cache_max_stale},
+      net_cache_prefetch_hits_{config.cache_prefetch_hits},
       net_cache_{config.cache_ways, config.cache_size_per_way},
       net_cache_update_mutexes_(config.cache_ways) {}
 
@@ -200,6 +218,8 @@ Resolver::Impl::~Impl() { wait_token_storage_.WaitForAllTokens(); }
 
 const Resolver::LookupSourceCounters& Resolver::Impl::GetLookupSourceCounters() const { return source_counters_; }
 
+const Resolver::UpdateCounters& Resolver::Impl::GetUpdateCounters() const { return update_counters_; }
+
 void Resolver::Impl::ReloadHosts() { file_resolver_.ReloadHosts(); }
 
 void Resolver::Impl::FlushNetworkCache() { net_cache_.Invalidate(); }
@@ -218,7 +238,12 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(const std::string&
     NetCacheResult result;
 
     const auto now = utils::datetime::MockSteadyNow();
-    const auto cached = net_cache_.Get(name);
+    const auto cached = net_cache_.Get(name, [this, now](NetCacheEntry& entry) {
+        // too old to be served even while updating
+        if (!entry.is_failure && entry.expiration + net_cache_max_stale_ < now) return false;
+        ++entry.hits;
+        return true;
+    });
     if (!cached) return result;
 
     if (cached->is_failure) {
@@ -236,10 +261,14 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(const std::string&
         ++source_counters_.cached_stale;
     }
 
-    if (cached->expiration - now >= net_cache_update_margin_) {
-        result.status = NetCacheResult::Status::kHitReply;
-    } else {
+    const auto time_left = cached->expiration - now;
+    if (time_left < net_cache_update_margin_) {
         result.status = NetCacheResult::Status::kHitReplyWithUpdate;
+    } else if (net_cache_prefetch_hits_ && cached->hits >= net_cache_prefetch_hits_ &&
+               time_left * kPrefetchTtlDivisor <= cached->expiration - cached->updated_at) {
+        result.status = NetCacheResult::Status::kHitReplyWithPrefetch;
+    } else {
+        result.status = NetCacheResult::Status::kHitReply;
     }
 
     return result;
@@ -277,13 +306,23 @@ AddrVector Resolver::Impl::DoForegroundQuery(
 }
 
 template <typename Mutex>
-void Resolver::Impl::StartBackgroundQuery(std::unique_lock<Mutex>& lock, Mutex&& mutex, const std::string& name) {
+void Resolver::Impl::StartBackgroundQuery(
+    std::unique_lock<Mutex>& lock,
+    Mutex&& mutex,
+    const std::string& name,
+    NetCacheResult::Status reason
+) {
     UASSERT(lock.mutex() == &mutex);
     if (!lock && !lock.try_lock()) {
         LOG_TRACE() << "Record for '" << name << "' is already updating, skipping";
         return;
     }
     LOG_TRACE() << "Updating record for '" << name << "' in background";
+    if (reason == NetCacheResult::Status::kHitReplyWithPrefetch) {
+        ++update_counters_.prefetch;
+    } else {
+        ++update_counters_.expiring;
+    }
     auto future = net_resolver_.Resolve(name);
     MoveQueryToBackground(lock, std::forward<Mutex>(mutex), std::move(future), name, FailureMode::kIgnore);
 }
@@ -331,7 +370,8 @@ void Resolver::Impl::FinishNetUpdate(
         LOG_LIMITED_ERROR() << "Resolving of '" << name << "' failed: " << ex;
         if (failure_mode == FailureMode::kCache) {
             LOG_TRACE() << "Caching failure for '" << name << '\'';
-            net_cache_.Put(name, NetCacheEntry{{}, utils::datetime::MockSteadyNow() + net_cache_failure_ttl_, true});
+            const auto now = utils::datetime::MockSteadyNow();
+            net_cache_.Put(name, NetCacheEntry{{}, now + net_cache_failure_ttl_, now, true});
         }
         ++source_counters_.network_failure;
         throw;
@@ -342,9 +382,8 @@ void Resolver::Impl::FinishNetUpdate(
     if (addrs) *addrs = response.addrs;
     if (effective_ttl.count() > 0) {
         LOG_TRACE() << "Updating cache for '" << name << '\'';
-        net_cache_.Put(
-            name, NetCacheEntry{std::move(response.addrs), utils::datetime::MockSteadyNow() + effective_ttl}
-        );
+        const auto now = utils::datetime::MockSteadyNow();
+        net_cache_.Put(name, NetCacheEntry{std::move(response.addrs), now + effective_ttl, now});
     } else {
         LOG_TRACE() << "Skipping cache update for '" << name << '\'';
     }
@@ -405,7 +444,8 @@ AddrVector Resolver::Resolve(const std::string& name, engine::Deadline deadline)
             return impl_->DoForegroundQuery(lock, std::move(mutex), name, deadline);
 
         case Impl::NetCacheResult::Status::kHitReplyWithUpdate:
-            impl_->StartBackgroundQuery(lock, std::move(mutex), name);
+        case Impl::NetCacheResult::Status::kHitReplyWithPrefetch:
+            impl_->StartBackgroundQuery(lock, std::move(mutex), name, net_result.status);
             [[fallthrough]];
         case Impl::NetCacheResult::Status::kHitReply:
             return std::move(net_result.addrs);
@@ -421,6 +461,8 @@ const Resolver::LookupSourceCounters& Resolver::GetLookupSourceCounters() const
     return impl_->GetLookupSourceCounters();
 }
 
+const Resolver::UpdateCounters& Resolver::GetUpdateCounters() const { return impl_->GetUpdateCounters(); }
+
 void Resolver::ReloadHosts() { impl_->ReloadHosts(); }
 
 void Resolver::FlushNetworkCache() { impl_->FlushNetworkCache(); }
@@ -1,3 +1,4 @@
+#include <functional>
 #include <string_view>
 #include <vector>
 
@@ -59,7 +60,11 @@ constexpr auto kNetV6String{"2a02:6b8:a::a"};
 struct MockedResolver {
     using ServerMock = utest::DnsServerMock;
 
-    MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way)
+    MockedResolver(
+        size_t cache_max_ttl,
+        size_t cache_size_per_way,
+        const std::function<void(clients::dns::ResolverConfig&)>& adjust_config = {}
+    )
         : hosts_file{[] {
               auto file = fs::blocking::TempFile::Create();
               fs::blocking::RewriteFileContents(file.GetPath(), kTestHosts);
@@ -86,6 +91,7 @@ struct MockedResolver {
                        config.cache_failure_ttl = std::chrono::seconds{cache_max_ttl}, config.cache_ways = 1;
                        config.cache_size_per_way = cache_size_per_way;
                        config.network_custom_servers = {server_mock.GetServerAddress()};
+                       if (adjust_config) adjust_config(config);
                        return config;
                    }()} {}
 
@@ -450,4 +456,63 @@ UTEST(Resolver, FirstUpdateCombines) {
     EXPECT_EQ(counters.network_failure, 1);
 }
 
+UTEST(Resolver, CachePrefetch) {
+    const auto test_deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    MockedResolver resolver{1000, 1, [](auto& config) { config.cache_prefetch_hits = 10; }};
+
+    utils::datetime::MockNowSet({});
+
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+
+    // less than 10% of TTL is left, but the record is not popular yet
+    utils::datetime::MockSleep(std::chrono::seconds{950});
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_PRED_FORMAT2(
+            CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String})
+        );
+    }
+    const auto& counters = resolver->GetLookupSourceCounters();
+    const auto& update_counters = resolver->GetUpdateCounters();
+    EXPECT_EQ(update_counters.prefetch, 0);
+
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+    while (counters.network < 2) engine::Yield();
+
+    // the updated record is fresh again
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+
+    EXPECT_EQ(counters.cached, 11);
+    EXPECT_EQ(counters.cached_stale, 0);
+    EXPECT_EQ(counters.network, 2);
+    EXPECT_EQ(update_counters.prefetch, 1);
+    EXPECT_EQ(update_counters.expiring, 0);
+}
+
+UTEST(Resolver, CacheMaxStale) {
+    const auto test_deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    MockedResolver resolver{1, 1, [](auto& config) { config.cache_max_stale = std::chrono::seconds{5}; }};
+
+    utils::datetime::MockNowSet({});
+
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+
+    utils::datetime::MockSleep(std::chrono::seconds{3});
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+    const auto& counters = resolver->GetLookupSourceCounters();
+    while (counters.network < 2) engine::Yield();
+
+    // too stale to be served, resolved in foreground
+    utils::datetime::MockSleep(std::chrono::seconds{10});
+    EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline), (Expected{kNetV6String, kNetV4String}));
+
+    EXPECT_EQ(counters.cached, 0);
+    EXPECT_EQ(counters.cached_stale, 1);
+    EXPECT_EQ(counters.network, 3);
+    EXPECT_EQ(counters.network_failure, 0);
+    EXPECT_EQ(resolver->GetUpdateCounters().expiring, 1);
+    EXPECT_EQ(resolver->GetUpdateCounters().prefetch, 0);
+}
+
 USERVER_NAMESPACE_END
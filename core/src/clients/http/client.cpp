@@ -15,6 +15,7 @@
 
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
+#include <clients/http/http2_pools.hpp>
 #include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
 #include <curl-ev/multi.hpp>
@@ -69,10 +70,12 @@ Client::Client(
     // libcurl synchronously reads some of /etc/* files.
     // As we want httpclient to be non-blocking, we have to shift curl's init code
     // to a fs task processor.
-    engine::AsyncNoSpan(fs_task_processor_, [this, io_threads] {
+    engine::AsyncNoSpan(fs_task_processor_, [this, io_threads, &settings] {
         for (std::size_t i = 0; i < io_threads; ++i) {
             multis_.push_back(std::make_unique<curl::multi>(thread_pool_->NextThread(), connect_rate_limiter_));
         }
+        http2_pools_ =
+            std::make_unique<impl::Http2Pools>(settings.http2_pools, *thread_pool_, connect_rate_limiter_);
     }).Get();
 
     easy_reinit_task_.Start("http_easy_reinit", utils::PeriodicTask::Settings(kEasyReinitPeriod), [this] {
@@ -102,6 +105,7 @@ Client::~Client() {
     while (TryDequeueIdle())
         ;
 
+    http2_pools_.reset();
     multis_.clear();
     thread_pool_.reset();
 }
@@ -221,9 +225,15 @@ void Client::SetDestinationMetricsAutoMaxSize(size_t max_size) { destination_sta
 
 const DestinationStatistics& Client::GetDestinationStatistics() const { return *destination_statistics_; }
 
+const impl::Http2Pools& Client::GetHttp2Pools() const { return *http2_pools_; }
+
 void Client::PushIdleEasy(std::shared_ptr<curl::easy>&& easy) noexcept {
     try {
         easy->reset();
+        // idle handles are bound to the regular multis, statistics_ are indexed by them
+        if (http2_pools_->Contains(easy->GetMulti())) {
+            easy->RebindMulti(*multis_[utils::RandRange(multis_.size())]);
+        }
         idle_queue_->enqueue(std::move(easy));
     } catch (const std::exception& e) {
         LOG_ERROR() << e;
@@ -232,6 +242,8 @@ void Client::PushIdleEasy(std::shared_ptr<curl::easy>&& easy) noexcept {
     DecPending();
 }
 
+impl::Http2Pool* Client::FindHttp2Pool(std::string_view url) noexcept { return http2_pools_->Find(url); }
+
 std::shared_ptr<curl::easy> Client::TryDequeueIdle() noexcept {
     std::shared_ptr<curl::easy> result;
     if (!idle_queue_->try_dequeue(result)) {
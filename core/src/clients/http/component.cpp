@@ -10,6 +10,7 @@
 #include <userver/testsuite/testsuite_support.hpp>
 
 #include <clients/http/destination_statistics.hpp>
+#include <clients/http/http2_pools.hpp>
 #include <clients/http/statistics.hpp>
 #include <clients/http/testsuite.hpp>
 #include <userver/clients/http/client.hpp>
@@ -156,6 +157,7 @@ void HttpClient::WriteStatistics(utils::statistics::Writer& writer) {
         DumpMetric(writer, http_client_.GetPoolStatistics());
     }
     DumpMetric(writer, http_client_.GetDestinationStatistics());
+    writer["http2-pools"] = http_client_.GetHttp2Pools();
 }
 
 yaml_config::Schema HttpClient::GetStaticConfigSchema() {
@@ -231,6 +233,28 @@ properties:
         enum:
           - cancel
           - ignore
+    http2-pools:
+        type: object
+        description: dedicated HTTP/2 connection pools, the keys are destination origins `scheme://host[:port]`
+        defaultDescription: '{}'
+        properties: {}
+        additionalProperties:
+            type: object
+            description: HTTP/2 connection pool of the destination
+            additionalProperties: false
+            properties:
+                max-connections:
+                    type: integer
+                    description: max connections to the destination
+                    defaultDescription: 4
+                max-concurrent-streams:
+                    type: integer
+                    description: max streams multiplexed over a single connection
+                    defaultDescription: 100
+                prior-knowledge:
+                    type: boolean
+                    description: use HTTP/2 without the Upgrade for `http://` URLs (h2c prior knowledge)
+                    defaultDescription: false
 )");
 }
 
@@ -1,5 +1,6 @@
 #include <userver/clients/http/config.hpp>
 
+#include <stdexcept>
 #include <string_view>
 
 #include <userver/dynamic_config/value.hpp>
@@ -47,11 +48,23 @@ CancellationPolicy Parse(yaml_config::YamlConfig value, formats::parse::To<Cance
     throw std::runtime_error("Invalid CancellationPolicy value: " + str);
 }
 
+Http2PoolPolicy Parse(const yaml_config::YamlConfig& value, formats::parse::To<Http2PoolPolicy>) {
+    Http2PoolPolicy result;
+    result.max_connections = value["max-connections"].As<size_t>(result.max_connections);
+    result.max_concurrent_streams = value["max-concurrent-streams"].As<size_t>(result.max_concurrent_streams);
+    result.prior_knowledge = value["prior-knowledge"].As<bool>(result.prior_knowledge);
+    if (result.max_connections == 0 || result.max_concurrent_streams == 0) {
+        throw std::runtime_error("Invalid HTTP/2 pool policy at '" + value.GetPath() + "': the limits must be positive");
+    }
+    return result;
+}
+
 ClientSettings Parse(const yaml_config::YamlConfig& value, formats::parse::To<ClientSettings>) {
     ClientSettings result;
     result.thread_name_prefix = value["thread-name-prefix"].As<std::string>(result.thread_name_prefix);
     result.io_threads = value["threads"].As<size_t>(result.io_threads);
     result.deadline_propagation = ParseDeadlinePropagationConfig(value);
+    result.http2_pools = value["http2-pools"].As<std::unordered_map<std::string, Http2PoolPolicy>>({});
     return result;
 }
 
@@ -1,5 +1,7 @@
 #include <clients/http/easy_wrapper.hpp>
 
+#include <clients/http/http2_pools.hpp>
+
 #include <userver/clients/http/client.hpp>
 #include <userver/clients/http/response_future.hpp>
 #include <userver/utils/assert.hpp>
@@ -24,6 +26,12 @@ curl::easy& EasyWrapper::Easy() { return *easy_; }
 
 const curl::easy& EasyWrapper::Easy() const { return *easy_; }
 
+Http2Pool* EasyWrapper::BindToHttp2Pool(std::string_view url) {
+    auto* pool = client_.FindHttp2Pool(url);
+    if (pool) easy_->RebindMulti(pool->GetMulti());
+    return pool;
+}
+
 }  // namespace clients::http::impl
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 
 #include <curl-ev/easy.hpp>
 
@@ -12,6 +13,8 @@ class Client;
 
 namespace clients::http::impl {
 
+class Http2Pool;
+
 class EasyWrapper final {
 public:
     EasyWrapper(std::shared_ptr<curl::easy>&& easy, Client& client);
@@ -26,6 +29,10 @@ public:
     curl::easy& Easy();
     const curl::easy& Easy() const;
 
+    /// Rebinds the handle to the dedicated multi of the URL destination.
+    /// @returns nullptr if the destination has no HTTP/2 pool
+    Http2Pool* BindToHttp2Pool(std::string_view url);
+
 private:
     std::shared_ptr<curl::easy> easy_;
     Client& client_;
@@ -0,0 +1,126 @@
+#include <clients/http/http2_pools.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <curl-ev/multi.hpp>
+#include <curl-ev/ratelimit.hpp>
+#include <engine/ev/thread_pool.hpp>
+
+#include <userver/utils/str_icase.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http::impl {
+
+namespace {
+
+long ClampToLong(std::size_t value) { return std::min<std::size_t>(value, std::numeric_limits<long>::max()); }
+
+constexpr std::pair<std::string_view, std::string_view> kDefaultPorts[] = {
+    {"http", ":80"},
+    {"https", ":443"},
+};
+
+}  // namespace
+
+Http2Pool::Http2Pool(std::string origin, const Http2PoolPolicy& policy, std::unique_ptr<curl::multi> multi)
+    : origin_(std::move(origin)), policy_(policy), multi_(std::move(multi)) {
+    const auto max_connections = ClampToLong(policy_.max_connections);
+    multi_->SetMultiplexingEnabled(true);
+    multi_->SetMaxHostConnections(max_connections);
+    multi_->SetMaxTotalConnections(max_connections);
+    multi_->SetConnectionCacheSize(max_connections);
+    multi_->SetMaxConcurrentStreams(ClampToLong(policy_.max_concurrent_streams));
+}
+
+Http2Pool::~Http2Pool() = default;
+
+void Http2Pool::AccountRequest(std::size_t connections_opened) noexcept {
+    ++stats_.requests;
+    if (connections_opened == 0) {
+        ++stats_.reused;
+    } else {
+        stats_.connections_opened.Add(utils::statistics::Rate{connections_opened});
+    }
+}
+
+std::int64_t Http2Pool::GetActiveConnections() const {
+    const auto& stats = multi_->Statistics();
+    // There is a race between close/open updates
+    return std::max<std::int64_t>(stats.open_socket_total() - stats.close_socket_total(), 0);
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const Http2Pool& pool) {
+    const auto& stats = pool.GetStatistics();
+    writer["requests"] = stats.requests;
+    writer["reused"] = stats.reused;
+    writer["connections"]["opened"] = stats.connections_opened;
+    writer["connections"]["active"] = pool.GetActiveConnections();
+    writer["connections"]["limit"] = pool.GetPolicy().max_connections;
+}
+
+std::string_view ExtractOrigin(std::string_view url) noexcept {
+    const auto scheme_end = url.find("://");
+    if (scheme_end == std::string_view::npos) return {};
+    auto origin = url.substr(0, url.find_first_of("/?#", scheme_end + 3));
+
+    // `https://host:443` is the same destination as `https://host`
+    const auto scheme = url.substr(0, scheme_end);
+    for (const auto& [default_scheme, default_port] : kDefaultPorts) {
+        if (utils::StrIcaseEqual{}(scheme, default_scheme) && utils::text::EndsWith(origin, default_port)) {
+            origin.remove_suffix(default_port.size());
+            break;
+        }
+    }
+    return origin;
+}
+
+Http2Pools::Http2Pools(
+    const std::unordered_map<std::string, Http2PoolPolicy>& policies,
+    engine::ev::ThreadPool& thread_pool,
+    const std::shared_ptr<curl::ConnectRateLimiter>& connect_rate_limiter
+) {
+    pools_.reserve(policies.size());
+    for (const auto& [origin, policy] : policies) {
+        const auto normalized_origin = ExtractOrigin(origin);
+        UINVARIANT(
+            !normalized_origin.empty() &&
+                origin.find_first_of("/?#", normalized_origin.size()) == std::string::npos,
+            "HTTP/2 pool key must be an origin 'scheme://host[:port]', got '" + origin + "'"
+        );
+        pools_.push_back(std::make_unique<Http2Pool>(
+            std::string{normalized_origin},
+            policy,
+            std::make_unique<curl::multi>(thread_pool.NextThread(), connect_rate_limiter)
+        ));
+    }
+}
+
+Http2Pools::~Http2Pools() = default;
+
+Http2Pool* Http2Pools::Find(std::string_view url) noexcept {
+    if (pools_.empty()) return nullptr;
+
+    const auto origin = ExtractOrigin(url);
+    for (const auto& pool : pools_) {
+        if (utils::StrIcaseEqual{}(pool->GetOrigin(), origin)) return pool.get();
+    }
+    return nullptr;
+}
+
+bool Http2Pools::Contains(const curl::multi* multi) const noexcept {
+    return std::any_of(pools_.begin(), pools_.end(), [multi](const auto& pool) { return &pool->GetMulti() == multi; });
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const Http2Pools& pools) {
+    for (const auto& pool : pools.pools_) {
+        writer.ValueWithLabels(*pool, {"http_destination", pool->GetOrigin()});
+    }
+}
+
+}  // namespace clients::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/clients/http/config.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace curl {
+class multi;
+class ConnectRateLimiter;
+}  // namespace curl
+
+namespace engine::ev {
+class ThreadPool;
+}  // namespace engine::ev
+
+namespace clients::http::impl {
+
+struct Http2PoolStatistics final {
+    utils::statistics::RateCounter requests;
+    // requests multiplexed over an already established connection
+    utils::statistics::RateCounter reused;
+    utils::statistics::RateCounter connections_opened;
+};
+
+/// Dedicated curl multi for a single destination, so that its connection
+/// cache holds only the connections to the destination.
+class Http2Pool final {
+public:
+    Http2Pool(std::string origin, const Http2PoolPolicy& policy, std::unique_ptr<curl::multi> multi);
+    ~Http2Pool();
+
+    const std::string& GetOrigin() const noexcept { return origin_; }
+    const Http2PoolPolicy& GetPolicy() const noexcept { return policy_; }
+    curl::multi& GetMulti() noexcept { return *multi_; }
+    const curl::multi& GetMulti() const noexcept { return *multi_; }
+
+    void AccountRequest(std::size_t connections_opened) noexcept;
+
+    const Http2PoolStatistics& GetStatistics() const noexcept { return stats_; }
+
+    std::int64_t GetActiveConnections() const;
+
+private:
+    const std::string origin_;
+    const Http2PoolPolicy policy_;
+    const std::unique_ptr<curl::multi> multi_;
+    Http2PoolStatistics stats_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const Http2Pool& pool);
+
+/// @returns `scheme://host[:port]` part of the URL, without the default port
+/// of the scheme
+std::string_view ExtractOrigin(std::string_view url) noexcept;
+
+class Http2Pools final {
+public:
+    /// Blocking, libcurl reads system files on multi initialization
+    Http2Pools(
+        const std::unordered_map<std::string, Http2PoolPolicy>& policies,
+        engine::ev::ThreadPool& thread_pool,
+        const std::shared_ptr<curl::ConnectRateLimiter>& connect_rate_limiter
+    );
+    ~Http2Pools();
+
+    /// @returns nullptr if the destination of the URL has no dedicated pool
+    Http2Pool* Find(std::string_view url) noexcept;
+
+    bool Contains(const curl::multi* multi) const noexcept;
+
+    bool IsEmpty() const noexcept { return pools_.empty(); }
+
+private:
+    friend void DumpMetric(utils::statistics::Writer& writer, const Http2Pools& pools);
+
+    // a handful of destinations, a linear search is faster than hashing
+    std::vector<std::unique_ptr<Http2Pool>> pools_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const Http2Pools& pools);
+
+}  // namespace clients::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,110 @@
+#include <clients/http/http2_pools.hpp>
+
+#include <clients/http/statistics.hpp>
+#include <userver/clients/http/client.hpp>
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/tracing/manager.hpp>
+#include <userver/utest/http_server_mock.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using clients::http::impl::ExtractOrigin;
+
+}  // namespace
+
+TEST(HttpClientHttp2Pools, ExtractOrigin) {
+    EXPECT_EQ(ExtractOrigin("https://example.com"), "https://example.com");
+    EXPECT_EQ(ExtractOrigin("https://example.com/"), "https://example.com");
+    EXPECT_EQ(ExtractOrigin("http://example.com:8080/path?a=b"), "http://example.com:8080");
+    EXPECT_EQ(ExtractOrigin("http://example.com?a=b"), "http://example.com");
+    EXPECT_EQ(ExtractOrigin("http://example.com#fragment"), "http://example.com");
+    EXPECT_EQ(ExtractOrigin("example.com/path"), "");
+    EXPECT_EQ(ExtractOrigin(""), "");
+}
+
+TEST(HttpClientHttp2Pools, ExtractOriginDefaultPorts) {
+    EXPECT_EQ(ExtractOrigin("https://example.com:443/path"), "https://example.com");
+    EXPECT_EQ(ExtractOrigin("HTTPS://example.com:443"), "HTTPS://example.com");
+    EXPECT_EQ(ExtractOrigin("http://example.com:80/path"), "http://example.com");
+    EXPECT_EQ(ExtractOrigin("http://[::1]:80"), "http://[::1]");
+
+    EXPECT_EQ(ExtractOrigin("http://example.com:443"), "http://example.com:443");
+    EXPECT_EQ(ExtractOrigin("https://example.com:80"), "https://example.com:80");
+    EXPECT_EQ(ExtractOrigin("https://example.com:8443"), "https://example.com:8443");
+    EXPECT_EQ(ExtractOrigin("http://example.com:8080"), "http://example.com:8080");
+}
+
+TEST(HttpClientHttp2Pools, ParsePolicy) {
+    const yaml_config::YamlConfig config{
+        formats::yaml::FromString(R"(
+max-connections: 2
+prior-knowledge: true
+)"),
+        {}};
+    const auto policy = config.As<clients::http::Http2PoolPolicy>();
+    EXPECT_EQ(policy.max_connections, 2);
+    EXPECT_EQ(policy.max_concurrent_streams, 100);
+    EXPECT_TRUE(policy.prior_knowledge);
+
+    const yaml_config::YamlConfig invalid{formats::yaml::FromString("max-concurrent-streams: 0"), {}};
+    EXPECT_ANY_THROW(invalid.As<clients::http::Http2PoolPolicy>());
+}
+
+UTEST(HttpClientHttp2Pools, RebindsRequests) {
+    const utest::HttpServerMock pool_server{[](const utest::HttpServerMock::HttpRequest&) {
+        return utest::HttpServerMock::HttpResponse{200, {}, "pool"};
+    }};
+    const utest::HttpServerMock other_server{[](const utest::HttpServerMock::HttpRequest&) {
+        return utest::HttpServerMock::HttpResponse{200, {}, "other"};
+    }};
+    const auto origin = pool_server.GetBaseUrl();
+
+    const tracing::GenericTracingManager tracing_manager{tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+    clients::http::ClientSettings settings;
+    settings.io_threads = 1;
+    settings.tracing_manager = &tracing_manager;
+    settings.http2_pools.emplace(origin, clients::http::Http2PoolPolicy{});
+    clients::http::Client client{
+        std::move(settings),
+        engine::current_task::GetTaskProcessor(),
+        std::vector<utils::NotNull<clients::http::Plugin*>>{}};
+
+    utils::statistics::Storage statistics_storage;
+    const auto holder = statistics_storage.RegisterWriter("http2-pools", [&client](utils::statistics::Writer& writer) {
+        writer = client.GetHttp2Pools();
+    });
+    const auto get_metric = [&](const std::string& path) {
+        return utils::statistics::Snapshot{statistics_storage, "http2-pools"}
+            .SingleMetric(path, {{"http_destination", origin}})
+            .AsRate();
+    };
+
+    // A plain HTTP/1.1 server, the connection is reused by the sequential
+    // requests through the pool multi
+    for (int i = 0; i < 3; ++i) {
+        const auto response =
+            client.CreateRequest().get(origin + "/path").timeout(utest::kMaxTestWaitTime).perform();
+        EXPECT_EQ(response->status_code(), 200);
+        EXPECT_EQ(response->body(), "pool");
+    }
+    EXPECT_EQ(get_metric("requests"), utils::statistics::Rate{3});
+    EXPECT_EQ(get_metric("reused"), utils::statistics::Rate{2});
+    EXPECT_EQ(get_metric("connections.opened"), utils::statistics::Rate{1});
+    EXPECT_EQ(pool_server.GetConnectionsOpenedCount(), 1);
+    EXPECT_EQ(client.GetPoolStatistics().multi[0].multi.socket_open, utils::statistics::Rate{0});
+
+    // The idle handle is back at the regular multi
+    const auto response =
+        client.CreateRequest().get(other_server.GetBaseUrl()).timeout(utest::kMaxTestWaitTime).perform();
+    EXPECT_EQ(response->body(), "other");
+    EXPECT_EQ(get_metric("requests"), utils::statistics::Rate{3});
+    EXPECT_EQ(client.GetPoolStatistics().multi[0].multi.socket_open, utils::statistics::Rate{1});
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,390 @@
+#include <userver/clients/http/load_balancer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include <fmt/format.h>
+
+#include <userver/clients/dns/resolver.hpp>
+#include <userver/clients/http/connect_to.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/fs/read.hpp>
+#include <userver/http/url.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/retry_budget.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/utils/text_light.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace impl {
+
+struct EndpointState final {
+    explicit EndpointState(const Endpoint& endpoint) : endpoint(endpoint) {
+        if (!endpoint.connect_to.empty()) connect_to.emplace(endpoint.connect_to);
+    }
+
+    const Endpoint endpoint;
+    std::optional<ConnectTo> connect_to;
+
+    std::atomic<std::int64_t> in_flight{0};
+    // microseconds
+    std::atomic<double> latency_ewma{0};
+    std::atomic<std::chrono::steady_clock::rep> latency_updated_at{0};
+
+    std::atomic<std::size_t> consecutive_failures{0};
+    std::atomic<std::chrono::steady_clock::rep> ejected_until{0};
+    std::atomic<std::chrono::steady_clock::rep> last_ejected_at{0};
+    std::atomic<std::uint32_t> ejections_in_row{0};
+
+    utils::statistics::RateCounter requests;
+    utils::statistics::RateCounter failures;
+    utils::statistics::RateCounter ejections;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const EndpointState& state) {
+    writer["requests"] = state.requests;
+    writer["failures"] = state.failures;
+    writer["ejections"] = state.ejections;
+    writer["in-flight"] = state.in_flight.load(std::memory_order_relaxed);
+    writer["latency-ewma-us"] = static_cast<std::int64_t>(state.latency_ewma.load(std::memory_order_relaxed));
+    writer["ejected"] = state.ejected_until.load(std::memory_order_relaxed) >
+                        std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+}  // namespace impl
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Clock::rep ToRep(Clock::time_point time) noexcept { return time.time_since_epoch().count(); }
+
+bool IsEjected(const impl::EndpointState& state, Clock::rep now) noexcept {
+    return state.ejected_until.load(std::memory_order_relaxed) > now;
+}
+
+// The 1us floor makes the in-flight requests count for a new endpoint
+double GetCost(const impl::EndpointState& state) noexcept {
+    return (state.latency_ewma.load(std::memory_order_relaxed) + 1) *
+           static_cast<double>(state.in_flight.load(std::memory_order_relaxed) + 1);
+}
+
+// The endpoints resolved from a single host share the base_url and differ
+// by connect_to only, so the whole endpoints are compared
+bool IsExcluded(const impl::EndpointState& state, utils::span<const Endpoint> exclude) noexcept {
+    return std::find(exclude.begin(), exclude.end(), state.endpoint) != exclude.end();
+}
+
+std::string_view ExtractPort(std::string_view url) {
+    const auto scheme_end = url.find("://");
+    const auto authority_begin = scheme_end == std::string_view::npos ? 0 : scheme_end + 3;
+    auto authority = url.substr(authority_begin, url.find_first_of("/?#", authority_begin) - authority_begin);
+
+    const auto userinfo_end = authority.rfind('@');
+    if (userinfo_end != std::string_view::npos) authority.remove_prefix(userinfo_end + 1);
+
+    const auto port_pos = authority.rfind(':');
+    if (port_pos == std::string_view::npos || authority.find(']', port_pos) != std::string_view::npos) {
+        if (utils::text::StartsWith(url, "https://")) return "443";
+        return "80";
+    }
+    return authority.substr(port_pos + 1);
+}
+
+bool IsFailure(const Response& response) { return response.status_code() >= 500; }
+
+}  // namespace
+
+LoadBalancerSettings Parse(const yaml_config::YamlConfig& value, formats::parse::To<LoadBalancerSettings>) {
+    LoadBalancerSettings result;
+    result.latency_decay = value["latency-decay"].As<std::chrono::milliseconds>(result.latency_decay);
+    result.consecutive_failures = value["consecutive-failures"].As<std::size_t>(result.consecutive_failures);
+    result.base_ejection_time = value["base-ejection-time"].As<std::chrono::milliseconds>(result.base_ejection_time);
+    result.max_ejection_time = value["max-ejection-time"].As<std::chrono::milliseconds>(result.max_ejection_time);
+    result.max_ejection_percent = value["max-ejection-percent"].As<std::size_t>(result.max_ejection_percent);
+    return result;
+}
+
+std::vector<Endpoint> MakeEndpoints(const std::vector<std::string>& base_urls) {
+    std::vector<Endpoint> result;
+    result.reserve(base_urls.size());
+    for (const auto& base_url : base_urls) result.push_back(Endpoint{base_url});
+    return result;
+}
+
+std::vector<Endpoint>
+ResolveEndpoints(clients::dns::Resolver& resolver, const std::string& base_url, engine::Deadline deadline) {
+    const auto host = USERVER_NAMESPACE::http::ExtractHostname(base_url);
+    const auto port = ExtractPort(base_url);
+    const auto addrs = resolver.Resolve(host, deadline);
+
+    std::vector<Endpoint> result;
+    result.reserve(addrs.size());
+    for (const auto& addr : addrs) {
+        const auto address = addr.Domain() == engine::io::AddrDomain::kInet6
+                                 ? fmt::format("[{}]", addr.PrimaryAddressString())
+                                 : addr.PrimaryAddressString();
+        result.push_back(Endpoint{base_url, fmt::format("{}:{}:{}:{}", host, port, address, port)});
+    }
+    return result;
+}
+
+std::vector<Endpoint> ReadEndpointsFile(engine::TaskProcessor& fs_task_processor, const std::string& path) {
+    const auto contents = fs::ReadFileContents(fs_task_processor, path);
+
+    std::vector<Endpoint> result;
+    std::string_view rest = contents;
+    while (!rest.empty()) {
+        const auto line_end = rest.find('\n');
+        auto line = rest.substr(0, line_end);
+        rest.remove_prefix(line_end == std::string_view::npos ? rest.size() : line_end + 1);
+
+        line = line.substr(0, line.find('#'));
+        const auto url = utils::text::Trim(std::string{line});
+        if (!url.empty()) result.push_back(Endpoint{url});
+    }
+    return result;
+}
+
+LoadBalancer::Lease::Lease(const LoadBalancer& balancer, std::shared_ptr<impl::EndpointState> state) noexcept
+    : balancer_(&balancer), state_(std::move(state)), started_at_(Clock::now()) {
+    state_->in_flight.fetch_add(1, std::memory_order_relaxed);
+}
+
+LoadBalancer::Lease::Lease(Lease&& other) noexcept
+    : balancer_(other.balancer_),
+      state_(std::move(other.state_)),
+      started_at_(other.started_at_),
+      accounted_(other.accounted_) {}
+
+LoadBalancer::Lease& LoadBalancer::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (state_) state_->in_flight.fetch_sub(1, std::memory_order_relaxed);
+        balancer_ = other.balancer_;
+        state_ = std::move(other.state_);
+        started_at_ = other.started_at_;
+        accounted_ = other.accounted_;
+    }
+    return *this;
+}
+
+LoadBalancer::Lease::~Lease() {
+    if (state_) state_->in_flight.fetch_sub(1, std::memory_order_relaxed);
+}
+
+const Endpoint& LoadBalancer::Lease::GetEndpoint() const noexcept {
+    UASSERT(state_);
+    return state_->endpoint;
+}
+
+void LoadBalancer::Lease::Apply(Request& request) const {
+    UASSERT(state_);
+    if (state_->connect_to) request.connect_to(*state_->connect_to);
+}
+
+void LoadBalancer::Lease::AccountResult(bool success) {
+    UASSERT(state_);
+    UINVARIANT(!accounted_, "The result of the request is already accounted");
+    accounted_ = true;
+    balancer_->AccountResult(*state_, Clock::now() - started_at_, success);
+}
+
+LoadBalancer::LoadBalancer(LoadBalancerSettings settings) : settings_(std::move(settings)) {
+    UINVARIANT(settings_.latency_decay.count() > 0, "latency-decay must be positive");
+    UINVARIANT(settings_.consecutive_failures > 0, "consecutive-failures must be positive");
+}
+
+LoadBalancer::~LoadBalancer() = default;
+
+void LoadBalancer::SetEndpoints(const std::vector<Endpoint>& endpoints) {
+    auto current = endpoints_.Read();
+
+    std::vector<std::shared_ptr<impl::EndpointState>> updated;
+    updated.reserve(endpoints.size());
+    for (const auto& endpoint : endpoints) {
+        const auto it = std::find_if(current->begin(), current->end(), [&endpoint](const auto& state) {
+            return state->endpoint == endpoint;
+        });
+        if (it != current->end()) {
+            updated.push_back(*it);
+        } else if (std::none_of(updated.begin(), updated.end(), [&endpoint](const auto& state) {
+                       return state->endpoint == endpoint;
+                   })) {
+            updated.push_back(std::make_shared<impl::EndpointState>(endpoint));
+        }
+    }
+    endpoints_.Assign(std::move(updated));
+}
+
+LoadBalancer::Lease LoadBalancer::Pick(utils::span<const Endpoint> exclude) const {
+    const auto endpoints = endpoints_.Read();
+    const auto size = endpoints->size();
+    if (size == 0) throw NoEndpointsException("No endpoints to pick from");
+
+    const auto now = ToRep(Clock::now());
+    // Relaxes the restrictions until there is a candidate: all the endpoints
+    // may be ejected or excluded
+    for (const bool respect_ejection : {true, false}) {
+        for (const bool respect_exclude : {true, false}) {
+            const auto is_candidate = [&](const impl::EndpointState& state) {
+                return !(respect_ejection && IsEjected(state, now)) && !(respect_exclude && IsExcluded(state, exclude));
+            };
+            // A random start and a linear probe keep the pick allocation-free
+            const auto find_candidate = [&](std::size_t start) -> std::optional<std::size_t> {
+                for (std::size_t i = 0; i < size; ++i) {
+                    const auto index = (start + i) % size;
+                    if (is_candidate(*(*endpoints)[index])) return index;
+                }
+                return std::nullopt;
+            };
+
+            const auto first = find_candidate(utils::RandRange(size));
+            if (!first) continue;
+
+            // the second choice is different from the first one if possible
+            const auto second = find_candidate(*first + 1 + utils::RandRange(size - 1 + (size == 1)));
+            const auto picked =
+                (second && GetCost(*(*endpoints)[*second]) < GetCost(*(*endpoints)[*first])) ? *second : *first;
+            return Lease{*this, (*endpoints)[picked]};
+        }
+    }
+    UINVARIANT(false, "No endpoint was picked");
+}
+
+std::size_t LoadBalancer::GetEndpointsCount() const {
+    const auto endpoints = endpoints_.Read();
+    return endpoints->size();
+}
+
+void LoadBalancer::AccountResult(impl::EndpointState& state, Clock::duration latency, bool success) const {
+    ++state.requests;
+    if (!success) {
+        ++state.failures;
+        if (state.consecutive_failures.fetch_add(1, std::memory_order_relaxed) + 1 >= settings_.consecutive_failures) {
+            TryEject(state);
+        }
+        return;
+    }
+    state.consecutive_failures.store(0, std::memory_order_relaxed);
+
+    // Time-decayed moving average, so that an idle endpoint is probed again
+    const auto now = ToRep(Clock::now());
+    const auto elapsed = Clock::duration{now - state.latency_updated_at.exchange(now, std::memory_order_relaxed)};
+    const auto weight = std::exp(
+        -std::chrono::duration<double>(elapsed).count() / std::chrono::duration<double>(settings_.latency_decay).count()
+    );
+    const auto sample = std::chrono::duration<double, std::micro>(latency).count();
+    auto ewma = state.latency_ewma.load(std::memory_order_relaxed);
+    while (!state.latency_ewma.compare_exchange_weak(ewma, ewma * weight + sample * (1 - weight))) {
+    }
+}
+
+void LoadBalancer::TryEject(impl::EndpointState& state) const {
+    const auto now = Clock::now();
+    const auto now_rep = ToRep(now);
+    if (IsEjected(state, now_rep)) return;
+
+    const auto endpoints = endpoints_.Read();
+    const auto ejected = std::count_if(endpoints->begin(), endpoints->end(), [now_rep](const auto& endpoint) {
+        return IsEjected(*endpoint, now_rep);
+    });
+    if (static_cast<std::size_t>(ejected + 1) * 100 > endpoints->size() * settings_.max_ejection_percent) {
+        LOG_LIMITED_WARNING() << "Not ejecting failing endpoint " << state.endpoint.base_url
+                              << ": too many endpoints are ejected already";
+        return;
+    }
+
+    // a flapping endpoint is ejected for longer each time
+    const auto last_ejected_at = Clock::time_point{Clock::duration{state.last_ejected_at.exchange(now_rep)}};
+    const auto in_row = (now - last_ejected_at > settings_.max_ejection_time + settings_.base_ejection_time)
+                            ? 0
+                            : std::min<std::uint32_t>(state.ejections_in_row.load(), 16);
+    state.ejections_in_row.store(in_row + 1);
+    const auto ejection_time =
+        std::min<Clock::duration>(settings_.base_ejection_time * (1 << in_row), settings_.max_ejection_time);
+
+    state.ejected_until.store(ToRep(now + ejection_time), std::memory_order_relaxed);
+    state.consecutive_failures.store(0, std::memory_order_relaxed);
+    ++state.ejections;
+    LOG_WARNING() << "Endpoint " << state.endpoint.base_url << " is ejected for "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(ejection_time).count() << "ms";
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const LoadBalancer& balancer) {
+    const auto endpoints = balancer.endpoints_.Read();
+    writer["endpoints"] = endpoints->size();
+    for (const auto& state : *endpoints) {
+        const auto& endpoint = state->endpoint;
+        const auto& name = endpoint.connect_to.empty() ? endpoint.base_url : endpoint.connect_to;
+        writer.ValueWithLabels(*state, {"http_endpoint", name});
+    }
+}
+
+LoadBalancedStrategy::LoadBalancedStrategy(
+    const LoadBalancer& balancer,
+    RequestFactory request_factory,
+    utils::RetryBudget* retry_budget
+)
+    : balancer_(balancer), request_factory_(std::move(request_factory)), retry_budget_(retry_budget) {
+    UINVARIANT(request_factory_, "Request factory is not set");
+}
+
+std::optional<LoadBalancedStrategy::Attempt> LoadBalancedStrategy::Create(std::size_t attempt) {
+    if (succeeded_) return std::nullopt;
+    // hedged attempts are the extra load as well as retries
+    if (attempt > 0 && retry_budget_ && !retry_budget_->CanRetry()) return std::nullopt;
+
+    auto lease = balancer_.Pick(tried_);
+    tried_.push_back(lease.GetEndpoint());
+
+    auto request = request_factory_(lease.GetEndpoint().base_url);
+    lease.Apply(request);
+    auto future = request.async_perform();
+    return Attempt{std::move(lease), std::move(future)};
+}
+
+std::optional<std::chrono::milliseconds> LoadBalancedStrategy::ProcessReply(Attempt&& attempt) {
+    bool success = false;
+    try {
+        auto response = attempt.future.Get();
+        success = !IsFailure(*response);
+        if (success || !succeeded_) reply_ = std::move(response);
+    } catch (const std::exception& e) {
+        LOG_INFO() << "Request to " << attempt.lease.GetEndpoint().base_url << " failed: " << e;
+    }
+    attempt.lease.AccountResult(success);
+
+    if (retry_budget_) {
+        if (success) {
+            retry_budget_->AccountOk();
+        } else {
+            retry_budget_->AccountFail();
+        }
+    }
+
+    if (success) {
+        succeeded_ = true;
+        return std::nullopt;
+    }
+    // retry on another endpoint right away, Create() checks the budget
+    return std::chrono::milliseconds{0};
+}
+
+std::optional<std::shared_ptr<Response>> LoadBalancedStrategy::ExtractReply() {
+    if (!reply_) return std::nullopt;
+    return std::move(reply_);
+}
+
+void LoadBalancedStrategy::Finish(Attempt&& attempt) { attempt.future.Cancel(); }
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,214 @@
+#include <userver/clients/http/load_balancer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/clients/dns/config.hpp>
+#include <userver/clients/dns/resolver.hpp>
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/utest/dns_server_mock.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/http_server_mock.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/hedged_request.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using clients::http::LoadBalancer;
+
+const std::string kFirst = "http://first";
+const std::string kSecond = "http://second";
+const std::string kThird = "http://third";
+
+std::map<std::string, int> CountPicks(const LoadBalancer& balancer, int picks) {
+    std::map<std::string, int> result;
+    for (int i = 0; i < picks; ++i) ++result[balancer.Pick().GetEndpoint().base_url];
+    return result;
+}
+
+LoadBalancer::Lease PickExactly(const LoadBalancer& balancer, const std::string& base_url) {
+    std::vector<clients::http::Endpoint> exclude;
+    for (const auto& other : {kFirst, kSecond, kThird}) {
+        if (other != base_url) exclude.push_back({other});
+    }
+    auto lease = balancer.Pick(exclude);
+    EXPECT_EQ(lease.GetEndpoint().base_url, base_url);
+    return lease;
+}
+
+std::string ExtractPort(const std::string& base_url) { return base_url.substr(base_url.rfind(':') + 1); }
+
+}  // namespace
+
+UTEST(HttpLoadBalancer, NoEndpoints) {
+    const LoadBalancer balancer;
+    UEXPECT_THROW(balancer.Pick(), clients::http::NoEndpointsException);
+}
+
+UTEST(HttpLoadBalancer, PrefersLessLoaded) {
+    LoadBalancer balancer;
+    balancer.SetEndpoints(clients::http::MakeEndpoints({kFirst, kSecond}));
+
+    const auto busy = balancer.Pick();
+    const auto& idle = busy.GetEndpoint().base_url == kFirst ? kSecond : kFirst;
+    EXPECT_EQ(CountPicks(balancer, 100), (std::map<std::string, int>{{idle, 100}}));
+}
+
+UTEST(HttpLoadBalancer, PrefersFaster) {
+    LoadBalancer balancer;
+    balancer.SetEndpoints(clients::http::MakeEndpoints({kFirst, kSecond}));
+
+    {
+        auto slow = PickExactly(balancer, kFirst);
+        engine::SleepFor(std::chrono::milliseconds{20});
+        slow.AccountResult(true);
+    }
+    PickExactly(balancer, kSecond).AccountResult(true);
+
+    EXPECT_EQ(CountPicks(balancer, 100), (std::map<std::string, int>{{kSecond, 100}}));
+}
+
+UTEST(HttpLoadBalancer, Ejection) {
+    clients::http::LoadBalancerSettings settings;
+    settings.consecutive_failures = 3;
+    settings.base_ejection_time = utest::kMaxTestWaitTime;
+    LoadBalancer balancer{settings};
+    balancer.SetEndpoints(clients::http::MakeEndpoints({kFirst, kSecond}));
+
+    for (int i = 0; i < 2; ++i) PickExactly(balancer, kFirst).AccountResult(false);
+    // a success resets the consecutive failures
+    PickExactly(balancer, kFirst).AccountResult(true);
+    for (int i = 0; i < 2; ++i) PickExactly(balancer, kFirst).AccountResult(false);
+
+    PickExactly(balancer, kFirst).AccountResult(false);
+    // exclusions are ignored rather than ejections
+    EXPECT_EQ(balancer.Pick(clients::http::MakeEndpoints({kSecond})).GetEndpoint().base_url, kSecond);
+
+    // no more than a half of the endpoints are ejected
+    for (int i = 0; i < 3; ++i) PickExactly(balancer, kSecond).AccountResult(false);
+    EXPECT_EQ(CountPicks(balancer, 100), (std::map<std::string, int>{{kSecond, 100}}));
+
+    // the state of the kept endpoints survives the update
+    balancer.SetEndpoints(clients::http::MakeEndpoints({kFirst, kSecond, kThird}));
+    EXPECT_EQ(balancer.GetEndpointsCount(), 3);
+    EXPECT_EQ(CountPicks(balancer, 100).count(kFirst), 0);
+}
+
+UTEST(HttpLoadBalancer, AllExcluded) {
+    LoadBalancer balancer;
+    balancer.SetEndpoints(clients::http::MakeEndpoints({kFirst}));
+
+    EXPECT_EQ(balancer.Pick(clients::http::MakeEndpoints({kFirst})).GetEndpoint().base_url, kFirst);
+}
+
+UTEST(HttpLoadBalancer, ExcludesSameBaseUrl) {
+    // the endpoints resolved from a single host
+    const std::vector<clients::http::Endpoint> endpoints{
+        {kFirst, "first:80:127.0.0.1:80"},
+        {kFirst, "first:80:127.0.0.2:80"},
+    };
+    LoadBalancer balancer;
+    balancer.SetEndpoints(endpoints);
+    EXPECT_EQ(balancer.GetEndpointsCount(), 2);
+
+    for (const auto& endpoint : endpoints) {
+        const std::vector<clients::http::Endpoint> exclude{endpoint};
+        for (int i = 0; i < 10; ++i) EXPECT_NE(balancer.Pick(exclude).GetEndpoint(), endpoint);
+    }
+}
+
+UTEST(HttpLoadBalancer, ResolveEndpoints) {
+    const auto hosts_file = fs::blocking::TempFile::Create();
+    fs::blocking::RewriteFileContents(hosts_file.GetPath(), "127.0.0.1 service\n127.0.0.2 service\n::1 service\n");
+
+    // the addresses come from the hosts file
+    const utest::DnsServerMock dns_server{[](const utest::DnsServerMock::DnsQuery&
+                                          ) -> utest::DnsServerMock::DnsAnswerVector { throw std::exception{}; }};
+
+    clients::dns::ResolverConfig config;
+    config.file_path = hosts_file.GetPath();
+    config.file_update_interval = utest::kMaxTestWaitTime;
+    config.network_custom_servers = {dns_server.GetServerAddress()};
+    clients::dns::Resolver resolver{engine::current_task::GetTaskProcessor(), config};
+
+    const std::string base_url = "https://service:8443";
+    auto endpoints = clients::http::ResolveEndpoints(
+        resolver, base_url, engine::Deadline::FromDuration(utest::kMaxTestWaitTime)
+    );
+    std::sort(endpoints.begin(), endpoints.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.connect_to < rhs.connect_to;
+    });
+    EXPECT_EQ(
+        endpoints,
+        (std::vector<clients::http::Endpoint>{
+            {base_url, "service:8443:127.0.0.1:8443"},
+            {base_url, "service:8443:127.0.0.2:8443"},
+            {base_url, "service:8443:[::1]:8443"},
+        })
+    );
+}
+
+UTEST(HttpLoadBalancer, ReadEndpointsFile) {
+    const auto file = fs::blocking::TempFile::Create();
+    fs::blocking::RewriteFileContents(
+        file.GetPath(), "# endpoints\n" + kFirst + "\n\n  " + kSecond + "  # the second one\n" + kThird
+    );
+
+    EXPECT_EQ(
+        clients::http::ReadEndpointsFile(engine::current_task::GetTaskProcessor(), file.GetPath()),
+        clients::http::MakeEndpoints({kFirst, kSecond, kThird})
+    );
+}
+
+UTEST(HttpLoadBalancer, StrategyRetriesOnAnotherEndpoint) {
+    std::atomic<int> failed_requests{0};
+    std::atomic<int> ok_requests{0};
+    const utest::HttpServerMock failing_server{[&](const utest::HttpServerMock::HttpRequest&) {
+        ++failed_requests;
+        return utest::HttpServerMock::HttpResponse{500, {}, "fail"};
+    }};
+    const utest::HttpServerMock ok_server{[&](const utest::HttpServerMock::HttpRequest&) {
+        ++ok_requests;
+        return utest::HttpServerMock::HttpResponse{200, {}, "ok"};
+    }};
+    const auto http_client = utest::CreateHttpClient();
+
+    // both endpoints share the base_url, as the resolved ones do
+    const auto base_url = failing_server.GetBaseUrl();
+    const auto failing_port = ExtractPort(base_url);
+    const auto ok_port = ExtractPort(ok_server.GetBaseUrl());
+    const clients::http::Endpoint failing_endpoint{base_url, fmt::format("::127.0.0.1:{}", failing_port)};
+    const clients::http::Endpoint ok_endpoint{base_url, fmt::format("::127.0.0.1:{}", ok_port)};
+
+    LoadBalancer balancer;
+    balancer.SetEndpoints({failing_endpoint, ok_endpoint});
+    // the busy endpoint is picked second
+    const auto busy = balancer.Pick(std::vector{failing_endpoint});
+    ASSERT_EQ(busy.GetEndpoint(), ok_endpoint);
+
+    const auto response = utils::hedging::HedgeRequest(
+        clients::http::LoadBalancedStrategy{
+            balancer,
+            [&http_client](const std::string& url) {
+                return http_client->CreateRequest().get(url).timeout(utest::kMaxTestWaitTime);
+            }},
+        utils::hedging::HedgingSettings{2, utest::kMaxTestWaitTime, utest::kMaxTestWaitTime}
+    );
+    ASSERT_TRUE(response);
+    EXPECT_EQ((*response)->status_code(), 200);
+    EXPECT_EQ(failed_requests, 1);
+    EXPECT_EQ(ok_requests, 1);
+}
+
+USERVER_NAMESPACE_END
@@ -14,6 +14,7 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
+#include <clients/http/http2_pools.hpp>
 #include <curl-ev/error_code.hpp>
 #include <userver/baggage/baggage.hpp>
 #include <userver/clients/dns/resolver.hpp>
@@ -458,6 +459,7 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder, std::error
     holder->AccountResponse(err);
     const auto sockets = easy.get_num_connects();
     holder->WithRequestStats([sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+    if (holder->http2_pool_) holder->http2_pool_->AccountRequest(sockets);
 
     span.AddTag(tracing::kAttempts, holder->retry_.current);
     if (holder->deadline_propagation_config_.update_header) {
@@ -701,6 +703,8 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
 
     plugin_pipeline_.HookPerformRequest(*this);
 
+    if (retry_.current == 1) ApplyHttp2Pool();
+
     if (resolver_ && retry_.current == 1) {
         engine::AsyncNoSpan([this, holder = shared_from_this(), handler = std::move(handler)]() mutable {
             try {
@@ -724,6 +728,24 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
     }
 }
 
+void RequestState::ApplyHttp2Pool() {
+    // connections through a proxy are not multiplexed per destination
+    if (!proxy_url_.empty()) return;
+
+    const auto& url = easy().get_original_url();
+    http2_pool_ = easy_.BindToHttp2Pool(url);
+    if (!http2_pool_) return;
+
+    const bool prior_knowledge =
+        http2_pool_->GetPolicy().prior_knowledge && utils::text::StartsWith(url, "http://");
+    easy().set_http_version(
+        prior_knowledge ? curl::easy::http_version_2_prior_knowledge : curl::easy::http_version_2tls
+    );
+    // wait for a connection being established to multiplex over it instead of
+    // opening a new one
+    easy().set_pipewait(true);
+}
+
 void RequestState::SetEasyTimeout(std::chrono::milliseconds timeout) {
     UASSERT_MSG(
         timeout >= std::chrono::seconds{0}, fmt::format("timeout_ms < 0 ({})), uninitialized variable?", timeout)
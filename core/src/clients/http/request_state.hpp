@@ -153,6 +153,8 @@ private:
     void on_retry_timer(std::error_code err);
     /// run curl async_request, called once per attempt
     void perform_request(curl::easy::handler_type handler);
+    /// move the request to the HTTP/2 pool of its destination, if any
+    void ApplyHttp2Pool();
 
     void UpdateTimeoutFromDeadline(std::chrono::milliseconds backoff);
     [[nodiscard]] bool UpdateTimeoutFromDeadlineAndCheck(std::chrono::milliseconds backoff = {});
@@ -231,6 +233,7 @@ private:
 
     clients::dns::Resolver* resolver_{nullptr};
     std::string proxy_url_;
+    impl::Http2Pool* http2_pool_{nullptr};
     impl::PluginPipeline& plugin_pipeline_;
 
     struct StreamData {
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <system_error>
 #include <unordered_map>
 #include <vector>
 
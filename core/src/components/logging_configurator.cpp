@@ -3,6 +3,7 @@
 #include <logging/dynamic_debug.hpp>
 #include <logging/dynamic_debug_config.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
@@ -29,6 +30,18 @@ const dynamic_config::Key<tracing::NoLogSpans> kNoLogSpans{
 )"}};
 /// [key]
 
+const dynamic_config::Key<tracing::TailSampling> kTailSampling{
+    "USERVER_TAIL_SAMPLING",
+    dynamic_config::DefaultAsJsonString{R"(
+  {
+    "enabled": false,
+    "latency-threshold-ms": 1000,
+    "keep-errors": true,
+    "random-rate": 0.0,
+    "max-spans-per-trace": 1000
+  }
+)"}};
+
 const dynamic_config::Key<logging::DynamicDebugConfig> kDynamicDebugConfig{
     "USERVER_LOG_DYNAMIC_DEBUG",
     dynamic_config::DefaultAsJsonString{R"(
@@ -54,6 +67,7 @@ LoggingConfigurator::~LoggingConfigurator() { config_subscription_.Unsubscribe()
 void LoggingConfigurator::OnConfigUpdate(const dynamic_config::Snapshot& config) {
     (void)this;  // silence clang-tidy
     tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans{config[kNoLogSpans]});
+    tracing::Tracer::SetTailSampling(tracing::TailSampling{config[kTailSampling]});
 
     try {
         const auto& dd = config[kDynamicDebugConfig];
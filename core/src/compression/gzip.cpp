@@ -1,5 +1,6 @@
 #include <compression/gzip.hpp>
 
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -41,6 +42,22 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
     return decompressed;
 }
 
+std::string Compress(std::string_view data) {
+    std::string compressed;
+    // gzip is usually used for highly compressible text data
+    compressed.reserve(data.size() / 4);
+
+    namespace bio = boost::iostreams;
+
+    bio::filtering_ostream stream;
+    stream.push(bio::gzip_compressor());
+    stream.push(bio::back_inserter(compressed));
+    stream.write(data.data(), data.size());
+    stream.reset();
+
+    return compressed;
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
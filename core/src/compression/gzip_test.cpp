@@ -28,4 +28,17 @@ TEST(Gzip, TestOverflow) {
     EXPECT_THROW(compression::gzip::Decompress(compressed, big_msg.size() / 2), compression::TooBigError);
 }
 
+TEST(Gzip, CompressDecompress) {
+    std::string msg;
+    for (int i = 0; i < 1000; ++i) {
+        msg += "metric_name{label=\"value\"} 42\n";
+    }
+
+    const auto compressed = compression::gzip::Compress(msg);
+    EXPECT_LT(compressed.size(), msg.size() / 10);
+    EXPECT_EQ(compression::gzip::Decompress(compressed, msg.size()), msg);
+
+    EXPECT_EQ(compression::gzip::Decompress(compression::gzip::Compress({}), 1), "");
+}
+
 USERVER_NAMESPACE_END
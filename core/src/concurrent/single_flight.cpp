@@ -0,0 +1,19 @@
+#include <userver/concurrent/single_flight.hpp>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+void DumpMetric(utils::statistics::Writer& writer, const SingleFlightStatistics& stats) {
+    writer["executions"] = stats.executions;
+    writer["coalesced"] = stats.coalesced;
+    writer["timeouts"] = stats.timeouts;
+    writer["abandoned"] = stats.abandoned;
+    writer["in-flight"] = stats.in_flight.load();
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
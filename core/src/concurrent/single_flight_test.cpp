@@ -0,0 +1,181 @@
+#include <userver/concurrent/single_flight.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/server/request/task_inherited_data.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Flight = concurrent::SingleFlight<std::string, int>;
+
+// Work that waits for the release and remembers whether it was cancelled
+struct BlockedWork final {
+    int operator()() const {
+        ++state->started;
+        if (!state->release.WaitForEvent()) {
+            state->cancelled = true;
+            throw std::runtime_error("cancelled");
+        }
+        if (state->fail) throw std::runtime_error("failed");
+        return state->result;
+    }
+
+    struct State final {
+        engine::SingleConsumerEvent release;
+        std::atomic<int> started{0};
+        std::atomic<bool> cancelled{false};
+        bool fail{false};
+        int result{42};
+    };
+
+    std::shared_ptr<State> state;
+};
+
+void WaitForCalls(const Flight& flight, std::uint64_t calls) {
+    const auto& stats = flight.GetStatistics();
+    while (stats.executions.Load().value + stats.coalesced.Load().value < calls) engine::Yield();
+}
+
+}  // namespace
+
+UTEST_MT(SingleFlight, Coalesces, 4) {
+    Flight flight;
+    const auto state = std::make_shared<BlockedWork::State>();
+
+    std::vector<engine::TaskWithResult<int>> callers;
+    for (int i = 0; i < 10; ++i) {
+        callers.push_back(utils::Async("caller", [&] { return flight.Execute("key", BlockedWork{state}); }));
+    }
+    WaitForCalls(flight, 10);
+    EXPECT_EQ(flight.GetInFlightCount(), 1);
+
+    state->release.Send();
+    for (auto& caller : callers) EXPECT_EQ(caller.Get(), 42);
+
+    EXPECT_EQ(state->started, 1);
+    const auto& stats = flight.GetStatistics();
+    EXPECT_EQ(stats.executions.Load().value, 1u);
+    EXPECT_EQ(stats.coalesced.Load().value, 9u);
+    EXPECT_EQ(flight.GetInFlightCount(), 0);
+
+    // the finished work is not reused
+    EXPECT_EQ(flight.Execute("key", [] { return 1; }), 1);
+    EXPECT_EQ(stats.executions.Load().value, 2u);
+}
+
+UTEST(SingleFlight, DifferentKeys) {
+    Flight flight{concurrent::SingleFlightSettings{1, {}}};
+    const auto state = std::make_shared<BlockedWork::State>();
+
+    auto blocked = utils::Async("blocked", [&] { return flight.Execute("a", BlockedWork{state}); });
+    WaitForCalls(flight, 1);
+
+    EXPECT_EQ(flight.Execute("b", [] { return 1; }), 1);
+    EXPECT_EQ(flight.GetStatistics().coalesced.Load().value, 0u);
+
+    state->release.Send();
+    EXPECT_EQ(blocked.Get(), 42);
+}
+
+UTEST(SingleFlight, Exception) {
+    Flight flight;
+    const auto state = std::make_shared<BlockedWork::State>();
+    state->fail = true;
+
+    auto first = utils::Async("first", [&] { return flight.Execute("key", BlockedWork{state}); });
+    auto second = utils::Async("second", [&] { return flight.Execute("key", BlockedWork{state}); });
+    WaitForCalls(flight, 2);
+
+    state->release.Send();
+    EXPECT_THROW(first.Get(), std::runtime_error);
+    EXPECT_THROW(second.Get(), std::runtime_error);
+    EXPECT_EQ(state->started, 1);
+}
+
+UTEST(SingleFlight, Timeout) {
+    Flight flight{concurrent::SingleFlightSettings{16, std::chrono::milliseconds{10}}};
+    const auto state = std::make_shared<BlockedWork::State>();
+
+    EXPECT_THROW(flight.Execute("key", BlockedWork{state}), concurrent::SingleFlightTimeoutException);
+
+    // nobody waits for the work anymore
+    EXPECT_TRUE(state->cancelled);
+    const auto& stats = flight.GetStatistics();
+    EXPECT_EQ(stats.timeouts.Load().value, 1u);
+    EXPECT_EQ(stats.abandoned.Load().value, 1u);
+    EXPECT_EQ(flight.GetInFlightCount(), 0);
+}
+
+UTEST(SingleFlight, CancelledCaller) {
+    Flight flight;
+    const auto state = std::make_shared<BlockedWork::State>();
+
+    auto leader = utils::Async("leader", [&] { return flight.Execute("key", BlockedWork{state}); });
+    WaitForCalls(flight, 1);
+    auto follower = utils::Async("follower", [&] { return flight.Execute("key", BlockedWork{state}); });
+    WaitForCalls(flight, 2);
+    while (state->started == 0) engine::Yield();
+
+    leader.SyncCancel();
+    EXPECT_FALSE(state->cancelled);
+
+    state->release.Send();
+    EXPECT_EQ(follower.Get(), 42);
+    EXPECT_EQ(flight.GetStatistics().abandoned.Load().value, 0u);
+}
+
+UTEST(SingleFlight, LeaderDeadlineIsNotInherited) {
+    Flight flight;
+    const auto state = std::make_shared<BlockedWork::State>();
+    std::atomic<bool> work_has_deadline{true};
+
+    auto leader = utils::Async("leader", [&] {
+        // the request of the leader has already timed out
+        server::request::TaskInheritedData data;
+        data.deadline = engine::Deadline::FromDuration(std::chrono::milliseconds{1});
+        server::request::kTaskInheritedData.Set(std::move(data));
+
+        return flight.Execute("key", [&work_has_deadline, work = BlockedWork{state}] {
+            work_has_deadline = server::request::GetTaskInheritedDeadline().IsReachable();
+            return work();
+        });
+    });
+    WaitForCalls(flight, 1);
+    auto follower = utils::Async("follower", [&] { return flight.Execute("key", BlockedWork{state}); });
+    WaitForCalls(flight, 2);
+
+    state->release.Send();
+    EXPECT_EQ(leader.Get(), 42);
+    EXPECT_EQ(follower.Get(), 42);
+    EXPECT_FALSE(work_has_deadline);
+    EXPECT_EQ(state->started, 1);
+}
+
+UTEST(SingleFlight, AllCallersCancelled) {
+    Flight flight;
+    const auto state = std::make_shared<BlockedWork::State>();
+
+    auto first = utils::Async("first", [&] { return flight.Execute("key", BlockedWork{state}); });
+    auto second = utils::Async("second", [&] { return flight.Execute("key", BlockedWork{state}); });
+    WaitForCalls(flight, 2);
+    while (state->started == 0) engine::Yield();
+
+    first.SyncCancel();
+    second.SyncCancel();
+
+    EXPECT_TRUE(state->cancelled);
+    EXPECT_EQ(flight.GetStatistics().abandoned.Load().value, 1u);
+    EXPECT_EQ(flight.GetInFlightCount(), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,66 @@
+#include <userver/congestion_control/controllers/factory.hpp>
+
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/trivial_map.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::v2 {
+
+namespace {
+
+constexpr utils::TrivialBiMap kControllerTypes([](auto selector) {
+    return selector()
+        .Case(ControllerType::kLinear, "linear")
+        .Case(ControllerType::kGradient, "gradient")
+        .Case(ControllerType::kVegas, "vegas");
+});
+
+}  // namespace
+
+ControllerType Parse(const yaml_config::YamlConfig& value, formats::parse::To<ControllerType>) {
+    return utils::ParseFromValueString(value, kControllerTypes);
+}
+
+ControllerStaticConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<ControllerStaticConfig>) {
+    ControllerStaticConfig config;
+    static_cast<Controller::Config&>(config) = value.As<LinearController::StaticConfig>();
+    config.type = value["controller"].As<ControllerType>(config.type);
+    config.gradient = value["gradient"].As<GradientController::Settings>({});
+    config.vegas = value["vegas"].As<VegasController::Settings>({});
+    return config;
+}
+
+std::unique_ptr<Controller> MakeController(
+    const std::string& name,
+    v2::Sensor& sensor,
+    Limiter& limiter,
+    Stats& stats,
+    const ControllerStaticConfig& config,
+    dynamic_config::Source config_source,
+    std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter
+) {
+    switch (config.type) {
+        case ControllerType::kLinear:
+            return std::make_unique<LinearController>(
+                name, sensor, limiter, stats, config, config_source, std::move(config_getter)
+            );
+        case ControllerType::kGradient:
+            return std::make_unique<GradientController>(
+                name, sensor, limiter, stats, config, config.gradient, config_source, std::move(config_getter)
+            );
+        case ControllerType::kVegas:
+            return std::make_unique<VegasController>(
+                name, sensor, limiter, stats, config, config.vegas, config_source, std::move(config_getter)
+            );
+    }
+
+    UINVARIANT(false, "Unexpected congestion control controller type");
+}
+
+}  // namespace congestion_control::v2
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,109 @@
+#include <userver/congestion_control/controllers/gradient.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <userver/logging/log.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::v2 {
+
+namespace {
+// First seconds of service life might be too noisy
+constexpr std::size_t kWarmupEpochs = 30;
+
+constexpr double kMinGradient = 0.5;
+
+// The long RTT falls slowly by itself, help it once the timings got much
+// better than the long RTT, e.g. after a long overload
+constexpr double kLongRttRecoveryRatio = 2.0;
+constexpr double kLongRttRecoveryFactor = 0.95;
+}  // namespace
+
+GradientController::GradientController(
+    const std::string& name,
+    v2::Sensor& sensor,
+    Limiter& limiter,
+    Stats& stats,
+    const Controller::Config& config,
+    const Settings& settings,
+    dynamic_config::Source config_source,
+    std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter
+)
+    : Controller(name, sensor, limiter, stats, config),
+      settings_(settings),
+      config_source_(config_source),
+      config_getter_(std::move(config_getter)) {}
+
+Limit GradientController::Update(const Sensor::Data& current) {
+    const v2::Config config = config_getter_(config_source_.GetSnapshot());
+
+    if (current.total < config.min_qps && !estimated_limit_) {
+        // Too little QPS, timings avg data is VERY noisy
+        return {std::nullopt, current.current_load};
+    }
+
+    // Do not react to the jitter of very small timings
+    const auto short_rtt =
+        static_cast<double>(std::max<std::size_t>(current.timings_avg_ms, config.min_timings.count()));
+
+    if (!long_rtt_) {
+        long_rtt_ = short_rtt;
+    } else {
+        const double long_rtt_weight = 2.0 / static_cast<double>(settings_.long_window + 1);
+        *long_rtt_ = *long_rtt_ * (1 - long_rtt_weight) + short_rtt * long_rtt_weight;
+        if (*long_rtt_ > kLongRttRecoveryRatio * short_rtt) *long_rtt_ *= kLongRttRecoveryFactor;
+    }
+
+    if (epochs_passed_ < kWarmupEpochs) {
+        epochs_passed_++;
+        return {std::nullopt, current.current_load};
+    }
+
+    const bool has_errors = 100 * current.GetRate() > config.errors_threshold_percent;
+    // Timeouts hardly affect the timings, back off as fast as possible
+    const double gradient =
+        has_errors ? kMinGradient : std::clamp(settings_.rtt_tolerance * *long_rtt_ / short_rtt, kMinGradient, 1.0);
+    const bool overloaded = gradient < 1.0;
+
+    LOG_DEBUG() << "CC " << GetName() << " gradient:"
+                << " sensor=(" << current.ToLogString() << ") long_rtt=" << *long_rtt_ << " gradient=" << gradient;
+
+    if (!estimated_limit_) {
+        if (!overloaded) return {std::nullopt, current.current_load};
+
+        LOG_ERROR() << GetName() << " Congestion Control is activated";
+        estimated_limit_ = static_cast<double>(current.current_load);
+    }
+
+    auto& limit = *estimated_limit_;
+    const double previous_limit = limit;
+    const double new_limit = limit * gradient + std::sqrt(limit);
+    limit = limit * (1 - settings_.smoothing) + new_limit * settings_.smoothing;
+    limit = std::max(limit, static_cast<double>(config.min_limit));
+
+    // The load is capped by the previous limit, compare with it
+    if (!overloaded && previous_limit > static_cast<double>(current.current_load + config.safe_delta_limit)) {
+        LOG_ERROR() << GetName() << " Congestion Control is deactivated";
+        estimated_limit_.reset();
+        return {std::nullopt, current.current_load};
+    }
+
+    return {static_cast<std::size_t>(limit), current.current_load};
+}
+
+GradientController::Settings
+Parse(const yaml_config::YamlConfig& value, formats::parse::To<GradientController::Settings>) {
+    GradientController::Settings settings;
+    settings.smoothing = value["smoothing"].As<double>(settings.smoothing);
+    settings.rtt_tolerance = value["rtt-tolerance"].As<double>(settings.rtt_tolerance);
+    settings.long_window = value["long-window"].As<std::size_t>(settings.long_window);
+    return settings;
+}
+
+}  // namespace congestion_control::v2
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,124 @@
+#include <userver/utest/utest.hpp>
+
+#include <cmath>
+
+#include <userver/congestion_control/controllers/gradient.hpp>
+#include <userver/dynamic_config/test_helpers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class FakeSensor final : public congestion_control::v2::Sensor {
+    Data GetCurrent() override { return {}; }
+};
+
+class FakeLimiter final : public congestion_control::Limiter {
+    void SetLimit(const congestion_control::Limit&) override {}
+};
+
+congestion_control::v2::Stats stats;
+FakeSensor sensor;
+FakeLimiter limiter;
+
+congestion_control::v2::GradientController MakeController(
+    const congestion_control::v2::GradientController::Settings& settings = {}
+) {
+    return congestion_control::v2::GradientController(
+        "test", sensor, limiter, stats, {}, settings, dynamic_config::GetDefaultSource(), [](auto) {
+            return congestion_control::v2::Config();
+        }
+    );
+}
+
+congestion_control::v2::Sensor::Data MakeData(std::size_t timings_avg_ms, std::size_t current_load = 0) {
+    congestion_control::v2::Sensor::Data data;
+    data.timings_avg_ms = timings_avg_ms;
+    data.total = 100;
+    data.current_load = current_load;
+    return data;
+}
+
+void WarmUp(congestion_control::v2::GradientController& controller, std::size_t current_load) {
+    for (size_t i = 0; i < 31; i++) {
+        auto limit = controller.Update(MakeData(100, current_load));
+        EXPECT_EQ(limit.load_limit, std::nullopt) << i;
+    }
+}
+
+}  // namespace
+
+TEST(CCGradient, RttTolerance) {
+    auto controller = MakeController();
+    WarmUp(controller, 200);
+
+    // The timings are within rtt_tolerance of the long RTT. A queue of
+    // 40% of the load is not an overload
+    for (size_t i = 0; i < 10; i++) {
+        auto limit = controller.Update(MakeData(140, 200));
+        EXPECT_EQ(limit.load_limit, std::nullopt) << i;
+    }
+
+    auto limit = controller.Update(MakeData(200, 200));
+    ASSERT_NE(limit.load_limit, std::nullopt);
+    EXPECT_LT(*limit.load_limit, 200);
+}
+
+TEST(CCGradient, SqrtHeadroom) {
+    auto controller = MakeController();
+    WarmUp(controller, 100);
+
+    auto limit = controller.Update(MakeData(300, 100));
+    ASSERT_NE(limit.load_limit, std::nullopt);
+    EXPECT_LT(*limit.load_limit, 100);
+
+    // Back to the long RTT, the limit grows by the smoothed sqrt(limit)
+    // queue allowance rather than by a fixed step
+    for (size_t i = 0; i < 10; i++) {
+        const auto previous_limit = *limit.load_limit;
+        limit = controller.Update(MakeData(100, previous_limit));
+        ASSERT_NE(limit.load_limit, std::nullopt) << i;
+
+        const auto expected_limit = previous_limit + 0.2 * std::sqrt(previous_limit);
+        EXPECT_NEAR(*limit.load_limit, expected_limit, 1.0) << i;
+    }
+}
+
+TEST(CCGradient, LongWindowTracking) {
+    // The downstream became 3 times slower for good
+    const auto run = [](congestion_control::v2::GradientController& controller) {
+        WarmUp(controller, 200);
+
+        std::optional<std::size_t> load_limit = 200;
+        bool deactivated = false;
+        for (size_t i = 0; i < 50; i++) {
+            load_limit = controller.Update(MakeData(300, std::min<std::size_t>(load_limit.value_or(200), 200)))
+                             .load_limit;
+            deactivated |= !load_limit.has_value();
+        }
+        return deactivated;
+    };
+
+    // The long RTT catches up with the new timings within a few long windows
+    congestion_control::v2::GradientController::Settings settings;
+    settings.long_window = 10;
+    auto short_window_controller = MakeController(settings);
+    EXPECT_TRUE(run(short_window_controller));
+
+    auto long_window_controller = MakeController();
+    EXPECT_FALSE(run(long_window_controller));
+}
+
+TEST(CCGradient, Errors) {
+    auto controller = MakeController();
+    WarmUp(controller, 200);
+
+    auto data = MakeData(100, 200);
+    data.timeouts = 50;
+    auto limit = controller.Update(data);
+    ASSERT_NE(limit.load_limit, std::nullopt);
+    // The minimal gradient of 0.5 and the sqrt(200) allowance, smoothed
+    EXPECT_EQ(*limit.load_limit, 182);
+}
+
+USERVER_NAMESPACE_END
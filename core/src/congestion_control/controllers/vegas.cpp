@@ -0,0 +1,118 @@
+#include <userver/congestion_control/controllers/vegas.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <userver/logging/log.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::v2 {
+
+namespace {
+// First seconds of service life might be too noisy
+constexpr std::size_t kWarmupEpochs = 30;
+
+constexpr double kErrorsBackoffFactor = 0.9;
+}  // namespace
+
+VegasController::VegasController(
+    const std::string& name,
+    v2::Sensor& sensor,
+    Limiter& limiter,
+    Stats& stats,
+    const Controller::Config& config,
+    const Settings& settings,
+    dynamic_config::Source config_source,
+    std::function<v2::Config(const dynamic_config::Snapshot&)> config_getter
+)
+    : Controller(name, sensor, limiter, stats, config),
+      settings_(settings),
+      config_source_(config_source),
+      config_getter_(std::move(config_getter)) {}
+
+Limit VegasController::Update(const Sensor::Data& current) {
+    const v2::Config config = config_getter_(config_source_.GetSnapshot());
+
+    if (current.total < config.min_qps && !estimated_limit_) {
+        // Too little QPS, timings avg data is VERY noisy
+        return {std::nullopt, current.current_load};
+    }
+
+    // Do not react to the jitter of very small timings
+    const auto rtt = static_cast<double>(std::max<std::size_t>(current.timings_avg_ms, config.min_timings.count()));
+
+    if (epochs_passed_ < kWarmupEpochs) {
+        epochs_passed_++;
+        no_load_rtt_ = std::min(no_load_rtt_.value_or(rtt), rtt);
+        return {std::nullopt, current.current_load};
+    }
+
+    // Probing while the limit is applied would take the queueing delay for
+    // the new minimal timings
+    if (++epochs_since_probe_ >= settings_.probe_interval && !estimated_limit_) {
+        epochs_since_probe_ = 0;
+        no_load_rtt_ = rtt;
+    } else {
+        no_load_rtt_ = std::min(no_load_rtt_.value_or(rtt), rtt);
+    }
+
+    const auto min_limit = static_cast<double>(config.min_limit);
+    double limit = estimated_limit_.value_or(std::max(static_cast<double>(current.current_load), min_limit));
+    const double log_limit = std::max(1.0, std::log10(limit));
+    const double queue_size = limit * (1 - *no_load_rtt_ / rtt);
+
+    const bool has_errors = 100 * current.GetRate() > config.errors_threshold_percent;
+    const bool overloaded = has_errors || queue_size > settings_.beta * log_limit;
+
+    LOG_DEBUG() << "CC " << GetName() << " vegas:"
+                << " sensor=(" << current.ToLogString() << ") no_load_rtt=" << *no_load_rtt_
+                << " queue_size=" << queue_size;
+
+    if (!estimated_limit_) {
+        if (!overloaded) return {std::nullopt, current.current_load};
+        LOG_ERROR() << GetName() << " Congestion Control is activated";
+    }
+
+    double new_limit = limit;
+    if (has_errors) {
+        new_limit = limit * kErrorsBackoffFactor;
+    } else if (queue_size <= log_limit) {
+        new_limit = limit + settings_.beta * log_limit;
+    } else if (queue_size < settings_.alpha * log_limit) {
+        new_limit = limit + log_limit;
+    } else if (queue_size > settings_.beta * log_limit) {
+        // Unlike the per-request updates of TCP Vegas, an epoch update drops
+        // the whole excess of the queue at once
+        new_limit = limit - queue_size + settings_.beta * log_limit;
+    }
+
+    const double previous_limit = limit;
+    limit = limit * (1 - settings_.smoothing) + new_limit * settings_.smoothing;
+    limit = std::max(limit, min_limit);
+
+    // The load is capped by the previous limit, compare with it
+    if (!overloaded && previous_limit > static_cast<double>(current.current_load + config.safe_delta_limit)) {
+        LOG_ERROR() << GetName() << " Congestion Control is deactivated";
+        estimated_limit_.reset();
+        return {std::nullopt, current.current_load};
+    }
+
+    estimated_limit_ = limit;
+    return {static_cast<std::size_t>(limit), current.current_load};
+}
+
+VegasController::Settings Parse(const yaml_config::YamlConfig& value, formats::parse::To<VegasController::Settings>) {
+    VegasController::Settings settings;
+    settings.smoothing = value["smoothing"].As<double>(settings.smoothing);
+    settings.alpha = value["alpha"].As<double>(settings.alpha);
+    settings.beta = value["beta"].As<double>(settings.beta);
+    settings.probe_interval = value["probe-interval"].As<std::size_t>(settings.probe_interval);
+    return settings;
+}
+
+}  // namespace congestion_control::v2
+
+USERVER_NAMESPACE_END
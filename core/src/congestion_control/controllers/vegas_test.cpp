@@ -0,0 +1,120 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/congestion_control/controllers/vegas.hpp>
+#include <userver/dynamic_config/test_helpers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class FakeSensor final : public congestion_control::v2::Sensor {
+    Data GetCurrent() override { return {}; }
+};
+
+class FakeLimiter final : public congestion_control::Limiter {
+    void SetLimit(const congestion_control::Limit&) override {}
+};
+
+congestion_control::v2::Stats stats;
+FakeSensor sensor;
+FakeLimiter limiter;
+
+congestion_control::v2::VegasController MakeController(
+    const congestion_control::v2::VegasController::Settings& settings = {}
+) {
+    return congestion_control::v2::VegasController(
+        "test", sensor, limiter, stats, {}, settings, dynamic_config::GetDefaultSource(), [](auto) {
+            return congestion_control::v2::Config();
+        }
+    );
+}
+
+congestion_control::v2::Sensor::Data MakeData(std::size_t timings_avg_ms, std::size_t current_load = 0) {
+    congestion_control::v2::Sensor::Data data;
+    data.timings_avg_ms = timings_avg_ms;
+    data.total = 100;
+    data.current_load = current_load;
+    return data;
+}
+
+void WarmUp(congestion_control::v2::VegasController& controller, std::size_t current_load) {
+    for (size_t i = 0; i < 31; i++) {
+        auto limit = controller.Update(MakeData(100, current_load));
+        EXPECT_EQ(limit.load_limit, std::nullopt) << i;
+    }
+}
+
+}  // namespace
+
+TEST(CCVegas, QueueThresholds) {
+    auto controller = MakeController();
+    WarmUp(controller, 100);
+
+    // With the limit of 100, alpha * log10(limit) = 6 and
+    // beta * log10(limit) = 12 queued requests.
+
+    // ~9 queued requests, no overload
+    auto limit = controller.Update(MakeData(110, 100));
+    EXPECT_EQ(limit.load_limit, std::nullopt);
+
+    // ~17 queued requests, the excess over beta is dropped at once
+    limit = controller.Update(MakeData(120, 100));
+    ASSERT_NE(limit.load_limit, std::nullopt);
+    EXPECT_EQ(*limit.load_limit, 95);
+
+    // Between alpha and beta the limit is kept as is
+    for (size_t i = 0; i < 5; i++) {
+        limit = controller.Update(MakeData(110, *limit.load_limit));
+        ASSERT_NE(limit.load_limit, std::nullopt) << i;
+        EXPECT_EQ(*limit.load_limit, 95) << i;
+    }
+
+    // Up to log10(limit) queued requests, the limit grows by beta * log10(limit)
+    limit = controller.Update(MakeData(101, *limit.load_limit));
+    ASSERT_NE(limit.load_limit, std::nullopt);
+    EXPECT_EQ(*limit.load_limit, 107);
+
+    // Between log10(limit) and alpha, the limit grows by log10(limit)
+    limit = controller.Update(MakeData(105, *limit.load_limit));
+    ASSERT_NE(limit.load_limit, std::nullopt);
+    EXPECT_EQ(*limit.load_limit, 109);
+}
+
+TEST(CCVegas, ProbeRebaselining) {
+    // The downstream became 1.5 times slower for good, the small load does
+    // not queue enough to be an overload
+    const auto run = [](congestion_control::v2::VegasController& controller) {
+        WarmUp(controller, 10);
+        for (size_t i = 0; i < 10; i++) {
+            auto limit = controller.Update(MakeData(150, 10));
+            EXPECT_EQ(limit.load_limit, std::nullopt) << i;
+        }
+        return controller.Update(MakeData(160, 100)).load_limit;
+    };
+
+    // The probe takes the new timings for the no-load ones
+    congestion_control::v2::VegasController::Settings settings;
+    settings.probe_interval = 5;
+    auto probing_controller = MakeController(settings);
+    EXPECT_EQ(run(probing_controller), std::nullopt);
+
+    // Against the old no-load timings the load of 100 is an overload
+    settings.probe_interval = 1000;
+    auto non_probing_controller = MakeController(settings);
+    const auto limit = run(non_probing_controller);
+    ASSERT_NE(limit, std::nullopt);
+    EXPECT_LT(*limit, 100);
+}
+
+TEST(CCVegas, Errors) {
+    auto controller = MakeController();
+    WarmUp(controller, 200);
+
+    auto data = MakeData(100, 200);
+    data.timeouts = 50;
+    auto limit = controller.Update(data);
+    ASSERT_NE(limit.load_limit, std::nullopt);
+    EXPECT_EQ(*limit.load_limit, 180);
+}
+
+USERVER_NAMESPACE_END
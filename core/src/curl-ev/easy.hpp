@@ -216,6 +216,9 @@ public:
 
     const multi* GetMulti() const { return multi_; }
 
+    // Binds the easy to another multi, must not be called while performing
+    void RebindMulti(multi&);
+
     inline native::CURL* native_handle() { return handle_; }
     engine::ev::ThreadControl& GetThreadControl();
 
@@ -464,6 +467,7 @@ public:
         http_version_2_prior_knowledge = native::CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE,
     };
     IMPLEMENT_CURL_OPTION_ENUM(set_http_version, native::CURLOPT_HTTP_VERSION, http_version_t, long);
+    IMPLEMENT_CURL_OPTION_BOOLEAN(set_pipewait, native::CURLOPT_PIPEWAIT);
     IMPLEMENT_CURL_OPTION_BOOLEAN(set_ignore_content_length, native::CURLOPT_IGNORE_CONTENT_LENGTH);
     IMPLEMENT_CURL_OPTION_BOOLEAN(set_http_content_decoding, native::CURLOPT_HTTP_CONTENT_DECODING);
     IMPLEMENT_CURL_OPTION_BOOLEAN(set_http_transfer_decoding, native::CURLOPT_HTTP_TRANSFER_DECODING);
@@ -56,6 +56,9 @@ public:
     void SetMultiplexingEnabled(bool);
     void SetMaxHostConnections(long);
     void SetConnectionCacheSize(long);
+    void SetMaxTotalConnections(long);
+    // HTTP/2 streams per connection
+    void SetMaxConcurrentStreams(long);
 
 private:
     void add_handle(native::CURL* native_easy);
@@ -1,16 +1,29 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
 #include <boost/stacktrace/stacktrace.hpp>
+#include <array>
+#include <cstring>
 #include <exception>
 #include <memory>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
 #include <openssl/ssl.h>
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+#include <openssl/core_names.h>
+#else
+#include <openssl/hmac.h>
+#endif
 
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/crypto/openssl.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/rcu/rcu.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <crypto/helpers.hpp>
@@ -251,6 +264,259 @@ void AddCertAuthorities(SslCtx& ctx, const std::vector<crypto::Certificate>& cer
 
 }  // namespace
 
+class TlsSessionResumption::Impl final {
+public:
+    struct TicketKey {
+        std::array<unsigned char, 16> name{};
+        std::array<unsigned char, 32> hmac_key{};
+        std::array<unsigned char, 32> aes_key{};
+    };
+
+    explicit Impl(std::size_t cache_size) : cache_size_(cache_size), sessions_(std::max<std::size_t>(cache_size, 1)) {
+        SetTicketKeys({});
+    }
+
+    void SetTicketKeys(const std::vector<std::string>& keys) {
+        std::vector<TicketKey> new_keys;
+        new_keys.reserve(std::max<std::size_t>(keys.size(), 1));
+        for (const auto& key : keys) {
+            if (key.size() != kTicketKeySize) {
+                throw TlsException(
+                    fmt::format("Invalid TLS session ticket key size {}, expected {}", key.size(), kTicketKeySize)
+                );
+            }
+            auto& new_key = new_keys.emplace_back();
+            const auto* data = reinterpret_cast<const unsigned char*>(key.data());
+            std::memcpy(new_key.name.data(), data, new_key.name.size());
+            data += new_key.name.size();
+            std::memcpy(new_key.hmac_key.data(), data, new_key.hmac_key.size());
+            data += new_key.hmac_key.size();
+            std::memcpy(new_key.aes_key.data(), data, new_key.aes_key.size());
+        }
+
+        if (new_keys.empty()) {
+            crypto::Openssl::Init();
+            auto& new_key = new_keys.emplace_back();
+            if (1 != RAND_bytes(new_key.name.data(), new_key.name.size()) ||
+                1 != RAND_bytes(new_key.hmac_key.data(), new_key.hmac_key.size()) ||
+                1 != RAND_bytes(new_key.aes_key.data(), new_key.aes_key.size())) {
+                throw TlsException(crypto::FormatSslError("Failed to generate a TLS session ticket key: RAND_bytes"));
+            }
+        }
+
+        ticket_keys_.Assign(std::move(new_keys));
+    }
+
+    void SetUpServer(SSL_CTX* ctx) {
+        static constexpr std::string_view kSessionIdContext = "userver";
+
+        SSL_CTX_set_app_data(ctx, this);
+        if (1 != SSL_CTX_set_session_id_context(
+                     ctx, reinterpret_cast<const unsigned char*>(kSessionIdContext.data()), kSessionIdContext.size()
+                 )) {
+            throw TlsException(crypto::FormatSslError("Failed to set up server TLS wrapper: SSL_CTX_set_session_id_context"
+            ));
+        }
+        // OpenSSL cache would die with the per-connection context
+        SSL_CTX_set_session_cache_mode(
+            ctx, cache_size_ ? SSL_SESS_CACHE_SERVER | SSL_SESS_CACHE_NO_INTERNAL : SSL_SESS_CACHE_OFF
+        );
+        SSL_CTX_sess_set_new_cb(ctx, &NewSessionCallback);
+        SSL_CTX_sess_set_get_cb(ctx, &GetSessionCallback);
+        SSL_CTX_sess_set_remove_cb(ctx, &RemoveSessionCallback);
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+        const auto ticket_cb_ret = SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &TicketKeyCallback);
+#else
+        // cast in openssl1.x macro expansion
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        const auto ticket_cb_ret = SSL_CTX_set_tlsext_ticket_key_cb(ctx, &TicketKeyCallback);
+#endif
+        if (1 != ticket_cb_ret) {
+            throw TlsException(crypto::FormatSslError("Failed to set up server TLS wrapper: ticket key callback"));
+        }
+    }
+
+    void SetUpClient(SSL_CTX* ctx) {
+        SSL_CTX_set_app_data(ctx, this);
+        SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL);
+        // No remove callback: the client sessions are keyed by the server name
+        // rather than by the session id, a newer session of the server replaces
+        // the stale one
+        SSL_CTX_sess_set_new_cb(ctx, &NewSessionCallback);
+    }
+
+    void SetClientSession(SSL* ssl, const std::string& server_name) {
+        std::string serialized;
+        {
+            auto sessions = sessions_.Lock();
+            serialized = sessions->GetOr(MakeClientSessionKey(server_name), {});
+        }
+        if (serialized.empty()) return;
+
+        const auto* data = reinterpret_cast<const unsigned char*>(serialized.data());
+        SSL_SESSION* session = d2i_SSL_SESSION(nullptr, &data, serialized.size());
+        if (!session) return;
+        // a stale session only makes the server do the full handshake
+        SSL_set_session(ssl, session);
+        SSL_SESSION_free(session);
+    }
+
+private:
+    static Impl& FromSsl(SSL* ssl) noexcept {
+        auto* impl = static_cast<Impl*>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl)));
+        UASSERT(impl);
+        return *impl;
+    }
+
+    // The server and the client sessions may share the cache, the prefix keeps
+    // the server names apart from the binary session ids
+    static std::string MakeClientSessionKey(std::string_view server_name) {
+        return fmt::format("client:{}", server_name);
+    }
+
+    static std::string GetSessionKey(SSL* ssl, SSL_SESSION* session) {
+        if (!SSL_is_server(ssl)) {
+            const char* server_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+            return MakeClientSessionKey(server_name ? server_name : "");
+        }
+
+        unsigned int id_size = 0;
+        const unsigned char* id = SSL_SESSION_get_id(session, &id_size);
+        return std::string(reinterpret_cast<const char*>(id), id_size);
+    }
+
+    static int NewSessionCallback(SSL* ssl, SSL_SESSION* session) noexcept {
+        try {
+            const int size = i2d_SSL_SESSION(session, nullptr);
+            if (size <= 0) return 0;
+            std::string serialized(size, '\0');
+            auto* data = reinterpret_cast<unsigned char*>(serialized.data());
+            if (i2d_SSL_SESSION(session, &data) != size) return 0;
+
+            auto key = GetSessionKey(ssl, session);
+            auto sessions = FromSsl(ssl).sessions_.Lock();
+            sessions->Put(key, std::move(serialized));
+        } catch (const std::exception& ex) {
+            LOG_LIMITED_WARNING() << "Failed to store a TLS session: " << ex;
+        }
+        // the session is serialized, no reference is kept
+        return 0;
+    }
+
+#if OPENSSL_VERSION_NUMBER >= 0x010100000L
+    using SessionId = const unsigned char*;
+#else
+    using SessionId = unsigned char*;
+#endif
+
+    static SSL_SESSION* GetSessionCallback(SSL* ssl, SessionId id, int id_size, int* copy) noexcept {
+        *copy = 0;
+        try {
+            const std::string key(reinterpret_cast<const char*>(id), static_cast<std::size_t>(id_size));
+            std::string serialized;
+            {
+                auto sessions = FromSsl(ssl).sessions_.Lock();
+                serialized = sessions->GetOr(key, {});
+            }
+            if (serialized.empty()) return nullptr;
+
+            const auto* data = reinterpret_cast<const unsigned char*>(serialized.data());
+            return d2i_SSL_SESSION(nullptr, &data, serialized.size());
+        } catch (const std::exception& ex) {
+            LOG_LIMITED_WARNING() << "Failed to load a TLS session: " << ex;
+            return nullptr;
+        }
+    }
+
+    // Server contexts only, the key is the session id
+    static void RemoveSessionCallback(SSL_CTX* ctx, SSL_SESSION* session) noexcept {
+        auto* impl = static_cast<Impl*>(SSL_CTX_get_app_data(ctx));
+        UASSERT(impl);
+
+        unsigned int id_size = 0;
+        const unsigned char* id = SSL_SESSION_get_id(session, &id_size);
+        try {
+            const std::string key(reinterpret_cast<const char*>(id), id_size);
+            auto sessions = impl->sessions_.Lock();
+            sessions->Erase(key);
+        } catch (const std::exception& ex) {
+            LOG_LIMITED_WARNING() << "Failed to remove a TLS session: " << ex;
+        }
+    }
+
+#if OPENSSL_VERSION_NUMBER >= 0x030000000L
+    using TicketMacCtx = EVP_MAC_CTX;
+
+    static bool InitTicketMac(EVP_MAC_CTX* mac_ctx, const TicketKey& key) noexcept {
+        char digest[] = "SHA256";
+        const OSSL_PARAM params[] = {
+            OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, digest, 0),
+            OSSL_PARAM_construct_end(),
+        };
+        return 1 == EVP_MAC_init(mac_ctx, key.hmac_key.data(), key.hmac_key.size(), params);
+    }
+#else
+    using TicketMacCtx = HMAC_CTX;
+
+    static bool InitTicketMac(HMAC_CTX* mac_ctx, const TicketKey& key) noexcept {
+        return 1 == HMAC_Init_ex(mac_ctx, key.hmac_key.data(), key.hmac_key.size(), EVP_sha256(), nullptr);
+    }
+#endif
+
+    // Returns 1 on success, 2 to renew the ticket of an old key, 0 to do the
+    // full handshake and -1 on errors
+    static int TicketKeyCallback(
+        SSL* ssl,
+        unsigned char* key_name,
+        unsigned char* iv,
+        EVP_CIPHER_CTX* cipher_ctx,
+        TicketMacCtx* mac_ctx,
+        int encrypt
+    ) noexcept {
+        try {
+            auto& impl = FromSsl(ssl);
+            const auto keys = impl.ticket_keys_.Read();
+            UASSERT(!keys->empty());
+
+            if (encrypt) {
+                const auto& key = keys->front();
+                if (1 != RAND_bytes(iv, EVP_CIPHER_iv_length(EVP_aes_256_cbc()))) return -1;
+                if (1 != EVP_EncryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, key.aes_key.data(), iv)) {
+                    return -1;
+                }
+                if (!InitTicketMac(mac_ctx, key)) return -1;
+                std::memcpy(key_name, key.name.data(), key.name.size());
+                return 1;
+            }
+
+            for (auto it = keys->begin(); it != keys->end(); ++it) {
+                if (0 != std::memcmp(key_name, it->name.data(), it->name.size())) continue;
+
+                if (!InitTicketMac(mac_ctx, *it)) return -1;
+                if (1 != EVP_DecryptInit_ex(cipher_ctx, EVP_aes_256_cbc(), nullptr, it->aes_key.data(), iv)) {
+                    return -1;
+                }
+                return it == keys->begin() ? 1 : 2;
+            }
+            return 0;
+        } catch (const std::exception& ex) {
+            LOG_LIMITED_WARNING() << "Failed to process a TLS session ticket: " << ex;
+            return -1;
+        }
+    }
+
+    const std::size_t cache_size_;
+    rcu::Variable<std::vector<TicketKey>> ticket_keys_;
+    // session id (server) or server name (client) -> serialized session
+    concurrent::Variable<cache::LruMap<std::string, std::string>> sessions_;
+};
+
+TlsSessionResumption::TlsSessionResumption(std::size_t cache_size) : impl_(std::make_unique<Impl>(cache_size)) {}
+
+TlsSessionResumption::~TlsSessionResumption() = default;
+
+void TlsSessionResumption::SetTicketKeys(const std::vector<std::string>& keys) { impl_->SetTicketKeys(keys); }
+
 class TlsWrapper::ReadContextAccessor final : public engine::impl::ContextAccessor {
 public:
     explicit ReadContextAccessor(TlsWrapper::Impl& impl);
@@ -278,20 +544,16 @@ public:
         : bio_data(std::move(other.bio_data)),
           ssl(std::move(other.ssl)),
           read_accessor(*this),
-          is_in_shutdown(other.is_in_shutdown) {
+          is_in_shutdown(other.is_in_shutdown),
+          uses_kernel_bio(other.uses_kernel_bio) {
         UASSERT(ssl);
         UASSERT(SSL_get_rbio(ssl.get()) == SSL_get_wbio(ssl.get()));
-        SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+        // The socket BIO knows only the fd which stays the same
+        if (!uses_kernel_bio) SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
     }
 
-    void SetUp(SslCtx&& ssl_ctx) {
-        Bio socket_bio{BIO_new(GetSocketBioMethod())};
-        if (!socket_bio) {
-            throw TlsException(crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
-        }
-        BIO_set_shutdown(socket_bio.get(), 0);
-        SyncBioData(socket_bio.get(), nullptr);
-        BIO_set_init(socket_bio.get(), 1);
+    void SetUp(SslCtx&& ssl_ctx, TlsOffload offload) {
+        Bio socket_bio = MakeBio(offload);
 
         ssl.reset(SSL_new(ssl_ctx.get()));
         if (!ssl) {
@@ -299,11 +561,64 @@ public:
         }
 #if OPENSSL_VERSION_NUMBER < 0x010100000L
         ssl->s3->flags |= SSL3_FLAGS_NO_RENEGOTIATE_CIPHERS;
+#endif
+#ifdef SSL_OP_ENABLE_KTLS
+        if (uses_kernel_bio) SSL_set_options(ssl.get(), SSL_OP_ENABLE_KTLS);
 #endif
         SSL_set_bio(ssl.get(), socket_bio.get(), socket_bio.get());
         [[maybe_unused]] const auto* disowned_bio = socket_bio.release();
     }
 
+    template <typename SslHandshakeFunc>
+    void Handshake(SslHandshakeFunc&& handshake_func, Deadline deadline, const char* context) {
+        bio_data.current_deadline = deadline;
+
+        while (true) {
+            const auto ret = handshake_func(ssl.get());
+            if (1 == ret) break;
+
+            const int ssl_error = SSL_get_error(ssl.get(), ret);
+            if (WaitKernelBio(ssl_error, 0, context)) continue;
+
+            if (bio_data.last_exception) {
+                std::rethrow_exception(bio_data.last_exception);
+            }
+
+            throw TlsException(crypto::FormatSslError(fmt::format("Failed to set up {} ({})", context, ssl_error)));
+        }
+
+#ifdef SSL_OP_ENABLE_KTLS
+        if (uses_kernel_bio) {
+            LOG_DEBUG() << "Kernel TLS offload for fd " << bio_data.socket.Fd()
+                        << ": send=" << BIO_get_ktls_send(SSL_get_wbio(ssl.get()))
+                        << ", recv=" << BIO_get_ktls_recv(SSL_get_rbio(ssl.get()));
+        }
+#endif
+    }
+
+    // OpenSSL reports the non-blocking kernel BIO as not ready instead of
+    // waiting for the socket, returns whether the operation should be retried
+    bool WaitKernelBio(int ssl_error, std::size_t bytes_transferred, const char* context) {
+        if (!uses_kernel_bio) return false;
+
+        bool is_ready = false;
+        if (ssl_error == SSL_ERROR_WANT_READ) {
+            is_ready = bio_data.socket.WaitReadable(bio_data.current_deadline);
+        } else if (ssl_error == SSL_ERROR_WANT_WRITE) {
+            is_ready = bio_data.socket.WaitWriteable(bio_data.current_deadline);
+        } else {
+            return false;
+        }
+
+        if (!is_ready) {
+            if (current_task::ShouldCancel()) {
+                throw IoCancelled(bytes_transferred) << context;
+            }
+            throw IoTimeout(bytes_transferred) << context;
+        }
+        return true;
+    }
+
     void ClientConnect(const std::string& server_name, Deadline deadline) {
         if (!server_name.empty()) {
             // cast in openssl1.0 macro expansion
@@ -315,18 +630,7 @@ public:
             }
         }
 
-        bio_data.current_deadline = deadline;
-
-        auto ret = SSL_connect(ssl.get());
-        if (1 != ret) {
-            if (bio_data.last_exception) {
-                std::rethrow_exception(bio_data.last_exception);
-            }
-
-            throw TlsException(crypto::FormatSslError(
-                fmt::format("Failed to set up client TLS wrapper ({})", SSL_get_error(ssl.get(), ret))
-            ));
-        }
+        Handshake(&SSL_connect, deadline, "client TLS wrapper");
     }
 
     template <typename SslIoFunc>
@@ -368,6 +672,12 @@ public:
                 }
             } else {
                 ssl_error = SSL_get_error(ssl.get(), io_ret);
+                try {
+                    if (WaitKernelBio(ssl_error, pos - begin, context)) continue;
+                } catch (const IoInterrupted&) {
+                    if (interrupt_action == InterruptAction::kFail) ssl.reset();
+                    throw;
+                }
                 switch (ssl_error) {
                     // timeout, cancel, EOF, or just a spurious wakeup
                     case SSL_ERROR_WANT_READ:
@@ -413,9 +723,35 @@ public:
     Ssl ssl;
     ReadContextAccessor read_accessor;
     bool is_in_shutdown{false};
+    // plain OpenSSL socket BIO that is able to enable kernel TLS
+    bool uses_kernel_bio{false};
     std::atomic<int> ssl_usage_level{0};
 
 private:
+    Bio MakeBio(TlsOffload offload) {
+        if (offload == TlsOffload::kKernel) {
+#ifdef SSL_OP_ENABLE_KTLS
+            Bio kernel_bio{BIO_new_socket(bio_data.socket.Fd(), BIO_NOCLOSE)};
+            if (!kernel_bio) {
+                throw TlsException(crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new_socket"));
+            }
+            uses_kernel_bio = true;
+            return kernel_bio;
+#else
+            LOG_LIMITED_WARNING() << "Kernel TLS offload is not supported by the OpenSSL, encrypting in user space";
+#endif
+        }
+
+        Bio socket_bio{BIO_new(GetSocketBioMethod())};
+        if (!socket_bio) {
+            throw TlsException(crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
+        }
+        BIO_set_shutdown(socket_bio.get(), 0);
+        SyncBioData(socket_bio.get(), nullptr);
+        BIO_set_init(socket_bio.get(), 1);
+        return socket_bio;
+    }
+
     void SyncBioData(BIO* bio, [[maybe_unused]] SocketBioData* old_data) noexcept {
         UASSERT(BIO_get_data(bio) == old_data);
         BIO_set_data(bio, &bio_data);
@@ -453,12 +789,20 @@ engine::impl::ContextAccessor& TlsWrapper::ReadContextAccessor::GetSocketContext
 
 TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) { SetupContextAccessors(); }
 
-TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket, const std::string& server_name, Deadline deadline) {
+TlsWrapper TlsWrapper::StartTlsClient(
+    Socket&& socket,
+    const std::string& server_name,
+    Deadline deadline,
+    TlsOffload offload,
+    TlsSessionResumption* session_resumption
+) {
     auto ssl_ctx = MakeSslCtx();
     SetServerName(ssl_ctx, server_name);
+    if (session_resumption) session_resumption->impl_->SetUpClient(ssl_ctx.get());
 
     TlsWrapper wrapper{std::move(socket)};
-    wrapper.impl_->SetUp(std::move(ssl_ctx));
+    wrapper.impl_->SetUp(std::move(ssl_ctx), offload);
+    if (session_resumption) session_resumption->impl_->SetClientSession(wrapper.impl_->ssl.get(), server_name);
     wrapper.impl_->ClientConnect(server_name, deadline);
     return wrapper;
 }
@@ -469,7 +813,8 @@ TlsWrapper TlsWrapper::StartTlsClient(
     const crypto::Certificate& cert,
     const crypto::PrivateKey& key,
     Deadline deadline,
-    const std::vector<crypto::Certificate>& extra_cert_authorities
+    const std::vector<crypto::Certificate>& extra_cert_authorities,
+    TlsOffload offload
 ) {
     auto ssl_ctx = MakeSslCtx();
     SetServerName(ssl_ctx, server_name);
@@ -491,7 +836,7 @@ TlsWrapper TlsWrapper::StartTlsClient(
     }
 
     TlsWrapper wrapper{std::move(socket)};
-    wrapper.impl_->SetUp(std::move(ssl_ctx));
+    wrapper.impl_->SetUp(std::move(ssl_ctx), offload);
     wrapper.impl_->ClientConnect(server_name, deadline);
     return wrapper;
 }
@@ -501,7 +846,9 @@ TlsWrapper TlsWrapper::StartTlsServer(
     const crypto::Certificate& cert,
     const crypto::PrivateKey& key,
     Deadline deadline,
-    const std::vector<crypto::Certificate>& extra_cert_authorities
+    const std::vector<crypto::Certificate>& extra_cert_authorities,
+    TlsOffload offload,
+    TlsSessionResumption* session_resumption
 ) {
     auto ssl_ctx = MakeSslCtx();
 
@@ -521,20 +868,11 @@ TlsWrapper TlsWrapper::StartTlsServer(
         throw TlsException(crypto::FormatSslError("Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
     }
 
-    TlsWrapper wrapper{std::move(socket)};
-    wrapper.impl_->SetUp(std::move(ssl_ctx));
-    wrapper.impl_->bio_data.current_deadline = deadline;
+    if (session_resumption) session_resumption->impl_->SetUpServer(ssl_ctx.get());
 
-    auto ret = SSL_accept(wrapper.impl_->ssl.get());
-    if (1 != ret) {
-        if (wrapper.impl_->bio_data.last_exception) {
-            std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-        }
-
-        throw TlsException(crypto::FormatSslError(
-            fmt::format("Failed to set up server TLS wrapper ({})", SSL_get_error(wrapper.impl_->ssl.get(), ret))
-        ));
-    }
+    TlsWrapper wrapper{std::move(socket)};
+    wrapper.impl_->SetUp(std::move(ssl_ctx), offload);
+    wrapper.impl_->Handshake(&SSL_accept, deadline, "server TLS wrapper");
 
     UASSERT(wrapper.impl_->ssl);
     return wrapper;
@@ -602,13 +940,18 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
 }
 
 [[nodiscard]] size_t TlsWrapper::WriteAll(std::initializer_list<IoData> list, Deadline deadline) {
+    return WriteAll(list.begin(), list.size(), deadline);
+}
+
+[[nodiscard]] size_t TlsWrapper::WriteAll(const IoData* list, std::size_t list_size, Deadline deadline) {
     static constexpr std::size_t kBufSize = 4'096;
     std::byte buf[kBufSize];
 
     std::size_t sent_bytes = 0;
     std::size_t remaining_cap = kBufSize;
-    auto fits_in_buf_begin = list.begin();
-    for (auto it = fits_in_buf_begin; it != list.end(); ++it) {
+    const auto* const list_end = list + list_size;
+    auto fits_in_buf_begin = list;
+    for (auto it = fits_in_buf_begin; it != list_end; ++it) {
         if (it->len > remaining_cap) {
             if (it - fits_in_buf_begin >= 2) {
                 for (auto* ins_pos = buf; fits_in_buf_begin != it; ++fits_in_buf_begin) {
@@ -636,7 +979,7 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
     }
 
     auto ins_pos = buf;
-    for (auto ins_it = fits_in_buf_begin; ins_it != list.end(); ++ins_it) {
+    for (auto ins_it = fits_in_buf_begin; ins_it != list_end; ++ins_it) {
         ins_pos = std::copy_n(static_cast<const std::byte*>(ins_it->data), ins_it->len, ins_pos);
     }
     sent_bytes += SendAll(buf, kBufSize - remaining_cap, deadline);
@@ -646,6 +989,9 @@ size_t TlsWrapper::SendAll(const void* buf, size_t len, Deadline deadline) {
 
 Socket TlsWrapper::StopTls(Deadline deadline) {
     if (impl_->ssl) {
+        if (IsKernelTlsSendActive() || IsKernelTlsRecvActive()) {
+            throw TlsException("Cannot stop TLS with kernel TLS offload active");
+        }
         impl_->is_in_shutdown = true;
         impl_->bio_data.current_deadline = deadline;
         int shutdown_ret = 0;
@@ -653,6 +999,7 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
             shutdown_ret = SSL_shutdown(impl_->ssl.get());
             if (shutdown_ret < 0) {
                 const int ssl_error = SSL_get_error(impl_->ssl.get(), shutdown_ret);
+                if (impl_->WaitKernelBio(ssl_error, 0, "StopTls")) continue;
                 switch (ssl_error) {
                     // this is fine
                     case SSL_ERROR_WANT_READ:
@@ -680,6 +1027,24 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
     return std::move(impl_->bio_data.socket);
 }
 
+bool TlsWrapper::IsKernelTlsSendActive() const {
+#ifdef SSL_OP_ENABLE_KTLS
+    return impl_->ssl && impl_->uses_kernel_bio && BIO_get_ktls_send(SSL_get_wbio(impl_->ssl.get()));
+#else
+    return false;
+#endif
+}
+
+bool TlsWrapper::IsKernelTlsRecvActive() const {
+#ifdef SSL_OP_ENABLE_KTLS
+    return impl_->ssl && impl_->uses_kernel_bio && BIO_get_ktls_recv(SSL_get_rbio(impl_->ssl.get()));
+#else
+    return false;
+#endif
+}
+
+bool TlsWrapper::IsSessionReused() const { return impl_->ssl && SSL_session_reused(impl_->ssl.get()); }
+
 int TlsWrapper::GetRawFd() { return impl_->bio_data.socket.Fd(); }
 
 }  // namespace engine::io
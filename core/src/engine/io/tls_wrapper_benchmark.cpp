@@ -3,6 +3,7 @@
 #include <openssl/opensslv.h>
 #include <sys/socket.h>
 
+#include <optional>
 #include <stdexcept>
 #include <string_view>
 #include <vector>
@@ -175,4 +176,106 @@ BENCHMARK(tls_write_all_buffered)->RangeMultiplier(2)->Range(1 << 6, 1 << 12)->U
 
 BENCHMARK(tls_write_all_default)->RangeMultiplier(2)->Range(1 << 6, 1 << 12)->Unit(benchmark::kNanosecond);
 
+// Bulk transfer with and without kernel TLS offload. Without kernel support
+// both variants encrypt in user space and show the same numbers.
+[[maybe_unused]] void tls_bulk_transfer(benchmark::State& state) {
+    const auto offload = state.range(1) ? io::TlsOffload::kKernel : io::TlsOffload::kNone;
+
+    engine::RunStandalone(2, [&]() {
+        const auto deadline = Deadline::FromDuration(kDeadlineMaxTime);
+
+        TcpListener tcp_listener;
+        auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+
+        auto server_task = engine::AsyncNoSpan(
+            [deadline, offload](auto&& server) {
+                auto tls_server = io::TlsWrapper::StartTlsServer(
+                    std::forward<decltype(server)>(server),
+                    crypto::Certificate::LoadFromString(cert),
+                    crypto::PrivateKey::LoadFromString(key),
+                    deadline,
+                    {},
+                    offload
+                );
+
+                std::vector<std::byte> buf(1 << 20);
+                while (tls_server.RecvSome(buf.data(), buf.size(), deadline) > 0) {
+                    /* receiving msgs */
+                }
+            },
+            std::move(server)
+        );
+
+        const std::string payload(state.range(0), 'x');
+        auto tls_client =
+            std::make_optional(io::TlsWrapper::StartTlsClient(std::move(client), {}, deadline, offload));
+        state.counters["kernel_tls"] = tls_client->IsKernelTlsSendActive();
+
+        for ([[maybe_unused]] auto _ : state) {
+            auto send_bytes = tls_client->SendAll(payload.data(), payload.size(), deadline);
+            benchmark::DoNotOptimize(send_bytes);
+        }
+        state.SetBytesProcessed(state.iterations() * payload.size());
+
+        // sends close_notify to stop the server
+        tls_client.reset();
+        server_task.Get();
+    });
+}
+
+BENCHMARK(tls_bulk_transfer)
+    ->ArgsProduct({{1 << 14, 1 << 20}, {0, 1}})
+    ->ArgNames({"size", "kernel_tls"})
+    ->Unit(benchmark::kMicrosecond);
+
+// Full handshakes against the resumed ones, counting the TCP connection setup
+[[maybe_unused]] void tls_handshake(benchmark::State& state) {
+    const bool resume = state.range(0);
+
+    engine::RunStandalone(2, [&]() {
+        const auto deadline = Deadline::FromDuration(kDeadlineMaxTime);
+        const auto server_cert = crypto::Certificate::LoadFromString(cert);
+        const auto server_key = crypto::PrivateKey::LoadFromString(key);
+
+        io::TlsSessionResumption server_resumption{1024};
+        io::TlsSessionResumption client_resumption{1};
+        auto* server_resumption_ptr = resume ? &server_resumption : nullptr;
+        auto* client_resumption_ptr = resume ? &client_resumption : nullptr;
+
+        TcpListener tcp_listener;
+        std::size_t resumed = 0;
+        for ([[maybe_unused]] auto _ : state) {
+            auto [server, client] = tcp_listener.MakeSocketPair(deadline);
+            auto server_task = engine::AsyncNoSpan(
+                [&, deadline](auto&& server) {
+                    auto tls_server = io::TlsWrapper::StartTlsServer(
+                        std::forward<decltype(server)>(server),
+                        server_cert,
+                        server_key,
+                        deadline,
+                        {},
+                        io::TlsOffload::kNone,
+                        server_resumption_ptr
+                    );
+                    [[maybe_unused]] auto sent_bytes = tls_server.SendAll("1", 1, deadline);
+                },
+                std::move(server)
+            );
+
+            auto tls_client = io::TlsWrapper::StartTlsClient(
+                std::move(client), {}, deadline, io::TlsOffload::kNone, client_resumption_ptr
+            );
+            // receives the session tickets along with the data
+            char c = 0;
+            benchmark::DoNotOptimize(tls_client.RecvAll(&c, 1, deadline));
+            resumed += tls_client.IsSessionReused();
+            server_task.Get();
+        }
+        state.counters["resumed"] = benchmark::Counter(resumed, benchmark::Counter::kAvgIterations);
+        state.counters["handshakes"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+    });
+}
+
+BENCHMARK(tls_handshake)->Arg(0)->Arg(1)->ArgName("resumption")->Unit(benchmark::kMicrosecond);
+
 USERVER_NAMESPACE_END
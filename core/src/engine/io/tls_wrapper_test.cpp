@@ -441,6 +441,108 @@ UTEST_MT(TlsWrapper, IoTimeout, 2) {
     server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, KernelOffload, 2) {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    TcpListener tcp_listener;
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+    // Falls back to the user space encryption if the kernel has no TLS support,
+    // the data must get through in both cases
+    const std::string payload(1 << 20, 'x');
+    engine::SingleConsumerEvent timeout_happened;
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline, &payload, &timeout_happened](auto&& server) {
+            auto tls_server = io::TlsWrapper::StartTlsServer(
+                std::forward<decltype(server)>(server),
+                crypto::Certificate::LoadFromString(cert),
+                crypto::PrivateKey::LoadFromString(key),
+                test_deadline,
+                {},
+                io::TlsOffload::kKernel
+            );
+            EXPECT_EQ(payload.size(), tls_server.SendAll(payload.data(), payload.size(), test_deadline));
+            char c = 0;
+            EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+            EXPECT_EQ('2', c);
+            // close_notify from ~TlsWrapper would end the client read before its timeout
+            ASSERT_TRUE(timeout_happened.WaitForEventUntil(test_deadline));
+            if (tls_server.IsKernelTlsSendActive() || tls_server.IsKernelTlsRecvActive()) {
+                UEXPECT_THROW(static_cast<void>(tls_server.StopTls(test_deadline)), io::TlsException);
+            }
+        },
+        std::move(server)
+    );
+
+    auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline, io::TlsOffload::kKernel);
+    std::string received(payload.size(), '\0');
+    EXPECT_EQ(payload.size(), tls_client.RecvAll(received.data(), received.size(), test_deadline));
+    EXPECT_EQ(payload, received);
+    EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+
+    char c = 0;
+    UEXPECT_THROW(
+        static_cast<void>(tls_client.RecvSome(&c, 1, Deadline::FromDuration(kShortTimeout))), io::IoTimeout
+    );
+    timeout_happened.Send();
+
+    server_task.Get();
+}
+
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+    const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    io::TlsSessionResumption server_resumption{16};
+    io::TlsSessionResumption client_resumption{16};
+    TcpListener tcp_listener;
+
+    const auto connect = [&] {
+        auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+        auto server_task = engine::AsyncNoSpan(
+            [test_deadline, &server_resumption](auto&& server) {
+                auto tls_server = io::TlsWrapper::StartTlsServer(
+                    std::forward<decltype(server)>(server),
+                    crypto::Certificate::LoadFromString(cert),
+                    crypto::PrivateKey::LoadFromString(key),
+                    test_deadline,
+                    {},
+                    io::TlsOffload::kNone,
+                    &server_resumption
+                );
+                EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+                return tls_server.IsSessionReused();
+            },
+            std::move(server)
+        );
+
+        auto tls_client = io::TlsWrapper::StartTlsClient(
+            std::move(client), {}, test_deadline, io::TlsOffload::kNone, &client_resumption
+        );
+        // TLS 1.3 session tickets arrive after the handshake
+        char c = 0;
+        EXPECT_EQ(1, tls_client.RecvAll(&c, 1, test_deadline));
+
+        const bool is_server_reused = server_task.Get();
+        EXPECT_EQ(is_server_reused, tls_client.IsSessionReused());
+        return is_server_reused;
+    };
+
+    const auto make_key = [](char c) { return std::string(io::TlsSessionResumption::kTicketKeySize, c); };
+    server_resumption.SetTicketKeys({make_key('a')});
+    EXPECT_FALSE(connect());
+    EXPECT_TRUE(connect());
+
+    // tickets of the previous key are still accepted after the rotation
+    server_resumption.SetTicketKeys({make_key('b'), make_key('a')});
+    EXPECT_TRUE(connect());
+
+    server_resumption.SetTicketKeys({make_key('c')});
+    EXPECT_FALSE(connect());
+    EXPECT_TRUE(connect());
+
+    UEXPECT_THROW(server_resumption.SetTicketKeys({"short"}), io::TlsException);
+}
+
 UTEST(TlsWrapper, Cancel) {
     const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
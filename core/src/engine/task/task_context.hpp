@@ -94,6 +94,10 @@ public:
 
     Task::State GetState() const { return state_; }
 
+    // whether the task has ever been run, must only be called from the thread
+    // that is going to run its next step
+    bool HasStarted() const noexcept { return static_cast<bool>(coro_); }
+
     // whether this task is the one currently executing on the calling thread
     bool IsCurrent() const noexcept;
 
@@ -180,6 +180,8 @@ std::size_t TaskProcessor::GetTaskQueueSize() const {
 
 void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
     sensor_task_queue_wait_time_ = settings.sensor_wait_queue_time_limit;
+    codel_target_ = settings.wait_queue_codel_target;
+    codel_interval_ = settings.wait_queue_codel_interval;
 
     // We store the overload action and limit in a single atomic, to avoid races
     // on {kIgnore, 10} transitions to {kCancel, 10000}, when the limit is taken
@@ -326,20 +328,29 @@ void TaskProcessor::ProcessTasks() noexcept {
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     const auto [action, max_wait_time] = GetOverloadActionAndValue(action_bit_and_max_task_queue_wait_time_);
     const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
+    const auto codel_target = codel_target_.load();
 
-    if (max_wait_time.count() == 0 && sensor_wait_time.count() == 0) {
+    if (max_wait_time.count() == 0 && sensor_wait_time.count() == 0 && codel_target.count() == 0) {
         SetTaskQueueWaitTimeOverloaded(false);
         return;
     }
 
+    bool shed_by_codel = false;
     const auto wait_timepoint = context.GetQueueWaitTimepoint();
     if (wait_timepoint != std::chrono::steady_clock::time_point()) {
-        const auto wait_time = std::chrono::steady_clock::now() - wait_timepoint;
+        const auto now = std::chrono::steady_clock::now();
+        const auto wait_time = now - wait_timepoint;
         const auto wait_time_us = std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
         LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
 
         SetTaskQueueWaitTimeOverloaded(max_wait_time.count() && wait_time >= max_wait_time);
 
+        // Resumed tasks have already done some work, shedding them would waste
+        // it. Leave them to the `time_limit_us` check above.
+        if (codel_target.count() && context.GetState() == Task::State::kQueued && !context.HasStarted()) {
+            shed_by_codel = IsOverloadedByCodel(now, wait_time_us, codel_target);
+        }
+
         if (sensor_wait_time.count() && wait_time >= sensor_wait_time) {
             GetTaskCounter().AccountTaskOverloadSensor();
         } else {
@@ -351,7 +362,7 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     }
 
     // Don't cancel critical tasks, but use their timestamp to cancel other tasks
-    if (overloaded_cache_->overloaded_by_wait_time.load()) {
+    if (shed_by_codel || overloaded_cache_->overloaded_by_wait_time.load()) {
         HandleOverload(context, action);
     }
 }
@@ -386,6 +397,45 @@ void TaskProcessor::HandleOverload(impl::TaskContext& context, TaskProcessorSett
     }
 }
 
+bool TaskProcessor::IsOverloadedByCodel(
+    std::chrono::steady_clock::time_point now,
+    std::chrono::microseconds wait_time,
+    std::chrono::microseconds target
+) noexcept {
+    auto& state = *codel_state_;
+
+    const auto now_us = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+    auto interval_end = state.interval_end.load(std::memory_order_relaxed);
+    if (now_us >= interval_end &&
+        state.interval_end.compare_exchange_strong(
+            interval_end, now_us + codel_interval_.load().count(), std::memory_order_relaxed
+        )) {
+        // Only the thread that started the new interval gets here. If even
+        // the shortest wait of the whole interval was too long, the queue is
+        // a standing one rather than a burst.
+        const auto interval_min_wait_time = state.min_wait_time.exchange(kNoCodelWaitTime, std::memory_order_relaxed);
+        const bool overloaded = interval_min_wait_time != kNoCodelWaitTime && interval_min_wait_time > target.count();
+        if (state.overloaded.exchange(overloaded, std::memory_order_relaxed) != overloaded) {
+            if (overloaded) {
+                LOG_WARNING() << "Task processor " << Name() << " has a standing queue, minimal wait in queue time="
+                              << interval_min_wait_time << "us > codel_target_us=" << target.count()
+                              << "us, shedding the tasks that waited longer than the target";
+            } else {
+                LOG_WARNING() << "Task processor " << Name() << " has no standing queue anymore";
+            }
+        }
+    }
+
+    auto min_wait_time = state.min_wait_time.load(std::memory_order_relaxed);
+    while (wait_time.count() < min_wait_time &&
+           !state.min_wait_time.compare_exchange_weak(min_wait_time, wait_time.count(), std::memory_order_relaxed)) {
+    }
+
+    // With a standing queue, shed the tasks that waited longer than the target
+    // instead of the `time_limit_us`, so that the fresh ones are served in time
+    return state.overloaded.load(std::memory_order_relaxed) && wait_time >= target;
+}
+
 TaskProcessor::OverloadByLength TaskProcessor::GetOverloadByLength(const std::size_t max_queue_length) noexcept {
     const auto old_overload_by_length = overloaded_cache_->overload_by_length.load();
     // With this choice of factor, the probability of skipping over 200 tasks
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <thread>
 #include <variant>
@@ -85,6 +87,16 @@ private:
         std::atomic<OverloadByLength> overload_by_length{0};
     };
 
+    static constexpr std::int64_t kNoCodelWaitTime = std::numeric_limits<std::int64_t>::max();
+
+    // Minimal wait in queue time over the current CoDel interval, all the
+    // values are in microseconds
+    struct CodelState final {
+        std::atomic<std::int64_t> interval_end{0};
+        std::atomic<std::int64_t> min_wait_time{kNoCodelWaitTime};
+        std::atomic<bool> overloaded{false};
+    };
+
     void Cleanup() noexcept;
 
     void PrepareWorkerThread(std::size_t index) noexcept;
@@ -97,6 +109,12 @@ private:
 
     void SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept;
 
+    bool IsOverloadedByCodel(
+        std::chrono::steady_clock::time_point now,
+        std::chrono::microseconds wait_time,
+        std::chrono::microseconds target
+    ) noexcept;
+
     void HandleOverload(impl::TaskContext& context, TaskProcessorSettings::OverloadAction);
 
     OverloadByLength GetOverloadByLength(std::size_t max_queue_length) noexcept;
@@ -107,6 +125,7 @@ private:
     concurrent::impl::InterferenceShield<impl::DetachedTasksSyncBlock> detached_contexts_{
         impl::DetachedTasksSyncBlock::StopMode::kCancel};
     concurrent::impl::InterferenceShield<OverloadedCache> overloaded_cache_;
+    concurrent::impl::InterferenceShield<CodelState> codel_state_;
     std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
     impl::TaskCounter task_counter_;
 
@@ -117,6 +136,8 @@ private:
 
     std::atomic<std::chrono::microseconds> task_profiler_threshold_{{}};
     std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{{}};
+    std::atomic<std::chrono::microseconds> codel_target_{{}};
+    std::atomic<std::chrono::microseconds> codel_interval_{{}};
 
     std::atomic<std::chrono::microseconds> action_bit_and_max_task_queue_wait_time_{{}};
     std::atomic<std::int64_t> action_bit_and_max_task_queue_wait_length_{0};
@@ -103,6 +103,11 @@ TaskProcessorSettings Parse(const formats::json::Value& value, formats::parse::T
     settings.sensor_wait_queue_time_limit =
         std::chrono::microseconds(overload_doc["sensor_time_limit_us"].As<std::int64_t>(3000));
     settings.overload_action = overload_doc["action"].As<OverloadAction>(OverloadAction::kIgnore);
+    settings.wait_queue_codel_target =
+        std::chrono::microseconds(overload_doc["codel_target_us"].As<std::int64_t>(0));
+    settings.wait_queue_codel_interval = std::chrono::microseconds(
+        overload_doc["codel_interval_us"].As<std::int64_t>(settings.wait_queue_codel_interval.count())
+    );
 
     return settings;
 }
@@ -48,6 +48,12 @@ struct TaskProcessorSettings {
     std::chrono::microseconds wait_queue_time_limit{0};
     std::chrono::microseconds sensor_wait_queue_time_limit{0};
 
+    // CoDel: while the minimal wait in queue time over an interval exceeds
+    // the target, the `overload_action` is applied to the tasks that waited
+    // longer than the target. Disabled with zero target.
+    std::chrono::microseconds wait_queue_codel_target{0};
+    std::chrono::microseconds wait_queue_codel_interval{100'000};
+
     enum class OverloadAction : std::uint8_t { kCancel, kIgnore };
     OverloadAction overload_action{OverloadAction::kIgnore};
 
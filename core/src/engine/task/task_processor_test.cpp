@@ -1,5 +1,7 @@
 #include <engine/task/task_processor.hpp>
 
+#include <thread>
+
 #include <engine/task/task_processor_config.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -48,6 +50,60 @@ UTEST(TaskProcessor, Overload) {
     }
 }
 
+UTEST(TaskProcessor, CodelOverload) {
+    // The target and the interval are far below the time the tasks are held
+    // in queue and far above the wait of a task that is not held, so that
+    // the outcome does not depend on the scheduling jitter
+    constexpr std::chrono::milliseconds kTarget{10};
+    constexpr std::chrono::milliseconds kInterval{100};
+    constexpr std::chrono::milliseconds kHoldTime{2 * kInterval};
+    constexpr std::size_t kTasksPerRound = 50;
+
+    engine::TaskProcessorSettings settings;
+    settings.overload_action = engine::TaskProcessorSettings::OverloadAction::kCancel;
+    settings.wait_queue_codel_target = kTarget;
+    settings.wait_queue_codel_interval = kInterval;
+    engine::current_task::GetTaskProcessor().SetSettings(settings);
+
+    // The only worker is blocked, so every task of the round waits in queue
+    // longer than the target
+    const auto run_held_round = [&] {
+        std::vector<engine::TaskWithResult<void>> tasks;
+        tasks.reserve(kTasksPerRound);
+        for (std::size_t i = 0; i < kTasksPerRound; ++i) {
+            tasks.push_back(engine::AsyncNoSpan([] {}));
+        }
+        std::this_thread::sleep_for(kHoldTime);
+
+        std::size_t canceled_tasks_count{0};
+        for (auto& task : tasks) {
+            task.Wait();
+            if (engine::Task::State::kCancelled == task.GetState()) {
+                ++canceled_tasks_count;
+            }
+        }
+        return canceled_tasks_count;
+    };
+
+    // A single burst is not a standing queue
+    EXPECT_EQ(run_held_round(), 0);
+
+    // The whole previous interval had long waits, the tasks with a measured
+    // wait time are shed
+    EXPECT_GT(run_held_round(), 0);
+
+    // Tasks that do not wait in queue are not shed, even while overloaded
+    for (std::size_t i = 0; i < kTasksPerRound; ++i) {
+        auto task = engine::AsyncNoSpan([] {});
+        task.Wait();
+        EXPECT_EQ(task.GetState(), engine::Task::State::kCompleted);
+    }
+
+    // The short waits end the standing queue at the next interval, so the next
+    // burst is not shed either
+    EXPECT_EQ(run_held_round(), 0);
+}
+
 UTEST_MT(TaskProcessor, MetricsAliveAndRunning, 2) {
     auto& task_counter = engine::current_task::GetTaskProcessor().GetTaskCounter();
 
@@ -273,6 +273,7 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
@@ -288,6 +289,22 @@ properties:
                     enum:
                       - discard
                       - block
+                file_write_mode:
+                    type: string
+                    description: "how records get to the log file: `buffered` writes each record into a stdio buffer, `batched` writes each batch of queued records with a single writev"
+                    defaultDescription: buffered
+                    enum:
+                      - buffered
+                      - batched
+                batch_max_size:
+                    type: integer
+                    description: for `batched` file_write_mode, small batches are gathered in memory until that many bytes are buffered
+                    defaultDescription: 65536
+                    minimum: 1
+                batch_max_age:
+                    type: string
+                    description: for `batched` file_write_mode, small batches are gathered in memory until the first of them gets that old
+                    defaultDescription: 100ms
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
@@ -15,6 +15,13 @@ QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value, formats::parse
     return utils::ParseFromValueString(value, kMap);
 }
 
+FileWriteMode Parse(const yaml_config::YamlConfig& value, formats::parse::To<FileWriteMode>) {
+    static constexpr utils::TrivialBiMap kMap([](auto selector) {
+        return selector().Case(FileWriteMode::kBuffered, "buffered").Case(FileWriteMode::kBatched, "batched");
+    });
+    return utils::ParseFromValueString(value, kMap);
+}
+
 Format Parse(const yaml_config::YamlConfig& value, formats::parse::To<Format>) {
     const auto format_str = value.As<std::string>("tskv");
     return FormatFromString(format_str);
@@ -44,6 +51,10 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<Logg
     config.queue_overflow_behavior =
         value["overflow_behavior"].As<QueueOverflowBehavior>(config.queue_overflow_behavior);
 
+    config.file_write_mode = value["file_write_mode"].As<FileWriteMode>(config.file_write_mode);
+    config.batch_max_size = value["batch_max_size"].As<std::size_t>(config.batch_max_size);
+    config.batch_max_age = value["batch_max_age"].As<std::chrono::milliseconds>(config.batch_max_age);
+
     config.fs_task_processor = value["fs-task-processor"].As<std::optional<std::string>>();
 
     config.testsuite_capture = value["testsuite-capture"].As<std::optional<TestsuiteCaptureConfig>>();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 
@@ -22,6 +23,10 @@ enum class QueueOverflowBehavior { kDiscard, kBlock };
 
 QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value, formats::parse::To<QueueOverflowBehavior>);
 
+enum class FileWriteMode { kBuffered, kBatched };
+
+FileWriteMode Parse(const yaml_config::YamlConfig& value, formats::parse::To<FileWriteMode>);
+
 struct LoggerConfig final {
     static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
 
@@ -38,6 +43,10 @@ struct LoggerConfig final {
     size_t message_queue_size = kDefaultMessageQueueSize;
     QueueOverflowBehavior queue_overflow_behavior = QueueOverflowBehavior::kDiscard;
 
+    FileWriteMode file_write_mode = FileWriteMode::kBuffered;
+    std::size_t batch_max_size = 64 * 1024;
+    std::chrono::milliseconds batch_max_age{100};
+
     std::optional<std::string> fs_task_processor;
 
     std::optional<TestsuiteCaptureConfig> testsuite_capture;
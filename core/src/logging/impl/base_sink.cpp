@@ -14,6 +14,12 @@ void BaseSink::Log(const LogMessage& message) {
     }
 }
 
+void BaseSink::LogBatch(utils::span<const LogMessage> messages) {
+    for (const auto& message : messages) {
+        Log(message);
+    }
+}
+
 void BaseSink::Flush() {}
 
 void BaseSink::Reopen(ReopenMode) {}
@@ -4,6 +4,7 @@
 
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/logging/level.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,6 +23,10 @@ public:
 
     void Log(const LogMessage& message);
 
+    /// Logs the messages consumed from the logger queue in one go, same as
+    /// calling Log() for each of them by default.
+    virtual void LogBatch(utils::span<const LogMessage> messages);
+
     virtual void Flush();
 
     virtual void Reopen(ReopenMode);
@@ -0,0 +1,134 @@
+#include "batched_file_sink.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include "open_file_helper.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+BatchedFileSink::BatchedFileSink(const std::string& filename, const BatchedFileSinkSettings& settings)
+    : filename_(filename), settings_(settings), fd_(OpenFile<fs::blocking::FileDescriptor>(filename)) {
+    if (fd_.GetSize() > 0) {
+        fd_.Write("\n");
+    }
+    buffer_.reserve(settings_.max_buffer_size);
+}
+
+BatchedFileSink::~BatchedFileSink() {
+    try {
+        Flush();
+    } catch (const std::exception& e) {
+        UASSERT_MSG(false, fmt::format("Failed to write the buffered logs to '{}': {}", filename_, e.what()));
+    }
+}
+
+void BatchedFileSink::LogBatch(utils::span<const LogMessage> messages) {
+    std::size_t batch_size = 0;
+    for (const auto& message : messages) {
+        if (ShouldLog(message.level)) batch_size += message.payload.size();
+    }
+
+    if (buffer_.size() + batch_size < settings_.max_buffer_size) {
+        for (const auto& message : messages) {
+            if (ShouldLog(message.level)) Append(message.payload);
+        }
+        if (IsBufferDue()) WriteBuffer();
+        return;
+    }
+
+    // Large batches are written right from the logger queue, without copying
+    const utils::FastScopeGuard clear_guard([this]() noexcept { buffer_.clear(); });
+    iovecs_.clear();
+    if (!buffer_.empty()) {
+        iovecs_.push_back({buffer_.data(), buffer_.size()});
+    }
+    for (const auto& message : messages) {
+        if (ShouldLog(message.level) && !message.payload.empty()) {
+            // writev() does not modify the data
+            iovecs_.push_back({const_cast<char*>(message.payload.data()), message.payload.size()});
+        }
+    }
+    WriteIovecs();
+}
+
+void BatchedFileSink::Write(std::string_view log) {
+    Append(log);
+    if (buffer_.size() >= settings_.max_buffer_size || IsBufferDue()) {
+        WriteBuffer();
+    }
+}
+
+void BatchedFileSink::Flush() {
+    if (!buffer_.empty()) {
+        WriteBuffer();
+    }
+}
+
+void BatchedFileSink::Reopen(ReopenMode mode) {
+    Flush();
+    auto new_fd = OpenFile<fs::blocking::FileDescriptor>(filename_, mode);
+    std::move(fd_).Close();
+    fd_ = std::move(new_fd);
+}
+
+void BatchedFileSink::Append(std::string_view log) {
+    if (buffer_.empty()) {
+        buffer_start_ = std::chrono::steady_clock::now();
+    }
+    buffer_.append(log);
+}
+
+bool BatchedFileSink::IsBufferDue() const noexcept {
+    return !buffer_.empty() && std::chrono::steady_clock::now() - buffer_start_ >= settings_.max_buffer_age;
+}
+
+void BatchedFileSink::WriteBuffer() {
+    // The logs are lost on errors, as with the other sinks
+    const utils::FastScopeGuard clear_guard([this]() noexcept { buffer_.clear(); });
+    iovecs_.clear();
+    iovecs_.push_back({buffer_.data(), buffer_.size()});
+    WriteIovecs();
+}
+
+void BatchedFileSink::WriteIovecs() {
+    auto* iov = iovecs_.data();
+    auto count = iovecs_.size();
+
+    while (count > 0) {
+        const auto written = ::writev(fd_.GetNative(), iov, static_cast<int>(std::min<std::size_t>(count, IOV_MAX)));
+        if (written < 0) {
+            if (errno == EAGAIN || errno == EINTR) continue;
+
+            const auto code = std::make_error_code(std::errc{errno});
+            throw std::system_error(code, "calling ::writev");
+        }
+        ++writes_count_;
+
+        // Skip the fully written parts, then move to the rest of a partially
+        // written one
+        auto left = static_cast<std::size_t>(written);
+        while (count > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+        if (left > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
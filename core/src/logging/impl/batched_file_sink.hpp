@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/uio.h>
+
+#include <logging/impl/base_sink.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+struct BatchedFileSinkSettings final {
+    // Small batches of records are gathered in memory until that many bytes
+    // are buffered...
+    std::size_t max_buffer_size{64 * 1024};
+
+    // ...or until the first buffered record gets that old
+    std::chrono::milliseconds max_buffer_age{100};
+};
+
+// Writes each batch of records consumed from the TpLogger queue with a single
+// writev() right from the queued records. Small batches are gathered in memory
+// first, so that a lightly loaded logger does not issue a syscall per record.
+class BatchedFileSink final : public BaseSink {
+public:
+    BatchedFileSink(const std::string& filename, const BatchedFileSinkSettings& settings);
+    ~BatchedFileSink() override;
+
+    void LogBatch(utils::span<const LogMessage> messages) override;
+
+    void Flush() override;
+
+    void Reopen(ReopenMode mode) override;
+
+    // The number of write syscalls made so far
+    std::size_t GetWritesCount() const noexcept { return writes_count_; }
+
+protected:
+    void Write(std::string_view log) override;
+
+private:
+    void Append(std::string_view log);
+    bool IsBufferDue() const noexcept;
+    void WriteBuffer();
+    void WriteIovecs();
+
+    const std::string filename_;
+    const BatchedFileSinkSettings settings_;
+    fs::blocking::FileDescriptor fd_;
+    std::string buffer_;
+    std::chrono::steady_clock::time_point buffer_start_{};
+    std::vector<::iovec> iovecs_;
+    std::size_t writes_count_{0};
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -1,8 +1,11 @@
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/utils/rand.hpp>
 
+#include "batched_file_sink.hpp"
 #include "buffered_file_sink.hpp"
 #include "file_sink.hpp"
 
@@ -36,4 +39,40 @@ void check_buffered_file_sink(benchmark::State& state) {
 }
 BENCHMARK(check_buffered_file_sink);
 
+void check_batched_file_sink(benchmark::State& state) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const std::string filename = temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
+    auto sink = logging::impl::BatchedFileSink(filename, {});
+    for ([[maybe_unused]] auto _ : state) {
+        for (auto i = 0; i < kCountLogs; ++i) {
+            sink.Log({"message\n", logging::Level::kWarning});
+        }
+    }
+    sink.Flush();
+    state.counters["records"] = benchmark::Counter(state.iterations() * kCountLogs, benchmark::Counter::kIsRate);
+    state.counters["syscalls_per_record"] =
+        static_cast<double>(sink.GetWritesCount()) / static_cast<double>(state.iterations() * kCountLogs);
+}
+BENCHMARK(check_batched_file_sink);
+
+// Batches of state.range(0) records, as passed by TpLogger
+void check_batched_file_sink_batches(benchmark::State& state) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const std::string filename = temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
+    auto sink = logging::impl::BatchedFileSink(filename, {});
+    const auto batch_size = state.range(0);
+    const std::vector<logging::impl::LogMessage> batch(batch_size, {"message\n", logging::Level::kWarning});
+    const auto batches_count = (kCountLogs + batch_size - 1) / batch_size;
+    for ([[maybe_unused]] auto _ : state) {
+        for (auto i = 0; i < batches_count; ++i) {
+            sink.LogBatch(batch);
+        }
+    }
+    sink.Flush();
+    const auto records = state.iterations() * batches_count * batch_size;
+    state.counters["records"] = benchmark::Counter(records, benchmark::Counter::kIsRate);
+    state.counters["syscalls_per_record"] = static_cast<double>(sink.GetWritesCount()) / static_cast<double>(records);
+}
+BENCHMARK(check_batched_file_sink_batches)->RangeMultiplier(4)->Range(1, 256);
+
 USERVER_NAMESPACE_END
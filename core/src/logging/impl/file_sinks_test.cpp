@@ -10,6 +10,7 @@
 #include <userver/utest/parameter_names.hpp>
 #include <userver/utest/utest.hpp>
 
+#include "batched_file_sink.hpp"
 #include "buffered_file_sink.hpp"
 #include "sink_helper_test.hpp"
 
@@ -30,6 +31,10 @@ SinkPtr MakeBufferedFileSink(const std::string& filename) {
     return std::make_unique<logging::impl::BufferedFileSink>(filename);
 }
 
+SinkPtr MakeBatchedFileSink(const std::string& filename) {
+    return std::make_unique<logging::impl::BatchedFileSink>(filename, logging::impl::BatchedFileSinkSettings{});
+}
+
 class FileSinks : public testing::TestWithParam<SinkFactory> {
 protected:
     const std::string& GetTempRootPath() const { return temp_root_.GetPath(); }
@@ -184,8 +189,60 @@ UTEST_P(FileSinks, TestValidWriteMultiInFile) {
 INSTANTIATE_UTEST_SUITE_P(
     /* no prefix */,
     FileSinks,
-    testing::Values(SinkFactory{"FileSink", MakeFileSink}, SinkFactory{"BufferedFileSink", MakeBufferedFileSink}),
+    testing::Values(
+        SinkFactory{"FileSink", MakeFileSink},
+        SinkFactory{"BufferedFileSink", MakeBufferedFileSink},
+        SinkFactory{"BatchedFileSink", MakeBatchedFileSink}
+    ),
     utest::PrintTestName()
 );
 
+UTEST(BatchedFileSink, SmallBatches) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const auto filename = temp_root.GetPath() + "/temp_file";
+    logging::impl::BatchedFileSink sink{filename, {}};
+
+    const std::vector<logging::impl::LogMessage> batch{
+        {"message\n", logging::Level::kInfo},
+        {"message 2\n", logging::Level::kWarning},
+    };
+    sink.LogBatch(batch);
+    sink.LogBatch(batch);
+    EXPECT_EQ(sink.GetWritesCount(), 0);
+
+    sink.Flush();
+    EXPECT_EQ(sink.GetWritesCount(), 1);
+    EXPECT_EQ(test::ReadFromFile(filename), test::Messages("message", "message 2", "message", "message 2"));
+}
+
+UTEST(BatchedFileSink, LargeBatch) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const auto filename = temp_root.GetPath() + "/temp_file";
+    logging::impl::BatchedFileSink sink{filename, {/*max_buffer_size=*/16, /*max_buffer_age=*/std::chrono::hours{1}}};
+
+    sink.Log({"buffered\n", logging::Level::kInfo});
+    EXPECT_EQ(sink.GetWritesCount(), 0);
+
+    const std::string long_message(100, 'a');
+    const std::string long_record = long_message + "\n";
+    const std::vector<logging::impl::LogMessage> batch{
+        {"message\n", logging::Level::kInfo},
+        {long_record, logging::Level::kInfo},
+        {"message 2\n", logging::Level::kWarning},
+    };
+    sink.LogBatch(batch);
+    EXPECT_EQ(sink.GetWritesCount(), 1);
+    EXPECT_EQ(test::ReadFromFile(filename), test::Messages("buffered", "message", long_message, "message 2"));
+}
+
+UTEST(BatchedFileSink, MaxAge) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const auto filename = temp_root.GetPath() + "/temp_file";
+    logging::impl::BatchedFileSink sink{filename, {/*max_buffer_size=*/1024, /*max_buffer_age=*/{}}};
+
+    sink.Log({"message\n", logging::Level::kInfo});
+    EXPECT_EQ(sink.GetWritesCount(), 1);
+    EXPECT_EQ(test::ReadFromFile(filename), test::Messages("message"));
+}
+
 USERVER_NAMESPACE_END
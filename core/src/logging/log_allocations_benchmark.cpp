@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <logging/impl/null_sink.hpp>
+#include <logging/tp_logger.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include <utils/gbench_auxilary.hpp>
+
+// The global allocation functions are replaced below, so the benchmarks of
+// this file live in a separate binary, see core/CMakeLists.txt
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging_benchmark {
+
+// Heap allocations of the whole process, counted by the operator new below
+std::atomic<std::uint64_t> allocations_count{0};
+
+}  // namespace logging_benchmark
+
+namespace {
+
+// Allocations per log line through the whole TpLogger pipeline. Should be
+// zero in the steady state: LogHelper::Impl, the log records and their payload
+// buffers are all reused.
+void LogAllocations(benchmark::State& state) {
+    auto logger = std::make_shared<logging::impl::TpLogger>(logging::Format::kTskv, "test");
+    logger->AddSink(std::make_unique<logging::impl::NullSink>());
+    const logging::DefaultLoggerGuard guard{logger};
+
+    engine::RunStandalone(2, [&] {
+        logger->StartConsumerTask(
+            engine::current_task::GetTaskProcessor(), 1 << 16, logging::QueueOverflowBehavior::kBlock
+        );
+        const utils::FastScopeGuard stop_guard([&]() noexcept { logger->StopConsumerTask(); });
+
+        const auto msg = Launder(std::string(state.range(0), '*'));
+
+        // Fill the pools
+        for (int i = 0; i < 10'000; ++i) {
+            LOG_INFO() << msg;
+        }
+        logging::LogFlush();
+
+        const auto allocations_before = logging_benchmark::allocations_count.load();
+        for ([[maybe_unused]] auto _ : state) {
+            LOG_INFO() << msg;
+        }
+        const auto allocations = logging_benchmark::allocations_count.load() - allocations_before;
+
+        state.counters["allocations_per_record"] =
+            static_cast<double>(allocations) / static_cast<double>(state.iterations());
+        logging::LogFlush();
+    });
+}
+BENCHMARK(LogAllocations)->Arg(8)->Arg(1024);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
+
+// Replaces the global allocation functions of the benchmark binary to count
+// the allocations. The rest of the operator new/delete overloads call these.
+void* operator new(std::size_t size) {
+    USERVER_NAMESPACE::logging_benchmark::allocations_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* const ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept { std::free(ptr); }
@@ -0,0 +1,104 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <logging/logging_test.hpp>
+#include <userver/logging/impl/binary_format.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/utils/regex.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace binary = logging::impl::binary;
+
+std::string_view FindField(const binary::Record& record, std::string_view key) {
+    for (const auto& [field_key, value] : record.fields) {
+        if (field_key == key) return value;
+    }
+    return "<not found>";
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Basic) {
+    const auto before = std::chrono::system_clock::now();
+    LOG_WARNING() << "line 1\nline 2\tend" << logging::LogExtra{{"key", "value\twith\ttabs"}, {"http.port", 80}};
+    logging::LogFlush();
+    const auto after = std::chrono::system_clock::now();
+
+    const auto log = GetStreamString();
+    std::string_view data{log};
+    const auto chunk = binary::ReadChunk(data, true);
+    ASSERT_TRUE(chunk);
+    ASSERT_TRUE(chunk->record);
+    EXPECT_TRUE(data.empty());
+
+    const auto& record = *chunk->record;
+    EXPECT_EQ(record.level, logging::Level::kWarning);
+    EXPECT_GE(record.timestamp, std::chrono::time_point_cast<std::chrono::microseconds>(before));
+    EXPECT_LE(record.timestamp, after);
+
+    EXPECT_EQ(FindField(record, "text"), "line 1\nline 2\tend");
+    EXPECT_EQ(FindField(record, "key"), "value\twith\ttabs");
+    EXPECT_EQ(FindField(record, "http_port"), "80");
+    EXPECT_THAT(std::string{FindField(record, "module")}, testing::HasSubstr("log_binary_test.cpp"));
+}
+
+TEST_F(LoggingBinaryTest, Tskv) {
+    // Same pattern as in the LoggingTest.LogFormat
+    constexpr std::string_view kExpectedPattern = R"(tskv\t)"
+                                                  R"(timestamp=\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{6}\t)"
+                                                  R"(level=[A-Z]+\t)"
+                                                  R"(module=[\w\d ():./]+\t)"
+                                                  R"(task_id=[0-9A-F]+\t)"
+                                                  R"(thread_id=0x[0-9A-F]+\t)"
+                                                  R"(text=line 1\\nline 2\t)"
+                                                  R"(foo=bar\n)";
+    LOG_CRITICAL() << "line 1\nline 2" << logging::LogExtra{{"foo", "bar"}};
+    logging::LogFlush();
+
+    const auto log = GetStreamString();
+    std::string_view data{log};
+    const auto chunk = binary::ReadChunk(data, true);
+    ASSERT_TRUE(chunk && chunk->record);
+
+    std::string tskv;
+    binary::AppendTskv(tskv, *chunk->record);
+    EXPECT_TRUE(utils::regex_match(tskv, utils::regex(kExpectedPattern))) << tskv;
+}
+
+TEST_F(LoggingBinaryTest, MixedWithText) {
+    LOG_INFO() << "first";
+    LOG_INFO() << "second";
+    logging::LogFlush();
+
+    // File sinks put a newline on reopening, the logs written before the logger
+    // configuration was loaded are in TSKV
+    const auto log = "tskv\ttext=early\n" + GetStreamString() + "\n";
+
+    std::vector<std::string> decoded;
+    std::string_view data{log};
+    while (const auto chunk = binary::ReadChunk(data, true)) {
+        decoded.emplace_back(chunk->record ? FindField(*chunk->record, "text") : chunk->text);
+    }
+    EXPECT_THAT(decoded, testing::ElementsAre("tskv\ttext=early\n", "first", "second", "\n"));
+}
+
+TEST_F(LoggingBinaryTest, Incomplete) {
+    LOG_INFO() << "text";
+    logging::LogFlush();
+
+    const auto log = GetStreamString();
+    for (std::size_t size = 0; size < log.size(); ++size) {
+        std::string_view data{log.data(), size};
+        EXPECT_FALSE(binary::ReadChunk(data, false));
+        EXPECT_EQ(data.size(), size);
+        if (size != 0) {
+            EXPECT_THROW(binary::ReadChunk(data, true), binary::DecodeError);
+        }
+    }
+}
+
+USERVER_NAMESPACE_END
@@ -121,4 +121,9 @@ protected:
     LoggingLtsvTest() : LoggingTestBase(logging::Format::kLtsv) { SetDefaultLogger(GetStreamLogger()); }
 };
 
+class LoggingBinaryTest : public LoggingTestBase {
+protected:
+    LoggingBinaryTest() : LoggingTestBase(logging::Format::kBinary) { SetDefaultLogger(GetStreamLogger()); }
+};
+
 USERVER_NAMESPACE_END
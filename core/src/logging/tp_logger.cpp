@@ -15,12 +15,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Logs consumed from the queue are passed to the sinks in batches of up to
+// that many records, so that the sinks could write them with a single syscall.
+constexpr std::size_t kMaxLogBatchSize = 256;
+
+// Limits the payload memory retained by the free log nodes after a burst of
+// logs, the rest of the nodes are kept without payload
+constexpr std::size_t kMaxFreeLogNodes = 1024;
+constexpr std::size_t kMaxFreeLogNodePayloadCapacity = 16 * 1024;
+
+}  // namespace
+
 struct TpLogger::ActionVisitor final {
     TpLogger& logger;
 
-    void operator()(impl::async::Log&& log) const {
-        logger.AccountLogConsumed();
-        logger.BackendLog(std::move(log));
+    void operator()(impl::async::Log&&) const noexcept {
+        UASSERT_MSG(false, "Logs are batched in ConsumeNode and should not get here");
     }
 
     void operator()(impl::async::Stop&&) const noexcept {
@@ -47,6 +59,8 @@ struct TpLogger::ActionVisitor final {
 
 TpLogger::TpLogger(Format format, std::string logger_name) : LoggerBase(format), logger_name_(std::move(logger_name)) {
     SetLevel(logging::Level::kInfo);
+    log_batch_.reserve(kMaxLogBatchSize);
+    log_batch_messages_.reserve(kMaxLogBatchSize);
 }
 
 void TpLogger::StartConsumerTask(
@@ -85,6 +99,8 @@ TpLogger::~TpLogger() {
         "We may be in non coroutine context, async logger must be in "
         "sync mode and consuming task must be stopped"
     );
+    free_log_nodes_.DisposeUnsafe([](impl::async::ActionNode& node) { delete &node; });
+    spare_log_nodes_.DisposeUnsafe([](impl::async::ActionNode& node) { delete &node; });
 }
 
 void TpLogger::StopConsumerTask() {
@@ -139,7 +155,7 @@ void TpLogger::Log(Level level, std::string_view msg) {
         produced_->fetch_add(1);
 
         try {
-            Push(impl::async::Log{level, std::string{msg}});
+            PushLog(level, msg);
         } catch (const std::exception&) {
             // failed to construct a Log action or a node in Push
             produced_->fetch_sub(1);
@@ -228,6 +244,51 @@ void TpLogger::Push(impl::async::Action&& action) {
     DoPush(*node.release());
 }
 
+void TpLogger::PushLog(Level level, std::string_view msg) {
+    auto* node = free_log_nodes_.TryPop();
+    if (node) {
+        free_log_nodes_count_.fetch_sub(1, std::memory_order_relaxed);
+    } else {
+        node = spare_log_nodes_.TryPop();
+    }
+
+    if (!node) {
+        auto new_node = std::make_unique<impl::async::ActionNode>();
+        new_node->action = impl::async::Log{level, std::string{msg}};
+        DoPush(*new_node.release());
+        return;
+    }
+
+    auto& log = std::get<impl::async::Log>(node->action);
+    try {
+        log.payload.assign(msg);
+    } catch (...) {
+        ReleaseLogNode(*node);
+        throw;
+    }
+    log.level = level;
+    log.time = std::chrono::system_clock::now();
+    DoPush(*node);
+}
+
+void TpLogger::ReleaseLogNode(impl::async::ActionNode& node) noexcept {
+    // Nodes can not be deleted once they got into a free list, because
+    // a concurrent TryPop might still read them. Instead, the nodes left after
+    // a burst of logs are kept without their payload memory until the logger
+    // is destroyed.
+    auto& log = std::get<impl::async::Log>(node.action);
+    if (log.payload.capacity() <= kMaxFreeLogNodePayloadCapacity) {
+        // The count is approximate, which is fine for limiting the memory usage
+        if (free_log_nodes_count_.fetch_add(1, std::memory_order_relaxed) < kMaxFreeLogNodes) {
+            free_log_nodes_.Push(node);
+            return;
+        }
+        free_log_nodes_count_.fetch_sub(1, std::memory_order_relaxed);
+    }
+    log.payload = std::string{};
+    spare_log_nodes_.Push(node);
+}
+
 void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
     auto consumer = queue_.PushAndTryStartConsuming(node);
     if (consumer.IsValid()) {
@@ -255,6 +316,17 @@ void TpLogger::ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcep
     auto& action_node = static_cast<impl::async::ActionNode&>(node);
     if (&action_node == &stop_node_) return;
 
+    if (std::holds_alternative<impl::async::Log>(action_node.action)) {
+        AccountLogConsumed();
+        // Does not allocate, the capacity is reserved
+        log_batch_.push_back(&action_node);
+        if (log_batch_.size() >= kMaxLogBatchSize) {
+            BackendLogBatch();
+        }
+        return;
+    }
+
+    BackendLogBatch();
     BackendPerform(std::move(action_node.action));
     delete &action_node;
 }
@@ -263,26 +335,44 @@ void TpLogger::ConsumeQueueOnce(Queue::Consumer& consumer) noexcept {
     while (auto* const node_base = consumer.TryPop()) {
         ConsumeNode(*node_base);
     }
+    BackendLogBatch();
 }
 
 void TpLogger::CleanUpQueue(Queue::Consumer&& consumer) noexcept {
-    std::move(consumer).ConsumeAndStop([this](auto& node) noexcept { ConsumeNode(node); });
+    // Same as Consumer::ConsumeAndStop, but the batch is written to the sinks
+    // before giving up the consumer role.
+    do {
+        ConsumeQueueOnce(consumer);
+    } while (!consumer.TryStopConsuming());
 }
 
-void TpLogger::BackendLog(impl::async::Log&& action) const {
-    LogMessage message;
-    message.payload = action.payload;
-    message.level = action.level;
+void TpLogger::BackendLogBatch() noexcept {
+    if (log_batch_.empty()) return;
+
+    // Group flush: sinks are flushed once per batch, even if it contains
+    // many messages of the flush level.
+    bool should_flush = false;
+    for (const auto* node : log_batch_) {
+        const auto& log = std::get<impl::async::Log>(node->action);
+        log_batch_messages_.push_back(LogMessage{log.payload, log.level});
+        should_flush = should_flush || ShouldFlush(log.level);
+    }
 
     for (const auto& sink : GetSinks()) {
         try {
-            sink->Log(message);
+            sink->LogBatch(log_batch_messages_);
         } catch (const std::exception& e) {
             UASSERT_MSG(false, "While writing a log message caught an exception: " + std::string(e.what()));
         }
     }
 
-    if (ShouldFlush(message.level)) {
+    log_batch_messages_.clear();
+    for (auto* node : log_batch_) {
+        ReleaseLogNode(*node);
+    }
+    log_batch_.clear();
+
+    if (should_flush) {
         BackendFlush();
     }
 }
@@ -22,6 +22,7 @@
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/concurrent/impl/intrusive_hooks.hpp>
+#include <userver/concurrent/impl/intrusive_stack.hpp>
 #include <userver/logging/impl/log_stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -57,6 +58,7 @@ using Action = std::variant<Stop, Log, FlushCoro, FlushThreaded, ReopenCoro>;
 
 struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
     Action action{Stop{}};
+    concurrent::impl::SinglyLinkedHook<ActionNode> free_list_hook;
 };
 
 }  // namespace async
@@ -101,18 +103,22 @@ private:
 
     using Queue = engine::impl::AsyncFlatCombiningQueue;
     using QueueSize = std::int64_t;
+    using FreeLogNodes = concurrent::impl::
+        IntrusiveStack<impl::async::ActionNode, concurrent::impl::MemberHook<&impl::async::ActionNode::free_list_hook>>;
 
     void ProcessingLoop();
     bool HasFreeQueueCapacity() noexcept;
     bool TryWaitFreeQueueCapacity();
     void Push(impl::async::Action&& action);
+    void PushLog(Level level, std::string_view msg);
+    void ReleaseLogNode(impl::async::ActionNode& node) noexcept;
     void DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
     void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
     void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
     void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
     void AccountLogConsumed() noexcept;
     void BackendPerform(impl::async::Action&& action) noexcept;
-    void BackendLog(impl::async::Log&& action) const;
+    void BackendLogBatch() noexcept;
     void BackendFlush() const;
     void BackendReopen(ReopenMode reopen_mode) const;
 
@@ -130,6 +136,17 @@ private:
     Queue::Consumer queue_consumer_;
     // A dummy action used for notifying the async task during stopping.
     impl::async::ActionNode stop_node_;
+    // Logs consumed from the queue, but not yet written to the sinks. Only
+    // accessed by the current consumer of the queue.
+    std::vector<impl::async::ActionNode*> log_batch_;
+    std::vector<impl::LogMessage> log_batch_messages_;
+
+    // Log nodes are reused along with the capacity of their payload, so that
+    // logging does not allocate in the steady state.
+    FreeLogNodes free_log_nodes_;
+    std::atomic<std::size_t> free_log_nodes_count_{0};
+    // Nodes without payload, left after bursts of logs
+    FreeLogNodes spare_log_nodes_;
 
     Queue queue_;
     concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
@@ -2,8 +2,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include <logging/impl/batched_file_sink.hpp>
+#include <logging/impl/buffered_file_sink.hpp>
 #include <logging/impl/null_sink.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
 #include <userver/tracing/span.hpp>
@@ -89,4 +92,48 @@ BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogCheckSpan)
 }
 BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogCheckSpan);
 
+// Arg: 0 - BufferedFileSink, 1 - BatchedFileSink
+void TpLoggerFileSink(benchmark::State& state) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const auto filename = temp_root.GetPath() + "/log";
+
+    logging::impl::BatchedFileSink* batched_sink = nullptr;
+    logging::impl::SinkPtr sink;
+    if (state.range(0) == 1) {
+        auto batched_sink_holder = std::make_unique<logging::impl::BatchedFileSink>(
+            filename, logging::impl::BatchedFileSinkSettings{}
+        );
+        batched_sink = batched_sink_holder.get();
+        sink = std::move(batched_sink_holder);
+    } else {
+        sink = std::make_unique<logging::impl::BufferedFileSink>(filename);
+    }
+
+    auto logger = MakeLoggerFromSink("test", std::move(sink), logging::Format::kTskv);
+    logger->SetLevel(logging::Level::kInfo);
+    const logging::DefaultLoggerGuard guard{logger};
+
+    std::int64_t records = 0;
+    engine::RunStandalone(2, [&] {
+        // Block instead of dropping the records, so that all of them are written
+        logger->StartConsumerTask(
+            engine::current_task::GetTaskProcessor(), 1 << 16, logging::QueueOverflowBehavior::kBlock
+        );
+        const utils::FastScopeGuard stop_guard([&]() noexcept { logger->StopConsumerTask(); });
+
+        for ([[maybe_unused]] auto _ : state) {
+            LOG_INFO() << "message";
+            ++records;
+        }
+        logging::LogFlush();
+    });
+
+    state.counters["records"] = benchmark::Counter(records, benchmark::Counter::kIsRate);
+    if (batched_sink) {
+        state.counters["syscalls_per_record"] =
+            static_cast<double>(batched_sink->GetWritesCount()) / static_cast<double>(records);
+    }
+}
+BENCHMARK(TpLoggerFileSink)->Arg(0)->Arg(1);
+
 USERVER_NAMESPACE_END
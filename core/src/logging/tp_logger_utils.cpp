@@ -8,6 +8,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/range/algorithm/find_if.hpp>
 
+#include <logging/impl/batched_file_sink.hpp>
 #include <logging/impl/buffered_file_sink.hpp>
 #include <logging/impl/tcp_socket_sink.hpp>
 #include <logging/impl/unix_socket_sink.hpp>
@@ -36,10 +37,15 @@ void CreateLogDirectory(const std::string& logger_name, const std::string& file_
     }
 }
 
-SinkPtr GetSinkFromFilename(const std::string& file_path) {
+SinkPtr GetSinkFromFilename(const LoggerConfig& config) {
+    const auto& file_path = config.file_path;
     if (utils::text::StartsWith(file_path, kUnixSocketPrefix)) {
         // Use Unix-socket sink
         return std::make_unique<UnixSocketSink>(file_path.substr(kUnixSocketPrefix.size()));
+    } else if (config.file_write_mode == FileWriteMode::kBatched) {
+        return std::make_unique<BatchedFileSink>(
+            file_path, BatchedFileSinkSettings{config.batch_max_size, config.batch_max_age}
+        );
     } else {
         return std::make_unique<BufferedFileSink>(file_path);
     }
@@ -54,7 +60,7 @@ SinkPtr MakeOptionalSink(const LoggerConfig& config) {
         return std::make_unique<logging::impl::BufferedUnownedFileSink>(stdout);
     } else {
         CreateLogDirectory(config.logger_name, config.file_path);
-        return GetSinkFromFilename(config.file_path);
+        return GetSinkFromFilename(config);
     }
 }
 
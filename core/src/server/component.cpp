@@ -132,6 +132,22 @@ properties:
                     private-key-passphrase-name:
                         type: string
                         description: passphrase name located in secdist
+                    kernel-offload:
+                        type: boolean
+                        description: encrypt and decrypt the records in the kernel (Linux kTLS) when possible
+                        defaultDescription: false
+                    session-resumption:
+                        type: boolean
+                        description: resume TLS sessions with the session tickets and the session cache
+                        defaultDescription: false
+                    session-cache-size:
+                        type: integer
+                        description: max sessions in the cache shared by the listener shards, 0 to use only the tickets
+                        defaultDescription: 20480
+                        minimum: 0
+                    session-ticket-keys-name:
+                        type: string
+                        description: session ticket keys name located in secdist, random keys are used if not set
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -210,6 +226,26 @@ properties:
                                 type: integer
                                 description: the initial window size of the server
                                 defaultDescription: 65536
+                            connection_window_size:
+                                type: integer
+                                description: the initial window size of the connection
+                                defaultDescription: 65536
+                            adaptive_window:
+                                type: boolean
+                                description: grow the windows up to the bandwidth-delay product measured with PINGs
+                                defaultDescription: false
+                            max_window_size:
+                                type: integer
+                                description: the max window size for the adaptive_window
+                                defaultDescription: 16777216
+                            rfc9218_priorities:
+                                type: boolean
+                                description: schedule the streams according to the RFC 9218 priority header and PRIORITY_UPDATE frames instead of the RFC 7540 priorities; requires nghttp2 1.49+
+                                defaultDescription: true
+                            write_buffer_size:
+                                type: integer
+                                description: frames of the streams are gathered into a buffer of this size and written with a single write
+                                defaultDescription: 65536
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
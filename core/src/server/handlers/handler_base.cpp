@@ -102,6 +102,21 @@ properties:
         type: boolean
         description: allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options
         defaultDescription: true
+    criticality:
+        type: string
+        description: criticality class of the requests, the lower classes are rejected first by the congestion control
+        defaultDescription: normal
+        enum:
+          - critical
+          - normal
+          - sheddable
+    criticality-header:
+        type: string
+        description: |
+            name of the request header (e.g. X-Priority) with the criticality
+            class that overrides the `criticality` option, enable only for
+            the trusted clients
+        defaultDescription: <criticality from the header is ignored>
     set-response-server-hostname:
         type: boolean
         description: set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header
@@ -7,13 +7,35 @@
 #include <server/http/parse_http_status.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/logging/level_serialization.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::handlers {
 
 namespace {
+
 constexpr size_t kLogRequestDataSizeDefaultLimit = 512;
+
+constexpr utils::TrivialBiMap kCriticalityMap([](auto selector) {
+    return selector()
+        .Case(Criticality::kCritical, "critical")
+        .Case(Criticality::kNormal, "normal")
+        .Case(Criticality::kSheddable, "sheddable");
+});
+
+}  // namespace
+
+std::string_view ToString(Criticality criticality) {
+    return utils::impl::EnumToStringView(criticality, kCriticalityMap);
+}
+
+std::optional<Criticality> CriticalityFromString(std::string_view name) noexcept {
+    return kCriticalityMap.TryFind(name);
+}
+
+Criticality Parse(const yaml_config::YamlConfig& value, formats::parse::To<Criticality>) {
+    return utils::ParseFromValueString(value, kCriticalityMap);
 }
 
 UrlTrailingSlashOption Parse(const yaml_config::YamlConfig& yaml, formats::parse::To<UrlTrailingSlashOption>) {
@@ -78,6 +100,8 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
     config.max_requests_per_second = value["max_requests_per_second"].As<std::optional<size_t>>();
     config.decompress_request = value["decompress_request"].As<bool>(true);
     config.throttling_enabled = value["throttling_enabled"].As<bool>(true);
+    config.criticality = value["criticality"].As<Criticality>(Criticality::kNormal);
+    config.criticality_header = value["criticality-header"].As<std::optional<std::string>>();
     config.set_response_server_hostname = value["set-response-server-hostname"].As<std::optional<bool>>();
 
     config.response_body_stream = value["response-body-stream"].As<bool>(false);
@@ -1,35 +1,25 @@
 #include <userver/server/handlers/server_monitor.hpp>
 
+#include <chrono>
+
 #include <userver/components/component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/http/common_headers.hpp>
 #include <userver/server/handlers/exceptions.hpp>
-#include <userver/utils/statistics/graphite.hpp>
-#include <userver/utils/statistics/json.hpp>
-#include <userver/utils/statistics/pretty_format.hpp>
-#include <userver/utils/statistics/prometheus.hpp>
-#include <userver/utils/statistics/solomon.hpp>
 #include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/text_light.hpp>
 #include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 #include <userver/yaml_config/schema.hpp>
 
+#include <server/handlers/server_monitor_cache.hpp>
 #include <utils/statistics/value_builder_helpers.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::handlers {
 
-enum class impl::StatsFormat {
-    kInternal,
-    kGraphite,
-    kPrometheus,
-    kPrometheusUntyped,
-    kJson,
-    kPretty,
-    kSolomon,
-};
-
 namespace {
 
 using impl::StatsFormat;
@@ -60,6 +50,35 @@ std::optional<StatsFormat> ParseFormat(std::string_view format) {
     )});
 }
 
+std::string_view GetContentType(StatsFormat format) {
+    switch (format) {
+        case StatsFormat::kJson:
+        case StatsFormat::kSolomon:
+        case StatsFormat::kInternal:
+            return "application/json";
+        case StatsFormat::kGraphite:
+        case StatsFormat::kPrometheus:
+        case StatsFormat::kPrometheusUntyped:
+        case StatsFormat::kPretty:
+            return "text/plain; charset=utf-8";
+    }
+
+    UINVARIANT(false, "Unexpected 'format' value");
+}
+
+bool AcceptsGzip(const http::HttpRequest& request) {
+    const auto& accept_encoding = request.GetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding);
+    for (const auto coding : utils::text::SplitIntoStringViewVector(accept_encoding, ",")) {
+        const auto params_pos = coding.find(';');
+        const auto params = params_pos == std::string_view::npos ? std::string_view{} : coding.substr(params_pos);
+        if (utils::text::Trim(std::string{coding.substr(0, params_pos)}) == "gzip" &&
+            params.find("q=0") == std::string_view::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
 }  // namespace
 
 ServerMonitor::ServerMonitor(
@@ -69,7 +88,15 @@ ServerMonitor::ServerMonitor(
     : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
       statistics_storage_(component_context.FindComponent<components::StatisticsStorage>().GetStorage()),
       common_labels_{config["common-labels"].As<CommonLabels>({})},
-      default_format_{ParseFormat(config["format"].As<std::string>({}))} {}
+      default_format_{ParseFormat(config["format"].As<std::string>({}))},
+      gzip_responses_{config["gzip-responses"].As<bool>(false)},
+      metrics_cache_{[&config]() -> std::unique_ptr<impl::MetricsCache> {
+          const auto ttl = config["metrics-cache-ttl"].As<std::chrono::milliseconds>(0);
+          if (ttl <= std::chrono::milliseconds::zero()) return nullptr;
+          return std::make_unique<impl::MetricsCache>(ttl);
+      }()} {}
+
+ServerMonitor::~ServerMonitor() = default;
 
 std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
     const auto& prefix = request.GetArg("prefix");
@@ -101,36 +128,26 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
         (path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels), std::move(labels))
                       : Request::MakeWithPath(path, std::move(common_labels), std::move(labels)));
 
-    request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
-    switch (format) {
-        case StatsFormat::kGraphite:
-            return utils::statistics::ToGraphiteFormat(statistics_storage_, statistics_request);
-
-        case StatsFormat::kPrometheus:
-            return utils::statistics::ToPrometheusFormat(statistics_storage_, statistics_request);
-
-        case StatsFormat::kPrometheusUntyped:
-            return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_, statistics_request);
-
-        case StatsFormat::kJson:
-            request.GetHttpResponse().SetContentType("application/json");
-            return utils::statistics::ToJsonFormat(statistics_storage_, statistics_request);
-
-        case StatsFormat::kPretty:
-            return utils::statistics::ToPrettyFormat(statistics_storage_, statistics_request);
+    auto& response = request.GetHttpResponse();
+    response.SetContentType(std::string{GetContentType(format)});
+    if (format == StatsFormat::kInternal) {
+        const auto json = statistics_storage_.GetAsJson();
+        UASSERT(utils::statistics::AreAllMetricsNumbers(json));
+        return formats::json::ToString(json);
+    }
 
-        case StatsFormat::kSolomon:
-            request.GetHttpResponse().SetContentType("application/json");
-            return utils::statistics::ToSolomonFormat(statistics_storage_, common_labels_, statistics_request);
+    const bool use_gzip = gzip_responses_ && AcceptsGzip(request);
+    if (use_gzip) {
+        response.SetContentEncoding("gzip");
+    }
 
-        case StatsFormat::kInternal:
-            request.GetHttpResponse().SetContentType("application/json");
-            const auto json = statistics_storage_.GetAsJson();
-            UASSERT(utils::statistics::AreAllMetricsNumbers(json));
-            return formats::json::ToString(json);
+    if (!metrics_cache_) {
+        return impl::RenderResponse(format, statistics_storage_, common_labels_, statistics_request, use_gzip);
     }
 
-    UINVARIANT(false, "Unexpected 'format' value");
+    const auto key =
+        fmt::format("{}\n{}\n{}\n{}\n{}", static_cast<int>(format), path, prefix, labels_json, use_gzip);
+    return metrics_cache_->GetResponse(statistics_storage_, key, format, common_labels_, statistics_request, use_gzip);
 }
 
 std::string
@@ -152,6 +169,17 @@ properties:
             added to each metric.
         additionalProperties: true
         properties: {}
+    metrics-cache-ttl:
+        type: string
+        description: |
+            If set to a positive duration, metrics are collected at most once
+            per this interval and responses for identical requests are
+            rendered once per collection.
+        defaultDescription: 0
+    gzip-responses:
+        type: boolean
+        description: compress responses for clients that accept gzip encoding
+        defaultDescription: false
     format:
         type: string
         description: Default metrics format. Either static option or URL parameter has to be provided.
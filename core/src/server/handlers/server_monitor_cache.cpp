@@ -0,0 +1,140 @@
+#include <server/handlers/server_monitor_cache.hpp>
+
+#include <mutex>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/graphite.hpp>
+#include <userver/utils/statistics/json.hpp>
+#include <userver/utils/statistics/metrics_snapshot.hpp>
+#include <userver/utils/statistics/pretty_format.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/solomon.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+#include <compression/gzip.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers::impl {
+
+namespace {
+
+template <typename MetricsSource>
+std::string Render(
+    StatsFormat format,
+    const MetricsSource& statistics,
+    const CommonLabels& common_labels,
+    const utils::statistics::Request& request
+) {
+    switch (format) {
+        case StatsFormat::kGraphite:
+            return utils::statistics::ToGraphiteFormat(statistics, request);
+
+        case StatsFormat::kPrometheus:
+            return utils::statistics::ToPrometheusFormat(statistics, request);
+
+        case StatsFormat::kPrometheusUntyped:
+            return utils::statistics::ToPrometheusFormatUntyped(statistics, request);
+
+        case StatsFormat::kJson:
+            return utils::statistics::ToJsonFormat(statistics, request);
+
+        case StatsFormat::kPretty:
+            return utils::statistics::ToPrettyFormat(statistics, request);
+
+        case StatsFormat::kSolomon:
+            return utils::statistics::ToSolomonFormat(statistics, common_labels, request);
+
+        case StatsFormat::kInternal:
+            break;
+    }
+
+    UINVARIANT(false, "Unexpected 'format' value");
+}
+
+template <typename MetricsSource>
+std::string DoRenderResponse(
+    StatsFormat format,
+    const MetricsSource& statistics,
+    const CommonLabels& common_labels,
+    const utils::statistics::Request& request,
+    bool use_gzip
+) {
+    auto body = Render(format, statistics, common_labels, request);
+    if (use_gzip) return compression::gzip::Compress(body);
+    return body;
+}
+
+}  // namespace
+
+class MetricsCache::CachedMetrics final {
+public:
+    explicit CachedMetrics(const utils::statistics::Storage& storage) : snapshot_(storage) {}
+
+    const utils::statistics::MetricsSnapshot& GetSnapshot() const noexcept { return snapshot_; }
+
+    template <typename RenderFunc>
+    std::shared_ptr<const std::string> GetOrRender(const std::string& key, RenderFunc render) {
+        {
+            std::lock_guard lock(mutex_);
+            const auto it = responses_.find(key);
+            if (it != responses_.end()) return it->second;
+        }
+
+        // Concurrent requests with the same key may render the response twice,
+        // that's fine as it happens at most once per snapshot.
+        auto response = std::make_shared<const std::string>(render());
+
+        std::lock_guard lock(mutex_);
+        if (responses_.size() >= kMaxResponsesPerSnapshot) return response;
+        return responses_.emplace(key, std::move(response)).first->second;
+    }
+
+private:
+    const utils::statistics::MetricsSnapshot snapshot_;
+    engine::Mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const std::string>> responses_;
+};
+
+std::string RenderResponse(
+    StatsFormat format,
+    const utils::statistics::Storage& storage,
+    const CommonLabels& common_labels,
+    const utils::statistics::Request& request,
+    bool use_gzip
+) {
+    return DoRenderResponse(format, storage, common_labels, request, use_gzip);
+}
+
+MetricsCache::MetricsCache(std::chrono::milliseconds ttl) : ttl_(ttl) {}
+
+MetricsCache::~MetricsCache() = default;
+
+std::string MetricsCache::GetResponse(
+    const utils::statistics::Storage& storage,
+    const std::string& key,
+    StatsFormat format,
+    const CommonLabels& common_labels,
+    const utils::statistics::Request& request,
+    bool use_gzip
+) {
+    const auto cached_metrics = GetMetrics(storage);
+    const auto response = cached_metrics->GetOrRender(key, [&] {
+        return DoRenderResponse(format, cached_metrics->GetSnapshot(), common_labels, request, use_gzip);
+    });
+    return *response;
+}
+
+// Concurrent requests wait for a single snapshot collection instead of
+// walking the Storage on their own.
+std::shared_ptr<MetricsCache::CachedMetrics> MetricsCache::GetMetrics(const utils::statistics::Storage& storage) {
+    std::lock_guard lock(mutex_);
+    if (!current_ || std::chrono::steady_clock::now() - current_->GetSnapshot().GetCreationTime() >= ttl_) {
+        current_ = std::make_shared<CachedMetrics>(storage);
+    }
+    return current_;
+}
+
+}  // namespace server::handlers::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers::impl {
+
+enum class StatsFormat {
+    kInternal,
+    kGraphite,
+    kPrometheus,
+    kPrometheusUntyped,
+    kJson,
+    kPretty,
+    kSolomon,
+};
+
+using CommonLabels = std::unordered_map<std::string, std::string>;
+
+// Renders the metrics of the `storage`, gzip-compressed if `use_gzip`
+std::string RenderResponse(
+    StatsFormat format,
+    const utils::statistics::Storage& storage,
+    const CommonLabels& common_labels,
+    const utils::statistics::Request& request,
+    bool use_gzip
+);
+
+// Collects the metrics at most once per TTL and renders the responses for
+// identical requests once per collection.
+class MetricsCache final {
+public:
+    // Responses for the other requests are rendered on each request, so that
+    // the filters of the scrapers do not grow the cache
+    static constexpr std::size_t kMaxResponsesPerSnapshot = 16;
+
+    explicit MetricsCache(std::chrono::milliseconds ttl);
+    ~MetricsCache();
+
+    // Requests with the same `key` must have the same response
+    std::string GetResponse(
+        const utils::statistics::Storage& storage,
+        const std::string& key,
+        StatsFormat format,
+        const CommonLabels& common_labels,
+        const utils::statistics::Request& request,
+        bool use_gzip
+    );
+
+private:
+    class CachedMetrics;
+
+    std::shared_ptr<CachedMetrics> GetMetrics(const utils::statistics::Storage& storage);
+
+    const std::chrono::milliseconds ttl_;
+    engine::Mutex mutex_;
+    std::shared_ptr<CachedMetrics> current_;
+};
+
+}  // namespace server::handlers::impl
+
+USERVER_NAMESPACE_END
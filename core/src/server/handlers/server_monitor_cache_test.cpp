@@ -0,0 +1,74 @@
+#include <server/handlers/server_monitor_cache.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+#include <compression/gzip.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::handlers::impl::MetricsCache;
+using server::handlers::impl::RenderResponse;
+using server::handlers::impl::StatsFormat;
+
+constexpr std::size_t kMaxResponseSize = 1 << 20;
+
+}  // namespace
+
+UTEST(ServerMonitorCache, GzipResponse) {
+    std::atomic<int> value{1};
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter("sample", [&value](utils::statistics::Writer& writer) {
+        writer["value"] = value.load();
+        writer.ValueWithLabels(2, {"label", "a"});
+    });
+
+    MetricsCache cache{std::chrono::hours{1}};
+    const auto request = utils::statistics::Request::MakeWithPrefix("sample");
+
+    for (const auto format : {StatsFormat::kPrometheus, StatsFormat::kJson, StatsFormat::kSolomon}) {
+        const auto key = std::to_string(static_cast<int>(format));
+        const auto fresh = RenderResponse(format, storage, {}, request, false);
+        const auto fresh_gzip = RenderResponse(format, storage, {}, request, true);
+        EXPECT_EQ(compression::gzip::Decompress(fresh_gzip, kMaxResponseSize), fresh);
+
+        const auto cached_gzip = cache.GetResponse(storage, key, format, {}, request, true);
+        EXPECT_EQ(compression::gzip::Decompress(cached_gzip, kMaxResponseSize), fresh);
+
+        // Served from the same snapshot
+        EXPECT_EQ(cache.GetResponse(storage, key, format, {}, request, true), cached_gzip);
+    }
+
+    // The snapshot is reused until the TTL expires
+    const auto old = RenderResponse(StatsFormat::kPrometheus, storage, {}, request, false);
+    value = 2;
+    EXPECT_NE(RenderResponse(StatsFormat::kPrometheus, storage, {}, request, false), old);
+    EXPECT_EQ(cache.GetResponse(storage, "other", StatsFormat::kPrometheus, {}, request, false), old);
+}
+
+UTEST(ServerMonitorCache, ResponsesLimit) {
+    utils::statistics::Storage storage;
+    const auto holder =
+        storage.RegisterWriter("sample", [](utils::statistics::Writer& writer) { writer["value"] = 1; });
+
+    MetricsCache cache{std::chrono::hours{1}};
+    const auto request = utils::statistics::Request::MakeWithPrefix("sample");
+    const auto fresh = RenderResponse(StatsFormat::kPrometheus, storage, {}, request, false);
+
+    // Responses over the limit are rendered without being cached
+    constexpr auto kRequests = MetricsCache::kMaxResponsesPerSnapshot * 2;
+    for (std::size_t i = 0; i < kRequests; ++i) {
+        const auto key = std::to_string(i);
+        EXPECT_EQ(cache.GetResponse(storage, key, StatsFormat::kPrometheus, {}, request, false), fresh);
+        EXPECT_EQ(cache.GetResponse(storage, key, StatsFormat::kPrometheus, {}, request, false), fresh);
+    }
+}
+
+USERVER_NAMESPACE_END
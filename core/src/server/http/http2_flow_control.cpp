@@ -0,0 +1,37 @@
+#include <server/http/http2_flow_control.hpp>
+
+#include <algorithm>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+WindowSizeEstimator::WindowSizeEstimator(std::uint32_t window_size, std::uint32_t max_window_size) noexcept
+    : window_size_(window_size), max_window_size_(std::max(window_size, max_window_size)) {}
+
+bool WindowSizeEstimator::OnDataReceived(std::size_t bytes) noexcept {
+    if (window_size_ >= max_window_size_) return false;
+
+    sample_ += bytes;
+    if (probe_in_flight_) return false;
+    probe_in_flight_ = true;
+    return true;
+}
+
+std::optional<std::uint32_t> WindowSizeEstimator::OnProbeAck() noexcept {
+    if (!probe_in_flight_) return std::nullopt;
+    probe_in_flight_ = false;
+
+    const auto sample = std::exchange(sample_, 0);
+    if (sample * 3 < std::uint64_t{window_size_} * 2) return std::nullopt;
+
+    const auto new_window_size = static_cast<std::uint32_t>(std::min<std::uint64_t>(sample * 2, max_window_size_));
+    if (new_window_size <= window_size_) return std::nullopt;
+    window_size_ = new_window_size;
+    return window_size_;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
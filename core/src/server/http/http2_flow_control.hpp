@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Grows the receive window of an HTTP/2 connection up to the bandwidth-delay
+/// product measured with PING round trips.
+///
+/// A probe PING is sent along with the first DATA frame, the bytes received
+/// until the PING ACK are the BDP sample. A sample that takes more than 2/3 of
+/// the window means that the peer is blocked by the window, so the window is
+/// set to the doubled sample.
+class WindowSizeEstimator final {
+public:
+    WindowSizeEstimator(std::uint32_t window_size, std::uint32_t max_window_size) noexcept;
+
+    /// @returns true if a probe PING should be sent
+    bool OnDataReceived(std::size_t bytes) noexcept;
+
+    /// @returns the new window size if the window should grow
+    std::optional<std::uint32_t> OnProbeAck() noexcept;
+
+    std::uint32_t GetWindowSize() const noexcept { return window_size_; }
+
+    bool IsProbeInFlight() const noexcept { return probe_in_flight_; }
+
+private:
+    std::uint32_t window_size_;
+    const std::uint32_t max_window_size_;
+    std::uint64_t sample_{0};
+    bool probe_in_flight_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,60 @@
+#include <server/http/http2_flow_control.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+TEST(Http2WindowSizeEstimator, GrowsWhenSaturated) {
+    WindowSizeEstimator estimator{1 << 16, 1 << 20};
+
+    EXPECT_TRUE(estimator.OnDataReceived(1 << 14));
+    EXPECT_TRUE(estimator.IsProbeInFlight());
+    // a single probe at a time
+    EXPECT_FALSE(estimator.OnDataReceived(1 << 14));
+    EXPECT_FALSE(estimator.OnDataReceived(1 << 14));
+    EXPECT_FALSE(estimator.OnDataReceived(1 << 14));
+
+    // the whole window was received in a round trip
+    EXPECT_EQ(estimator.OnProbeAck(), std::uint32_t{1 << 17});
+    EXPECT_EQ(estimator.GetWindowSize(), std::uint32_t{1 << 17});
+    EXPECT_FALSE(estimator.IsProbeInFlight());
+}
+
+TEST(Http2WindowSizeEstimator, KeepsWindowForSlowPeer) {
+    WindowSizeEstimator estimator{1 << 16, 1 << 20};
+
+    EXPECT_TRUE(estimator.OnDataReceived(1000));
+    EXPECT_FALSE(estimator.OnDataReceived(1000));
+    EXPECT_EQ(estimator.OnProbeAck(), std::nullopt);
+    EXPECT_EQ(estimator.GetWindowSize(), std::uint32_t{1 << 16});
+
+    // the sample starts over with a new probe
+    EXPECT_TRUE(estimator.OnDataReceived(40000));
+    EXPECT_EQ(estimator.OnProbeAck(), std::nullopt);
+    EXPECT_TRUE(estimator.OnDataReceived(50000));
+    EXPECT_EQ(estimator.OnProbeAck(), std::uint32_t{100000});
+}
+
+TEST(Http2WindowSizeEstimator, MaxWindowSize) {
+    WindowSizeEstimator estimator{1 << 16, 100000};
+
+    EXPECT_TRUE(estimator.OnDataReceived(1 << 20));
+    EXPECT_EQ(estimator.OnProbeAck(), std::uint32_t{100000});
+
+    // no more probes once the max is reached
+    EXPECT_FALSE(estimator.OnDataReceived(1 << 20));
+    EXPECT_EQ(estimator.OnProbeAck(), std::nullopt);
+    EXPECT_EQ(estimator.GetWindowSize(), std::uint32_t{100000});
+}
+
+TEST(Http2WindowSizeEstimator, UnexpectedAck) {
+    WindowSizeEstimator estimator{1 << 16, 1 << 20};
+    EXPECT_EQ(estimator.OnProbeAck(), std::nullopt);
+    EXPECT_EQ(estimator.GetWindowSize(), std::uint32_t{1 << 16});
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
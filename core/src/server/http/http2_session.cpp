@@ -1,9 +1,15 @@
 #include <server/http/http2_session.hpp>
 
+#include <algorithm>
+#include <cstring>
+
+#include <boost/container/small_vector.hpp>
+
 #include <server/http/http_request_parser.hpp>
 #include <server/net/connection_config.hpp>
 
 #include <userver/crypto/base64.hpp>
+#include <userver/engine/io/exception.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
@@ -16,6 +22,13 @@ namespace {
 
 constexpr std::size_t kFrameHeaderSize = 9;
 
+// Opaque data of the PINGs that measure the bandwidth-delay product
+constexpr std::array<std::uint8_t, 8> kWindowProbeData{'u', 's', 'e', 'r', 'v', 'b', 'd', 'p'};
+
+std::int32_t ToWindowSize(std::uint32_t size) {
+    return static_cast<std::int32_t>(std::min<std::uint32_t>(size, NGHTTP2_MAX_WINDOW_SIZE));
+}
+
 void ThrowIfErr(int error_code, std::string_view msg) {
     if (error_code != 0) {
         throw std::runtime_error{fmt::format("{}: {}", msg, nghttp2_strerror(error_code))};
@@ -77,15 +90,34 @@ Http2Session::Http2Session(
     UASSERT(session);
     session_ = SessionPtr(session, nghttp2_session_del);
 
-    std::array<nghttp2_settings_entry, 3> settings{
+    boost::container::small_vector<nghttp2_settings_entry, 4> settings{
         nghttp2_settings_entry{NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, config.max_concurrent_streams},
         nghttp2_settings_entry{NGHTTP2_SETTINGS_MAX_FRAME_SIZE, config.max_frame_size},
         nghttp2_settings_entry{NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, config.initial_window_size}};
+#if NGHTTP2_VERSION_NUM >= 0x013100
+    // nghttp2 parses the `priority` header and PRIORITY_UPDATE frames and
+    // schedules the DATA frames by urgency once the setting is sent
+    if (config.rfc9218_priorities) {
+        settings.push_back(nghttp2_settings_entry{NGHTTP2_SETTINGS_NO_RFC7540_PRIORITIES, 1});
+    }
+#endif
 
     auto rv = nghttp2_submit_settings(session_.get(), NGHTTP2_FLAG_NONE, settings.data(), settings.size());
     ThrowIfErr(rv, "Error when submit settings");
+    rv = nghttp2_session_set_local_window_size(
+        session_.get(), NGHTTP2_FLAG_NONE, 0, ToWindowSize(config.connection_window_size)
+    );
+    ThrowIfErr(rv, "Error when set the connection window size");
+    if (config.adaptive_window) {
+        window_estimator_.emplace(
+            std::min(config.initial_window_size, config.connection_window_size),
+            std::min<std::uint32_t>(config.max_window_size, NGHTTP2_MAX_WINDOW_SIZE)
+        );
+    }
+
     rv = nghttp2_session_send(session_.get());
     ThrowIfErr(rv, "Error when session send");
+    FlushOutput();
 }
 
 int Http2Session::OnFrameRecv(nghttp2_session* session, const nghttp2_frame* frame, void* user_data) {
@@ -111,7 +143,11 @@ int Http2Session::OnFrameRecv(nghttp2_session* session, const nghttp2_frame* fra
             IncStat(parser.stats_.http2_stats.reset_streams);
         } break;
         case NGHTTP2_PING: {
-            nghttp2_submit_ping(parser.session_.get(), NGHTTP2_FLAG_NONE, nullptr);
+            // nghttp2 acknowledges the PINGs of the client by itself
+            if ((frame->hd.flags & NGHTTP2_FLAG_ACK) &&
+                std::memcmp(frame->ping.opaque_data, kWindowProbeData.data(), kWindowProbeData.size()) == 0) {
+                parser.OnWindowProbeAck();
+            }
         } break;
         case NGHTTP2_GOAWAY: {
             IncStat(parser.stats_.http2_stats.goaway);
@@ -203,6 +239,9 @@ int Http2Session::OnDataChunkRecv(
     } catch (const std::exception& e) {
         LOG_LIMITED_WARNING() << "can't append body: " << e;
     }
+    if (parser.window_estimator_ && parser.window_estimator_->OnDataReceived(len)) {
+        parser.SubmitWindowProbe();
+    }
     return 0;
 }
 
@@ -210,10 +249,11 @@ long Http2Session::OnSend(nghttp2_session* session, const uint8_t* data, size_t
     UASSERT(session);
     UASSERT(data);
     auto& parser = GetParser(user_data);
-    if (parser.socket_ != nullptr) {
-        return parser.socket_->WriteAll(data, len, {});
+    if (parser.socket_ == nullptr) {
+        return NGHTTP2_ERR_WOULDBLOCK;
     }
-    return NGHTTP2_ERR_WOULDBLOCK;
+    parser.AppendOutput(ToStringView(data, len));
+    return static_cast<long>(len);
 }
 
 int Http2Session::OnDataFrameSend(
@@ -235,10 +275,10 @@ int Http2Session::OnDataFrameSend(
     auto& stream = *static_cast<Stream*>(source->ptr);
 
     const auto frame_header{ToStringView(framehd, kFrameHeaderSize)};
-    // TODO: doesn't work with TLS?!
-    UASSERT(dynamic_cast<engine::io::Socket*>(parser.socket_));
-    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
-    stream.Send(*static_cast<engine::io::Socket*>(parser.socket_), frame_header, max_len);
+    stream.WriteTo(parser.output_, frame_header, max_len);
+    if (parser.output_.size() >= parser.config_.write_buffer_size) {
+        parser.FlushOutput();
+    }
     return 0;
 }
 
@@ -349,6 +389,55 @@ void Http2Session::WriteWhileWant() {
         const auto res = nghttp2_session_send(session);
         ThrowIfErr(res, "Error while nghttp2_session_send");
     }
+    FlushOutput();
+}
+
+void Http2Session::AppendOutput(std::string_view data) {
+    output_.append(data);
+    if (output_.size() >= config_.write_buffer_size) {
+        FlushOutput();
+    }
+}
+
+void Http2Session::FlushOutput() {
+    if (output_.empty() || socket_ == nullptr) {
+        return;
+    }
+    const utils::FastScopeGuard clear_guard{[this]() noexcept { output_.clear(); }};
+    if (socket_->WriteAll(output_.data(), output_.size(), {}) != output_.size()) {
+        throw(engine::io::IoException() << "Socket closed during transfer");
+    }
+}
+
+void Http2Session::SubmitWindowProbe() {
+    const auto res = nghttp2_submit_ping(session_.get(), NGHTTP2_FLAG_NONE, kWindowProbeData.data());
+    if (res != 0) {
+        LOG_LIMITED_WARNING() << "Failed to submit the window probe: " << nghttp2_strerror(res);
+    }
+}
+
+void Http2Session::OnWindowProbeAck() {
+    if (!window_estimator_) {
+        return;
+    }
+    const auto window_size = window_estimator_->OnProbeAck();
+    if (!window_size) {
+        return;
+    }
+
+    auto res = nghttp2_session_set_local_window_size(
+        session_.get(), NGHTTP2_FLAG_NONE, 0, ToWindowSize(std::max(*window_size, config_.connection_window_size))
+    );
+    if (res == 0 && *window_size > config_.initial_window_size) {
+        const nghttp2_settings_entry setting{NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, *window_size};
+        res = nghttp2_submit_settings(session_.get(), NGHTTP2_FLAG_NONE, &setting, 1);
+    }
+    if (res != 0) {
+        LOG_LIMITED_WARNING() << "Failed to grow the window up to " << *window_size << ": " << nghttp2_strerror(res);
+        return;
+    }
+    LOG_LIMITED_DEBUG() << "HTTP/2 window of " << remote_address_.PrimaryAddressString() << " grown up to "
+                        << *window_size;
 }
 
 engine::SingleConsumerEvent& Http2Session::GetStreamingEvent() { return streaming_event_; }
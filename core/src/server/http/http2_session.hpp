@@ -3,6 +3,7 @@
 #include <nghttp2/nghttp2.h>
 #include <boost/pool/object_pool.hpp>
 
+#include <server/http/http2_flow_control.hpp>
 #include <server/http/http2_stream.hpp>
 #include <server/http/http2_writer.hpp>
 #include <server/http/http_request_constructor.hpp>
@@ -60,6 +61,8 @@ public:
 
     engine::SingleConsumerEvent& GetStreamingEvent();
 
+    // Sends the pending frames of all the streams, gathering them into as few
+    // writes as possible
     void WriteWhileWant();
     void HandleStreamingEvents();
 
@@ -110,6 +113,12 @@ private:
     void FinalizeRequest(Stream& stream);
     bool ConnectionIsOk();
 
+    void AppendOutput(std::string_view data);
+    void FlushOutput();
+
+    void SubmitWindowProbe();
+    void OnWindowProbeAck();
+
 private:
     friend class Http2ResponseWriter;
 
@@ -128,6 +137,9 @@ private:
     net::ParserStats& stats_;
     engine::io::Sockaddr remote_address_;
     engine::io::RwBase* socket_;
+    std::string output_;
+
+    std::optional<WindowSizeEstimator> window_estimator_;
 
     std::shared_ptr<impl::Http2StreamEventQueue> streaming_queue_{nullptr};
     engine::SingleConsumerEvent streaming_event_;
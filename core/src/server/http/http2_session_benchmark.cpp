@@ -0,0 +1,295 @@
+#include <server/http/http2_session.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <nghttp2/nghttp2.h>
+
+#include <server/http/http_request_parser.hpp>
+#include <server/net/connection_config.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Load benchmark: a batch of concurrent requests is parsed and answered over a
+// loopback TCP connection, while a separate task drains the client side.
+//
+// Arguments: requests in a batch, response body size.
+
+constexpr std::string_view kHttp1Request = "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+const server::request::HttpRequestConfig kRequestConfig{
+    /*.max_url_size = */ 8192,
+    /*.max_request_size = */ 1024 * 1024,
+    /*.max_headers_size = */ 65536,
+    /*.parse_args_from_body = */ false,
+    /*.testing_mode = */ false,
+    /*.decompress_request = */ false,
+    /* set_tracing_headers = */ false,
+    /* deadline_propagation_enabled = */ false,
+    /* deadline_expired_status_code = */ server::http::HttpStatus{498}};
+
+// Counts the writes of the server
+class CountingSocket final : public engine::io::RwBase {
+public:
+    explicit CountingSocket(engine::io::Socket& socket) : socket_(socket) {}
+
+    bool IsValid() const override { return socket_.IsValid(); }
+
+    bool WaitReadable(engine::Deadline deadline) override { return socket_.WaitReadable(deadline); }
+
+    size_t ReadSome(void* buf, size_t len, engine::Deadline deadline) override {
+        return socket_.ReadSome(buf, len, deadline);
+    }
+
+    size_t ReadAll(void* buf, size_t len, engine::Deadline deadline) override {
+        return socket_.ReadAll(buf, len, deadline);
+    }
+
+    bool WaitWriteable(engine::Deadline deadline) override { return socket_.WaitWriteable(deadline); }
+
+    size_t WriteAll(const void* buf, size_t len, engine::Deadline deadline) override {
+        return Account(socket_.WriteAll(buf, len, deadline));
+    }
+
+    size_t WriteAll(std::initializer_list<engine::io::IoData> list, engine::Deadline deadline) override {
+        return Account(socket_.WriteAll(list, deadline));
+    }
+
+    size_t WriteAll(const engine::io::IoData* list, std::size_t list_size, engine::Deadline deadline) override {
+        return Account(socket_.WriteAll(list, list_size, deadline));
+    }
+
+    std::uint64_t GetBytesWritten() const noexcept { return bytes_written_; }
+    std::uint64_t GetWrites() const noexcept { return writes_; }
+
+private:
+    size_t Account(size_t bytes) noexcept {
+        bytes_written_ += bytes;
+        ++writes_;
+        return bytes;
+    }
+
+    engine::io::Socket& socket_;
+    std::uint64_t bytes_written_{0};
+    std::uint64_t writes_{0};
+};
+
+// A client nghttp2 session with the windows that never block the server
+class Http2Client final {
+public:
+    Http2Client() {
+        nghttp2_session_callbacks* callbacks{nullptr};
+        UINVARIANT(nghttp2_session_callbacks_new(&callbacks) == 0, "Failed to init callbacks");
+        nghttp2_session_callbacks_set_on_stream_close_callback(
+            callbacks,
+            [](nghttp2_session*, int32_t, uint32_t, void* user_data) {
+                ++static_cast<Http2Client*>(user_data)->closed_streams_;
+                return 0;
+            }
+        );
+        UINVARIANT(nghttp2_session_client_new(&session_, callbacks, this) == 0, "Failed to init session");
+        nghttp2_session_callbacks_del(callbacks);
+
+        const nghttp2_settings_entry setting{NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, NGHTTP2_MAX_WINDOW_SIZE};
+        UINVARIANT(nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE, &setting, 1) == 0, "Failed to submit");
+        UINVARIANT(
+            nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE, 0, NGHTTP2_MAX_WINDOW_SIZE) == 0,
+            "Failed to set the window"
+        );
+    }
+
+    Http2Client(const Http2Client&) = delete;
+    Http2Client& operator=(const Http2Client&) = delete;
+    ~Http2Client() { nghttp2_session_del(session_); }
+
+    std::string MakeRequests(std::size_t count) {
+        auto lock = std::unique_lock{mutex_};
+        std::array<nghttp2_nv, 4> headers{
+            MakeHeader(":method", "GET"),
+            MakeHeader(":scheme", "http"),
+            MakeHeader(":authority", "localhost"),
+            MakeHeader(":path", "/")};
+        for (std::size_t i = 0; i < count; ++i) {
+            UINVARIANT(
+                nghttp2_submit_request(session_, nullptr, headers.data(), headers.size(), nullptr, nullptr) > 0,
+                "Failed to submit a request"
+            );
+        }
+
+        std::string result;
+        const std::uint8_t* data{nullptr};
+        while (const auto len = nghttp2_session_mem_send(session_, &data)) {
+            UINVARIANT(len > 0, "Failed to send");
+            result.append(reinterpret_cast<const char*>(data), len);
+        }
+        return result;
+    }
+
+    void Receive(const char* data, std::size_t size) {
+        auto lock = std::unique_lock{mutex_};
+        const auto res = nghttp2_session_mem_recv(session_, reinterpret_cast<const std::uint8_t*>(data), size);
+        UINVARIANT(res == static_cast<ssize_t>(size), "Failed to receive");
+    }
+
+    std::uint64_t GetClosedStreams() const noexcept { return closed_streams_; }
+
+private:
+    static nghttp2_nv MakeHeader(std::string_view name, std::string_view value) {
+        return {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())),
+            name.size(),
+            value.size(),
+            NGHTTP2_NV_FLAG_NONE};
+    }
+
+    engine::Mutex mutex_;
+    nghttp2_session* session_{nullptr};
+    std::atomic<std::uint64_t> closed_streams_{0};
+};
+
+struct Connection final {
+    Connection() {
+        auto [server, client] =
+            internal::net::TcpListener{}.MakeSocketPair(engine::Deadline::FromDuration(std::chrono::seconds{10}));
+        server_socket = std::move(server);
+        client_socket = std::move(client);
+    }
+
+    // Reads the client side until the socket is closed
+    engine::TaskWithResult<void> StartDrain(Http2Client* client) {
+        return engine::AsyncNoSpan([this, client] {
+            std::vector<char> buffer(256 * 1024);
+            while (const auto size = client_socket.ReadSome(buffer.data(), buffer.size(), {})) {
+                if (client) client->Receive(buffer.data(), size);
+                bytes_read += size;
+            }
+        });
+    }
+
+    void WaitDrained(const CountingSocket& socket) const {
+        while (bytes_read.load() < socket.GetBytesWritten()) engine::Yield();
+    }
+
+    engine::io::Socket server_socket;
+    engine::io::Socket client_socket;
+    std::atomic<std::uint64_t> bytes_read{0};
+};
+
+void SetCounters(benchmark::State& state, const CountingSocket& socket) {
+    const auto responses = state.iterations() * state.range(0);
+    state.SetItemsProcessed(responses);
+    state.SetBytesProcessed(responses * state.range(1));
+    state.counters["writes_per_response"] =
+        benchmark::Counter(static_cast<double>(socket.GetWrites()) / static_cast<double>(responses));
+}
+
+}  // namespace
+
+void http1_load(benchmark::State& state) {
+    engine::RunStandalone(2, [&] {
+        Connection connection;
+        CountingSocket socket{connection.server_socket};
+        auto drain = connection.StartDrain(nullptr);
+
+        const server::http::HandlerInfoIndex handler_info_index;
+        server::net::ParserStats stats;
+        server::request::ResponseDataAccounter accounter;
+        std::vector<std::shared_ptr<server::http::HttpRequest>> requests;
+        server::http::HttpRequestParser parser{
+            handler_info_index,
+            kRequestConfig,
+            [&requests](std::shared_ptr<server::http::HttpRequest>&& request) {
+                requests.push_back(std::move(request));
+            },
+            stats,
+            accounter,
+            engine::io::Sockaddr{}};
+
+        std::string pipelined_requests;
+        for (std::int64_t i = 0; i < state.range(0); ++i) pipelined_requests += kHttp1Request;
+        const std::string body(state.range(1), 'x');
+
+        for ([[maybe_unused]] auto _ : state) {
+            parser.Parse(pipelined_requests);
+            for (auto& request : requests) {
+                auto& response = request->GetHttpResponse();
+                response.SetData(body);
+                response.SendResponse(socket);
+            }
+            requests.clear();
+            connection.WaitDrained(socket);
+        }
+
+        SetCounters(state, socket);
+        connection.server_socket.Close();
+        drain.Get();
+    });
+}
+BENCHMARK(http1_load)->ArgsProduct({{1, 16, 64}, {128, 16 * 1024}});
+
+void http2_load(benchmark::State& state) {
+    engine::RunStandalone(2, [&] {
+        Connection connection;
+        CountingSocket socket{connection.server_socket};
+        Http2Client client;
+        auto drain = connection.StartDrain(&client);
+
+        const server::http::HandlerInfoIndex handler_info_index;
+        server::net::ParserStats stats;
+        server::request::ResponseDataAccounter accounter;
+        server::net::Http2SessionConfig config;
+        config.max_concurrent_streams = 128;
+        std::vector<std::shared_ptr<server::http::HttpRequest>> requests;
+        server::http::Http2Session session{
+            handler_info_index,
+            kRequestConfig,
+            config,
+            [&requests](std::shared_ptr<server::http::HttpRequest>&& request) {
+                requests.push_back(std::move(request));
+            },
+            stats,
+            accounter,
+            engine::io::Sockaddr{},
+            &socket};
+
+        const std::string body(state.range(1), 'x');
+
+        for ([[maybe_unused]] auto _ : state) {
+            session.Parse(client.MakeRequests(state.range(0)));
+            for (auto& request : requests) {
+                auto& response = request->GetHttpResponse();
+                response.SetData(body);
+                server::http::WriteHttp2ResponseToSocket(response, session);
+            }
+            requests.clear();
+            connection.WaitDrained(socket);
+        }
+
+        UINVARIANT(
+            client.GetClosedStreams() == static_cast<std::uint64_t>(state.iterations() * state.range(0)),
+            "Not all the responses were received"
+        );
+        SetCounters(state, socket);
+        connection.server_socket.Close();
+        drain.Get();
+    });
+}
+BENCHMARK(http2_load)->ArgsProduct({{1, 16, 64}, {128, 16 * 1024}});
+
+USERVER_NAMESPACE_END
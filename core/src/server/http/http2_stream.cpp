@@ -1,7 +1,5 @@
 #include <server/http/http2_stream.hpp>
 
-#include <userver/engine/io/socket.hpp>
-
 #include <numeric>  // std::accumulate
 
 USERVER_NAMESPACE_BEGIN
@@ -100,10 +98,10 @@ ssize_t Stream::GetMaxSize(std::size_t max_len, std::uint32_t* flags) {
     return res;
 }
 
-void Stream::Send(engine::io::Socket& socket, std::string_view data_frame_header, std::size_t max_len) {
-    boost::container::small_vector<engine::io::IoData, 16> parts{};
-    parts.push_back({data_frame_header.data(), data_frame_header.size()});
+void Stream::WriteTo(std::string& buffer, std::string_view data_frame_header, std::size_t max_len) {
+    buffer.append(data_frame_header);
     auto budget = max_len;
+    std::size_t sent_chunks_count = 0;
     for (const auto& chunk : chunks_) {
         if (budget == 0) {
             break;
@@ -111,19 +109,16 @@ void Stream::Send(engine::io::Socket& socket, std::string_view data_frame_header
         UASSERT(chunk.size() > pos_in_first_chunk_);
         const auto part =
             std::string_view{chunk}.substr(pos_in_first_chunk_, std::min(chunk.size() - pos_in_first_chunk_, budget));
-        parts.push_back({part.data(), part.size()});
+        buffer.append(part);
         pos_in_first_chunk_ += part.size();
         if (pos_in_first_chunk_ >= chunk.size()) {
             pos_in_first_chunk_ = 0;
+            ++sent_chunks_count;
         }
         UASSERT(budget >= part.size());
         budget -= part.size();
     }
-    UASSERT(!parts.empty());
-    [[maybe_unused]] const auto res = socket.SendAll(parts.data(), parts.size(), {});
-    const auto send_parts_count =
-        pos_in_first_chunk_ == 0 ? parts.size() - 1 : parts.size() - 2;  // data_frame_header doesn't matter
-    chunks_.erase(chunks_.begin(), chunks_.begin() + send_parts_count);
+    chunks_.erase(chunks_.begin(), chunks_.begin() + sent_chunks_count);
 }
 
 }  // namespace server::http
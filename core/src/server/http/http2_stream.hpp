@@ -9,10 +9,6 @@
 
 USERVER_NAMESPACE_BEGIN
 
-namespace engine::io {
-class Socket;
-}
-
 namespace server::http {
 
 class Stream final {
@@ -43,7 +39,8 @@ public:
     bool CheckUrlComplete();
     void PushChunk(std::string&& chunk);
     ssize_t GetMaxSize(std::size_t max_len, std::uint32_t* flags);
-    void Send(engine::io::Socket& socket, std::string_view data_frame_header, std::size_t max_len);
+    // Appends the DATA frame with up to max_len bytes of the body to the buffer
+    void WriteTo(std::string& buffer, std::string_view data_frame_header, std::size_t max_len);
     nghttp2_data_provider* GetNativeProvider() { return &nghttp2_provider_; }
 
 private:
@@ -1,5 +1,6 @@
 #include "http_request_handler.hpp"
 
+#include <array>
 #include <chrono>
 #include <stdexcept>
 
@@ -16,11 +17,70 @@
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/task_inherited_request.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+namespace {
+
+constexpr std::array kCriticalities{
+    handlers::Criticality::kCritical,
+    handlers::Criticality::kNormal,
+    handlers::Criticality::kSheddable,
+};
+
+}  // namespace
+
+struct CriticalityStatistics {
+    std::array<utils::statistics::RateCounter, kCriticalities.size()> accepted;
+    std::array<utils::statistics::RateCounter, kCriticalities.size()> rejected;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const CriticalityStatistics& stats) {
+    for (const auto criticality : kCriticalities) {
+        const auto index = static_cast<std::size_t>(criticality);
+        const utils::statistics::LabelView label{"criticality", handlers::ToString(criticality)};
+        writer["accepted"].ValueWithLabels(stats.accepted[index], label);
+        writer["rejected"].ValueWithLabels(stats.rejected[index], label);
+    }
+}
+
+namespace {
+
+utils::statistics::MetricTag<CriticalityStatistics> kCriticalityStatistics{"congestion-control.rps.criticality"};
+
+// Share of the congestion control RPS burst that is kept for the requests of
+// the higher criticality classes
+constexpr std::size_t kNormalReservePercent = 10;
+constexpr std::size_t kSheddableReservePercent = 50;
+
+std::size_t GetReservePercent(handlers::Criticality criticality) {
+    switch (criticality) {
+        case handlers::Criticality::kCritical:
+            return 0;
+        case handlers::Criticality::kNormal:
+            return kNormalReservePercent;
+        case handlers::Criticality::kSheddable:
+            return kSheddableReservePercent;
+    }
+    UINVARIANT(false, "Unexpected criticality");
+}
+
+}  // namespace
+
+handlers::Criticality GetRequestCriticality(const http::HttpRequest& request, const handlers::HandlerConfig& config) {
+    if (config.criticality_header) {
+        const auto& value = request.GetHeader(*config.criticality_header);
+        if (!value.empty()) {
+            if (const auto criticality = handlers::CriticalityFromString(value)) return *criticality;
+        }
+    }
+    return config.criticality;
+}
+
 HttpRequestHandler::HttpRequestHandler(
     const components::ComponentContext& component_context,
     const std::optional<std::string>& logger_access_component,
@@ -33,6 +93,7 @@ HttpRequestHandler::HttpRequestHandler(
       server_name_(std::move(server_name)),
       rate_limit_(utils::TokenBucket::MakeUnbounded()),
       metrics_(component_context.FindComponent<components::StatisticsStorage>().GetMetricsStorage()),
+      criticality_statistics_(metrics_->GetMetric(kCriticalityStatistics)),
       config_source_(component_context.FindComponent<components::DynamicConfig>().GetSource()) {
     auto& logging_component = component_context.FindComponent<components::Logging>();
 
@@ -109,7 +170,16 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(std::shared_pt
         return StartFailsafeTask(std::move(http_request));
     }
 
-    if (throttling_enabled && !rate_limit_.Obtain()) {
+    const auto criticality = GetRequestCriticality(*http_request, handler->GetConfig());
+    const auto criticality_index = static_cast<std::size_t>(criticality);
+    // Lower criticality classes leave a part of the burst to the higher ones,
+    // so they are rejected first
+    const auto reserve =
+        rate_limit_.IsUnbounded() ? 0 : rate_limit_.GetMaxSizeApprox() * GetReservePercent(criticality) / 100;
+
+    if (throttling_enabled && !rate_limit_.ObtainWithReserve(reserve)) {
+        ++criticality_statistics_.rejected[criticality_index];
+
         const auto config = config_source_.GetSnapshot();
         auto config_var = config[handlers::kCcCustomStatus];
         const auto& delta = config_var.max_time_delta;
@@ -133,10 +203,12 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(std::shared_pt
         LOG_LIMITED_ERROR() << "Request throttled (congestion control, "
                                "limit via USERVER_RPS_CCONTROL and USERVER_RPS_CCONTROL_ENABLED), "
                             << "limit=" << rate_limit_.GetRatePs() << "/sec, "
-                            << "url=" << http_request->GetUrl() << ", status_code=" << static_cast<size_t>(status);
+                            << "url=" << http_request->GetUrl() << ", status_code=" << static_cast<size_t>(status)
+                            << ", criticality=" << handlers::ToString(criticality);
 
         return StartFailsafeTask(std::move(http_request));
     }
+    if (throttling_enabled) ++criticality_statistics_.accepted[criticality_index];
 
     // config::operator[] && is forbidden, so this
     const auto get_config_stream_api_enabled = [this] {
@@ -18,6 +18,12 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+struct CriticalityStatistics;
+
+/// The criticality from the HandlerConfig::criticality_header of the request,
+/// HandlerConfig::criticality if there is no such header or it is invalid
+handlers::Criticality GetRequestCriticality(const http::HttpRequest& request, const handlers::HandlerConfig& config);
+
 class HttpRequestHandler final : public RequestHandlerBase {
 public:
     HttpRequestHandler(
@@ -65,6 +71,7 @@ private:
     std::atomic<HttpStatus> cc_status_code_{HttpStatus::kTooManyRequests};
     std::chrono::steady_clock::time_point cc_enabled_tp_;
     utils::statistics::MetricsStoragePtr metrics_;
+    CriticalityStatistics& criticality_statistics_;
     dynamic_config::Source config_source_;
 };
 
@@ -0,0 +1,68 @@
+#include <userver/utest/utest.hpp>
+
+#include <server/http/http_request_handler.hpp>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::handlers::Criticality;
+
+std::shared_ptr<server::http::HttpRequest> ParseRequest(const std::string& headers) {
+    std::shared_ptr<server::http::HttpRequest> result;
+    auto parser = server::CreateTestParser([&result](std::shared_ptr<server::http::HttpRequest>&& http_request) {
+        result = std::move(http_request);
+    });
+    parser->Parse("GET / HTTP/1.1\r\n" + headers + "\r\n");
+    return result;
+}
+
+server::handlers::HandlerConfig MakeConfig(std::optional<std::string> criticality_header) {
+    server::handlers::HandlerConfig config;
+    config.criticality = Criticality::kSheddable;
+    config.criticality_header = std::move(criticality_header);
+    return config;
+}
+
+}  // namespace
+
+UTEST(HttpRequestCriticality, HeaderOverridesConfig) {
+    const auto config = MakeConfig("X-Criticality");
+
+    const auto critical = ParseRequest("X-Criticality: critical\r\n");
+    ASSERT_TRUE(critical);
+    EXPECT_EQ(server::http::GetRequestCriticality(*critical, config), Criticality::kCritical);
+
+    // header names are case insensitive
+    const auto normal = ParseRequest("x-criticality: normal\r\n");
+    ASSERT_TRUE(normal);
+    EXPECT_EQ(server::http::GetRequestCriticality(*normal, config), Criticality::kNormal);
+}
+
+UTEST(HttpRequestCriticality, ConfigFallback) {
+    const auto config = MakeConfig("X-Criticality");
+
+    const auto missing = ParseRequest("");
+    ASSERT_TRUE(missing);
+    EXPECT_EQ(server::http::GetRequestCriticality(*missing, config), Criticality::kSheddable);
+
+    const auto empty = ParseRequest("X-Criticality: \r\n");
+    ASSERT_TRUE(empty);
+    EXPECT_EQ(server::http::GetRequestCriticality(*empty, config), Criticality::kSheddable);
+
+    const auto invalid = ParseRequest("X-Criticality: urgent\r\n");
+    ASSERT_TRUE(invalid);
+    EXPECT_EQ(server::http::GetRequestCriticality(*invalid, config), Criticality::kSheddable);
+}
+
+UTEST(HttpRequestCriticality, NoHeaderConfigured) {
+    const auto config = MakeConfig(std::nullopt);
+
+    const auto request = ParseRequest("X-Criticality: critical\r\n");
+    ASSERT_TRUE(request);
+    EXPECT_EQ(server::http::GetRequestCriticality(*request, config), Criticality::kSheddable);
+}
+
+USERVER_NAMESPACE_END
@@ -11,6 +11,11 @@ Http2SessionConfig Parse(const yaml_config::YamlConfig& value, formats::parse::T
     conf.max_concurrent_streams = value["max_concurrent_streams"].As<std::uint32_t>(conf.max_concurrent_streams);
     conf.max_frame_size = value["max_frame_size"].As<std::uint32_t>(conf.max_frame_size);
     conf.initial_window_size = value["initial_window_size"].As<std::uint32_t>(conf.initial_window_size);
+    conf.connection_window_size = value["connection_window_size"].As<std::uint32_t>(conf.connection_window_size);
+    conf.adaptive_window = value["adaptive_window"].As<bool>(conf.adaptive_window);
+    conf.max_window_size = value["max_window_size"].As<std::uint32_t>(conf.max_window_size);
+    conf.rfc9218_priorities = value["rfc9218_priorities"].As<bool>(conf.rfc9218_priorities);
+    conf.write_buffer_size = value["write_buffer_size"].As<std::size_t>(conf.write_buffer_size);
     return conf;
 }
 
@@ -22,6 +22,11 @@ struct Http2SessionConfig final {
     std::uint32_t max_concurrent_streams = 100;
     std::uint32_t max_frame_size = 1 << 14;
     std::uint32_t initial_window_size = 1 << 16;
+    std::uint32_t connection_window_size = 1 << 16;
+    bool adaptive_window = false;
+    std::uint32_t max_window_size = 1 << 24;
+    bool rfc9218_priorities = true;
+    std::size_t write_buffer_size = 64 * 1024;
 };
 
 struct ConnectionConfig {
@@ -5,7 +5,12 @@ USERVER_NAMESPACE_BEGIN
 namespace server::net {
 
 EndpointInfo::EndpointInfo(const ListenerConfig& listener_config, http::HttpRequestHandler& request_handler)
-    : listener_config(listener_config), request_handler(request_handler) {}
+    : listener_config(listener_config), request_handler(request_handler) {
+    if (listener_config.tls && listener_config.tls_session_resumption) {
+        tls_session_resumption =
+            std::make_unique<engine::io::TlsSessionResumption>(listener_config.tls_session_cache_size);
+    }
+}
 
 std::string EndpointInfo::GetDescription() const {
     if (listener_config.unix_socket_path.empty())
@@ -52,6 +52,14 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<Li
     if (!pkey_pass_name.empty()) {
         config.tls_private_key_passphrase_name = pkey_pass_name;
     }
+    config.tls_kernel_offload = value["tls"]["kernel-offload"].As<bool>(config.tls_kernel_offload);
+    config.tls_session_resumption = value["tls"]["session-resumption"].As<bool>(config.tls_session_resumption);
+    config.tls_session_cache_size = value["tls"]["session-cache-size"].As<size_t>(config.tls_session_cache_size);
+    config.tls_session_ticket_keys_name = value["tls"]["session-ticket-keys-name"].As<std::string>({});
+    if (!config.tls_session_ticket_keys_name.empty() && !config.tls_session_resumption) {
+        throw std::runtime_error("tls.session-ticket-keys-name requires tls.session-resumption to be enabled");
+    }
+
     auto ca_paths = value["tls"]["ca"].As<std::vector<std::string>>({});
     for (const auto& ca_path : ca_paths) {
         auto contents = fs::blocking::ReadFileContents(ca_path);
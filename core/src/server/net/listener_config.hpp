@@ -31,6 +31,10 @@ struct ListenerConfig {
     std::string tls_private_key_passphrase_name;
     crypto::PrivateKey tls_private_key;
     std::vector<crypto::Certificate> tls_certificate_authorities;
+    bool tls_kernel_offload{false};
+    bool tls_session_resumption{false};
+    size_t tls_session_cache_size = 20480;
+    std::string tls_session_ticket_keys_name;
 };
 
 ListenerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<ListenerConfig>);
@@ -101,9 +101,23 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
     auto remote_address = peer_socket.Getpeername();
     if (endpoint_info_->listener_config.tls) {
         const auto& config = endpoint_info_->listener_config;
-        socket = std::make_unique<engine::io::TlsWrapper>(engine::io::TlsWrapper::StartTlsServer(
-            std::move(peer_socket), config.tls_cert, config.tls_private_key, {}, config.tls_certificate_authorities
+        auto tls_socket = std::make_unique<engine::io::TlsWrapper>(engine::io::TlsWrapper::StartTlsServer(
+            std::move(peer_socket),
+            config.tls_cert,
+            config.tls_private_key,
+            {},
+            config.tls_certificate_authorities,
+            config.tls_kernel_offload ? engine::io::TlsOffload::kKernel : engine::io::TlsOffload::kNone,
+            endpoint_info_->tls_session_resumption.get()
         ));
+        ++stats_->tls_handshakes;
+        if (tls_socket->IsSessionReused()) {
+            ++stats_->tls_resumed_handshakes;
+        }
+        if (tls_socket->IsKernelTlsSendActive() || tls_socket->IsKernelTlsRecvActive()) {
+            ++stats_->kernel_tls_connections_created;
+        }
+        socket = std::move(tls_socket);
     } else {
         socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
     }
@@ -61,6 +61,9 @@ struct Stats {
     std::atomic<size_t> active_connections{0};
     std::atomic<size_t> connections_created{0};
     std::atomic<size_t> connections_closed{0};
+    std::atomic<size_t> kernel_tls_connections_created{0};
+    std::atomic<size_t> tls_handshakes{0};
+    std::atomic<size_t> tls_resumed_handshakes{0};
 
     // per connection
     ParserStats parser_stats;
@@ -75,6 +78,9 @@ struct StatsAggregation final {
         : active_connections{stats.active_connections.load()},
           connections_created{stats.connections_created.load()},
           connections_closed{stats.connections_closed.load()},
+          kernel_tls_connections_created{stats.kernel_tls_connections_created.load()},
+          tls_handshakes{stats.tls_handshakes.load()},
+          tls_resumed_handshakes{stats.tls_resumed_handshakes.load()},
           parser_stats{stats.parser_stats},
           active_request_count{stats.active_request_count.NonNegativeRead()},
           requests_processed_count{stats.requests_processed_count.Read()} {}
@@ -83,6 +89,9 @@ struct StatsAggregation final {
         active_connections += other.active_connections;
         connections_created += other.connections_created;
         connections_closed += other.connections_closed;
+        kernel_tls_connections_created += other.kernel_tls_connections_created;
+        tls_handshakes += other.tls_handshakes;
+        tls_resumed_handshakes += other.tls_resumed_handshakes;
 
         parser_stats += other.parser_stats;
         active_request_count += other.active_request_count;
@@ -94,6 +103,9 @@ struct StatsAggregation final {
     std::size_t active_connections{0};
     std::size_t connections_created{0};
     std::size_t connections_closed{0};
+    std::size_t kernel_tls_connections_created{0};
+    std::size_t tls_handshakes{0};
+    std::size_t tls_resumed_handshakes{0};
 
     // per connection
     ParserStatsAggregation parser_stats;
@@ -4,6 +4,7 @@
 #include <shared_mutex>
 #include <stdexcept>
 
+#include <userver/concurrent/async_event_source.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -17,6 +18,7 @@
 #include <server/pph_config.hpp>
 #include <server/requests_view.hpp>
 #include <server/server_config.hpp>
+#include <server/tls_session_ticket_keys_config.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/server/http/http_request.hpp>
 #include <userver/server/middlewares/configuration.hpp>
@@ -127,6 +129,8 @@ public:
     std::uint64_t GetTotalRequests() const;
 
 private:
+    void OnSecdistUpdate(const storages::secdist::SecdistConfig& secdist);
+
     PortInfo main_port_info_;
     PortInfo monitor_port_info_;
 
@@ -140,6 +144,8 @@ private:
 
     ServerConfig config_;
     std::vector<std::string> middlewares_;
+
+    concurrent::AsyncEventSubscriberScope secdist_subscriber_;
 };
 
 ServerImpl::ServerImpl(
@@ -171,6 +177,19 @@ ServerImpl::ServerImpl(
     middlewares_ = component_context.FindComponent<middlewares::PipelineBuilder>(config_.middleware_pipeline_builder)
                        .BuildPipeline(middlewares::DefaultPipeline());
 
+    const auto has_ticket_keys = [](const net::ListenerConfig& listener) {
+        return listener.tls && !listener.tls_session_ticket_keys_name.empty();
+    };
+    if (has_ticket_keys(config_.listener) ||
+        (config_.monitor_listener && has_ticket_keys(*config_.monitor_listener))) {
+        auto* secdist_component = component_context.FindComponentOptional<components::Secdist>();
+        if (!secdist_component) {
+            throw std::runtime_error("tls.session-ticket-keys-name requires the 'secdist' component");
+        }
+        secdist_subscriber_ =
+            secdist_component->GetStorage().UpdateAndListen(this, "server", &ServerImpl::OnSecdistUpdate);
+    }
+
     LOG_INFO() << "Server is created, listening for incoming connections.";
 }
 
@@ -205,11 +224,28 @@ void ServerImpl::Stop() {
     }
 
     LOG_INFO() << "Stopping server";
+    secdist_subscriber_.Unsubscribe();
     main_port_info_.Stop();
     monitor_port_info_.Stop();
     LOG_INFO() << "Stopped server";
 }
 
+void ServerImpl::OnSecdistUpdate(const storages::secdist::SecdistConfig& secdist) {
+    for (const auto* port_info : {&main_port_info_, &monitor_port_info_}) {
+        const auto& endpoint_info = port_info->endpoint_info_;
+        if (!endpoint_info || !endpoint_info->tls_session_resumption) continue;
+
+        const auto& keys_name = endpoint_info->listener_config.tls_session_ticket_keys_name;
+        if (keys_name.empty()) continue;
+
+        endpoint_info->tls_session_resumption->SetTicketKeys(
+            secdist.Get<TlsSessionTicketKeysConfig>().GetKeys(keys_name)
+        );
+        LOG_INFO() << "TLS session ticket keys '" << keys_name << "' are updated for "
+                   << endpoint_info->GetDescription();
+    }
+}
+
 void ServerImpl::AddHandler(const handlers::HttpHandlerBase& handler, engine::TaskProcessor& task_processor) {
     UASSERT(!main_port_info_.IsRunning());
 
@@ -339,6 +375,9 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
         conn_stats["active"] = server_stats.active_connections;
         conn_stats["opened"] = server_stats.connections_created;
         conn_stats["closed"] = server_stats.connections_closed;
+        conn_stats["opened-kernel-tls"] = server_stats.kernel_tls_connections_created;
+        conn_stats["tls-handshakes"] = server_stats.tls_handshakes;
+        conn_stats["tls-resumed-handshakes"] = server_stats.tls_resumed_handshakes;
     }
 
     if (auto request_stats = writer["requests"]) {
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/crypto/base64.hpp>
+#include <userver/utils/strong_typedef.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server {
+
+class TlsSessionTicketKeysConfig final {
+public:
+    using Key = utils::NonLoggable<class TicketKeyT, std::string>;
+
+    explicit TlsSessionTicketKeysConfig(const formats::json::Value& doc)
+        : keys_(doc["tls_session_ticket_keys"].As<std::unordered_map<std::string, std::vector<Key>>>({})) {}
+
+    /// Returns the decoded keys, the newest first
+    std::vector<std::string> GetKeys(const std::string& name) const {
+        auto it = keys_.find(name);
+        if (it == keys_.cend()) {
+            auto message =
+                fmt::format("No session ticket keys with name '{}' in secdist 'tls_session_ticket_keys' entry", name);
+            LOG_ERROR() << message;
+            throw std::runtime_error(std::move(message));
+        }
+
+        std::vector<std::string> result;
+        result.reserve(it->second.size());
+        for (const auto& key : it->second) {
+            result.push_back(crypto::base64::Base64Decode(key.GetUnderlying()));
+        }
+        return result;
+    }
+
+private:
+    std::unordered_map<std::string, std::vector<Key>> keys_;
+};
+
+}  // namespace server
+
+USERVER_NAMESPACE_END
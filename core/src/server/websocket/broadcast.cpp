@@ -0,0 +1,262 @@
+#include <userver/server/websocket/broadcast.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket {
+
+namespace impl {
+
+struct PendingMessages final {
+    std::deque<PreparedMessage> messages;
+    std::deque<std::chrono::steady_clock::time_point> enqueued_at;
+};
+
+struct BroadcastSubscriber final {
+    explicit BroadcastSubscriber(std::shared_ptr<WebSocketConnection> connection)
+        : connection(std::move(connection)) {}
+
+    const std::shared_ptr<WebSocketConnection> connection;
+    concurrent::Variable<PendingMessages> pending;
+    engine::SingleConsumerEvent event;
+    // false after a write error or a disconnect for being too slow
+    std::atomic<bool> active{true};
+    std::atomic<bool> disconnect{false};
+    engine::TaskWithResult<void> writer;
+};
+
+class BroadcastGroupImpl final {
+public:
+    explicit BroadcastGroupImpl(BroadcastConfig config) : config_(std::move(config)) {
+        UINVARIANT(config_.max_pending_messages > 0, "max_pending_messages must be positive");
+        UINVARIANT(
+            config_.max_batch_size > 0 && config_.max_batch_size <= IOV_MAX,
+            "max_batch_size must be in [1, IOV_MAX] range"
+        );
+    }
+
+    std::shared_ptr<BroadcastSubscriber> Subscribe(std::shared_ptr<WebSocketConnection> connection) {
+        UINVARIANT(connection, "Cannot subscribe an empty connection");
+        auto subscriber = std::make_shared<BroadcastSubscriber>(std::move(connection));
+        // The subscription owns both the group and the subscriber and stops
+        // the writer before releasing them
+        subscriber->writer =
+            engine::CriticalAsyncNoSpan(engine::current_task::GetTaskProcessor(), [this, &subscriber = *subscriber] {
+                RunWriter(subscriber);
+            });
+
+        {
+            auto subscribers = subscribers_.Lock();
+            subscribers->emplace(subscriber.get(), subscriber);
+            stats_.subscribers = static_cast<std::int64_t>(subscribers->size());
+        }
+        return subscriber;
+    }
+
+    void Unsubscribe(BroadcastSubscriber& subscriber) noexcept {
+        {
+            auto subscribers = subscribers_.Lock();
+            subscribers->erase(&subscriber);
+            stats_.subscribers = static_cast<std::int64_t>(subscribers->size());
+        }
+        subscriber.writer.SyncCancel();
+    }
+
+    void Broadcast(const PreparedMessage& message) {
+        ++stats_.messages;
+        const auto now = std::chrono::steady_clock::now();
+
+        auto subscribers = subscribers_.Lock();
+        for (const auto& [_, subscriber] : *subscribers) {
+            if (subscriber->active.load()) Enqueue(*subscriber, message, now);
+        }
+    }
+
+    std::size_t GetSubscribersCount() const {
+        auto subscribers = subscribers_.Lock();
+        return subscribers->size();
+    }
+
+    const BroadcastConfig& GetConfig() const noexcept { return config_; }
+
+    const BroadcastStatistics& GetStatistics() const noexcept { return stats_; }
+
+private:
+    void Enqueue(
+        BroadcastSubscriber& subscriber,
+        const PreparedMessage& message,
+        std::chrono::steady_clock::time_point now
+    ) {
+        {
+            auto pending = subscriber.pending.Lock();
+            if (pending->messages.size() >= config_.max_pending_messages) {
+                switch (config_.overflow_policy) {
+                    case OverflowPolicy::kDropOldest:
+                        pending->messages.pop_front();
+                        pending->enqueued_at.pop_front();
+                        ++stats_.dropped;
+                        break;
+                    case OverflowPolicy::kDropNewest:
+                        ++stats_.dropped;
+                        return;
+                    case OverflowPolicy::kDisconnect:
+                        stats_.dropped.Add(utils::statistics::Rate{pending->messages.size() + 1});
+                        pending->messages.clear();
+                        pending->enqueued_at.clear();
+                        subscriber.active = false;
+                        subscriber.disconnect = true;
+                        subscriber.event.Send();
+                        return;
+                }
+            }
+            pending->messages.push_back(message);
+            pending->enqueued_at.push_back(now);
+        }
+        subscriber.event.Send();
+    }
+
+    void RunWriter(BroadcastSubscriber& subscriber) {
+        std::vector<PreparedMessage> batch;
+        std::vector<std::chrono::steady_clock::time_point> batch_enqueued_at;
+        batch.reserve(config_.max_batch_size);
+        batch_enqueued_at.reserve(config_.max_batch_size);
+
+        while (subscriber.event.WaitForEvent()) {
+            while (!subscriber.disconnect.load()) {
+                {
+                    auto pending = subscriber.pending.Lock();
+                    const auto count = std::min(pending->messages.size(), config_.max_batch_size);
+                    batch.assign(
+                        std::make_move_iterator(pending->messages.begin()),
+                        std::make_move_iterator(pending->messages.begin() + count)
+                    );
+                    batch_enqueued_at.assign(pending->enqueued_at.begin(), pending->enqueued_at.begin() + count);
+                    pending->messages.erase(pending->messages.begin(), pending->messages.begin() + count);
+                    pending->enqueued_at.erase(pending->enqueued_at.begin(), pending->enqueued_at.begin() + count);
+                }
+                if (batch.empty()) break;
+
+                try {
+                    subscriber.connection->SendPrepared(batch);
+                } catch (const std::exception& e) {
+                    // the subscription is being destroyed
+                    if (engine::current_task::ShouldCancel()) return;
+
+                    LOG_LIMITED_WARNING() << "Failed to broadcast to "
+                                          << subscriber.connection->RemoteAddr().PrimaryAddressString() << ": " << e;
+                    ++stats_.write_errors;
+                    subscriber.active = false;
+                    return;
+                }
+
+                ++stats_.writes;
+                stats_.sent.Add(utils::statistics::Rate{batch.size()});
+                const auto now = std::chrono::steady_clock::now();
+                auto& timings = stats_.fanout_timings.GetCurrentCounter();
+                for (const auto enqueued_at : batch_enqueued_at) {
+                    timings.Account(std::chrono::duration_cast<std::chrono::milliseconds>(now - enqueued_at).count());
+                }
+            }
+
+            if (subscriber.disconnect.load()) {
+                ++stats_.disconnected;
+                try {
+                    subscriber.connection->Close(CloseStatus::kPolicyViolation);
+                } catch (const std::exception& e) {
+                    LOG_LIMITED_INFO() << "Failed to close the slow broadcast subscriber "
+                                       << subscriber.connection->RemoteAddr().PrimaryAddressString() << ": " << e;
+                }
+                return;
+            }
+        }
+    }
+
+    const BroadcastConfig config_;
+    BroadcastStatistics stats_;
+    mutable concurrent::Variable<std::unordered_map<BroadcastSubscriber*, std::shared_ptr<BroadcastSubscriber>>>
+        subscribers_;
+};
+
+}  // namespace impl
+
+void DumpMetric(utils::statistics::Writer& writer, const BroadcastStatistics& stats) {
+    writer["messages"] = stats.messages;
+    writer["sent"] = stats.sent;
+    writer["dropped"] = stats.dropped;
+    writer["disconnected"] = stats.disconnected;
+    writer["write-errors"] = stats.write_errors;
+    writer["writes"] = stats.writes;
+    writer["subscribers"] = stats.subscribers.load();
+    writer["fanout-timings"] = stats.fanout_timings;
+}
+
+BroadcastGroup::Subscription::Subscription() noexcept = default;
+
+BroadcastGroup::Subscription::Subscription(
+    std::shared_ptr<impl::BroadcastGroupImpl> group,
+    std::shared_ptr<impl::BroadcastSubscriber> subscriber
+) noexcept
+    : group_(std::move(group)), subscriber_(std::move(subscriber)) {}
+
+BroadcastGroup::Subscription::Subscription(Subscription&&) noexcept = default;
+
+BroadcastGroup::Subscription& BroadcastGroup::Subscription::operator=(Subscription&& other) noexcept {
+    if (this != &other) {
+        Unsubscribe();
+        group_ = std::move(other.group_);
+        subscriber_ = std::move(other.subscriber_);
+    }
+    return *this;
+}
+
+BroadcastGroup::Subscription::~Subscription() { Unsubscribe(); }
+
+void BroadcastGroup::Subscription::Unsubscribe() noexcept {
+    if (!subscriber_) return;
+    group_->Unsubscribe(*subscriber_);
+    subscriber_.reset();
+    group_.reset();
+}
+
+bool BroadcastGroup::Subscription::IsActive() const noexcept { return subscriber_ && subscriber_->active.load(); }
+
+BroadcastGroup::BroadcastGroup(BroadcastConfig config)
+    : impl_(std::make_shared<impl::BroadcastGroupImpl>(std::move(config))) {}
+
+BroadcastGroup::~BroadcastGroup() = default;
+
+BroadcastGroup::Subscription BroadcastGroup::Subscribe(std::shared_ptr<WebSocketConnection> connection) {
+    return Subscription{impl_, impl_->Subscribe(std::move(connection))};
+}
+
+void BroadcastGroup::Broadcast(const PreparedMessage& message) { impl_->Broadcast(message); }
+
+void BroadcastGroup::BroadcastText(std::string_view message) {
+    Broadcast(PreparedMessage{message, /*is_text=*/true, impl_->GetConfig().deflate});
+}
+
+void BroadcastGroup::BroadcastBinary(std::string_view message) {
+    Broadcast(PreparedMessage{message, /*is_text=*/false, impl_->GetConfig().deflate});
+}
+
+std::size_t BroadcastGroup::GetSubscribersCount() const { return impl_->GetSubscribersCount(); }
+
+const BroadcastStatistics& BroadcastGroup::GetStatistics() const noexcept { return impl_->GetStatistics(); }
+
+}  // namespace server::websocket
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,297 @@
+#include <userver/server/websocket/broadcast.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/internal/net/net_listener.hpp>
+#include <userver/utest/utest.hpp>
+
+#include <server/websocket/deflate.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace ws = server::websocket;
+
+struct Frame {
+    bool is_final{false};
+    bool is_compressed{false};
+    int opcode{0};
+    std::string payload;
+};
+
+Frame ReadFrame(engine::io::Socket& socket, engine::Deadline deadline) {
+    unsigned char header[2]{};
+    EXPECT_EQ(socket.RecvAll(header, sizeof(header), deadline), sizeof(header));
+
+    std::size_t size = header[1] & 0x7f;
+    if (size >= 126) {
+        unsigned char extended[8]{};
+        const std::size_t extended_size = size == 126 ? 2 : 8;
+        EXPECT_EQ(socket.RecvAll(extended, extended_size, deadline), extended_size);
+        size = 0;
+        for (std::size_t i = 0; i < extended_size; ++i) size = (size << 8) | extended[i];
+    }
+
+    Frame frame;
+    frame.is_final = header[0] & 0x80;
+    frame.is_compressed = header[0] & 0x40;
+    frame.opcode = header[0] & 0x0f;
+    frame.payload.resize(size);
+    EXPECT_EQ(socket.RecvAll(frame.payload.data(), size, deadline), size);
+    return frame;
+}
+
+struct Peer {
+    std::shared_ptr<ws::WebSocketConnection> connection;
+    engine::io::Socket client;
+};
+
+Peer MakePeer(const std::optional<ws::DeflateParams>& deflate = std::nullopt) {
+    auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(
+        engine::Deadline::FromDuration(utest::kMaxTestWaitTime)
+    );
+    auto connection = ws::MakeWebSocket(
+        std::make_unique<engine::io::Socket>(std::move(server)), engine::io::Sockaddr{}, ws::Config{}, deflate
+    );
+    return {std::move(connection), std::move(client)};
+}
+
+// Blocks the writes until released or fails them
+class StuckConnection final : public ws::WebSocketConnection {
+public:
+    void Recv(ws::Message&) override {}
+    bool TryRecv(ws::Message&) override { return false; }
+    void Send(const ws::Message&) override {}
+    void SendText(std::string_view) override {}
+
+    void SendPrepared(utils::span<const ws::PreparedMessage> messages) override {
+        ++writes_started;
+        if (fail) throw engine::io::IoException("Connection reset by peer");
+        ASSERT_TRUE(release.WaitForEvent());
+        for (const auto& message : messages) sent.emplace_back(message.GetPayload());
+    }
+
+    void Close(ws::CloseStatus status_code) override { close_status = status_code; }
+
+    const engine::io::Sockaddr& RemoteAddr() const override { return addr_; }
+    void AddFinalTags(tracing::Span&) const override {}
+    void AddStatistics(ws::Statistics&) const override {}
+
+    std::atomic<int> writes_started{0};
+    bool fail{false};
+    engine::SingleConsumerEvent release;
+    std::vector<std::string> sent;
+    std::optional<ws::CloseStatus> close_status;
+
+protected:
+    void DoSendBinary(utils::span<const std::byte>) override {}
+
+private:
+    engine::io::Sockaddr addr_;
+};
+
+void WaitForWriteStarted(const StuckConnection& connection, int count) {
+    while (connection.writes_started < count) engine::Yield();
+}
+
+void WaitForSent(const ws::BroadcastGroup& group, std::uint64_t count) {
+    while (group.GetStatistics().sent.Load().value < count) engine::Yield();
+}
+
+}  // namespace
+
+UTEST(WebsocketBroadcast, Smoke) {
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    ws::BroadcastGroup group;
+
+    std::vector<Peer> peers;
+    std::vector<ws::BroadcastGroup::Subscription> subscriptions;
+    for (int i = 0; i < 3; ++i) {
+        peers.push_back(MakePeer());
+        subscriptions.push_back(group.Subscribe(peers.back().connection));
+    }
+    EXPECT_EQ(group.GetSubscribersCount(), 3);
+
+    const std::string big_message(100'000, 'x');
+    group.BroadcastText("hello");
+    group.BroadcastBinary(big_message);
+
+    for (auto& peer : peers) {
+        auto frame = ReadFrame(peer.client, deadline);
+        EXPECT_TRUE(frame.is_final);
+        EXPECT_FALSE(frame.is_compressed);
+        EXPECT_EQ(frame.opcode, 0x1);
+        EXPECT_EQ(frame.payload, "hello");
+
+        // broadcast messages are not fragmented
+        frame = ReadFrame(peer.client, deadline);
+        EXPECT_TRUE(frame.is_final);
+        EXPECT_EQ(frame.opcode, 0x2);
+        EXPECT_EQ(frame.payload, big_message);
+    }
+
+    WaitForSent(group, 6);
+    subscriptions.pop_back();
+    EXPECT_EQ(group.GetSubscribersCount(), 2);
+
+    const auto& stats = group.GetStatistics();
+    EXPECT_EQ(stats.messages.Load().value, 2u);
+    EXPECT_EQ(stats.sent.Load().value, 6u);
+    EXPECT_EQ(stats.dropped.Load().value, 0u);
+    EXPECT_EQ(stats.subscribers.load(), 2);
+}
+
+UTEST(WebsocketBroadcast, Compressed) {
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    ws::BroadcastConfig config;
+    config.deflate.enabled = true;
+    ws::BroadcastGroup group{config};
+
+    ws::DeflateParams no_context_takeover;
+    no_context_takeover.server_no_context_takeover = true;
+    auto compressing_peer = MakePeer(no_context_takeover);
+    // the shared frame would break the kept compression context
+    auto context_takeover_peer = MakePeer(ws::DeflateParams{});
+    auto plain_peer = MakePeer();
+
+    const auto subscription1 = group.Subscribe(compressing_peer.connection);
+    const auto subscription2 = group.Subscribe(context_takeover_peer.connection);
+    const auto subscription3 = group.Subscribe(plain_peer.connection);
+
+    const std::string message(1000, 'a');
+    group.BroadcastText(message);
+
+    auto frame = ReadFrame(compressing_peer.client, deadline);
+    EXPECT_TRUE(frame.is_compressed);
+    EXPECT_LT(frame.payload.size(), message.size());
+    ws::impl::PerMessageDeflate inflater{ws::DeflateParams{}, 6};
+    std::string decompressed;
+    EXPECT_EQ(inflater.Decompress(frame.payload, decompressed, message.size()), ws::CloseStatus::kNone);
+    EXPECT_EQ(decompressed, message);
+
+    for (auto* peer : {&context_takeover_peer, &plain_peer}) {
+        frame = ReadFrame(peer->client, deadline);
+        EXPECT_FALSE(frame.is_compressed);
+        EXPECT_EQ(frame.payload, message);
+    }
+}
+
+UTEST(WebsocketBroadcast, Batching) {
+    ws::BroadcastConfig config;
+    config.max_batch_size = 3;
+    ws::BroadcastGroup group{config};
+
+    auto connection = std::make_shared<StuckConnection>();
+    const auto subscription = group.Subscribe(connection);
+
+    group.BroadcastText("0");
+    WaitForWriteStarted(*connection, 1);
+    for (int i = 1; i < 5; ++i) group.BroadcastText(std::to_string(i));
+
+    connection->release.Send();
+    WaitForWriteStarted(*connection, 2);
+    connection->release.Send();
+    WaitForWriteStarted(*connection, 3);
+    connection->release.Send();
+    WaitForSent(group, 5);
+
+    EXPECT_EQ(connection->sent, (std::vector<std::string>{"0", "1", "2", "3", "4"}));
+    // the pending messages are written by 3 at once
+    EXPECT_EQ(connection->writes_started, 3);
+    EXPECT_EQ(group.GetStatistics().writes.Load().value, 3u);
+}
+
+UTEST(WebsocketBroadcast, DropOldest) {
+    ws::BroadcastConfig config;
+    config.max_pending_messages = 2;
+    config.overflow_policy = ws::OverflowPolicy::kDropOldest;
+    ws::BroadcastGroup group{config};
+
+    auto connection = std::make_shared<StuckConnection>();
+    const auto subscription = group.Subscribe(connection);
+
+    group.BroadcastText("0");
+    WaitForWriteStarted(*connection, 1);
+    for (int i = 1; i < 5; ++i) group.BroadcastText(std::to_string(i));
+
+    connection->release.Send();
+    WaitForWriteStarted(*connection, 2);
+    connection->release.Send();
+    WaitForSent(group, 3);
+
+    EXPECT_EQ(connection->sent, (std::vector<std::string>{"0", "3", "4"}));
+    EXPECT_EQ(group.GetStatistics().dropped.Load().value, 2u);
+    EXPECT_TRUE(subscription.IsActive());
+}
+
+UTEST(WebsocketBroadcast, DropNewest) {
+    ws::BroadcastConfig config;
+    config.max_pending_messages = 2;
+    config.overflow_policy = ws::OverflowPolicy::kDropNewest;
+    ws::BroadcastGroup group{config};
+
+    auto connection = std::make_shared<StuckConnection>();
+    const auto subscription = group.Subscribe(connection);
+
+    group.BroadcastText("0");
+    WaitForWriteStarted(*connection, 1);
+    for (int i = 1; i < 5; ++i) group.BroadcastText(std::to_string(i));
+
+    connection->release.Send();
+    WaitForWriteStarted(*connection, 2);
+    connection->release.Send();
+    WaitForSent(group, 3);
+
+    EXPECT_EQ(connection->sent, (std::vector<std::string>{"0", "1", "2"}));
+    EXPECT_EQ(group.GetStatistics().dropped.Load().value, 2u);
+}
+
+UTEST(WebsocketBroadcast, DisconnectSlowConsumer) {
+    ws::BroadcastConfig config;
+    config.max_pending_messages = 1;
+    config.overflow_policy = ws::OverflowPolicy::kDisconnect;
+    ws::BroadcastGroup group{config};
+
+    auto slow_connection = std::make_shared<StuckConnection>();
+    auto fast_peer = MakePeer();
+    const auto slow_subscription = group.Subscribe(slow_connection);
+    const auto fast_subscription = group.Subscribe(fast_peer.connection);
+
+    group.BroadcastText("0");
+    WaitForWriteStarted(*slow_connection, 1);
+    group.BroadcastText("1");
+    group.BroadcastText("2");
+    EXPECT_FALSE(slow_subscription.IsActive());
+    EXPECT_TRUE(fast_subscription.IsActive());
+
+    slow_connection->release.Send();
+    while (!slow_connection->close_status) engine::Yield();
+    EXPECT_EQ(slow_connection->close_status, ws::CloseStatus::kPolicyViolation);
+    EXPECT_EQ(slow_connection->sent, std::vector<std::string>{"0"});
+    EXPECT_EQ(group.GetStatistics().disconnected.Load().value, 1u);
+
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    for (const auto* expected : {"0", "1", "2"}) EXPECT_EQ(ReadFrame(fast_peer.client, deadline).payload, expected);
+}
+
+UTEST(WebsocketBroadcast, WriteError) {
+    ws::BroadcastGroup group;
+    auto connection = std::make_shared<StuckConnection>();
+    connection->fail = true;
+    const auto subscription = group.Subscribe(connection);
+
+    group.BroadcastText("0");
+    while (subscription.IsActive()) engine::Yield();
+    group.BroadcastText("1");
+
+    EXPECT_EQ(connection->writes_started, 1);
+    EXPECT_EQ(group.GetStatistics().write_errors.Load().value, 1u);
+    EXPECT_EQ(group.GetStatistics().sent.Load().value, 0u);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,246 @@
+#include <server/websocket/deflate.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+namespace {
+
+constexpr std::string_view kExtensionName = "permessage-deflate";
+
+// Z_SYNC_FLUSH ends the data with an empty stored block, RFC 7692 removes it
+// from the messages
+constexpr std::string_view kEmptyBlock{"\x00\x00\xff\xff", 4};
+
+constexpr int kMaxWindowBits = 15;
+// zlib deflate does not support the window of 8 bits
+constexpr int kMinDeflateWindowBits = 9;
+constexpr int kMinWindowBits = 8;
+constexpr int kMemLevel = 8;
+
+constexpr std::size_t kMinInflateBufferSize = 1024;
+
+std::string_view TrimSpaces(std::string_view str) {
+    while (!str.empty() && utils::text::IsAsciiSpace(str.front())) str.remove_prefix(1);
+    while (!str.empty() && utils::text::IsAsciiSpace(str.back())) str.remove_suffix(1);
+    return str;
+}
+
+std::optional<int> ParseWindowBits(std::string_view value) {
+    value = TrimSpaces(value);
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+        value = value.substr(1, value.size() - 2);
+    }
+
+    int result = 0;
+    const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (ec != std::errc{} || ptr != value.data() + value.size()) return std::nullopt;
+    if (result < kMinWindowBits || result > kMaxWindowBits) return std::nullopt;
+    return result;
+}
+
+struct DeflateOffer {
+    bool server_no_context_takeover = false;
+    bool client_no_context_takeover = false;
+    std::optional<int> server_max_window_bits;
+    bool has_client_max_window_bits = false;
+    std::optional<int> client_max_window_bits;
+};
+
+// https://datatracker.ietf.org/doc/html/rfc7692#section-7.1
+std::optional<DeflateOffer> ParseOffer(std::string_view offer) {
+    const auto params = utils::text::SplitIntoStringViewVector(offer, ";");
+    if (params.empty() || TrimSpaces(params.front()) != kExtensionName) return std::nullopt;
+
+    DeflateOffer result;
+    std::vector<std::string_view> seen;
+    for (auto it = std::next(params.begin()); it != params.end(); ++it) {
+        const auto param = TrimSpaces(*it);
+        const auto eq_pos = param.find('=');
+        const auto name = TrimSpaces(param.substr(0, eq_pos));
+        const std::optional<std::string_view> value =
+            eq_pos == std::string_view::npos ? std::nullopt : std::make_optional(param.substr(eq_pos + 1));
+
+        // parameters must not be repeated
+        if (std::find(seen.begin(), seen.end(), name) != seen.end()) return std::nullopt;
+        seen.push_back(name);
+
+        if (name == "server_no_context_takeover" && !value) {
+            result.server_no_context_takeover = true;
+        } else if (name == "client_no_context_takeover" && !value) {
+            result.client_no_context_takeover = true;
+        } else if (name == "server_max_window_bits" && value) {
+            result.server_max_window_bits = ParseWindowBits(*value);
+            if (!result.server_max_window_bits) return std::nullopt;
+        } else if (name == "client_max_window_bits") {
+            result.has_client_max_window_bits = true;
+            if (value) {
+                result.client_max_window_bits = ParseWindowBits(*value);
+                if (!result.client_max_window_bits) return std::nullopt;
+            }
+        } else {
+            return std::nullopt;
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+std::optional<DeflateNegotiation> NegotiateDeflate(std::string_view extensions, const DeflateConfig& config) {
+    if (!config.enabled) return std::nullopt;
+
+    for (const auto offer_str : utils::text::SplitIntoStringViewVector(extensions, ",")) {
+        const auto offer = ParseOffer(offer_str);
+        if (!offer) continue;
+
+        DeflateNegotiation result;
+        auto& params = result.params;
+        params.server_no_context_takeover = config.server_no_context_takeover || offer->server_no_context_takeover;
+        params.client_no_context_takeover = config.client_no_context_takeover || offer->client_no_context_takeover;
+        params.server_max_window_bits =
+            std::min(config.server_max_window_bits, offer->server_max_window_bits.value_or(kMaxWindowBits));
+        if (params.server_max_window_bits < kMinDeflateWindowBits) continue;
+
+        result.response = kExtensionName;
+        if (params.server_no_context_takeover) result.response += "; server_no_context_takeover";
+        if (params.client_no_context_takeover) result.response += "; client_no_context_takeover";
+        if (offer->server_max_window_bits || params.server_max_window_bits < kMaxWindowBits) {
+            result.response += fmt::format("; server_max_window_bits={}", params.server_max_window_bits);
+        }
+        // The client window may be limited only if the client supports that,
+        // the messages are decompressed with the max window anyway
+        const auto client_max_window_bits =
+            std::min(config.client_max_window_bits, offer->client_max_window_bits.value_or(kMaxWindowBits));
+        if (offer->has_client_max_window_bits && client_max_window_bits < kMaxWindowBits) {
+            result.response += fmt::format("; client_max_window_bits={}", client_max_window_bits);
+        }
+        return result;
+    }
+    return std::nullopt;
+}
+
+struct PerMessageDeflate::DeflateStream {
+    z_stream stream{};
+};
+
+struct PerMessageDeflate::InflateStream {
+    z_stream stream{};
+};
+
+void PerMessageDeflate::DeflateStreamDeleter::operator()(DeflateStream* deflate) const noexcept {
+    deflateEnd(&deflate->stream);
+    delete deflate;
+}
+
+void PerMessageDeflate::InflateStreamDeleter::operator()(InflateStream* inflate) const noexcept {
+    inflateEnd(&inflate->stream);
+    delete inflate;
+}
+
+PerMessageDeflate::PerMessageDeflate(const DeflateParams& params, int compression_level)
+    : params_(params), compression_level_(compression_level) {}
+
+PerMessageDeflate::~PerMessageDeflate() = default;
+
+void PerMessageDeflate::Compress(utils::span<const std::byte> message, std::string& out) {
+    if (!deflate_) {
+        auto deflate = std::make_unique<DeflateStream>();
+        const auto ret = deflateInit2(
+            &deflate->stream,
+            compression_level_,
+            Z_DEFLATED,
+            -std::max(params_.server_max_window_bits, kMinDeflateWindowBits),
+            kMemLevel,
+            Z_DEFAULT_STRATEGY
+        );
+        if (ret != Z_OK) throw std::runtime_error(fmt::format("deflateInit2 failed: {}", ret));
+        deflate_.reset(deflate.release());
+    }
+    auto& stream = deflate_->stream;
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(message.data()));
+    stream.avail_in = static_cast<uInt>(message.size());
+
+    // the bound does not include the flush marker
+    out.resize(deflateBound(&stream, message.size()) + kEmptyBlock.size() * 2);
+    std::size_t produced = 0;
+    do {
+        if (produced == out.size()) out.resize(out.size() * 2);
+        stream.next_out = reinterpret_cast<Bytef*>(out.data() + produced);
+        stream.avail_out = static_cast<uInt>(out.size() - produced);
+        const auto ret = deflate(&stream, Z_SYNC_FLUSH);
+        UINVARIANT(ret == Z_OK || ret == Z_BUF_ERROR, fmt::format("deflate failed: {}", ret));
+        produced = out.size() - stream.avail_out;
+    } while (stream.avail_out == 0);
+
+    UASSERT(std::string_view(out.data(), produced).substr(produced - kEmptyBlock.size()) == kEmptyBlock);
+    out.resize(produced - kEmptyBlock.size());
+
+    if (params_.server_no_context_takeover) deflateReset(&stream);
+}
+
+CloseStatus PerMessageDeflate::Decompress(std::string_view message, std::string& out, std::size_t max_size) {
+    if (!inflate_) {
+        auto inflate = std::make_unique<InflateStream>();
+        // the client window is never larger than the max one
+        const auto ret = inflateInit2(&inflate->stream, -kMaxWindowBits);
+        if (ret != Z_OK) throw std::runtime_error(fmt::format("inflateInit2 failed: {}", ret));
+        inflate_.reset(inflate.release());
+    }
+    auto& stream = inflate_->stream;
+
+    out.resize(std::min(std::max(message.size() * 4, kMinInflateBufferSize), max_size + 1));
+    std::size_t produced = 0;
+    bool stream_end = false;
+
+    const auto inflate_chunk = [&](std::string_view chunk) {
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(chunk.data()));
+        stream.avail_in = static_cast<uInt>(chunk.size());
+        while (!stream_end) {
+            if (produced == out.size()) {
+                if (produced > max_size) return CloseStatus::kTooBigData;
+                out.resize(std::min(out.size() * 2, max_size + 1));
+            }
+            stream.next_out = reinterpret_cast<Bytef*>(out.data() + produced);
+            stream.avail_out = static_cast<uInt>(out.size() - produced);
+            const auto ret = inflate(&stream, Z_SYNC_FLUSH);
+            produced = out.size() - stream.avail_out;
+
+            if (ret == Z_STREAM_END) {
+                stream_end = true;
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                return CloseStatus::kBadMessageData;
+            } else if (stream.avail_out != 0) {
+                // all the input is consumed
+                break;
+            }
+        }
+        return CloseStatus::kNone;
+    };
+
+    auto status = inflate_chunk(message);
+    if (status == CloseStatus::kNone) status = inflate_chunk(kEmptyBlock);
+    if (status == CloseStatus::kNone && produced > max_size) status = CloseStatus::kTooBigData;
+
+    if (status != CloseStatus::kNone || stream_end || params_.client_no_context_takeover) inflateReset(&stream);
+    out.resize(status == CloseStatus::kNone ? produced : 0);
+    return status;
+}
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/server/websocket/server.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+struct DeflateNegotiation final {
+    DeflateParams params;
+    // value of the Sec-WebSocket-Extensions response header
+    std::string response;
+};
+
+// Picks the first permessage-deflate offer from the Sec-WebSocket-Extensions
+// request header that is acceptable with `config`
+std::optional<DeflateNegotiation> NegotiateDeflate(std::string_view extensions, const DeflateConfig& config);
+
+// permessage-deflate state of a connection. Compress() and Decompress() use
+// separate streams and may be called concurrently from the writer and
+// the reader. zlib streams are allocated on the first use.
+class PerMessageDeflate final {
+public:
+    PerMessageDeflate(const DeflateParams& params, int compression_level);
+    ~PerMessageDeflate();
+
+    PerMessageDeflate(const PerMessageDeflate&) = delete;
+    PerMessageDeflate& operator=(const PerMessageDeflate&) = delete;
+
+    const DeflateParams& GetParams() const noexcept { return params_; }
+
+    // Compresses a whole message into `out`
+    void Compress(utils::span<const std::byte> message, std::string& out);
+
+    // Decompresses a whole message into `out`, returns kTooBigData if the
+    // result exceeds `max_size` and kBadMessageData on invalid data
+    CloseStatus Decompress(std::string_view message, std::string& out, std::size_t max_size);
+
+private:
+    struct DeflateStream;
+    struct InflateStream;
+    struct DeflateStreamDeleter {
+        void operator()(DeflateStream*) const noexcept;
+    };
+    struct InflateStreamDeleter {
+        void operator()(InflateStream*) const noexcept;
+    };
+
+    const DeflateParams params_;
+    const int compression_level_;
+    std::unique_ptr<DeflateStream, DeflateStreamDeleter> deflate_;
+    std::unique_ptr<InflateStream, InflateStreamDeleter> inflate_;
+};
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
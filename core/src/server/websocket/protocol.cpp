@@ -1,5 +1,13 @@
 #include <server/websocket/protocol.hpp>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include <cstdlib>
 #include <cstring>
 
@@ -55,16 +63,6 @@ union Mask32 {
     uint8_t mask8[4];
 };
 
-void XorMaskInplace(uint8_t* dest, size_t len, Mask32 mask) {
-    auto* dest32 = reinterpret_cast<uint32_t*>(dest);
-    while (len >= sizeof(uint32_t)) {
-        *(dest32++) ^= mask.mask32;
-        len -= sizeof(uint32_t);
-    }
-    auto* dest8 = reinterpret_cast<uint8_t*>(dest32);
-    for (unsigned i = 0; i < len; ++i) *(dest8++) ^= mask.mask8[i];
-}
-
 template <class T, class V>
 void PushRaw(const T& value, V& data) {
     const auto* valBytes = reinterpret_cast<const char*>(&value);
@@ -73,10 +71,52 @@ void PushRaw(const T& value, V& data) {
 
 }  // namespace
 
+// Every step consumes a multiple of 4 bytes, so the mask stays in phase
+void XorMaskInplace(char* data, std::size_t len, std::uint32_t mask) noexcept {
+    auto* dest = reinterpret_cast<unsigned char*>(data);
+
+#if defined(__AVX2__)
+    const __m256i mask256 = _mm256_set1_epi32(static_cast<int>(mask));
+    for (; len >= sizeof(__m256i); len -= sizeof(__m256i), dest += sizeof(__m256i)) {
+        auto* chunk = reinterpret_cast<__m256i*>(dest);
+        _mm256_storeu_si256(chunk, _mm256_xor_si256(_mm256_loadu_si256(chunk), mask256));
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i mask128 = _mm_set1_epi32(static_cast<int>(mask));
+    for (; len >= sizeof(__m128i); len -= sizeof(__m128i), dest += sizeof(__m128i)) {
+        auto* chunk = reinterpret_cast<__m128i*>(dest);
+        _mm_storeu_si128(chunk, _mm_xor_si128(_mm_loadu_si128(chunk), mask128));
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t mask128 = vreinterpretq_u8_u32(vdupq_n_u32(mask));
+    for (; len >= sizeof(mask128); len -= sizeof(mask128), dest += sizeof(mask128)) {
+        vst1q_u8(dest, veorq_u8(vld1q_u8(dest), mask128));
+    }
+#endif
+
+    const std::uint64_t mask64 = (std::uint64_t{mask} << 32) | mask;
+    for (; len >= sizeof(mask64); len -= sizeof(mask64), dest += sizeof(mask64)) {
+        std::uint64_t chunk = 0;
+        std::memcpy(&chunk, dest, sizeof(chunk));
+        chunk ^= mask64;
+        std::memcpy(dest, &chunk, sizeof(chunk));
+    }
+
+    Mask32 mask_bytes;
+    mask_bytes.mask32 = mask;
+    for (std::size_t i = 0; i < len; ++i) dest[i] ^= mask_bytes.mask8[i % 4];
+}
+
 namespace frames {
 
-boost::container::small_vector<char, impl::kMaxFrameHeaderSize>
-DataFrameHeader(utils::span<const std::byte> data, bool is_text, Continuation is_continuation, Final is_final) {
+boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
+    utils::span<const std::byte> data,
+    bool is_text,
+    Continuation is_continuation,
+    Final is_final,
+    Compressed is_compressed
+) {
     boost::container::small_vector<char, impl::kMaxFrameHeaderSize> frame;
 
     frame.resize(sizeof(WSHeader));
@@ -87,6 +127,7 @@ DataFrameHeader(utils::span<const std::byte> data, bool is_text, Continuation is
     hdr->bits.fin = is_final == Final::kYes ? 1 : 0;
     hdr->bits.opcode = is_text ? kText : kBinary;
     if (is_continuation == Continuation::kYes) hdr->bits.opcode = kContinuation;
+    if (is_compressed == Compressed::kYes) hdr->bits.reserved = kRsv1;
 
     if (data.size() <= 125) {
         hdr->bits.payloadLen = data.size();
@@ -164,6 +205,15 @@ CloseStatus ReadWSFrameImpl(
     // we assume that the WSHeader has been read a while ago
     if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
+    // RSV1 marks the compressed messages, other bits have no meaning
+    // without the extensions
+    if (hdr.bits.reserved & ~(frame.deflate_negotiated ? kRsv1 : 0)) return CloseStatus::kProtocolError;
+    if (hdr.bits.reserved & kRsv1) {
+        // only the first frame of a data message is marked
+        if (hdr.bits.opcode != kText && hdr.bits.opcode != kBinary) return CloseStatus::kProtocolError;
+        frame.is_compressed = true;
+    }
+
     const bool isDataFrame = (hdr.bits.opcode & (kText | kBinary)) || hdr.bits.opcode == kContinuation;
     if (hdr.bits.payloadLen <= 125) {
         payload_len = hdr.bits.payloadLen;
@@ -203,7 +253,7 @@ CloseStatus ReadWSFrameImpl(
         RecvExactly(io, MakeSpan(frame.payload->data() + newPayloadOffset, payload_len), {});
         if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
-        if (mask.mask32) XorMaskInplace(reinterpret_cast<uint8_t*>(frame.payload->data()), frame.payload->size(), mask);
+        if (mask.mask32) XorMaskInplace(frame.payload->data() + newPayloadOffset, payload_len, mask.mask32);
     }
     char opcode = hdr.bits.opcode;
     char fin = hdr.bits.fin;
@@ -63,6 +63,9 @@ static_assert(sizeof(WSHeader) == 2);
 
 constexpr inline unsigned int kMaxFrameHeaderSize = sizeof(WSHeader) + sizeof(uint64_t);
 
+// RSV1 bit of WSHeader::bits::reserved
+constexpr inline unsigned char kRsv1 = 0x4;
+
 namespace frames {
 
 enum class Continuation {
@@ -75,8 +78,18 @@ enum class Final {
     kNo,
 };
 
-boost::container::small_vector<char, impl::kMaxFrameHeaderSize>
-DataFrameHeader(utils::span<const std::byte> data, bool is_text, Continuation is_continuation, Final is_final);
+enum class Compressed {
+    kYes,
+    kNo,
+};
+
+boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
+    utils::span<const std::byte> data,
+    bool is_text,
+    Continuation is_continuation,
+    Final is_final,
+    Compressed is_compressed = Compressed::kNo
+);
 std::array<char, sizeof(WSHeader)> MakeControlFrame(WSOpcodes opcode, utils::span<const std::byte> data = {});
 std::string CloseFrame(CloseStatusInt status_code);
 
@@ -84,14 +97,33 @@ const std::array<char, sizeof(WSHeader)>& PingFrame();
 const std::array<char, sizeof(WSHeader)>& CloseFrame();
 }  // namespace frames
 
+// Encoded frames of a PreparedMessage
+struct PreparedFrames final {
+    // header followed by the payload
+    std::string frame;
+    std::size_t header_size{0};
+    // frame compressed without context takeover, empty if not compressed
+    std::string compressed_frame;
+    int compressed_window_bits{0};
+    bool is_text{false};
+};
+
 std::string WebsocketSecAnswer(std::string_view sec_key);
 
+// Applies the masking key in the network byte order to the payload starting
+// from its first byte
+void XorMaskInplace(char* data, std::size_t len, std::uint32_t mask) noexcept;
+
 struct FrameParserState {
     bool closed = false;
     bool ping_received = false;
     bool pong_received = false;
     bool waiting_continuation = false;
     bool is_text = false;
+    // permessage-deflate is negotiated and RSV1 bit is allowed
+    bool deflate_negotiated = false;
+    // RSV1 bit of the first frame of the current message
+    bool is_compressed = false;
     CloseStatusInt remote_close_status = 0;
     size_t offset_when_noblock = 0;
 
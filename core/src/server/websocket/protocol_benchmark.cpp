@@ -0,0 +1,149 @@
+#include <server/websocket/protocol.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <server/websocket/deflate.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace ws = server::websocket;
+
+constexpr std::uint32_t kMask = 0x12a4c6f8;
+
+// Reads the same data over and over
+class MemoryReader final : public engine::io::ReadableBase {
+public:
+    explicit MemoryReader(std::string data) : data_(std::move(data)) {}
+
+    bool IsValid() const override { return true; }
+
+    bool WaitReadable(engine::Deadline) override { return true; }
+
+    std::optional<size_t> ReadNoblock(void* buf, size_t len) override { return Read(buf, len); }
+
+    size_t ReadSome(void* buf, size_t len, engine::Deadline) override { return Read(buf, len); }
+
+    size_t ReadAll(void* buf, size_t len, engine::Deadline) override { return Read(buf, len); }
+
+    void Rewind() noexcept { pos_ = 0; }
+
+private:
+    size_t Read(void* buf, size_t len) noexcept {
+        len = std::min(len, data_.size() - pos_);
+        std::memcpy(buf, data_.data() + pos_, len);
+        pos_ += len;
+        return len;
+    }
+
+    const std::string data_;
+    std::size_t pos_{0};
+};
+
+// A binary frame as sent by a client
+std::string MakeMaskedFrame(std::size_t size) {
+    std::string frame;
+    frame.push_back(static_cast<char>(0x82));
+    if (size <= 125) {
+        frame.push_back(static_cast<char>(0x80 | size));
+    } else if (size <= UINT16_MAX) {
+        frame.push_back(static_cast<char>(0x80 | 126));
+        for (int shift = 8; shift >= 0; shift -= 8) frame.push_back(static_cast<char>(size >> shift));
+    } else {
+        frame.push_back(static_cast<char>(0x80 | 127));
+        for (int shift = 56; shift >= 0; shift -= 8) frame.push_back(static_cast<char>(size >> shift));
+    }
+    frame.append(reinterpret_cast<const char*>(&kMask), sizeof(kMask));
+    frame.append(size, 'x');
+    return frame;
+}
+
+std::string MakeJsonMessage(std::size_t size) {
+    std::string message = "[";
+    for (std::size_t i = 0; message.size() < size; ++i) {
+        message += R"({"id":)" + std::to_string(i) + R"(,"type":"update","value":)" + std::to_string(i * 31 % 1000) +
+                   "},";
+    }
+    message.back() = ']';
+    return message;
+}
+
+utils::span<const std::byte> AsBytes(std::string_view data) {
+    return utils::as_bytes(utils::span<const char>(data.data(), data.data() + data.size()));
+}
+
+}  // namespace
+
+void websocket_xor_mask(benchmark::State& state) {
+    std::string payload(state.range(0), 'x');
+    for ([[maybe_unused]] auto _ : state) {
+        ws::impl::XorMaskInplace(payload.data(), payload.size(), kMask);
+        benchmark::DoNotOptimize(payload.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(websocket_xor_mask)->RangeMultiplier(4)->Range(16, 1 << 20);
+
+void websocket_read_frame(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        const std::size_t size = state.range(0);
+        MemoryReader reader{MakeMaskedFrame(size)};
+        std::string payload;
+        payload.reserve(size);
+
+        for ([[maybe_unused]] auto _ : state) {
+            reader.Rewind();
+            payload.clear();
+            ws::impl::FrameParserState frame;
+            frame.payload = &payload;
+            std::size_t payload_len = 0;
+            const auto status = ws::impl::ReadWSFrame(frame, reader, size, payload_len);
+            UINVARIANT(status == ws::CloseStatus::kNone && payload.size() == size, "Failed to read the frame");
+            benchmark::DoNotOptimize(payload.data());
+        }
+        state.SetBytesProcessed(state.iterations() * size);
+    });
+}
+BENCHMARK(websocket_read_frame)->RangeMultiplier(8)->Range(16, 1 << 20);
+
+void websocket_deflate_compress(benchmark::State& state) {
+    const auto message = MakeJsonMessage(state.range(0));
+    ws::impl::PerMessageDeflate deflate{ws::DeflateParams{}, 6};
+    std::string compressed;
+
+    for ([[maybe_unused]] auto _ : state) {
+        deflate.Compress(AsBytes(message), compressed);
+        benchmark::DoNotOptimize(compressed.data());
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(websocket_deflate_compress)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+void websocket_deflate_decompress(benchmark::State& state) {
+    const auto message = MakeJsonMessage(state.range(0));
+    // no context takeover to decompress the same data repeatedly
+    ws::DeflateParams params;
+    params.server_no_context_takeover = true;
+    params.client_no_context_takeover = true;
+    ws::impl::PerMessageDeflate deflate{params, 6};
+    std::string compressed;
+    deflate.Compress(AsBytes(message), compressed);
+    std::string decompressed;
+
+    for ([[maybe_unused]] auto _ : state) {
+        const auto status = deflate.Decompress(compressed, decompressed, message.size());
+        UINVARIANT(status == ws::CloseStatus::kNone, "Failed to decompress");
+        benchmark::DoNotOptimize(decompressed.data());
+    }
+    state.SetBytesProcessed(state.iterations() * message.size());
+}
+BENCHMARK(websocket_deflate_decompress)->RangeMultiplier(16)->Range(64, 1 << 20);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,152 @@
+#include <server/websocket/protocol.hpp>
+
+#include <string>
+
+#include <server/websocket/deflate.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace ws = server::websocket;
+
+std::string XorMaskNaive(std::string data, std::uint32_t mask) {
+    const auto* mask_bytes = reinterpret_cast<const unsigned char*>(&mask);
+    for (std::size_t i = 0; i < data.size(); ++i) data[i] ^= mask_bytes[i % 4];
+    return data;
+}
+
+utils::span<const std::byte> AsBytes(std::string_view data) {
+    return utils::as_bytes(utils::span<const char>(data.data(), data.data() + data.size()));
+}
+
+ws::DeflateConfig MakeDeflateConfig() {
+    ws::DeflateConfig config;
+    config.enabled = true;
+    return config;
+}
+
+}  // namespace
+
+TEST(WebsocketProtocol, XorMask) {
+    std::string payload;
+    for (std::size_t i = 0; i < 300; ++i) payload.push_back(static_cast<char>(i * 7));
+
+    constexpr std::uint32_t kMask = 0x12a4c6f8;
+    // unaligned starts and tails of every size
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        for (std::size_t size = 0; size + offset <= payload.size(); size += 7) {
+            auto data = payload.substr(offset, size);
+            ws::impl::XorMaskInplace(data.data(), data.size(), kMask);
+            EXPECT_EQ(data, XorMaskNaive(payload.substr(offset, size), kMask)) << offset << " " << size;
+        }
+    }
+}
+
+TEST(WebsocketDeflate, Negotiate) {
+    const auto config = MakeDeflateConfig();
+
+    EXPECT_FALSE(ws::impl::NegotiateDeflate("", config));
+    EXPECT_FALSE(ws::impl::NegotiateDeflate("x-webkit-deflate-frame", config));
+    EXPECT_FALSE(ws::impl::NegotiateDeflate("permessage-deflate", ws::DeflateConfig{}));
+
+    auto negotiation = ws::impl::NegotiateDeflate("permessage-deflate; client_max_window_bits", config);
+    ASSERT_TRUE(negotiation);
+    EXPECT_EQ(negotiation->response, "permessage-deflate");
+    EXPECT_FALSE(negotiation->params.server_no_context_takeover);
+    EXPECT_EQ(negotiation->params.server_max_window_bits, 15);
+
+    // the first acceptable offer wins
+    negotiation = ws::impl::NegotiateDeflate(
+        "permessage-deflate; unknown_param, permessage-deflate; server_max_window_bits=8, "
+        "permessage-deflate; server_max_window_bits=10; server_no_context_takeover, permessage-deflate",
+        config
+    );
+    ASSERT_TRUE(negotiation);
+    EXPECT_EQ(negotiation->response, "permessage-deflate; server_no_context_takeover; server_max_window_bits=10");
+    EXPECT_TRUE(negotiation->params.server_no_context_takeover);
+    EXPECT_EQ(negotiation->params.server_max_window_bits, 10);
+
+    EXPECT_FALSE(ws::impl::NegotiateDeflate("permessage-deflate; server_no_context_takeover=1", config));
+    EXPECT_FALSE(ws::impl::NegotiateDeflate(
+        "permessage-deflate; client_no_context_takeover; client_no_context_takeover", config
+    ));
+
+    auto limited_config = MakeDeflateConfig();
+    limited_config.client_no_context_takeover = true;
+    limited_config.server_max_window_bits = 12;
+    limited_config.client_max_window_bits = 11;
+    negotiation = ws::impl::NegotiateDeflate("permessage-deflate; client_max_window_bits=\"13\"", limited_config);
+    ASSERT_TRUE(negotiation);
+    EXPECT_EQ(
+        negotiation->response,
+        "permessage-deflate; client_no_context_takeover; server_max_window_bits=12; client_max_window_bits=11"
+    );
+
+    // the client window cannot be limited without the client support
+    negotiation = ws::impl::NegotiateDeflate("permessage-deflate", limited_config);
+    ASSERT_TRUE(negotiation);
+    EXPECT_EQ(negotiation->response, "permessage-deflate; client_no_context_takeover; server_max_window_bits=12");
+}
+
+TEST(WebsocketDeflate, DecompressRfcSamples) {
+    // https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.3.2
+    ws::impl::PerMessageDeflate deflate{ws::DeflateParams{}, 6};
+    std::string out;
+    EXPECT_EQ(
+        deflate.Decompress(std::string_view{"\xf2\x48\xcd\xc9\xc9\x07\x00", 7}, out, 100), ws::CloseStatus::kNone
+    );
+    EXPECT_EQ(out, "Hello");
+    EXPECT_EQ(deflate.Decompress(std::string_view{"\xf2\x00\x11\x00\x00", 5}, out, 100), ws::CloseStatus::kNone);
+    EXPECT_EQ(out, "Hello");
+
+    // https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.3.3
+    EXPECT_EQ(
+        deflate.Decompress(std::string_view{"\x00\x05\x00\xfa\xffHello\x00", 11}, out, 100), ws::CloseStatus::kNone
+    );
+    EXPECT_EQ(out, "Hello");
+}
+
+TEST(WebsocketDeflate, RoundTrip) {
+    for (const bool no_context_takeover : {false, true}) {
+        ws::DeflateParams params;
+        params.server_no_context_takeover = no_context_takeover;
+        params.client_no_context_takeover = no_context_takeover;
+        ws::impl::PerMessageDeflate sender{params, 6};
+        ws::impl::PerMessageDeflate receiver{params, 6};
+
+        std::string compressed;
+        std::string decompressed;
+        std::size_t previous_size = 0;
+        for (int i = 0; i < 3; ++i) {
+            const std::string message = R"({"type":"chat","text":")" + std::string(1000, 'a') + R"("})";
+            sender.Compress(AsBytes(message), compressed);
+            EXPECT_LT(compressed.size(), message.size());
+            // repeated messages are almost free with the context takeover
+            if (i > 0 && !no_context_takeover) EXPECT_LT(compressed.size(), previous_size);
+            if (i > 0 && no_context_takeover) EXPECT_EQ(compressed.size(), previous_size);
+            previous_size = compressed.size();
+
+            // decompression of a big message needs several buffer extensions
+            EXPECT_EQ(receiver.Decompress(compressed, decompressed, 100'000), ws::CloseStatus::kNone);
+            EXPECT_EQ(decompressed, message);
+        }
+    }
+}
+
+TEST(WebsocketDeflate, DecompressErrors) {
+    ws::impl::PerMessageDeflate sender{ws::DeflateParams{}, 6};
+    std::string compressed;
+    sender.Compress(AsBytes(std::string(10'000, 'x')), compressed);
+
+    std::string out;
+    ws::impl::PerMessageDeflate receiver{ws::DeflateParams{}, 6};
+    EXPECT_EQ(receiver.Decompress(compressed, out, 9'999), ws::CloseStatus::kTooBigData);
+    EXPECT_EQ(receiver.Decompress(compressed, out, 10'000), ws::CloseStatus::kNone);
+    EXPECT_EQ(out, std::string(10'000, 'x'));
+
+    EXPECT_EQ(receiver.Decompress("\xff\xff\xff\xff", out, 100), ws::CloseStatus::kBadMessageData);
+}
+
+USERVER_NAMESPACE_END
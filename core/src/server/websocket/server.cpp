@@ -7,6 +7,7 @@
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include "deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -27,13 +28,85 @@ utils::span<const std::byte> MakeBinarySpan(utils::span<const char> span) { retu
 
 }  // namespace
 
+DeflateConfig Parse(const yaml_config::YamlConfig& config, formats::parse::To<DeflateConfig>) {
+    DeflateConfig result;
+    result.enabled = config["enabled"].As<bool>(result.enabled);
+    result.server_no_context_takeover =
+        config["server-no-context-takeover"].As<bool>(result.server_no_context_takeover);
+    result.client_no_context_takeover =
+        config["client-no-context-takeover"].As<bool>(result.client_no_context_takeover);
+    result.server_max_window_bits = config["server-max-window-bits"].As<int>(result.server_max_window_bits);
+    result.client_max_window_bits = config["client-max-window-bits"].As<int>(result.client_max_window_bits);
+    result.compression_level = config["compression-level"].As<int>(result.compression_level);
+    result.min_size = config["min-size"].As<unsigned>(result.min_size);
+
+    // zlib deflate does not support the window of 8 bits
+    if (result.server_max_window_bits < 9 || result.server_max_window_bits > 15 ||
+        result.client_max_window_bits < 9 || result.client_max_window_bits > 15) {
+        throw std::runtime_error("Window bits must be in [9, 15] range in " + config.GetPath());
+    }
+    if (result.compression_level < 0 || result.compression_level > 9) {
+        throw std::runtime_error("Compression level must be in [0, 9] range in " + config.GetPath());
+    }
+    return result;
+}
+
 Config Parse(const yaml_config::YamlConfig& config, formats::parse::To<Config>) {
     return {
         config["max-remote-payload"].As<unsigned>(65536),
         config["fragment-size"].As<unsigned>(65536),
+        config["permessage-deflate"].As<DeflateConfig>(DeflateConfig{}),
     };
 }
 
+PreparedMessage::PreparedMessage(std::string_view data, bool is_text, const DeflateConfig& deflate) {
+    auto frames = std::make_shared<impl::PreparedFrames>();
+    frames->is_text = is_text;
+
+    const auto payload = MakeBinarySpan(data);
+    const auto header =
+        impl::frames::DataFrameHeader(payload, is_text, impl::frames::Continuation::kNo, impl::frames::Final::kYes);
+    frames->header_size = header.size();
+    frames->frame.reserve(header.size() + data.size());
+    frames->frame.append(header.data(), header.size());
+    frames->frame.append(data);
+
+    if (deflate.enabled && data.size() >= deflate.min_size) {
+        // without context takeover the frame is valid for any connection
+        // that does not keep the compression context
+        DeflateParams params;
+        params.server_no_context_takeover = true;
+        params.server_max_window_bits = deflate.server_max_window_bits;
+
+        std::string compressed;
+        impl::PerMessageDeflate{params, deflate.compression_level}.Compress(payload, compressed);
+        if (compressed.size() < data.size()) {
+            const auto compressed_payload = MakeBinarySpan(compressed);
+            const auto compressed_header = impl::frames::DataFrameHeader(
+                compressed_payload,
+                is_text,
+                impl::frames::Continuation::kNo,
+                impl::frames::Final::kYes,
+                impl::frames::Compressed::kYes
+            );
+            frames->compressed_frame.reserve(compressed_header.size() + compressed.size());
+            frames->compressed_frame.append(compressed_header.data(), compressed_header.size());
+            frames->compressed_frame.append(compressed);
+            frames->compressed_window_bits = deflate.server_max_window_bits;
+        }
+    }
+
+    frames_ = std::move(frames);
+}
+
+bool PreparedMessage::IsText() const noexcept { return frames_->is_text; }
+
+std::string_view PreparedMessage::GetPayload() const noexcept {
+    return std::string_view{frames_->frame}.substr(frames_->header_size);
+}
+
+const impl::PreparedFrames& PreparedMessage::GetFrames() const noexcept { return *frames_; }
+
 class WebSocketConnectionImpl final : public WebSocketConnection {
 public:
 private:
@@ -59,13 +132,27 @@ private:
 
     Config config;
 
+    std::optional<impl::PerMessageDeflate> deflate_;
+    // protected by write_mutex_
+    std::string compressed_buffer_;
+    // used only by Recv()
+    std::string decompressed_buffer_;
+    // protected by write_mutex_
+    std::vector<engine::io::IoData> prepared_io_;
+
 public:
     WebSocketConnectionImpl(
         std::unique_ptr<engine::io::RwBase> io_,
         const engine::io::Sockaddr& remote_addr,
-        const Config& server_config
+        const Config& server_config,
+        const std::optional<DeflateParams>& deflate
     )
-        : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {}
+        : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {
+        if (deflate) {
+            deflate_.emplace(*deflate, config.deflate.compression_level);
+            frame_.deflate_negotiated = true;
+        }
+    }
 
     ~WebSocketConnectionImpl() override { LOG_TRACE() << "Websocket connection closed"; }
 
@@ -86,20 +173,34 @@ public:
             SendExactly(*io, close_frame, {});
         } else if (!message.data.empty()) {
             utils::span<const std::byte> data_to_send{message.data};
+            // only the first frame of a message is marked as compressed
+            auto compressed = impl::frames::Compressed::kNo;
+            if (deflate_ && data_to_send.size() >= config.deflate.min_size) {
+                deflate_->Compress(data_to_send, compressed_buffer_);
+                data_to_send = MakeBinarySpan(compressed_buffer_);
+                compressed = impl::frames::Compressed::kYes;
+            }
+
             auto continuation = impl::frames::Continuation::kNo;
             while (data_to_send.size() > config.fragment_size && config.fragment_size > 0) {
                 const auto data_frame_header = impl::frames::DataFrameHeader(
                     data_to_send.first(config.fragment_size),
                     message.opcode == impl::WSOpcodes::kText,
                     continuation,
-                    impl::frames::Final::kNo
+                    impl::frames::Final::kNo,
+                    compressed
                 );
                 SendExactly(*io, data_frame_header, data_to_send.first(config.fragment_size));
                 continuation = impl::frames::Continuation::kYes;
+                compressed = impl::frames::Compressed::kNo;
                 data_to_send = data_to_send.last(data_to_send.size() - config.fragment_size);
             }
             const auto data_frame_header = impl::frames::DataFrameHeader(
-                data_to_send, message.opcode == impl::WSOpcodes::kText, continuation, impl::frames::Final::kYes
+                data_to_send,
+                message.opcode == impl::WSOpcodes::kText,
+                continuation,
+                impl::frames::Final::kYes,
+                compressed
             );
             SendExactly(*io, data_frame_header, data_to_send);
         }
@@ -123,6 +224,37 @@ public:
         SendExtended(mext);
     }
 
+    void SendPrepared(utils::span<const PreparedMessage> messages) override {
+        if (messages.empty()) return;
+
+        const std::unique_lock lock(write_mutex_);
+
+        prepared_io_.clear();
+        std::size_t total_size = 0;
+        for (const auto& message : messages) {
+            const auto& frames = message.GetFrames();
+            const std::string_view frame = CanSendCompressed(frames) ? frames.compressed_frame : frames.frame;
+            prepared_io_.push_back({frame.data(), frame.size()});
+            total_size += frame.size();
+
+            stats_.msg_sent++;
+            stats_.bytes_sent += frames.frame.size() - frames.header_size;
+        }
+
+        LOG_TRACE() << "Write " << messages.size() << " prepared messages " << total_size << " bytes";
+        if (io->WriteAll(prepared_io_.data(), prepared_io_.size(), {}) != total_size) {
+            throw(engine::io::IoException() << "Socket closed during transfer");
+        }
+    }
+
+    // The shared frame is compressed from scratch. Sending it would break
+    // the compression context of the connection, if it is kept.
+    bool CanSendCompressed(const impl::PreparedFrames& frames) const noexcept {
+        if (!deflate_ || frames.compressed_frame.empty()) return false;
+        const auto& params = deflate_->GetParams();
+        return params.server_no_context_takeover && frames.compressed_window_bits <= params.server_max_window_bits;
+    }
+
     bool RecvImpl(Message& msg, bool do_not_wait_for_message_header) {
         msg.data.resize(0);  // do not call .clear() to keep the allocated memory
         frame_.payload = &msg.data;
@@ -177,6 +309,20 @@ public:
             }
             if (frame_.waiting_continuation) continue;
 
+            if (frame_.is_compressed) {
+                frame_.is_compressed = false;
+                const auto decompress_status =
+                    deflate_->Decompress(msg.data, decompressed_buffer_, config.max_remote_payload);
+                if (decompress_status != CloseStatus::kNone) {
+                    MessageExtended close_msg{{}, impl::WSOpcodes::kClose, decompress_status};
+                    SendExtended(close_msg);
+                    msg = CloseMessage(decompress_status);
+                    return true;
+                }
+                // keeps both buffers allocated for the next messages
+                msg.data.swap(decompressed_buffer_);
+            }
+
             msg.is_text = frame_.is_text;
             stats_.msg_recv++;
             stats_.bytes_recv += msg.data.size();
@@ -217,9 +363,23 @@ WebSocketConnection::WebSocketConnection() = default;
 
 WebSocketConnection::~WebSocketConnection() = default;
 
-std::shared_ptr<WebSocketConnection>
-MakeWebSocket(std::unique_ptr<engine::io::RwBase>&& socket, engine::io::Sockaddr&& peer_name, const Config& config) {
-    return std::make_shared<WebSocketConnectionImpl>(std::move(socket), std::move(peer_name), config);
+void WebSocketConnection::SendPrepared(utils::span<const PreparedMessage> messages) {
+    for (const auto& message : messages) {
+        if (message.IsText()) {
+            SendText(message.GetPayload());
+        } else {
+            SendBinary(message.GetPayload());
+        }
+    }
+}
+
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name,
+    const Config& config,
+    const std::optional<DeflateParams>& deflate
+) {
+    return std::make_shared<WebSocketConnectionImpl>(std::move(socket), std::move(peer_name), config, deflate);
 }
 
 }  // namespace server::websocket
@@ -11,6 +11,7 @@
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include <userver/server/websocket/server.hpp>
+#include "deflate.hpp"
 #include "protocol.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -61,6 +62,14 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
 
     if (!HandleHandshake(request, response, context)) return "";
 
+    std::optional<DeflateParams> deflate;
+    if (auto negotiation = websocket::impl::NegotiateDeflate(
+            request.GetHeader(USERVER_NAMESPACE::http::headers::kWebsocketExtensions), config_.deflate
+        )) {
+        response.SetHeader(USERVER_NAMESPACE::http::headers::kWebsocketExtensions, std::move(negotiation->response));
+        deflate = negotiation->params;
+    }
+
     response.SetStatus(server::http::HttpStatus::kSwitchingProtocols);
     response.SetHeader(USERVER_NAMESPACE::http::headers::kConnection, "Upgrade");
     response.SetHeader(USERVER_NAMESPACE::http::headers::kUpgrade, "websocket");
@@ -69,9 +78,10 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
     );
 
     request.SetUpgradeWebsocket([context = std::make_shared<server::request::RequestContext>(std::move(context)),
+                                 deflate,
                                  this](std::unique_ptr<engine::io::RwBase> socket, engine::io::Sockaddr&& peer_name) {
         tracing::Span span("ws/" + HandlerName());
-        auto ws = websocket::MakeWebSocket(std::move(socket), std::move(peer_name), config_);
+        auto ws = websocket::MakeWebSocket(std::move(socket), std::move(peer_name), config_, deflate);
         try {
             Handle(*ws, *context);
         } catch (const std::exception& e) {
@@ -106,6 +116,45 @@ properties:
         type: integer
         description: max output fragment size
         defaultDescription: 65536
+    permessage-deflate:
+        type: object
+        description: permessage-deflate extension (RFC 7692) settings
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: compress the messages if the client supports the extension
+                defaultDescription: false
+            server-no-context-takeover:
+                type: boolean
+                description: compress each message from scratch, uses less memory and compresses worse
+                defaultDescription: false
+            client-no-context-takeover:
+                type: boolean
+                description: ask the client to compress each message from scratch
+                defaultDescription: false
+            server-max-window-bits:
+                type: integer
+                description: base-2 logarithm of the compression window size
+                defaultDescription: 15
+                minimum: 9
+                maximum: 15
+            client-max-window-bits:
+                type: integer
+                description: base-2 logarithm of the client compression window size, if the client supports the limit
+                defaultDescription: 15
+                minimum: 9
+                maximum: 15
+            compression-level:
+                type: integer
+                description: zlib compression level from 0 to 9
+                defaultDescription: 6
+                minimum: 0
+                maximum: 9
+            min-size:
+                type: integer
+                description: messages of smaller size are sent uncompressed
+                defaultDescription: 64
 )");
 }
 
@@ -1,16 +1,20 @@
 #include <tracing/span_impl.hpp>
 
+#include <new>
 #include <type_traits>
+#include <variant>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/hex.hpp>
@@ -34,6 +38,8 @@ constexpr std::string_view kReferenceType = "span_ref_type";
 constexpr std::string_view kReferenceTypeChild = "child";
 constexpr std::string_view kReferenceTypeFollows = "follows";
 
+constexpr std::string_view kTailSamplingDroppedSpansTag = "tail_sampling_dropped_spans";
+
 struct TsBuffer final {
     // digits + dot + fract + (to be sure)
     char data[32]{};
@@ -106,10 +112,103 @@ Span::Impl::Impl(
     if (parent) {
         log_extra_inheritable_ = parent->log_extra_inheritable_;
         local_log_level_ = parent->local_log_level_;
+        tail_sampling_buffer_ = parent->tail_sampling_buffer_;
+    } else {
+        tail_sampling_buffer_ = impl::MakeTraceBufferIfEnabled();
+        is_tail_sampling_root_ = (tail_sampling_buffer_ != nullptr);
     }
 }
 
 Span::Impl::~Impl() {
+    if (tail_sampling_buffer_) {
+        FinishTailSampling();
+        return;
+    }
+
+    LogSelf();
+}
+
+void Span::Impl::FinishTailSampling() {
+    finish_steady_time_ = std::chrono::steady_clock::now();
+    const auto buffer = std::move(tail_sampling_buffer_);
+    const bool is_error = HasErrorTag();
+
+    if (!is_tail_sampling_root_) {
+        // Span::~Span has not passed the span to the buffer, e.g. SpanBuilder
+        // was never built. Do not postpone the decision then.
+        buffer->AccountError(is_error);
+        LogSelf();
+        return;
+    }
+
+    const auto duration = *finish_steady_time_ - start_steady_time_;
+    const bool keep = impl::ShouldKeepTrace(buffer->GetConfig(), duration, is_error || buffer->HasErrors());
+    const auto dropped_spans_count = buffer->Finish(keep);
+    if (!keep) {
+        return;
+    }
+
+    if (dropped_spans_count != 0) {
+        if (!log_extra_local_) log_extra_local_.emplace();
+        log_extra_local_->Extend(std::string{kTailSamplingDroppedSpansTag}, dropped_spans_count);
+    }
+    LogSelf();
+}
+
+void Span::Impl::PassToTailSamplingBuffer(std::unique_ptr<Impl, OptionalDeleter>&& span) noexcept {
+    UASSERT(span->tail_sampling_buffer_ && !span->is_tail_sampling_root_);
+
+    const auto buffer = std::move(span->tail_sampling_buffer_);
+    span->finish_steady_time_ = std::chrono::steady_clock::now();
+    const bool is_error = span->HasErrorTag();
+    if (!span->ShouldLog()) {
+        buffer->AccountError(is_error);
+        return;
+    }
+
+    span->DetachFromCoroStack();
+    span->span_ = nullptr;
+
+    std::unique_ptr<Impl> finished_span;
+    if (span.get_deleter().IsOwning()) {
+        finished_span.reset(span.release());
+    } else {
+        // The Impl is owned by InPlaceSpan, it is destroyed right after the Span
+        try {
+            finished_span = std::make_unique<Impl>(std::move(*span));
+        } catch (const std::bad_alloc&) {
+            // Could not postpone the decision, the span is logged by its owner
+            buffer->AccountError(is_error);
+            return;
+        }
+        span->DisableLogging();
+    }
+
+    buffer->Add(std::move(finished_span), is_error);
+}
+
+bool Span::Impl::HasErrorTag() const {
+    const auto is_set = [](const logging::LogExtra& log_extra) {
+        return std::visit(
+            [](const auto& value) {
+                if constexpr (std::is_arithmetic_v<std::decay_t<decltype(value)>>) {
+                    return value != 0;
+                } else {
+                    return false;
+                }
+            },
+            log_extra.GetValue(kErrorFlag)
+        );
+    };
+
+    return is_set(log_extra_inheritable_) || (log_extra_local_ && is_set(*log_extra_local_));
+}
+
+std::chrono::steady_clock::time_point Span::Impl::GetFinishSteadyTime() const {
+    return finish_steady_time_.value_or(std::chrono::steady_clock::now());
+}
+
+void Span::Impl::LogSelf() {
     if (!ShouldLog()) {
         return;
     }
@@ -123,8 +222,7 @@ Span::Impl::~Impl() {
 }
 
 void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
-    const auto steady_now = std::chrono::steady_clock::now();
-    const auto duration = steady_now - start_steady_time_;
+    const auto duration = GetFinishSteadyTime() - start_steady_time_;
     const auto total_time_ms = std::chrono::duration_cast<RealMilliseconds>(duration).count();
     const auto timestamp_buffer = StartTsToString(start_system_time_);
     const auto ref_type = GetReferenceType() == ReferenceType::kChild ? kReferenceTypeChild : kReferenceTypeFollows;
@@ -259,7 +357,13 @@ Span::Span(std::unique_ptr<Span::Impl, OptionalDeleter>&& pimpl) : pimpl_(std::m
 
 Span::Span(Span&& other) noexcept : pimpl_(std::move(other.pimpl_)) { pimpl_->span_ = this; }
 
-Span::~Span() = default;
+Span::~Span() {
+    // Buffered spans of a trace outlive their Span, so they are passed to
+    // the buffer before the Impl is destroyed
+    if (pimpl_ && pimpl_->tail_sampling_buffer_ && !pimpl_->is_tail_sampling_root_) {
+        Impl::PassToTailSamplingBuffer(std::move(pimpl_));
+    }
+}
 
 Span& Span::CurrentSpan() {
     UASSERT_MSG(
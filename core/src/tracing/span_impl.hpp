@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -27,6 +28,10 @@ namespace tracing {
 inline const std::string kLinkTag = "link";
 inline const std::string kParentLinkTag = "parent_link";
 
+namespace impl {
+class TraceBuffer;
+}  // namespace impl
+
 class Span::Impl : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
 public:
     explicit Impl(
@@ -75,7 +80,15 @@ public:
     void DetachFromCoroStack();
     void AttachToCoroStack();
 
+    // Used by tail sampling to drop the span without writing it into the log
+    void DisableLogging() noexcept { log_level_ = logging::Level::kNone; }
+
 private:
+    void LogSelf();
+    void FinishTailSampling();
+    static void PassToTailSamplingBuffer(std::unique_ptr<Impl, OptionalDeleter>&& span) noexcept;
+    bool HasErrorTag() const;
+    std::chrono::steady_clock::time_point GetFinishSteadyTime() const;
     void LogOpenTracing() const;
     void DoLogOpenTracing(logging::impl::TagWriter writer) const;
     static void AddOpentracingTags(formats::json::StringBuilder& output, const logging::LogExtra& input);
@@ -105,6 +118,11 @@ private:
     const ReferenceType reference_type_;
     utils::impl::SourceLocation source_location_;
 
+    // Shared by the spans of a trace if tail sampling is enabled
+    std::shared_ptr<impl::TraceBuffer> tail_sampling_buffer_;
+    bool is_tail_sampling_root_{false};
+    std::optional<std::chrono::steady_clock::time_point> finish_steady_time_;
+
     friend class Span;
     friend class SpanBuilder;
     friend class TagScope;
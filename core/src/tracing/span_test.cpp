@@ -4,9 +4,11 @@
 #include <logging/log_helper_impl.hpp>
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/regex.hpp>
@@ -688,4 +690,93 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
     }
 }
 
+class TailSamplingSpan : public Span {
+protected:
+    TailSamplingSpan() {
+        tracing::TailSampling config;
+        config.enabled = true;
+        config.latency_threshold = std::chrono::hours{1};
+        config.max_spans_per_trace = 2;
+        tracing::Tracer::SetTailSampling(std::move(config));
+    }
+
+    ~TailSamplingSpan() override { tracing::Tracer::SetTailSampling(tracing::TailSampling{}); }
+};
+
+UTEST_F(TailSamplingSpan, DropsFastTrace) {
+    {
+        tracing::Span root("tail_root");
+        { tracing::Span child("tail_child"); }
+        logging::LogFlush();
+        EXPECT_THAT(GetStreamString(), Not(HasSubstr("tail_child")));
+    }
+
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("tail_root")));
+    EXPECT_THAT(GetStreamString(), Not(HasSubstr("tail_child")));
+}
+
+UTEST_F(TailSamplingSpan, KeepsTraceWithError) {
+    {
+        tracing::Span root("tail_root");
+        {
+            tracing::Span child("tail_child");
+            child.AddTag(tracing::kErrorFlag, true);
+        }
+        { tracing::Span child("tail_other_child"); }
+    }
+
+    logging::LogFlush();
+    const auto output = GetStreamString();
+    EXPECT_THAT(output, HasSubstr("tail_root"));
+    EXPECT_THAT(output, HasSubstr("tail_child"));
+    EXPECT_THAT(output, HasSubstr("tail_other_child"));
+    EXPECT_THAT(output, Not(HasSubstr("tail_sampling_dropped_spans")));
+}
+
+UTEST_F(TailSamplingSpan, BufferOverflow) {
+    {
+        tracing::Span root("tail_root");
+        root.AddTag(tracing::kErrorFlag, true);
+        for (int i = 0; i < 3; ++i) {
+            tracing::Span child(fmt::format("tail_child_{}", i));
+        }
+    }
+
+    logging::LogFlush();
+    const auto output = GetStreamString();
+    EXPECT_THAT(output, HasSubstr("tail_child_0"));
+    EXPECT_THAT(output, HasSubstr("tail_child_1"));
+    EXPECT_THAT(output, Not(HasSubstr("tail_child_2")));
+    EXPECT_THAT(output, HasSubstr("tail_sampling_dropped_spans=1"));
+}
+
+UTEST_F(TailSamplingSpan, ChildOutlivesRoot) {
+    std::optional<tracing::Span> child;
+    {
+        tracing::Span root("tail_root");
+        root.AddTag(tracing::kErrorFlag, true);
+        child.emplace(root.CreateChild("tail_late_child"));
+    }
+    child.reset();
+
+    logging::LogFlush();
+    EXPECT_THAT(GetStreamString(), HasSubstr("tail_late_child"));
+}
+
+UTEST(TailSampling, ShouldKeepTrace) {
+    tracing::TailSampling config;
+    config.latency_threshold = std::chrono::milliseconds{100};
+
+    EXPECT_TRUE(tracing::impl::ShouldKeepTrace(config, std::chrono::milliseconds{100}, false));
+    EXPECT_FALSE(tracing::impl::ShouldKeepTrace(config, std::chrono::milliseconds{99}, false));
+    EXPECT_TRUE(tracing::impl::ShouldKeepTrace(config, std::chrono::milliseconds{0}, true));
+
+    config.keep_errors = false;
+    EXPECT_FALSE(tracing::impl::ShouldKeepTrace(config, std::chrono::milliseconds{0}, true));
+
+    config.random_rate = 1.0;
+    EXPECT_TRUE(tracing::impl::ShouldKeepTrace(config, std::chrono::milliseconds{0}, false));
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,136 @@
+#include <tracing/tail_sampling.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/rand.hpp>
+
+#include <tracing/span_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace {
+
+auto& GlobalTailSampling() {
+    static rcu::Variable<TailSampling> config{};
+    return config;
+}
+
+}  // namespace
+
+TailSampling Parse(const formats::json::Value& value, formats::parse::To<TailSampling>) {
+    TailSampling result;
+    result.enabled = value["enabled"].As<bool>(result.enabled);
+    result.latency_threshold =
+        std::chrono::milliseconds{value["latency-threshold-ms"].As<std::int64_t>(result.latency_threshold.count())};
+    result.keep_errors = value["keep-errors"].As<bool>(result.keep_errors);
+    result.random_rate = value["random-rate"].As<double>(result.random_rate);
+    result.max_spans_per_trace = value["max-spans-per-trace"].As<std::size_t>(result.max_spans_per_trace);
+
+    if (result.random_rate < 0.0 || result.random_rate > 1.0) {
+        throw std::invalid_argument("random-rate should be in [0, 1] range");
+    }
+
+    return result;
+}
+
+namespace impl {
+
+TraceBuffer::TraceBuffer(const TailSampling& config) : config_(config) {}
+
+TraceBuffer::~TraceBuffer() {
+    // Root span always calls Finish(), this is just a safety net
+    for (auto& span : spans_) {
+        span->DisableLogging();
+    }
+}
+
+void TraceBuffer::Add(std::unique_ptr<Span::Impl> span, bool is_error) noexcept {
+    UASSERT(span);
+
+    {
+        const std::lock_guard lock{mutex_};
+        has_errors_ = has_errors_ || is_error;
+
+        if (decision_ == Decision::kPending) {
+            if (spans_.size() < config_.max_spans_per_trace) {
+                try {
+                    spans_.push_back(std::move(span));
+                    return;
+                } catch (const std::bad_alloc&) {
+                    // drop the span
+                }
+            }
+
+            ++dropped_spans_count_;
+            span->DisableLogging();
+        } else if (decision_ == Decision::kDrop) {
+            span->DisableLogging();
+        }
+    }
+
+    // The span is logged (or silently destroyed) outside of the lock
+    span.reset();
+}
+
+void TraceBuffer::AccountError(bool is_error) noexcept {
+    if (!is_error) return;
+
+    const std::lock_guard lock{mutex_};
+    has_errors_ = true;
+}
+
+bool TraceBuffer::HasErrors() const noexcept {
+    const std::lock_guard lock{mutex_};
+    return has_errors_;
+}
+
+std::size_t TraceBuffer::Finish(bool keep) noexcept {
+    std::vector<std::unique_ptr<Span::Impl>> spans;
+    std::size_t dropped_spans_count = 0;
+    {
+        const std::lock_guard lock{mutex_};
+        UASSERT(decision_ == Decision::kPending);
+        decision_ = keep ? Decision::kKeep : Decision::kDrop;
+        spans = std::move(spans_);
+        dropped_spans_count = dropped_spans_count_;
+    }
+
+    if (!keep) {
+        for (auto& span : spans) {
+            span->DisableLogging();
+        }
+    }
+
+    // Destructors of the spans write them into the log
+    spans.clear();
+    return dropped_spans_count;
+}
+
+void SetTailSampling(TailSampling&& config) { GlobalTailSampling().Assign(std::move(config)); }
+
+std::shared_ptr<TraceBuffer> MakeTraceBufferIfEnabled() {
+    const auto config = GlobalTailSampling().Read();
+    if (!config->enabled) return {};
+
+    return std::make_shared<TraceBuffer>(*config);
+}
+
+bool ShouldKeepTrace(const TailSampling& config, std::chrono::steady_clock::duration duration, bool has_errors) {
+    if (duration >= config.latency_threshold) return true;
+    if (config.keep_errors && has_errors) return true;
+    return config.random_rate > 0.0 && utils::RandRange(0.0, 1.0) < config.random_rate;
+}
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace tracing {
+
+struct TailSampling {
+    // Buffer the spans of each trace until its root span finishes
+    bool enabled{false};
+
+    // Keep the trace if its root span took at least that long
+    std::chrono::milliseconds latency_threshold{1000};
+
+    // Keep the trace if any of its spans has the 'error' tag
+    bool keep_errors{true};
+
+    // Keep this share of other traces, [0, 1]
+    double random_rate{0.0};
+
+    // Spans that do not fit into the buffer are dropped
+    std::size_t max_spans_per_trace{1000};
+};
+
+TailSampling Parse(const formats::json::Value& value, formats::parse::To<TailSampling>);
+
+namespace impl {
+
+// Holds the finished spans of a trace until the decision to log or to drop
+// them is made by the root span. Shared between all the spans of a trace
+// within this process.
+class TraceBuffer final {
+public:
+    explicit TraceBuffer(const TailSampling& config);
+    ~TraceBuffer();
+
+    const TailSampling& GetConfig() const noexcept { return config_; }
+
+    // Takes ownership of a finished span. The span is logged right away if
+    // the trace was already decided to be kept.
+    void Add(std::unique_ptr<Span::Impl> span, bool is_error) noexcept;
+
+    // Accounts a finished span that is not going to be logged.
+    void AccountError(bool is_error) noexcept;
+
+    bool HasErrors() const noexcept;
+
+    // Logs or drops all the buffered spans and the spans that finish later.
+    // Returns the count of spans dropped due to buffer overflow.
+    std::size_t Finish(bool keep) noexcept;
+
+private:
+    enum class Decision { kPending, kKeep, kDrop };
+
+    const TailSampling config_;
+
+    mutable engine::Mutex mutex_;
+    Decision decision_{Decision::kPending};
+    bool has_errors_{false};
+    std::size_t dropped_spans_count_{0};
+    std::vector<std::unique_ptr<Span::Impl>> spans_;
+};
+
+void SetTailSampling(TailSampling&& config);
+
+// Returns nullptr if tail sampling is disabled
+std::shared_ptr<TraceBuffer> MakeTraceBufferIfEnabled();
+
+// Whether the finished trace should be kept
+bool ShouldKeepTrace(const TailSampling& config, std::chrono::steady_clock::duration duration, bool has_errors);
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,148 @@
+#include <userver/utils/adaptive_hedging.hpp>
+
+#include <algorithm>
+#include <string_view>
+
+#include <userver/formats/json.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/retry_budget.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::hedging {
+
+namespace {
+
+constexpr std::int32_t kMillis = 1000;
+constexpr std::int64_t kLatencyUnitUs = 100;
+constexpr std::chrono::microseconds kDelayUpdatePeriod{std::chrono::seconds{1}};
+constexpr std::chrono::seconds kLatencyEpoch{5};
+constexpr std::chrono::seconds kLatencyWindow{30};
+constexpr std::string_view kOverflowDestination = "__overflow__";
+
+std::int64_t NowUs() noexcept {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+}  // namespace
+
+AdaptiveHedging::Destination::Destination(const AdaptiveHedging& hedging)
+    : hedging_(hedging),
+      latencies_(kLatencyEpoch, kLatencyWindow),
+      delay_us_(std::chrono::microseconds{hedging.settings_.default_delay}.count()),
+      tokens_(hedging.settings_.max_extra_burst * kMillis) {}
+
+std::chrono::microseconds AdaptiveHedging::Destination::GetHedgingDelay() const {
+    const auto now = NowUs();
+    auto updated_at = delay_updated_at_us_.load(std::memory_order_relaxed);
+    // a single caller recalculates the delay, the rest use the previous one
+    if (now - updated_at >= kDelayUpdatePeriod.count() &&
+        delay_updated_at_us_.compare_exchange_strong(updated_at, now, std::memory_order_relaxed)) {
+        delay_us_.store(CalculateDelay().count(), std::memory_order_relaxed);
+    }
+    return std::chrono::microseconds{delay_us_.load(std::memory_order_relaxed)};
+}
+
+void AdaptiveHedging::Destination::AccountLatency(std::chrono::steady_clock::duration latency) noexcept {
+    const auto latency_us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    latencies_.GetCurrentCounter().Account(std::max<std::int64_t>(latency_us, 0) / kLatencyUnitUs);
+}
+
+void AdaptiveHedging::Destination::AccountRequest() noexcept {
+    const auto& settings = hedging_.settings_;
+    const auto max_tokens = static_cast<std::int32_t>(settings.max_extra_burst * kMillis);
+    const auto token_ratio = static_cast<std::int32_t>(settings.max_extra_ratio * kMillis);
+
+    auto expected = tokens_.load(std::memory_order_relaxed);
+    while (!tokens_.compare_exchange_weak(
+        expected, std::min(max_tokens, expected + token_ratio), std::memory_order_relaxed, std::memory_order_relaxed
+    ))
+        ;
+
+    ++requests_;
+}
+
+bool AdaptiveHedging::Destination::TryStartExtraAttempt() noexcept {
+    const auto* retry_budget = hedging_.retry_budget_;
+    if (retry_budget && !retry_budget->CanRetry()) {
+        ++denied_attempts_;
+        return false;
+    }
+
+    auto expected = tokens_.load(std::memory_order_relaxed);
+    do {
+        if (expected < kMillis) {
+            ++denied_attempts_;
+            return false;
+        }
+    } while (!tokens_.compare_exchange_weak(
+        expected, expected - kMillis, std::memory_order_relaxed, std::memory_order_relaxed
+    ));
+
+    ++extra_attempts_;
+    return true;
+}
+
+std::chrono::microseconds AdaptiveHedging::Destination::CalculateDelay() const {
+    const auto& settings = hedging_.settings_;
+    const auto stats = latencies_.GetStatsForPeriod(kLatencyWindow, true);
+    if (stats.Count() < settings.min_samples) return settings.default_delay;
+
+    const std::chrono::microseconds delay{
+        static_cast<std::int64_t>(stats.GetPercentile(settings.percentile)) * kLatencyUnitUs};
+    return std::clamp<std::chrono::microseconds>(delay, settings.min_delay, settings.max_delay);
+}
+
+AdaptiveHedging::AdaptiveHedging(AdaptiveHedgingSettings settings, RetryBudget* retry_budget)
+    : settings_(settings),
+      retry_budget_(retry_budget),
+      overflow_destination_(std::make_shared<Destination>(*this)) {
+    UASSERT(settings_.percentile > 0 && settings_.percentile <= 100);
+    UASSERT(settings_.min_delay <= settings_.max_delay);
+    UASSERT(settings_.max_extra_ratio >= 0);
+    UASSERT(settings_.max_extra_burst >= 0 && settings_.max_extra_burst <= 1000000);
+}
+
+std::shared_ptr<AdaptiveHedging::Destination> AdaptiveHedging::GetDestination(const std::string& name) {
+    if (auto destination = destinations_.Get(name)) return destination;
+    if (destinations_.SizeApprox() >= settings_.max_destinations) return overflow_destination_;
+    return destinations_.Emplace(name, *this).value;
+}
+
+void DumpMetric(statistics::Writer& writer, const AdaptiveHedging::Destination& destination) {
+    writer["requests"] = destination.requests_;
+    writer["extra-attempts"] = destination.extra_attempts_;
+    writer["denied-attempts"] = destination.denied_attempts_;
+    writer["delay-us"] = destination.delay_us_.load(std::memory_order_relaxed);
+    writer["budget"] =
+        static_cast<double>(destination.tokens_.load(std::memory_order_relaxed)) / static_cast<double>(kMillis);
+}
+
+void DumpMetric(statistics::Writer& writer, const AdaptiveHedging& hedging) {
+    for (const auto& [name, destination] : hedging.destinations_) {
+        writer.ValueWithLabels(*destination, {"hedging_destination", name});
+    }
+    writer.ValueWithLabels(*hedging.overflow_destination_, {"hedging_destination", kOverflowDestination});
+}
+
+AdaptiveHedgingSettings Parse(const formats::json::Value& elem, formats::parse::To<AdaptiveHedgingSettings>) {
+    AdaptiveHedgingSettings result;
+    result.percentile = elem["percentile"].As<double>(result.percentile);
+    result.min_delay = std::chrono::milliseconds{
+        elem["min-delay-ms"].As<std::chrono::milliseconds::rep>(result.min_delay.count())};
+    result.max_delay = std::chrono::milliseconds{
+        elem["max-delay-ms"].As<std::chrono::milliseconds::rep>(result.max_delay.count())};
+    result.default_delay = std::chrono::milliseconds{
+        elem["default-delay-ms"].As<std::chrono::milliseconds::rep>(result.default_delay.count())};
+    result.min_samples = elem["min-samples"].As<std::size_t>(result.min_samples);
+    result.max_extra_ratio = elem["max-extra-ratio"].As<double>(result.max_extra_ratio);
+    result.max_extra_burst = elem["max-extra-burst"].As<double>(result.max_extra_burst);
+    result.max_destinations = elem["max-destinations"].As<std::size_t>(result.max_destinations);
+    return result;
+}
+
+}  // namespace utils::hedging
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,212 @@
+#include <userver/utils/adaptive_hedging.hpp>
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/retry_budget.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace hedging = utils::hedging;
+
+void AccountLatencies(
+    hedging::AdaptiveHedging::Destination& destination,
+    std::size_t count,
+    std::chrono::milliseconds latency
+) {
+    for (std::size_t i = 0; i < count; ++i) destination.AccountLatency(latency);
+}
+
+// The first attempt hangs, the hedged ones reply at once
+class SlowFirstStrategy final {
+public:
+    struct Request final {
+        engine::TaskWithResult<std::string> task;
+
+        auto* TryGetContextAccessor() { return task.TryGetContextAccessor(); }
+    };
+
+    std::optional<Request> Create(std::size_t attempt) {
+        return Request{utils::Async("attempt", [attempt] {
+            if (attempt == 0) engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+            return "Request" + std::to_string(attempt);
+        })};
+    }
+
+    std::optional<std::chrono::milliseconds> ProcessReply(Request&& request) {
+        reply_ = request.task.Get();
+        return std::nullopt;
+    }
+
+    std::optional<std::string> ExtractReply() { return reply_; }
+
+    void Finish(Request&& request) {
+        if (request.task.IsValid()) request.task.RequestCancel();
+    }
+
+private:
+    std::optional<std::string> reply_;
+};
+
+}  // namespace
+
+UTEST(AdaptiveHedging, DefaultDelay) {
+    hedging::AdaptiveHedgingSettings settings;
+    settings.default_delay = 42ms;
+    settings.min_samples = 10;
+    hedging::AdaptiveHedging adaptive_hedging{settings};
+    const auto destination = adaptive_hedging.GetDestination("service");
+
+    AccountLatencies(*destination, 9, 5ms);
+    EXPECT_EQ(destination->GetHedgingDelay(), 42ms);
+}
+
+UTEST(AdaptiveHedging, DelayFollowsPercentile) {
+    hedging::AdaptiveHedgingSettings settings;
+    settings.min_samples = 100;
+    hedging::AdaptiveHedging adaptive_hedging{settings};
+    const auto destination = adaptive_hedging.GetDestination("service");
+
+    AccountLatencies(*destination, 90, 5ms);
+    AccountLatencies(*destination, 10, 50ms);
+    EXPECT_EQ(destination->GetHedgingDelay(), 50ms);
+}
+
+UTEST(AdaptiveHedging, DelayBounds) {
+    hedging::AdaptiveHedgingSettings settings;
+    settings.min_samples = 1;
+    settings.min_delay = 2ms;
+    settings.max_delay = 20ms;
+    hedging::AdaptiveHedging adaptive_hedging{settings};
+
+    const auto fast = adaptive_hedging.GetDestination("fast");
+    AccountLatencies(*fast, 10, 0ms);
+    EXPECT_EQ(fast->GetHedgingDelay(), 2ms);
+
+    const auto slow = adaptive_hedging.GetDestination("slow");
+    AccountLatencies(*slow, 10, 3s);
+    EXPECT_EQ(slow->GetHedgingDelay(), 20ms);
+}
+
+UTEST(AdaptiveHedging, Budget) {
+    hedging::AdaptiveHedgingSettings settings;
+    settings.max_extra_burst = 2;
+    settings.max_extra_ratio = 0.5;
+    hedging::AdaptiveHedging adaptive_hedging{settings};
+    const auto destination = adaptive_hedging.GetDestination("service");
+
+    EXPECT_TRUE(destination->TryStartExtraAttempt());
+    EXPECT_TRUE(destination->TryStartExtraAttempt());
+    EXPECT_FALSE(destination->TryStartExtraAttempt());
+
+    destination->AccountRequest();
+    EXPECT_FALSE(destination->TryStartExtraAttempt());
+    destination->AccountRequest();
+    EXPECT_TRUE(destination->TryStartExtraAttempt());
+}
+
+UTEST(AdaptiveHedging, SharedRetryBudget) {
+    utils::RetryBudget retry_budget{utils::RetryBudgetSettings{10, 0.1f, true}};
+    hedging::AdaptiveHedging adaptive_hedging{{}, &retry_budget};
+    const auto destination = adaptive_hedging.GetDestination("service");
+
+    EXPECT_TRUE(destination->TryStartExtraAttempt());
+    for (int i = 0; i < 10; ++i) retry_budget.AccountFail();
+    EXPECT_FALSE(destination->TryStartExtraAttempt());
+}
+
+UTEST(AdaptiveHedging, Destinations) {
+    hedging::AdaptiveHedgingSettings settings;
+    settings.max_destinations = 1;
+    hedging::AdaptiveHedging adaptive_hedging{settings};
+
+    const auto first = adaptive_hedging.GetDestination("first");
+    EXPECT_EQ(adaptive_hedging.GetDestination("first"), first);
+
+    // over the limit
+    const auto second = adaptive_hedging.GetDestination("second");
+    EXPECT_NE(second, first);
+    EXPECT_EQ(adaptive_hedging.GetDestination("third"), second);
+}
+
+UTEST(AdaptiveHedging, Metrics) {
+    hedging::AdaptiveHedgingSettings settings;
+    settings.max_destinations = 1;
+    hedging::AdaptiveHedging adaptive_hedging{settings};
+
+    utils::statistics::Storage statistics_storage;
+    const auto holder =
+        statistics_storage.RegisterWriter("hedging", [&adaptive_hedging](utils::statistics::Writer& writer) {
+            writer = adaptive_hedging;
+        });
+    const auto get_requests = [&](const std::string& destination) {
+        return utils::statistics::Snapshot{statistics_storage, "hedging"}
+            .SingleMetric("requests", {{"hedging_destination", destination}})
+            .AsRate();
+    };
+
+    adaptive_hedging.GetDestination("first")->AccountRequest();
+    // over the limit
+    adaptive_hedging.GetDestination("second")->AccountRequest();
+    adaptive_hedging.GetDestination("third")->AccountRequest();
+
+    EXPECT_EQ(get_requests("first"), utils::statistics::Rate{1});
+    EXPECT_EQ(get_requests("__overflow__"), utils::statistics::Rate{2});
+}
+
+UTEST(AdaptiveHedging, ParseSettings) {
+    const auto json = formats::json::FromString(R"({
+        "percentile": 99,
+        "min-delay-ms": 5,
+        "max-delay-ms": 500,
+        "default-delay-ms": 50,
+        "min-samples": 10,
+        "max-extra-ratio": 0.2,
+        "max-extra-burst": 3,
+        "max-destinations": 7
+    })");
+    const auto settings = json.As<hedging::AdaptiveHedgingSettings>();
+
+    EXPECT_EQ(settings.percentile, 99.0);
+    EXPECT_EQ(settings.min_delay, 5ms);
+    EXPECT_EQ(settings.max_delay, 500ms);
+    EXPECT_EQ(settings.default_delay, 50ms);
+    EXPECT_EQ(settings.min_samples, 10);
+    EXPECT_EQ(settings.max_extra_ratio, 0.2);
+    EXPECT_EQ(settings.max_extra_burst, 3.0);
+    EXPECT_EQ(settings.max_destinations, 7);
+
+    // the omitted fields keep the defaults
+    const auto defaults = formats::json::FromString("{}").As<hedging::AdaptiveHedgingSettings>();
+    EXPECT_EQ(defaults.percentile, hedging::AdaptiveHedgingSettings{}.percentile);
+    EXPECT_EQ(defaults.default_delay, hedging::AdaptiveHedgingSettings{}.default_delay);
+    EXPECT_EQ(defaults.max_destinations, hedging::AdaptiveHedgingSettings{}.max_destinations);
+}
+
+UTEST(AdaptiveHedging, Strategy) {
+    hedging::AdaptiveHedgingSettings settings;
+    settings.default_delay = 10ms;
+    hedging::AdaptiveHedging adaptive_hedging{settings};
+    const auto destination = adaptive_hedging.GetDestination("service");
+
+    // the fixed delay is ignored
+    const hedging::HedgingSettings hedging_settings{2, utest::kMaxTestWaitTime, utest::kMaxTestWaitTime};
+    const auto reply =
+        hedging::HedgeRequest(hedging::AdaptiveStrategy{SlowFirstStrategy{}, destination}, hedging_settings);
+    EXPECT_EQ(reply, "Request1");
+}
+
+USERVER_NAMESPACE_END
@@ -8,6 +8,7 @@
 
 #include <userver/utils/mock_now.hpp>
 #include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/metrics_snapshot.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -73,6 +74,13 @@ std::string ToGraphiteFormat(const utils::statistics::Storage& statistics, const
     return builder.Release();
 }
 
+std::string
+ToGraphiteFormat(const utils::statistics::MetricsSnapshot& statistics, const utils::statistics::Request& request) {
+    FormatBuilder builder{};
+    statistics.VisitMetrics(builder, request);
+    return builder.Release();
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
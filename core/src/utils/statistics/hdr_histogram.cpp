@@ -0,0 +1,231 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+constexpr int kMaxSignificantBits = 16;
+constexpr std::size_t kMaxStripes = 16;
+constexpr std::size_t kCountersPerCacheLine =
+    concurrent::impl::kDestructiveInterferenceSize / sizeof(std::atomic<std::uint64_t>);
+
+// Values are converted to integer multiples of 'unit'. The first
+// 2^significant_bits of them have buckets of their own. After that, each
+// power-of-two range [2^msb, 2^(msb+1)) is split into 2^significant_bits / 2
+// buckets of equal width.
+std::size_t ScaledIndex(std::uint64_t scaled, int significant_bits) noexcept {
+    const std::uint64_t linear_count = std::uint64_t{1} << significant_bits;
+    if (scaled < linear_count) return scaled;
+
+    const std::uint64_t half_count = linear_count / 2;
+    const int msb = 63 - __builtin_clzll(scaled);
+    const int shift = msb - significant_bits + 1;
+    const std::uint64_t top = scaled >> shift;
+    return linear_count + (shift - 1) * half_count + (top - half_count);
+}
+
+// Exclusive upper bound of the bucket, in multiples of 'unit'.
+std::uint64_t ScaledUpperBound(std::size_t index, int significant_bits) noexcept {
+    const std::uint64_t linear_count = std::uint64_t{1} << significant_bits;
+    if (index < linear_count) return index + 1;
+
+    const std::uint64_t half_count = linear_count / 2;
+    const auto shift = (index - linear_count) / half_count + 1;
+    const auto top = half_count + (index - linear_count) % half_count;
+    return (top + 1) << shift;
+}
+
+std::uint64_t ToScaled(double value, double unit, std::uint64_t max_scaled) noexcept {
+    const double scaled = value / unit;
+    // Also catches NaN
+    if (!(scaled > 0)) return 0;
+    if (scaled >= static_cast<double>(max_scaled)) return max_scaled;
+    return static_cast<std::uint64_t>(scaled);
+}
+
+std::uint64_t MaxScaled(const HdrHistogramSettings& settings) {
+    if (!(settings.unit > 0) || !std::isfinite(settings.unit)) {
+        throw std::invalid_argument(fmt::format("HdrHistogram unit must be positive, got {}", settings.unit));
+    }
+    if (settings.significant_bits < 1 || settings.significant_bits > kMaxSignificantBits) {
+        throw std::invalid_argument(fmt::format(
+            "HdrHistogram significant_bits must be in [1, {}], got {}", kMaxSignificantBits, settings.significant_bits
+        ));
+    }
+    const double max_scaled = settings.max_value / settings.unit;
+    if (!(max_scaled >= 1) || max_scaled > static_cast<double>(std::uint64_t{1} << 62)) {
+        throw std::invalid_argument(fmt::format(
+            "HdrHistogram max_value must be in [unit, unit * 2^62], got max_value={}, unit={}",
+            settings.max_value,
+            settings.unit
+        ));
+    }
+    return static_cast<std::uint64_t>(max_scaled);
+}
+
+std::size_t StripeCount() {
+    const std::size_t concurrency = std::thread::hardware_concurrency();
+    return std::clamp(concurrency, std::size_t{1}, kMaxStripes);
+}
+
+std::size_t StripeStride(std::size_t bucket_count) {
+    // Round up to whole cache lines, so that stripes never share one.
+    return (bucket_count + kCountersPerCacheLine - 1) / kCountersPerCacheLine * kCountersPerCacheLine;
+}
+
+std::vector<double> DefaultExportBounds(const HdrHistogramSettings& settings) {
+    std::vector<double> bounds;
+    for (double bound = settings.unit;; bound *= 2) {
+        bounds.push_back(bound);
+        if (bound >= settings.max_value) break;
+    }
+    return bounds;
+}
+
+std::size_t ThisThreadStripeHint() noexcept {
+    static std::atomic<std::size_t> next_thread_index{0};
+    thread_local const std::size_t thread_index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+    return thread_index;
+}
+
+}  // namespace
+
+HdrHistogramSnapshot::HdrHistogramSnapshot(double unit, int significant_bits, std::size_t bucket_count)
+    : unit_(unit), significant_bits_(significant_bits), counts_(bucket_count, 0) {}
+
+double HdrHistogramSnapshot::GetUpperBoundAt(std::size_t index) const {
+    UINVARIANT(index < counts_.size(), "HdrHistogram bucket index out of range");
+    return static_cast<double>(ScaledUpperBound(index, significant_bits_)) * unit_;
+}
+
+std::uint64_t HdrHistogramSnapshot::GetTotalCount() const noexcept {
+    std::uint64_t total = 0;
+    for (const auto count : counts_) total += count;
+    return total;
+}
+
+double HdrHistogramSnapshot::GetPercentile(double percent) const {
+    const auto total = GetTotalCount();
+    if (total == 0) return 0;
+
+    const auto clamped_percent = std::clamp(percent, 0.0, 100.0);
+    const auto rank = std::max(std::uint64_t{1}, static_cast<std::uint64_t>(std::ceil(total * clamped_percent / 100)));
+
+    std::uint64_t accumulated = 0;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        accumulated += counts_[i];
+        if (accumulated >= rank) return GetUpperBoundAt(i);
+    }
+    return GetUpperBoundAt(counts_.size() - 1);
+}
+
+void HdrHistogramSnapshot::Add(const HdrHistogramSnapshot& other) {
+    if (other.unit_ != unit_ || other.significant_bits_ != significant_bits_ ||
+        other.counts_.size() != counts_.size()) {
+        throw std::invalid_argument("Only HdrHistograms with identical settings can be added");
+    }
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+}
+
+HistogramAggregator HdrHistogramSnapshot::ToHistogram(utils::span<const double> upper_bounds) const {
+    HistogramAggregator result{upper_bounds};
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] == 0) continue;
+
+        // All the values in the bucket are less than its upper bound.
+        const auto it = std::lower_bound(upper_bounds.begin(), upper_bounds.end(), GetUpperBoundAt(i));
+        if (it == upper_bounds.end()) {
+            result.AccountInf(counts_[i]);
+        } else {
+            result.AccountAt(it - upper_bounds.begin(), counts_[i]);
+        }
+    }
+    return result;
+}
+
+HdrHistogram::HdrHistogram(HdrHistogramSettings settings)
+    : unit_(settings.unit),
+      significant_bits_(settings.significant_bits),
+      max_scaled_(MaxScaled(settings)),
+      bucket_count_(ScaledIndex(max_scaled_, significant_bits_) + 1),
+      stripe_stride_(StripeStride(bucket_count_)),
+      stripe_count_(StripeCount()),
+      export_bounds_(
+          settings.export_bounds.empty() ? DefaultExportBounds(settings) : std::move(settings.export_bounds)
+      ),
+      counters_(std::make_unique<std::atomic<std::uint64_t>[]>(stripe_stride_ * stripe_count_)) {
+    // Validate the export bounds early.
+    [[maybe_unused]] const HistogramAggregator validator{export_bounds_};
+}
+
+HdrHistogram::~HdrHistogram() = default;
+
+std::size_t HdrHistogram::BucketIndex(double value) const noexcept {
+    return ScaledIndex(ToScaled(value, unit_, max_scaled_), significant_bits_);
+}
+
+std::atomic<std::uint64_t>* HdrHistogram::Stripe(std::size_t stripe_index) const noexcept {
+    UASSERT(stripe_index < stripe_count_);
+    return counters_.get() + stripe_index * stripe_stride_;
+}
+
+void HdrHistogram::Account(double value, std::uint64_t count) noexcept {
+    const auto index = BucketIndex(value);
+    UASSERT(index < bucket_count_);
+    Stripe(ThisThreadStripeHint() % stripe_count_)[index].fetch_add(count, std::memory_order_relaxed);
+}
+
+void HdrHistogram::Add(const HdrHistogramSnapshot& other) {
+    if (other.unit_ != unit_ || other.significant_bits_ != significant_bits_ ||
+        other.counts_.size() != bucket_count_) {
+        throw std::invalid_argument("Only HdrHistograms with identical settings can be added");
+    }
+    auto* stripe = Stripe(ThisThreadStripeHint() % stripe_count_);
+    for (std::size_t i = 0; i < bucket_count_; ++i) {
+        if (other.counts_[i] != 0) stripe[i].fetch_add(other.counts_[i], std::memory_order_relaxed);
+    }
+}
+
+void ResetMetric(HdrHistogram& histogram) noexcept {
+    for (std::size_t stripe_index = 0; stripe_index < histogram.stripe_count_; ++stripe_index) {
+        auto* stripe = histogram.Stripe(stripe_index);
+        for (std::size_t i = 0; i < histogram.bucket_count_; ++i) {
+            stripe[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+HdrHistogramSnapshot HdrHistogram::GetSnapshot() const {
+    HdrHistogramSnapshot snapshot{unit_, significant_bits_, bucket_count_};
+    for (std::size_t stripe_index = 0; stripe_index < stripe_count_; ++stripe_index) {
+        const auto* stripe = Stripe(stripe_index);
+        for (std::size_t i = 0; i < bucket_count_; ++i) {
+            snapshot.counts_[i] += stripe[i].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+void DumpMetric(Writer& writer, const HdrHistogram& histogram) {
+    const auto aggregated = histogram.GetSnapshot().ToHistogram(histogram.GetExportBounds());
+    writer = aggregated.GetView();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,80 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <utils/gbench_auxilary.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Latencies in microseconds from 10us to 60s, log-uniformly distributed.
+std::vector<double> MakeLatencies() {
+    auto values = std::vector<double>(1024);
+    for (auto& value : values) {
+        value = std::pow(10.0, utils::RandRange(1.0, 7.8));
+    }
+    return values;
+}
+
+}  // namespace
+
+void HdrHistogramAccount(benchmark::State& state) {
+    utils::statistics::HdrHistogramSettings settings;
+    settings.significant_bits = state.range(0);
+    utils::statistics::HdrHistogram histogram{settings};
+    const auto values = Launder(MakeLatencies());
+
+    while (state.KeepRunningBatch(values.size())) {
+        for (const auto value : values) {
+            histogram.Account(value);
+        }
+    }
+}
+BENCHMARK(HdrHistogramAccount)->DenseRange(3, 7, 2);
+
+// All the threads write into the same histogram.
+void HdrHistogramAccountContended(benchmark::State& state) {
+    static utils::statistics::HdrHistogram histogram;
+    const auto values = Launder(MakeLatencies());
+
+    while (state.KeepRunningBatch(values.size())) {
+        for (const auto value : values) {
+            histogram.Account(value);
+        }
+    }
+}
+BENCHMARK(HdrHistogramAccountContended)->ThreadRange(1, 4);
+
+// For comparison with the plain Histogram, using the same default export
+// bounds.
+void HdrHistogramPlainAccountContended(benchmark::State& state) {
+    static const utils::statistics::HdrHistogram hdr_histogram;
+    static utils::statistics::Histogram histogram{hdr_histogram.GetExportBounds()};
+    const auto values = Launder(MakeLatencies());
+
+    while (state.KeepRunningBatch(values.size())) {
+        for (const auto value : values) {
+            histogram.Account(value);
+        }
+    }
+}
+BENCHMARK(HdrHistogramPlainAccountContended)->ThreadRange(1, 4);
+
+void HdrHistogramReadPercentile(benchmark::State& state) {
+    utils::statistics::HdrHistogram histogram;
+    for (const auto value : MakeLatencies()) {
+        histogram.Account(value);
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(histogram.GetSnapshot().GetPercentile(99));
+    }
+}
+BENCHMARK(HdrHistogramReadPercentile);
+
+USERVER_NAMESPACE_END
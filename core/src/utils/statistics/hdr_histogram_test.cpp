@@ -0,0 +1,166 @@
+#include <userver/utils/statistics/hdr_histogram.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+utils::statistics::HdrHistogramSettings SmallSettings() {
+    utils::statistics::HdrHistogramSettings settings;
+    settings.unit = 1;
+    settings.max_value = 1000;
+    settings.significant_bits = 3;
+    settings.export_bounds = {10, 100, 1000};
+    return settings;
+}
+
+void AccountSome(utils::statistics::HdrHistogram& histogram) {
+    histogram.Account(5);
+    histogram.Account(50);
+    histogram.Account(500);
+    histogram.Account(5000);
+}
+
+}  // namespace
+
+UTEST(StatisticsHdrHistogram, Sample) {
+    /// [sample]
+    utils::statistics::Storage storage;
+
+    utils::statistics::HdrHistogramSettings settings;
+    settings.unit = 1;  // resolution of 1 microsecond
+    settings.max_value = 1000;
+    settings.significant_bits = 3;
+    settings.export_bounds = {10, 100, 1000};
+    utils::statistics::HdrHistogram histogram{settings};
+
+    auto statistics_holder =
+        storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+
+    histogram.Account(5);
+    histogram.Account(50);
+    histogram.Account(500);
+    histogram.Account(5000);  // saturates into the last bucket
+
+    const utils::statistics::Snapshot snapshot{storage};
+    EXPECT_EQ(fmt::to_string(snapshot.SingleMetric("test")), "[10]=1,[100]=1,[1000]=1,[inf]=1");
+    /// [sample]
+}
+
+UTEST(StatisticsHdrHistogram, BucketLayout) {
+    utils::statistics::HdrHistogram histogram{SmallSettings()};
+    // 8 linear buckets, then 4 buckets per power of two up to 1024
+    EXPECT_EQ(histogram.GetBucketCount(), 36);
+
+    const auto snapshot = histogram.GetSnapshot();
+    for (std::size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(snapshot.GetUpperBoundAt(i), i + 1);
+    }
+    double previous_bound = snapshot.GetUpperBoundAt(7);
+    for (std::size_t i = 8; i < snapshot.GetBucketCount(); ++i) {
+        const auto bound = snapshot.GetUpperBoundAt(i);
+        EXPECT_GT(bound, previous_bound);
+        EXPECT_LE(bound - previous_bound, bound / 4);
+        previous_bound = bound;
+    }
+    EXPECT_GE(previous_bound, 1000);
+}
+
+UTEST(StatisticsHdrHistogram, Percentile) {
+    utils::statistics::HdrHistogram histogram;
+    EXPECT_EQ(histogram.GetSnapshot().GetPercentile(50), 0);
+
+    for (int i = 1; i <= 100; ++i) {
+        histogram.Account(i);
+    }
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetTotalCount(), 100);
+    EXPECT_NEAR(snapshot.GetPercentile(50), 50, 50 * 0.07);
+    EXPECT_NEAR(snapshot.GetPercentile(90), 90, 90 * 0.07);
+    EXPECT_NEAR(snapshot.GetPercentile(100), 100, 100 * 0.07);
+    EXPECT_EQ(snapshot.GetPercentile(0), 2);
+}
+
+UTEST(StatisticsHdrHistogram, SmallAndInvalidValues) {
+    utils::statistics::HdrHistogram histogram{SmallSettings()};
+    histogram.Account(0);
+    histogram.Account(-42);
+    histogram.Account(std::numeric_limits<double>::quiet_NaN());
+
+    const auto snapshot = histogram.GetSnapshot();
+    EXPECT_EQ(snapshot.GetValueAt(0), 3);
+    EXPECT_EQ(snapshot.GetTotalCount(), 3);
+}
+
+UTEST(StatisticsHdrHistogram, Merge) {
+    utils::statistics::HdrHistogram histogram1{SmallSettings()};
+    AccountSome(histogram1);
+    utils::statistics::HdrHistogram histogram2{SmallSettings()};
+    AccountSome(histogram2);
+    histogram2.Account(7, 10);
+
+    auto merged = histogram1.GetSnapshot();
+    merged.Add(histogram2.GetSnapshot());
+    EXPECT_EQ(merged.GetTotalCount(), 18);
+    const auto aggregated = merged.ToHistogram(SmallSettings().export_bounds);
+    EXPECT_EQ(fmt::to_string(aggregated.GetView()), "[10]=12,[100]=2,[1000]=2,[inf]=2");
+
+    histogram1.Add(histogram2.GetSnapshot());
+    EXPECT_EQ(histogram1.GetSnapshot().GetTotalCount(), 18);
+
+    utils::statistics::HdrHistogram other_layout;
+    UEXPECT_THROW(merged.Add(other_layout.GetSnapshot()), std::invalid_argument);
+    UEXPECT_THROW(histogram1.Add(other_layout.GetSnapshot()), std::invalid_argument);
+}
+
+UTEST(StatisticsHdrHistogram, Reset) {
+    utils::statistics::HdrHistogram histogram{SmallSettings()};
+    AccountSome(histogram);
+    ResetMetric(histogram);
+    EXPECT_EQ(histogram.GetSnapshot().GetTotalCount(), 0);
+}
+
+UTEST(StatisticsHdrHistogram, InvalidSettings) {
+    auto settings = SmallSettings();
+    settings.significant_bits = 0;
+    UEXPECT_THROW(utils::statistics::HdrHistogram{settings}, std::invalid_argument);
+
+    settings = SmallSettings();
+    settings.unit = 0;
+    UEXPECT_THROW(utils::statistics::HdrHistogram{settings}, std::invalid_argument);
+
+    settings = SmallSettings();
+    settings.max_value = 0.5;
+    UEXPECT_THROW(utils::statistics::HdrHistogram{settings}, std::invalid_argument);
+}
+
+UTEST_MT(StatisticsHdrHistogram, ConcurrentAccount, 4) {
+    constexpr std::size_t kTasks = 4;
+    constexpr std::uint64_t kIterations = 10'000;
+    utils::statistics::HdrHistogram histogram;
+
+    auto tasks = utils::GenerateFixedArray(kTasks, [&](std::size_t task_index) {
+        return engine::AsyncNoSpan([&, task_index] {
+            for (std::uint64_t i = 0; i < kIterations; ++i) {
+                histogram.Account(task_index * kIterations + i);
+            }
+        });
+    });
+    for (auto& task : tasks) {
+        UEXPECT_NO_THROW(task.Get());
+    }
+
+    EXPECT_EQ(histogram.GetSnapshot().GetTotalCount(), kTasks * kIterations);
+}
+
+USERVER_NAMESPACE_END
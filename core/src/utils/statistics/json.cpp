@@ -4,6 +4,7 @@
 
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/utils/overloaded.hpp>
+#include <userver/utils/statistics/metrics_snapshot.hpp>
 #include <userver/utils/statistics/storage.hpp>
 #include <utils/statistics/impl/histogram_serialization.hpp>
 #include <utils/statistics/impl/rate_serialization.hpp>
@@ -56,6 +57,12 @@ std::string ToJsonFormat(const utils::statistics::Storage& statistics, const uti
     return std::move(builder).GetString();
 }
 
+std::string ToJsonFormat(const utils::statistics::MetricsSnapshot& statistics, const utils::statistics::Request& request) {
+    JsonFormat builder{};
+    statistics.VisitMetrics(builder, request);
+    return std::move(builder).GetString();
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#include <userver/utils/statistics/metrics_snapshot.hpp>
+
+#include <algorithm>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+bool MatchesPrefix(std::string_view path, const Request& request) {
+    switch (request.prefix_match_type) {
+        case Request::PrefixMatch::kNoop:
+            return true;
+        case Request::PrefixMatch::kExact:
+            return path == request.prefix;
+        case Request::PrefixMatch::kStartsWith:
+            return utils::text::StartsWith(path, request.prefix);
+    }
+
+    UINVARIANT(false, "Unexpected PrefixMatch value");
+}
+
+bool ContainsAllLabels(LabelsSpan labels, const std::vector<Label>& required) {
+    return std::all_of(required.begin(), required.end(), [labels](const Label& label) {
+        return std::find(labels.begin(), labels.end(), LabelView{label}) != labels.end();
+    });
+}
+
+}  // namespace
+
+class MetricsSnapshot::Collector final : public BaseFormatBuilder {
+public:
+    explicit Collector(MetricsSnapshot& snapshot) : snapshot_(snapshot) {}
+
+    void HandleMetric(std::string_view path, LabelsSpan labels, const MetricValue& value) override {
+        std::vector<Label> labels_owned;
+        labels_owned.reserve(labels.size());
+        for (const auto& label : labels) {
+            labels_owned.emplace_back(label);
+        }
+
+        Metric metric{std::string{path}, std::move(labels_owned), value};
+        if (value.IsHistogram()) {
+            // The view points to the memory owned by the writer, copy it.
+            metric.value = MetricValue{snapshot_.histograms_.emplace_back(value.AsHistogram()).GetView()};
+        }
+        snapshot_.metrics_.push_back(std::move(metric));
+    }
+
+private:
+    MetricsSnapshot& snapshot_;
+};
+
+MetricsSnapshot::MetricsSnapshot(const Storage& storage) : creation_time_(std::chrono::steady_clock::now()) {
+    Collector collector{*this};
+    storage.VisitMetrics(collector);
+}
+
+void MetricsSnapshot::VisitMetrics(BaseFormatBuilder& out, const Request& request) const {
+    // Same order as in Storage::VisitMetrics: labels from request go first.
+    boost::container::small_vector<LabelView, 16> labels;
+    for (const auto& [name, value] : request.add_labels) {
+        labels.emplace_back(name, value);
+    }
+    const auto add_labels_count = labels.size();
+
+    for (const auto& metric : metrics_) {
+        if (!MatchesPrefix(metric.path, request)) continue;
+
+        labels.resize(add_labels_count);
+        for (const auto& label : metric.labels) {
+            labels.emplace_back(label);
+        }
+
+        const LabelsSpan labels_span{labels.data(), labels.data() + labels.size()};
+        if (!ContainsAllLabels(labels_span, request.require_labels)) continue;
+
+        out.HandleMetric(metric.path, labels_span, metric.value);
+    }
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,98 @@
+#include <userver/utils/statistics/metrics_snapshot.hpp>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/json.hpp>
+#include <userver/utils/statistics/pretty_format.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
+#include <userver/utils/statistics/solomon.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class MetricsSnapshotTest : public ::testing::Test {
+protected:
+    MetricsSnapshotTest() {
+        histogram_.Account(3, 2);
+        histogram_.Account(100);
+
+        entries_.push_back(storage_.RegisterWriter("a", [this](utils::statistics::Writer& writer) {
+            writer["gauge"] = gauge_;
+            writer["rate"] = utils::statistics::Rate{10};
+            writer["labeled"].ValueWithLabels(1, {"kind", "first"});
+            writer["labeled"].ValueWithLabels(2, {"kind", "second"});
+        }));
+        entries_.push_back(storage_.RegisterWriter(
+            "b", [this](utils::statistics::Writer& writer) { writer["histogram"] = histogram_; }, {{"shard", "1"}}
+        ));
+        entries_.push_back(storage_.RegisterWriter("ab", [](utils::statistics::Writer& writer) {
+            writer["float"] = 1.5;
+        }));
+    }
+
+    const utils::statistics::Storage& GetStorage() const { return storage_; }
+
+    void SetGauge(int value) { gauge_ = value; }
+
+    static std::vector<utils::statistics::Request> MakeRequests() {
+        using utils::statistics::Label;
+        using utils::statistics::Request;
+        return {
+            Request{},
+            Request::MakeWithPrefix("a"),
+            Request::MakeWithPrefix("a.labeled", {}, {Label{"kind", "second"}}),
+            Request::MakeWithPath("b.histogram", {{"application", "test"}}),
+            Request::MakeWithPrefix({}, {{"application", "test"}}, {Label{"shard", "1"}}),
+        };
+    }
+
+private:
+    utils::statistics::Storage storage_;
+    utils::statistics::Histogram histogram_{std::vector<double>{5, 50}};
+    int gauge_{42};
+    std::vector<utils::statistics::Entry> entries_;
+};
+
+}  // namespace
+
+UTEST_F(MetricsSnapshotTest, SameAsStorage) {
+    const utils::statistics::MetricsSnapshot snapshot{GetStorage()};
+    EXPECT_EQ(snapshot.GetMetricsCount(), 6);
+
+    const std::unordered_map<std::string, std::string> common_labels{{"application", "test"}};
+    for (const auto& request : MakeRequests()) {
+        EXPECT_EQ(
+            utils::statistics::ToPrometheusFormat(GetStorage(), request),
+            utils::statistics::ToPrometheusFormat(snapshot, request)
+        );
+        EXPECT_EQ(
+            utils::statistics::ToPrometheusFormatUntyped(GetStorage(), request),
+            utils::statistics::ToPrometheusFormatUntyped(snapshot, request)
+        );
+        EXPECT_EQ(
+            utils::statistics::ToJsonFormat(GetStorage(), request), utils::statistics::ToJsonFormat(snapshot, request)
+        );
+        EXPECT_EQ(
+            utils::statistics::ToPrettyFormat(GetStorage(), request),
+            utils::statistics::ToPrettyFormat(snapshot, request)
+        );
+        EXPECT_EQ(
+            utils::statistics::ToSolomonFormat(GetStorage(), common_labels, request),
+            utils::statistics::ToSolomonFormat(snapshot, common_labels, request)
+        );
+    }
+}
+
+UTEST_F(MetricsSnapshotTest, Immutable) {
+    const utils::statistics::MetricsSnapshot snapshot{GetStorage()};
+    const auto request = utils::statistics::Request::MakeWithPath("a.gauge");
+    const auto before = utils::statistics::ToJsonFormat(snapshot, request);
+
+    SetGauge(43);
+    EXPECT_EQ(utils::statistics::ToJsonFormat(snapshot, request), before);
+    EXPECT_NE(utils::statistics::ToJsonFormat(GetStorage(), request), before);
+}
+
+USERVER_NAMESPACE_END
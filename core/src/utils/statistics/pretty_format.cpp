@@ -10,6 +10,7 @@
 
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/metrics_snapshot.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -71,6 +72,13 @@ std::string ToPrettyFormat(const utils::statistics::Storage& statistics, const u
     return std::move(builder).Release();
 }
 
+std::string
+ToPrettyFormat(const utils::statistics::MetricsSnapshot& statistics, const utils::statistics::Request& request) {
+    FormatBuilder builder;
+    statistics.VisitMetrics(builder, request);
+    return std::move(builder).Release();
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
@@ -10,6 +10,7 @@
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
+#include <userver/utils/statistics/metrics_snapshot.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -195,6 +196,22 @@ ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics, const ut
     return builder.Release();
 }
 
+std::string
+ToPrometheusFormat(const utils::statistics::MetricsSnapshot& statistics, const utils::statistics::Request& request) {
+    impl::FormatBuilder<impl::Typed::kYes> builder{};
+    statistics.VisitMetrics(builder, request);
+    return builder.Release();
+}
+
+std::string ToPrometheusFormatUntyped(
+    const utils::statistics::MetricsSnapshot& statistics,
+    const utils::statistics::Request& request
+) {
+    impl::FormatBuilder<impl::Typed::kNo> builder{};
+    statistics.VisitMetrics(builder, request);
+    return builder.Release();
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/overloaded.hpp>
+#include <userver/utils/statistics/metrics_snapshot.hpp>
 #include <userver/utils/statistics/storage.hpp>
 
 #include <utils/statistics/impl/histogram_serialization.hpp>
@@ -116,10 +117,9 @@ private:
     formats::json::StringBuilder& builder_;
 };
 
-}  // namespace
-
-std::string ToSolomonFormat(
-    const utils::statistics::Storage& statistics,
+template <typename MetricsSource>
+std::string ToSolomonFormatImpl(
+    const MetricsSource& statistics,
     const std::unordered_map<std::string, std::string>& common_labels,
     const utils::statistics::Request& request
 ) {
@@ -136,6 +136,24 @@ std::string ToSolomonFormat(
     return builder.GetString();
 }
 
+}  // namespace
+
+std::string ToSolomonFormat(
+    const utils::statistics::Storage& statistics,
+    const std::unordered_map<std::string, std::string>& common_labels,
+    const utils::statistics::Request& request
+) {
+    return ToSolomonFormatImpl(statistics, common_labels, request);
+}
+
+std::string ToSolomonFormat(
+    const utils::statistics::MetricsSnapshot& statistics,
+    const std::unordered_map<std::string, std::string>& common_labels,
+    const utils::statistics::Request& request
+) {
+    return ToSolomonFormatImpl(statistics, common_labels, request);
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
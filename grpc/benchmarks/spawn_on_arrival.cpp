@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/null_logger.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class TinyUnaryService final : public sample::ugrpc::UnitTestServiceBase {
+public:
+    SayHelloResult SayHello(CallContext& /*context*/, sample::ugrpc::GreetingRequest&& /*request*/) override {
+        return sample::ugrpc::GreetingResponse{};
+    }
+};
+
+class TinyUnaryServer final : public ugrpc::tests::ServiceBase {
+public:
+    explicit TinyUnaryServer(ugrpc::server::ServerConfig&& config) : ServiceBase(std::move(config)) {
+        RegisterService(service_);
+        StartServer();
+    }
+
+    ~TinyUnaryServer() override { StopServer(); }
+
+private:
+    TinyUnaryService service_;
+};
+
+ugrpc::server::ServerConfig MakeServerConfig(bool spawn_handlers_on_arrival) {
+    ugrpc::server::ServerConfig config;
+    config.spawn_handlers_on_arrival = spawn_handlers_on_arrival;
+    return config;
+}
+
+constexpr std::size_t kConcurrency = 32;
+constexpr std::size_t kCallsPerTask = 64;
+
+// Arguments: spawn_handlers_on_arrival, worker threads
+void TinyUnaryRPC(benchmark::State& state) {
+    const logging::DefaultLoggerGuard logger_guard{logging::MakeNullLogger()};
+
+    engine::RunStandalone(
+        state.range(1),
+        engine::TaskProcessorPoolsConfig{10000, 100000, 256 * 1024ULL, 1, "ev", false},
+        [&] {
+            TinyUnaryServer server{MakeServerConfig(state.range(0) != 0)};
+            auto clients = utils::GenerateFixedArray(kConcurrency, [&server](auto) {
+                return server.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+            });
+
+            std::vector<std::chrono::steady_clock::duration> latencies;
+            latencies.reserve(kConcurrency * kCallsPerTask);
+
+            for (auto _ : state) {
+                auto tasks = utils::GenerateFixedArray(kConcurrency, [&clients](auto i) {
+                    return engine::AsyncNoSpan([&client = clients[i]] {
+                        std::vector<std::chrono::steady_clock::duration> task_latencies;
+                        task_latencies.reserve(kCallsPerTask);
+                        for (std::size_t j = 0; j < kCallsPerTask; ++j) {
+                            const auto start = std::chrono::steady_clock::now();
+                            client.SayHello({}).Finish();
+                            task_latencies.push_back(std::chrono::steady_clock::now() - start);
+                        }
+                        return task_latencies;
+                    });
+                });
+
+                for (auto& task : tasks) {
+                    const auto task_latencies = task.Get();
+                    latencies.insert(latencies.end(), task_latencies.begin(), task_latencies.end());
+                }
+            }
+
+            UINVARIANT(!latencies.empty(), "No calls were made");
+            const auto p99 = latencies.begin() + latencies.size() * 99 / 100;
+            std::nth_element(latencies.begin(), p99, latencies.end());
+
+            state.counters["rps"] = benchmark::Counter(
+                static_cast<double>(state.iterations() * kConcurrency * kCallsPerTask), benchmark::Counter::kIsRate
+            );
+            state.counters["p99_us"] = std::chrono::duration<double, std::micro>(*p99).count();
+        }
+    );
+}
+
+}  // namespace
+
+BENCHMARK(TinyUnaryRPC)
+    ->ArgsProduct({{0, 1}, {1, 2, 4, 8}})
+    ->ArgNames({"on_arrival", "threads"})
+    ->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
@@ -21,6 +21,10 @@ public:
 
     void* GetTag() noexcept;
 
+    /// @brief Sets the task to cancel if the RPC is cancelled. Must be called
+    /// before the event can be notified.
+    void SetCancellationToken(engine::TaskCancellationToken cancellation_token) noexcept;
+
     /// @see EventBase::Notify
     void Notify(bool ok) noexcept override;
 
@@ -71,6 +71,11 @@ struct ServerConfig final {
     /// Serve a web page with runtime info about gRPC connections
     bool enable_channelz{false};
 
+    /// Spawn a task for an RPC right from the completion queue thread once the
+    /// RPC arrives, instead of keeping an idle listener task per method and
+    /// queue. Saves a task start and a context switch per RPC.
+    bool spawn_handlers_on_arrival{false};
+
     /// 'access-tskv.log' logger
     logging::LoggerPtr access_tskv_logger{logging::MakeNullLogger()};
 
@@ -33,6 +33,7 @@ struct ServiceDefaults;
 /// channel-args | a map of channel arguments, see gRPC Core docs | {}
 /// native-log-level | min log level for the native gRPC library | 'error'
 /// enable-channelz | initialize service with runtime info about gRPC connections | false
+/// spawn-handlers-on-arrival | spawn a task for an RPC only after the RPC arrives, instead of keeping idle listener tasks | false
 /// service-defaults | default config values for gRPC services, see config schema | {}
 /// tls.cert | path to file with server TLS certificate | -
 /// tls.key | path to file with secret key from server TLS certificate | -
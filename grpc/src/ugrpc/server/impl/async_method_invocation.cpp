@@ -12,6 +12,10 @@ RpcFinishedEvent::RpcFinishedEvent(
 
 void* RpcFinishedEvent::GetTag() noexcept { return this; }
 
+void RpcFinishedEvent::SetCancellationToken(engine::TaskCancellationToken cancellation_token) noexcept {
+    cancellation_token_ = std::move(cancellation_token);
+}
+
 void RpcFinishedEvent::Wait() noexcept { event_.WaitNonCancellable(); }
 
 void RpcFinishedEvent::Notify(bool ok) noexcept {
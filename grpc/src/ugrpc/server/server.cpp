@@ -123,6 +123,7 @@ private:
     ugrpc::impl::StatisticsStorage statistics_storage_;
     const dynamic_config::Source config_source_;
     logging::LoggerPtr access_tskv_logger_;
+    const bool spawn_handlers_on_arrival_;
 };
 
 Server::Impl::Impl(
@@ -132,7 +133,8 @@ Server::Impl::Impl(
 )
     : statistics_storage_(statistics_storage, ugrpc::impl::StatisticsDomain::kServer),
       config_source_(config_source),
-      access_tskv_logger_(std::move(config.access_tskv_logger)) {
+      access_tskv_logger_(std::move(config.access_tskv_logger)),
+      spawn_handlers_on_arrival_(config.spawn_handlers_on_arrival) {
     LOG_INFO() << "Configuring the gRPC server";
     ugrpc::impl::SetupNativeLogging();
     ugrpc::impl::UpdateNativeLogLevel(config.native_log_level);
@@ -196,6 +198,7 @@ impl::ServiceSettings Server::Impl::MakeServiceSettings(ServiceConfig&& config)
         std::move(config.middlewares),
         access_tskv_logger_,
         config_source_,
+        spawn_handlers_on_arrival_,
     };
 }
 
@@ -82,6 +82,10 @@ properties:
     enable-channelz:
         type: boolean
         description: enable channelz
+    spawn-handlers-on-arrival:
+        type: boolean
+        description: spawn a task for an RPC only after the RPC arrives, instead of keeping idle listener tasks
+        defaultDescription: false
     tls:
         type: object
         additionalProperties: false
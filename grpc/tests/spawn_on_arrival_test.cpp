@@ -0,0 +1,112 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class UnitTestServiceOnArrival final : public sample::ugrpc::UnitTestServiceBase {
+public:
+    SayHelloResult SayHello(CallContext& /*context*/, sample::ugrpc::GreetingRequest&& request) override {
+        sample::ugrpc::GreetingResponse response;
+        response.set_name("Hello " + request.name());
+        return response;
+    }
+
+    ChatResult Chat(CallContext& /*context*/, ChatReaderWriter& stream) override {
+        sample::ugrpc::StreamGreetingRequest request;
+        sample::ugrpc::StreamGreetingResponse response;
+        while (stream.Read(request)) {
+            response.set_name("Hello " + request.name());
+            stream.Write(response);
+        }
+        return grpc::Status::OK;
+    }
+
+    WriteManyResult WriteMany(CallContext& /*context*/, WriteManyReader& reader) override {
+        sample::ugrpc::StreamGreetingRequest request;
+        EXPECT_TRUE(reader.Read(request));
+        request_received.Send();
+
+        // Wait until the client drops the call
+        engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+        EXPECT_TRUE(engine::current_task::ShouldCancel());
+        return sample::ugrpc::StreamGreetingResponse{};
+    }
+
+    engine::SingleConsumerEvent request_received;
+};
+
+ugrpc::server::ServerConfig MakeServerConfig() {
+    ugrpc::server::ServerConfig config;
+    config.spawn_handlers_on_arrival = true;
+    return config;
+}
+
+}  // namespace
+
+UTEST_MT(GrpcSpawnOnArrival, Unary, 4) {
+    ugrpc::tests::Service<UnitTestServiceOnArrival> service{MakeServerConfig()};
+    auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < 8; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&client] {
+            for (int j = 0; j < 50; ++j) {
+                sample::ugrpc::GreetingRequest request;
+                request.set_name("userver");
+                EXPECT_EQ(client.SayHello(request).Finish().name(), "Hello userver");
+            }
+        }));
+    }
+    engine::GetAll(tasks);
+}
+
+UTEST(GrpcSpawnOnArrival, BidirectionalStream) {
+    ugrpc::tests::Service<UnitTestServiceOnArrival> service{MakeServerConfig()};
+    auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+    auto call = client.Chat();
+    sample::ugrpc::StreamGreetingRequest request;
+    sample::ugrpc::StreamGreetingResponse response;
+    for (int i = 0; i < 3; ++i) {
+        request.set_name(std::to_string(i));
+        ASSERT_TRUE(call.Write(request));
+        ASSERT_TRUE(call.Read(response));
+        EXPECT_EQ(response.name(), "Hello " + std::to_string(i));
+    }
+    ASSERT_TRUE(call.WritesDone());
+    EXPECT_FALSE(call.Read(response));
+}
+
+UTEST(GrpcSpawnOnArrival, CancelledByClient) {
+    ugrpc::tests::Service<UnitTestServiceOnArrival> service{MakeServerConfig()};
+    auto client = service.MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+    {
+        auto call = client.WriteMany();
+        ASSERT_TRUE(call.Write({}));
+        ASSERT_TRUE(service.GetService().request_received.WaitForEventFor(utest::kMaxTestWaitTime));
+        // Drop 'call' without finishing, the handler task should be cancelled
+    }
+
+    // The server should keep serving after the cancellation
+    sample::ugrpc::GreetingRequest request;
+    request.set_name("userver");
+    EXPECT_EQ(client.SayHello(request).Finish().name(), "Hello userver");
+}
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 /// @brief @copybrief components::MongoCache
 
 #include <chrono>
+#include <optional>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -11,13 +13,20 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/cache/mongo_cache_type_traits.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/inline.hpp>
 #include <userver/formats/bson/value_builder.hpp>
+#include <userver/storages/mongo/change_stream.hpp>
 #include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/exception.hpp>
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/options.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
@@ -32,9 +41,23 @@ inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
 
 namespace impl {
 
+inline constexpr std::chrono::milliseconds kChangeStreamMaxAwaitTime{1000};
+inline constexpr std::chrono::milliseconds kChangeStreamRetryInterval{1000};
+
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 
-}
+bool GetMongoCacheUseChangeStream(const ComponentConfig&);
+
+enum class ChangeEventKind {
+    /// insert, update or replace, carries the full document
+    kUpsert,
+    /// the change can not be applied incrementally, e.g. delete
+    kNeedsFullUpdate,
+};
+
+ChangeEventKind GetChangeEventKind(const formats::bson::Document& event);
+
+}  // namespace impl
 
 // clang-format off
 
@@ -52,6 +75,18 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// update-correction | adjusts incremental updates window to overlap with previous update | 0
+/// use-change-stream | apply the collection change stream events on incremental updates instead of querying the collection | false
+///
+/// ### Change stream mode
+/// With `use-change-stream: true` the cache watches the collection and
+/// requests an incremental update as soon as changes arrive. Incremental
+/// updates apply the `fullDocument` of the received insert, update and replace
+/// events, and do not query the collection at all, so `update-interval` may be
+/// relaxed. Any other event (e.g. delete) triggers a full update, as does
+/// a failure to resume the change stream.
+///
+/// Requires `update-types: full-and-incremental` and a replica set or
+/// a sharded cluster. Keeps a connection of the pool busy.
 ///
 /// ## Traits example:
 /// All fields below (except for function overrides) are mandatory.
@@ -150,10 +185,22 @@ private:
 
     std::unique_ptr<typename MongoCacheTraits::DataType> GetData(cache::UpdateType type);
 
+    storages::mongo::ChangeStream OpenChangeStream(const std::optional<formats::bson::Document>& resume_token) const;
+
+    void WatchChanges(std::optional<storages::mongo::ChangeStream> stream);
+
+    void ApplyChanges(cache::UpdateStatisticsScope& stats_scope);
+
     const std::shared_ptr<CollectionsType> mongo_collections_;
     const storages::mongo::Collection* const mongo_collection_;
     const std::chrono::system_clock::duration correction_;
+    const bool use_change_stream_;
     std::size_t cpu_relax_iterations_{0};
+
+    engine::Mutex pending_changes_mutex_;
+    std::vector<formats::bson::Document> pending_changes_;
+    // Must be the last member, so that it stops before the rest are destroyed
+    engine::TaskWithResult<void> watch_task_;
 };
 
 template <class MongoCacheTraits>
@@ -165,11 +212,20 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config, const Co
       mongo_collections_(context.FindComponent<typename MongoCacheTraits::MongoCollectionsComponent>()
                              .template GetCollectionForLibrary<CollectionsType>()),
       mongo_collection_(std::addressof(mongo_collections_.get()->*MongoCacheTraits::kMongoCollectionsField)),
-      correction_(impl::GetMongoCacheUpdateCorrection(config)) {
+      correction_(impl::GetMongoCacheUpdateCorrection(config)),
+      use_change_stream_(impl::GetMongoCacheUseChangeStream(config)) {
     [[maybe_unused]] mongo_cache::impl::CheckTraits<MongoCacheTraits> check_traits;
 
-    if (CachingComponentBase<typename MongoCacheTraits::DataType>::GetAllowedUpdateTypes() ==
-            cache::AllowedUpdateTypes::kFullAndIncremental &&
+    const auto allowed_update_types =
+        CachingComponentBase<typename MongoCacheTraits::DataType>::GetAllowedUpdateTypes();
+    if (use_change_stream_ && allowed_update_types != cache::AllowedUpdateTypes::kFullAndIncremental) {
+        throw std::logic_error(fmt::format(
+            "Change stream is requested in config of '{}' cache, but update-types "
+            "is not full-and-incremental",
+            components::GetCurrentComponentName(config)
+        ));
+    }
+    if (allowed_update_types == cache::AllowedUpdateTypes::kFullAndIncremental && !use_change_stream_ &&
         !mongo_cache::impl::kHasUpdateFieldName<MongoCacheTraits> &&
         !mongo_cache::impl::kHasFindOperation<MongoCacheTraits>) {
         throw std::logic_error(fmt::format(
@@ -186,11 +242,27 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config, const Co
         ));
     }
 
+    if (use_change_stream_) {
+        // The stream is opened before the first update, so that no changes
+        // are missed in between
+        std::optional<storages::mongo::ChangeStream> stream;
+        try {
+            stream.emplace(OpenChangeStream({}));
+        } catch (const std::exception& ex) {
+            LOG_WARNING() << "Failed to open change stream for cache " << MongoCacheTraits::kName << ": " << ex;
+        }
+        watch_task_ = utils::CriticalAsync(
+            fmt::format("mongo-cache-watch/{}", MongoCacheTraits::kName),
+            [this, stream = std::move(stream)]() mutable { WatchChanges(std::move(stream)); }
+        );
+    }
+
     this->StartPeriodicUpdates();
 }
 
 template <class MongoCacheTraits>
 MongoCache<MongoCacheTraits>::~MongoCache() {
+    if (watch_task_.IsValid()) watch_task_.SyncCancel();
     this->StopPeriodicUpdates();
 }
 
@@ -203,6 +275,17 @@ void MongoCache<MongoCacheTraits>::Update(
 ) {
     namespace sm = storages::mongo;
 
+    if (use_change_stream_) {
+        if (type == cache::UpdateType::kIncremental) {
+            ApplyChanges(stats_scope);
+            return;
+        }
+
+        // Full update reads all the changes made so far
+        const std::lock_guard lock{pending_changes_mutex_};
+        pending_changes_.clear();
+    }
+
     const auto* collection = mongo_collection_;
     auto find_op = GetFindOperation(type, last_update, now, correction_);
     auto cursor = collection->Execute(find_op);
@@ -324,6 +407,118 @@ std::unique_ptr<typename MongoCacheTraits::DataType> MongoCache<MongoCacheTraits
     }
 }
 
+template <class MongoCacheTraits>
+storages::mongo::ChangeStream MongoCache<MongoCacheTraits>::OpenChangeStream(
+    const std::optional<formats::bson::Document>& resume_token
+) const {
+    namespace sm = storages::mongo;
+
+    sm::operations::Watch watch_op;
+    watch_op.SetOption(sm::options::FullDocument::kUpdateLookup);
+    watch_op.SetOption(sm::options::MaxAwaitTime{impl::kChangeStreamMaxAwaitTime});
+    if (resume_token) watch_op.SetOption(sm::options::ResumeAfter{*resume_token});
+    if (MongoCacheTraits::kIsSecondaryPreferred) {
+        watch_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+    }
+    return mongo_collection_->Execute(watch_op);
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::WatchChanges(std::optional<storages::mongo::ChangeStream> stream) {
+    std::optional<formats::bson::Document> resume_token;
+    if (stream) resume_token = stream->GetResumeToken();
+
+    while (!engine::current_task::ShouldCancel()) {
+        try {
+            if (!stream) {
+                if (resume_token) {
+                    try {
+                        stream.emplace(OpenChangeStream(resume_token));
+                    } catch (const storages::mongo::ServerException& ex) {
+                        // Most probably the oplog does not have the token anymore
+                        LOG_WARNING() << "Failed to resume change stream for cache " << MongoCacheTraits::kName
+                                      << ": " << ex;
+                        resume_token.reset();
+                    }
+                }
+                if (!stream) {
+                    stream.emplace(OpenChangeStream({}));
+                    // Some changes might have been missed
+                    this->InvalidateAsync(cache::UpdateType::kFull);
+                }
+            }
+
+            auto event = stream->Next();
+            resume_token = stream->GetResumeToken();
+            if (!event) continue;
+
+            if (impl::GetChangeEventKind(*event) == impl::ChangeEventKind::kNeedsFullUpdate) {
+                this->InvalidateAsync(cache::UpdateType::kFull);
+                continue;
+            }
+
+            bool is_first_pending = false;
+            {
+                const std::lock_guard lock{pending_changes_mutex_};
+                is_first_pending = pending_changes_.empty();
+                pending_changes_.push_back(std::move(*event));
+            }
+            if (is_first_pending) this->InvalidateAsync(cache::UpdateType::kIncremental);
+        } catch (const std::exception& ex) {
+            LOG_WARNING() << "Error watching changes for cache " << MongoCacheTraits::kName << ": " << ex;
+            stream.reset();
+            engine::InterruptibleSleepFor(impl::kChangeStreamRetryInterval);
+        }
+    }
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::ApplyChanges(cache::UpdateStatisticsScope& stats_scope) {
+    std::vector<formats::bson::Document> changes;
+    {
+        const std::lock_guard lock{pending_changes_mutex_};
+        changes.swap(pending_changes_);
+    }
+    if (changes.empty()) {
+        stats_scope.FinishNoChanges();
+        return;
+    }
+
+    auto scope = tracing::Span::CurrentSpan().CreateScopeTime("copy_data");
+    auto new_cache = GetData(cache::UpdateType::kIncremental);
+    scope.Reset(kFetchAndParseStage);
+
+    for (const auto& event : changes) {
+        const auto doc = event["fullDocument"];
+        // The document might have been deleted before the lookup,
+        // the delete event is going to trigger a full update
+        if (doc.IsMissing() || doc.IsNull()) continue;
+
+        stats_scope.IncreaseDocumentsReadCount(1);
+        try {
+            auto object = DeserializeObject(doc.template As<formats::bson::Document>());
+            auto key = (object.*MongoCacheTraits::kKeyField);
+            (*new_cache)[key] = std::move(object);
+        } catch (const std::exception& e) {
+            LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache " << MongoCacheTraits::kName
+                                << ", _id=" << doc["_id"].template ConvertTo<std::string>() << ", what(): " << e;
+            stats_scope.IncreaseDocumentsParseFailures(1);
+
+            if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) {
+                // The taken changes are lost, a full update restores them
+                this->InvalidateAsync(cache::UpdateType::kFull);
+                throw;
+            }
+        }
+    }
+
+    scope.Reset();
+
+    const auto size = new_cache->size();
+    this->Set(std::move(new_cache));
+    stats_scope.Finish(size);
+}
+
 namespace impl {
 
 std::string GetMongoCacheSchema();
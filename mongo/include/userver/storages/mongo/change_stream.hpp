@@ -0,0 +1,52 @@
+#pragma once
+
+/// @file userver/storages/mongo/change_stream.hpp
+/// @brief @copybrief storages::mongo::ChangeStream
+
+#include <memory>
+#include <optional>
+
+#include <userver/formats/bson/document.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+namespace impl {
+class ChangeStreamImpl;
+}  // namespace impl
+
+/// @brief Interface for MongoDB change streams
+///
+/// Change stream is resumed automatically after a single transient error.
+/// To continue watching after a destruction of the stream, open a new one with
+/// options::ResumeAfter and the token from GetResumeToken().
+///
+/// @note Change stream keeps a pool connection for its whole lifetime.
+/// @note Change streams are only available for replica sets and sharded
+/// clusters.
+class ChangeStream {
+public:
+    explicit ChangeStream(std::unique_ptr<impl::ChangeStreamImpl>&&);
+    ~ChangeStream();
+
+    ChangeStream(ChangeStream&&) noexcept;
+    ChangeStream& operator=(ChangeStream&&) noexcept;
+
+    /// @brief Waits for the next change event.
+    /// @returns std::nullopt if no changes were made during
+    /// options::MaxAwaitTime (default is 1s).
+    /// @throws MongoException on errors, the stream is invalidated in this case.
+    std::optional<formats::bson::Document> Next();
+
+    /// @brief Returns the token to resume watching right after the last
+    /// returned event.
+    /// @note The token is advanced even when no events are returned.
+    std::optional<formats::bson::Document> GetResumeToken() const;
+
+private:
+    std::unique_ptr<impl::ChangeStreamImpl> impl_;
+};
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
@@ -12,6 +12,7 @@
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/value.hpp>
 #include <userver/storages/mongo/bulk.hpp>
+#include <userver/storages/mongo/change_stream.hpp>
 #include <userver/storages/mongo/cursor.hpp>
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/write_result.hpp>
@@ -116,6 +117,13 @@ public:
     template <typename... Options>
     Cursor Aggregate(formats::bson::Value pipeline, Options&&... options);
 
+    /// @brief Opens a change stream on the collection
+    /// @param pipeline an array of aggregation operations to filter or
+    /// transform the change events, might be empty
+    /// @see storages::mongo::ChangeStream
+    template <typename... Options>
+    ChangeStream Watch(formats::bson::Value pipeline, Options&&... options) const;
+
     /// Get collection name
     const std::string& GetCollectionName() const;
 
@@ -134,6 +142,7 @@ public:
     WriteResult Execute(operations::Bulk&&);
     Cursor Execute(const operations::Aggregate&);
     void Execute(const operations::Drop&);
+    ChangeStream Execute(const operations::Watch&) const;
     /// @}
 private:
     std::shared_ptr<impl::CollectionImpl> impl_;
@@ -275,6 +284,13 @@ Cursor Collection::Aggregate(formats::bson::Value pipeline, Options&&... options
     return Execute(aggregate);
 }
 
+template <typename... Options>
+ChangeStream Collection::Watch(formats::bson::Value pipeline, Options&&... options) const {
+    operations::Watch watch_op(std::move(pipeline));
+    (watch_op.SetOption(std::forward<Options>(options)), ...);
+    return Execute(watch_op);
+}
+
 }  // namespace storages::mongo
 
 USERVER_NAMESPACE_END
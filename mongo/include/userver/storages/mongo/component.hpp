@@ -44,6 +44,7 @@ namespace components {
 ///   local_threshold: 15ms
 ///   maintenance_period: 15s
 ///   stats_verbosity: terse
+///   compressors: [zstd, snappy]
 /// ```
 /// You must specify one of `dbalias` or `dbconnection`.
 ///
@@ -65,6 +66,9 @@ namespace components {
 /// maintenance_period | pool maintenance period (idle connections pruning etc.) | 15s
 /// stats_verbosity | changes the granularity of reported metrics | 'terse'
 /// dns_resolver | server hostname resolver type (getaddrinfo or async) | 'async'
+/// compressors | wire protocol compressors in the order of preference (zstd, snappy or zlib), the first one supported by the server is used | no compression
+/// zlib_compression_level | zlib compression level from -1 (zlib default) to 9 | -1
+/// congestion_control.controller | congestion control algorithm: linear, gradient (congestion_control::v2::GradientController) or vegas (congestion_control::v2::VegasController) | linear
 ///
 /// `stats_verbosity` accepts one of the following values:
 /// Value | Description
@@ -72,6 +76,10 @@ namespace components {
 /// terse | Default value, report only cumulative stats and read/write totals
 /// full | Separate metrics for each operation, divided by read preference or write concern
 ///
+/// Compression saves bandwidth on large documents at the cost of CPU, compare
+/// `pool.traffic.wire-bytes-*` and `pool.traffic.logical-bytes-*` metrics to
+/// see the effect. The compressors must be enabled in the mongo-c-driver build.
+///
 /// It is a common practice to provide a database connection string via
 /// environment variables. To retrieve a value from the environment use
 /// `dbconnection#env: THE_ENV_VARIABLE_WITH_CONNECTION_STRING` as described
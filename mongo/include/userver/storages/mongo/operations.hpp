@@ -336,6 +336,39 @@ private:
     utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
 };
 
+/// @brief Opens a change stream
+/// @see https://www.mongodb.com/docs/manual/changeStreams/
+class Watch {
+public:
+    /// Watches all the changes
+    Watch();
+
+    /// Watches the changes passed through an aggregation pipeline
+    explicit Watch(formats::bson::Value pipeline);
+    ~Watch();
+
+    Watch(const Watch&);
+    Watch(Watch&&) noexcept;
+    Watch& operator=(const Watch&);
+    Watch& operator=(Watch&&) noexcept;
+
+    void SetOption(const options::ReadPreference&);
+    void SetOption(options::ReadPreference::Mode);
+    void SetOption(options::FullDocument);
+    void SetOption(const options::ResumeAfter&);
+    void SetOption(const options::MaxAwaitTime&);
+    void SetOption(const options::Comment&);
+
+private:
+    friend class storages::mongo::impl::cdriver::CDriverCollectionImpl;
+
+    class Impl;
+    static constexpr size_t kSize = 120;
+    static constexpr size_t kAlignment = 8;
+    // MAC_COMPAT: std::string size differs
+    utils::FastPimpl<Impl, kSize, kAlignment, false> impl_;
+};
+
 class Drop {
 public:
     Drop();
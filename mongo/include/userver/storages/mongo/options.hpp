@@ -297,6 +297,39 @@ private:
     std::chrono::milliseconds value_;
 };
 
+/// @brief Specifies how long the server waits for new change stream events
+/// before returning an empty batch
+/// @warning Must be less than the socket timeout of the pool.
+class MaxAwaitTime {
+public:
+    explicit MaxAwaitTime(const std::chrono::milliseconds& value) : value_(value) {}
+
+    const std::chrono::milliseconds& Value() const { return value_; }
+
+private:
+    std::chrono::milliseconds value_;
+};
+
+/// Specifies what change stream returns for update events
+enum class FullDocument {
+    /// only the changed fields, default
+    kDefault,
+    /// also the majority-committed version of the whole document as of
+    /// some point after the change
+    kUpdateLookup,
+};
+
+/// Resumes the change stream right after the event with the specified token
+class ResumeAfter {
+public:
+    explicit ResumeAfter(formats::bson::Document resume_token) : value_(std::move(resume_token)) {}
+
+    const formats::bson::Document& Value() const { return value_; }
+
+private:
+    formats::bson::Document value_;
+};
+
 }  // namespace storages::mongo::options
 
 USERVER_NAMESPACE_END
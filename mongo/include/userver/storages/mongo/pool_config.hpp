@@ -7,9 +7,10 @@
 #include <cstddef>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/components/component_fwd.hpp>
-#include <userver/congestion_control/controllers/linear.hpp>
+#include <userver/congestion_control/controllers/factory.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -21,6 +22,13 @@ enum class StatsVerbosity {
     kNone,   ///< No stats at all
 };
 
+/// Wire protocol compression algorithm
+enum class Compressor {
+    kSnappy,
+    kZlib,
+    kZstd,
+};
+
 /// @brief Mongo connection pool options
 ///
 /// Dynamic option @ref MONGO_CONNECTION_POOL_SETTINGS
@@ -95,8 +103,14 @@ struct PoolConfig final {
     /// Whether to write detailed stats
     StatsVerbosity stats_verbosity = StatsVerbosity::kTerse;
 
+    /// @brief Wire protocol compressors in the order of preference.
+    /// The first one supported by the server is used, no compression if empty.
+    std::vector<Compressor> compressors;
+    /// zlib compression level from -1 (zlib default) to 9
+    std::optional<int> zlib_compression_level;
+
     /// Congestion control config
-    congestion_control::v2::LinearController::StaticConfig cc_config;
+    congestion_control::v2::ControllerStaticConfig cc_config;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& config, formats::parse::To<PoolConfig>);
@@ -11,6 +11,18 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig& c
     return config["update-correction"].As<std::chrono::milliseconds>(0);
 }
 
+bool GetMongoCacheUseChangeStream(const ComponentConfig& config) {
+    return config["use-change-stream"].As<bool>(false);
+}
+
+ChangeEventKind GetChangeEventKind(const formats::bson::Document& event) {
+    const auto operation_type = event["operationType"].As<std::string>({});
+    if (operation_type == "insert" || operation_type == "update" || operation_type == "replace") {
+        return ChangeEventKind::kUpsert;
+    }
+    return ChangeEventKind::kNeedsFullUpdate;
+}
+
 std::string GetMongoCacheSchema() {
     return R"(
 type: object
@@ -21,6 +33,10 @@ properties:
         type: string
         description: adjusts incremental updates window to overlap with previous update
         defaultDescription: 0
+    use-change-stream:
+        type: boolean
+        description: apply the collection change stream events on incremental updates instead of querying the collection
+        defaultDescription: false
 )";
 }
 
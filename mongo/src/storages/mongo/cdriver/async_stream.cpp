@@ -63,12 +63,12 @@ class AsyncStream : public mongoc_stream_t {
 public:
     static constexpr int kStreamType = 0x53755459;
 
-    static cdriver::StreamPtr Create(engine::io::Socket);
+    static cdriver::StreamPtr Create(engine::io::Socket, stats::TrafficStatistics*);
 
     void SetCreated() { is_created_ = true; }
 
 private:
-    AsyncStream(engine::io::Socket) noexcept;
+    AsyncStream(engine::io::Socket, stats::TrafficStatistics*) noexcept;
 
     // mongoc_stream_buffered resizes itself indiscriminately
     // NOTE: returns number of bytes stored to data, not buffered!
@@ -89,6 +89,7 @@ private:
 
     const uint64_t epoch_;
     engine::io::Socket socket_;
+    stats::TrafficStatistics* const traffic_stats_;
     bool is_timed_out_{false};
     bool is_created_{false};
 
@@ -313,7 +314,7 @@ mongoc_stream_t* MakeAsyncStream(
     auto socket = Connect(host, connect_timeout_ms, error, init_data->dns_resolver);
     if (!socket) return nullptr;
 
-    auto stream = AsyncStream::Create(std::move(socket));
+    auto stream = AsyncStream::Create(std::move(socket), init_data->traffic_stats);
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
     auto* const async_stream_ptr = static_cast<AsyncStream*>(stream.get());
 
@@ -349,8 +350,8 @@ mongoc_stream_t* MakeAsyncStream(
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
-AsyncStream::AsyncStream(engine::io::Socket socket) noexcept
-    : epoch_(GetNextStreamEpoch()), socket_(std::move(socket)) {
+AsyncStream::AsyncStream(engine::io::Socket socket, stats::TrafficStatistics* traffic_stats) noexcept
+    : epoch_(GetNextStreamEpoch()), socket_(std::move(socket)), traffic_stats_(traffic_stats) {
     type = kStreamType;
     destroy = &Destroy;
     close = &Close;
@@ -414,8 +415,8 @@ size_t AsyncStream::BufferedRecv(void* data, size_t size, size_t min_bytes, engi
     return bytes_stored;
 }
 
-cdriver::StreamPtr AsyncStream::Create(engine::io::Socket socket) {
-    return cdriver::StreamPtr(new AsyncStream(std::move(socket)));
+cdriver::StreamPtr AsyncStream::Create(engine::io::Socket socket, stats::TrafficStatistics* traffic_stats) {
+    return cdriver::StreamPtr(new AsyncStream(std::move(socket), traffic_stats));
 }
 
 void AsyncStream::Destroy(mongoc_stream_t* stream) noexcept {
@@ -488,6 +489,10 @@ ssize_t AsyncStream::Writev(mongoc_stream_t* stream, mongoc_iovec_t* iov, size_t
         bytes_sent = -1;
     }
 
+    if (self->traffic_stats_ && bytes_sent > 0) {
+        self->traffic_stats_->wire_bytes_sent.Add(utils::statistics::Rate{static_cast<std::uint64_t>(bytes_sent)});
+    }
+
     if (self->is_created_) {
         tracing::Span* span = tracing::Span::CurrentSpanUnchecked();
         if (span) {
@@ -547,6 +552,9 @@ ssize_t AsyncStream::Readv(
     } catch (const engine::io::IoException& io_ex) {
         error = EINVAL;
     }
+    if (self->traffic_stats_ && recvd_total) {
+        self->traffic_stats_->wire_bytes_received.Add(utils::statistics::Rate{recvd_total});
+    }
     // return value logic from _mongoc_stream_socket_readv
     if (recvd_total < min_bytes) {
         // libmongoc expects restored errno
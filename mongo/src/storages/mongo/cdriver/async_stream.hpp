@@ -4,6 +4,8 @@
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 
+#include <storages/mongo/stats.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::mongo::impl::cdriver {
@@ -13,6 +15,9 @@ struct AsyncStreamInitiatorData {
     clients::dns::Resolver* dns_resolver;
 
     mongoc_ssl_opt_t ssl_opt;
+
+    // Accounts bytes sent and received by the streams
+    stats::TrafficStatistics* traffic_stats;
 };
 
 mongoc_stream_t* MakeAsyncStream(const mongoc_uri_t*, const mongoc_host_list_t*, void*, bson_error_t*) noexcept;
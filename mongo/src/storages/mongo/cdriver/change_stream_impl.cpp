@@ -0,0 +1,75 @@
+#include <storages/mongo/cdriver/change_stream_impl.hpp>
+
+#include <stdexcept>
+
+#include <bson/bson.h>
+#include <mongoc/mongoc.h>
+
+#include <userver/storages/mongo/mongo_error.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <formats/bson/wrappers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl::cdriver {
+namespace {
+
+formats::bson::Document CopyDocument(const bson_t* native) {
+    return formats::bson::Document(formats::bson::impl::MutableBson::CopyNative(native).Extract());
+}
+
+}  // namespace
+
+CDriverChangeStreamImpl::CDriverChangeStreamImpl(
+    cdriver::CDriverPoolImpl::BoundClientPtr client,
+    cdriver::ChangeStreamPtr stream,
+    std::shared_ptr<stats::OperationStatisticsItem> watch_stats
+)
+    : client_(std::move(client)), stream_(std::move(stream)), watch_stats_(std::move(watch_stats)) {
+    UASSERT(client_ && stream_);
+}
+
+std::optional<formats::bson::Document> CDriverChangeStreamImpl::Next() {
+    if (!stream_) throw std::logic_error("Reading from invalidated change stream");
+
+    const auto before_stats = client_.GetEventStatsSnapshot();
+    stats::OperationStopwatch next_sw(watch_stats_, "watch");
+
+    const bson_t* current_bson = nullptr;
+    MongoError error;
+    std::optional<formats::bson::Document> result;
+    if (mongoc_change_stream_next(stream_.get(), &current_bson)) {
+        result = CopyDocument(current_bson);
+    } else {
+        mongoc_change_stream_error_document(stream_.get(), error.GetNative(), nullptr);
+    }
+
+    if (before_stats == client_.GetEventStatsSnapshot()) {
+        // served from the already fetched batch
+        next_sw.Discard();
+    } else if (!error) {
+        next_sw.AccountSuccess();
+    } else {
+        next_sw.AccountError(error.GetKind());
+    }
+
+    if (error) {
+        stream_.reset();
+        client_.reset();
+        error.Throw("Error reading change stream");
+    }
+    return result;
+}
+
+std::optional<formats::bson::Document> CDriverChangeStreamImpl::GetResumeToken() const {
+    if (!stream_) throw std::logic_error("Reading from invalidated change stream");
+
+    const bson_t* token = mongoc_change_stream_get_resume_token(stream_.get());
+    if (!token) return std::nullopt;
+    return CopyDocument(token);
+}
+
+}  // namespace storages::mongo::impl::cdriver
+
+USERVER_NAMESPACE_END
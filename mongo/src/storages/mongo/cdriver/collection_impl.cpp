@@ -15,6 +15,7 @@
 #include <userver/utils/text.hpp>
 
 #include <formats/bson/wrappers.hpp>
+#include <storages/mongo/cdriver/change_stream_impl.hpp>
 #include <storages/mongo/cdriver/cursor_impl.hpp>
 #include <storages/mongo/cdriver/pool_impl.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
@@ -562,6 +563,34 @@ void CDriverCollectionImpl::Execute(const operations::Drop& operation) {
     }
 }
 
+ChangeStream CDriverCollectionImpl::Execute(const operations::Watch& operation) const {
+    auto context = MakeRequestContext("mongo_watch", operation);
+
+    auto options = operation.impl_->options;
+    bool has_comment_option = operation.impl_->has_comment_option;
+    if (!has_comment_option) SetLinkComment(impl::EnsureBuilder(options), has_comment_option);
+
+    if (operation.impl_->read_prefs.Get()) {
+        mongoc_collection_set_read_prefs(context.collection.get(), operation.impl_->read_prefs.Get());
+    }
+
+    auto pipeline_doc = operation.impl_->pipeline.GetInternalArrayDocument();
+    MongoError error;
+    stats::OperationStopwatch stopwatch(context.stats);
+    impl::cdriver::ChangeStreamPtr stream(
+        mongoc_collection_watch(context.collection.get(), pipeline_doc.GetBson().get(), impl::GetNative(options))
+    );
+    if (mongoc_change_stream_error_document(stream.get(), error.GetNative(), nullptr)) {
+        stopwatch.AccountError(error.GetKind());
+        error.Throw("Error opening change stream");
+    }
+    stopwatch.AccountSuccess();
+
+    return ChangeStream(std::make_unique<impl::cdriver::CDriverChangeStreamImpl>(
+        std::move(context.client), std::move(stream), std::move(context.stats)
+    ));
+}
+
 cdriver::CDriverPoolImpl::BoundClientPtr CDriverCollectionImpl::GetClient(stats::OperationStatisticsItem& stats) const {
     try {
         // uasserted in ctor
@@ -40,6 +40,7 @@ public:
     WriteResult Execute(operations::Bulk&&) override;
     Cursor Execute(const operations::Aggregate&) override;
     void Execute(const operations::Drop&) override;
+    ChangeStream Execute(const operations::Watch&) const override;
 
 private:
     cdriver::CDriverPoolImpl::BoundClientPtr GetClient(stats::OperationStatisticsItem& stats) const;
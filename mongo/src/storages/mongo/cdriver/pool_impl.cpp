@@ -66,6 +66,18 @@ bool HasOption(const UriPtr& uri, const char* opt) {
     return bson_iter_init_find_case(&it, options, opt);
 }
 
+const char* ToCDriverCompressorName(Compressor compressor) {
+    switch (compressor) {
+        case Compressor::kSnappy:
+            return "snappy";
+        case Compressor::kZlib:
+            return "zlib";
+        case Compressor::kZstd:
+            return "zstd";
+    }
+    UINVARIANT(false, "Unexpected compressor");
+}
+
 UriPtr MakeUri(const std::string& pool_id, const std::string& uri_string, const PoolConfig& config) {
     MongoError parse_error;
     UriPtr uri(mongoc_uri_new_with_error(uri_string.c_str(), parse_error.GetNative()));
@@ -101,6 +113,20 @@ UriPtr MakeUri(const std::string& pool_id, const std::string& uri_string, const
         );
     }
 
+    if (!config.compressors.empty()) {
+        std::string compressors;
+        for (const auto compressor : config.compressors) {
+            if (!compressors.empty()) compressors += ',';
+            compressors += ToCDriverCompressorName(compressor);
+        }
+        if (!mongoc_uri_set_compressors(uri.get(), compressors.c_str())) {
+            throw InvalidConfigException("Bad compressors for pool '") << pool_id << "': " << compressors;
+        }
+    }
+    if (config.zlib_compression_level) {
+        mongoc_uri_set_option_as_int32(uri.get(), MONGOC_URI_ZLIBCOMPRESSIONLEVEL, *config.zlib_compression_level);
+    }
+
     // Don't retry operation with single threaded mongo topology
     // It does usleep() in mongoc_topology_select_server_id()
     if (!HasOption(uri, MONGOC_URI_RETRYREADS)) {
@@ -159,9 +185,17 @@ stats::ConnStats& GetStats(void* stats_ptr) {
     return *reinterpret_cast<stats::ConnStats*>(stats_ptr);
 }
 
+void CommandStarted(const mongoc_apm_command_started_t* event) {
+    auto& stats = GetStats(mongoc_apm_command_started_get_context(event));
+    const bson_t* command = mongoc_apm_command_started_get_command(event);
+    stats.apm_stats_->traffic.logical_bytes_sent.Add(utils::statistics::Rate{command->len});
+}
+
 void CommandSucceeded(const mongoc_apm_command_succeeded_t* event) {
     auto& stats = GetStats(mongoc_apm_command_succeeded_get_context(event));
     stats.event_stats_.success += utils::statistics::Rate{1};
+    const bson_t* reply = mongoc_apm_command_succeeded_get_reply(event);
+    stats.apm_stats_->traffic.logical_bytes_received.Add(utils::statistics::Rate{reply->len});
 }
 
 void CommandFailed(const mongoc_apm_command_failed_t* event) {
@@ -296,7 +330,7 @@ CDriverPoolImpl::CDriverPoolImpl(
 )
     : PoolImpl(std::move(id), config, config_source),
       app_name_(config.app_name),
-      init_data_{dns_resolver, {}},
+      init_data_{dns_resolver, {}, &apm_stats_.traffic},
       max_size_(config.pool_settings.max_size),
       idle_limit_(config.pool_settings.idle_limit),
       queue_timeout_(config.queue_timeout),
@@ -491,6 +525,7 @@ CDriverPoolImpl::ConnPtr CDriverPoolImpl::Create() {
     // Set command monitoring events to get command durations.
     {
         mongoc_apm_callbacks_t* cbs = mongoc_apm_callbacks_new();
+        mongoc_apm_set_command_started_cb(cbs, CommandStarted);
         mongoc_apm_set_command_succeeded_cb(cbs, CommandSucceeded);
         mongoc_apm_set_command_failed_cb(cbs, CommandFailed);
         mongoc_apm_set_server_heartbeat_started_cb(cbs, HeartbeatStarted);
@@ -23,6 +23,11 @@ struct BulkOperationDeleter {
 };
 using BulkOperationPtr = std::unique_ptr<mongoc_bulk_operation_t, BulkOperationDeleter>;
 
+struct ChangeStreamDeleter {
+    void operator()(mongoc_change_stream_t* stream) const noexcept { mongoc_change_stream_destroy(stream); }
+};
+using ChangeStreamPtr = std::unique_ptr<mongoc_change_stream_t, ChangeStreamDeleter>;
+
 struct CollectionDeleter {
     void operator()(mongoc_collection_t* collection) const noexcept { mongoc_collection_destroy(collection); }
 };
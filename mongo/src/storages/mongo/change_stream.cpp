@@ -0,0 +1,29 @@
+#include <userver/storages/mongo/change_stream.hpp>
+
+#include <stdexcept>
+
+#include <storages/mongo/change_stream_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+
+ChangeStream::ChangeStream(std::unique_ptr<impl::ChangeStreamImpl>&& impl) : impl_(std::move(impl)) {}
+
+ChangeStream::~ChangeStream() = default;
+ChangeStream::ChangeStream(ChangeStream&&) noexcept = default;
+ChangeStream& ChangeStream::operator=(ChangeStream&&) noexcept = default;
+
+std::optional<formats::bson::Document> ChangeStream::Next() {
+    if (!impl_) throw std::logic_error("Reading from moved-out change stream");
+    return impl_->Next();
+}
+
+std::optional<formats::bson::Document> ChangeStream::GetResumeToken() const {
+    if (!impl_) throw std::logic_error("Reading from moved-out change stream");
+    return impl_->GetResumeToken();
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
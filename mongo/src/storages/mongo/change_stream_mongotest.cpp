@@ -0,0 +1,116 @@
+#include <userver/utest/utest.hpp>
+
+#include <optional>
+
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/inline.hpp>
+#include <userver/storages/mongo/change_stream.hpp>
+#include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/exception.hpp>
+
+#include <storages/mongo/util_mongotest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace bson = formats::bson;
+namespace mongo = storages::mongo;
+
+namespace {
+
+class ChangeStream : public MongoPoolFixture {};
+
+// "$changeStream stage is only supported on replica sets"
+constexpr int kChangeStreamNotSupported = 40573;
+
+const mongo::options::MaxAwaitTime kMaxAwaitTime{std::chrono::milliseconds{100}};
+
+template <typename... Options>
+std::optional<mongo::ChangeStream> TryWatch(const mongo::Collection& coll, Options&&... options) {
+    try {
+        return coll.Watch(bson::MakeArray(), kMaxAwaitTime, std::forward<Options>(options)...);
+    } catch (const mongo::ServerException& ex) {
+        if (ex.Code() == kChangeStreamNotSupported) return std::nullopt;
+        throw;
+    }
+}
+
+bson::Document NextEvent(mongo::ChangeStream& stream) {
+    for (int i = 0; i < 50; ++i) {
+        auto event = stream.Next();
+        if (event) return std::move(*event);
+    }
+    ADD_FAILURE() << "No change event arrived";
+    return {};
+}
+
+}  // namespace
+
+UTEST_F(ChangeStream, Events) {
+    auto coll = GetDefaultPool().GetCollection("change_stream_events");
+    auto stream = TryWatch(coll, mongo::options::FullDocument::kUpdateLookup);
+    if (!stream) GTEST_SKIP() << "Change streams are not supported by the server";
+
+    EXPECT_EQ(stream->Next(), std::nullopt);
+
+    coll.InsertOne(bson::MakeDoc("_id", 1, "x", 1));
+    coll.UpdateOne(bson::MakeDoc("_id", 1), bson::MakeDoc("$set", bson::MakeDoc("x", 2)));
+    coll.DeleteOne(bson::MakeDoc("_id", 1));
+
+    auto event = NextEvent(*stream);
+    EXPECT_EQ(event["operationType"].As<std::string>(), "insert");
+    EXPECT_EQ(event["fullDocument"]["x"].As<int>(), 1);
+
+    event = NextEvent(*stream);
+    EXPECT_EQ(event["operationType"].As<std::string>(), "update");
+    EXPECT_EQ(event["documentKey"]["_id"].As<int>(), 1);
+    EXPECT_TRUE(event["fullDocument"].IsDocument() || event["fullDocument"].IsNull());
+
+    event = NextEvent(*stream);
+    EXPECT_EQ(event["operationType"].As<std::string>(), "delete");
+    EXPECT_EQ(event["documentKey"]["_id"].As<int>(), 1);
+}
+
+UTEST_F(ChangeStream, Pipeline) {
+    auto coll = GetDefaultPool().GetCollection("change_stream_pipeline");
+
+    std::optional<mongo::ChangeStream> stream;
+    try {
+        stream = coll.Watch(
+            bson::MakeArray(bson::MakeDoc("$match", bson::MakeDoc("operationType", "delete"))), kMaxAwaitTime
+        );
+    } catch (const mongo::ServerException& ex) {
+        if (ex.Code() != kChangeStreamNotSupported) throw;
+        GTEST_SKIP() << "Change streams are not supported by the server";
+    }
+
+    coll.InsertOne(bson::MakeDoc("_id", 1));
+    coll.DeleteOne(bson::MakeDoc("_id", 1));
+
+    const auto event = NextEvent(*stream);
+    EXPECT_EQ(event["operationType"].As<std::string>(), "delete");
+
+    UEXPECT_THROW(coll.Watch(bson::MakeDoc("$match", bson::MakeDoc())), mongo::InvalidQueryArgumentException);
+}
+
+UTEST_F(ChangeStream, Resume) {
+    auto coll = GetDefaultPool().GetCollection("change_stream_resume");
+
+    std::optional<bson::Document> resume_token;
+    {
+        auto stream = TryWatch(coll);
+        if (!stream) GTEST_SKIP() << "Change streams are not supported by the server";
+
+        coll.InsertOne(bson::MakeDoc("_id", 1));
+        EXPECT_EQ(NextEvent(*stream)["documentKey"]["_id"].As<int>(), 1);
+        resume_token = stream->GetResumeToken();
+        ASSERT_TRUE(resume_token);
+    }
+
+    coll.InsertOne(bson::MakeDoc("_id", 2));
+
+    auto stream = TryWatch(coll, mongo::options::ResumeAfter{*resume_token});
+    ASSERT_TRUE(stream);
+    EXPECT_EQ(NextEvent(*stream)["documentKey"]["_id"].As<int>(), 2);
+}
+
+USERVER_NAMESPACE_END
@@ -37,6 +37,8 @@ Cursor Collection::Execute(const operations::Aggregate& aggregate_op) { return i
 
 void Collection::Execute(const operations::Drop& drop_op) { return impl_->Execute(drop_op); }
 
+ChangeStream Collection::Execute(const operations::Watch& watch_op) const { return impl_->Execute(watch_op); }
+
 }  // namespace storages::mongo
 
 USERVER_NAMESPACE_END
@@ -180,6 +180,23 @@ properties:
         enum:
           - getaddrinfo
           - async
+    compressors:
+        type: array
+        description: wire protocol compressors in the order of preference
+        defaultDescription: no compression
+        items:
+            type: string
+            description: compressor name
+            enum:
+              - zstd
+              - snappy
+              - zlib
+    zlib_compression_level:
+        type: integer
+        description: zlib compression level from -1 (zlib default) to 9
+        defaultDescription: -1
+        minimum: -1
+        maximum: 9
     congestion_control:
         description: congestion control settings
         type: object
@@ -193,6 +210,59 @@ properties:
                 type: boolean
                 description: whether CC is enabled for the database
                 defaultDescription: true
+            controller:
+                type: string
+                description: congestion control algorithm
+                defaultDescription: linear
+                enum:
+                  - linear
+                  - gradient
+                  - vegas
+            gradient:
+                type: object
+                description: settings of the `gradient` controller
+                additionalProperties: false
+                properties:
+                    smoothing:
+                        type: number
+                        description: weight of the new limit estimation, from 0 to 1
+                        defaultDescription: 0.2
+                        minimum: 0
+                        maximum: 1
+                    rtt-tolerance:
+                        type: number
+                        description: how many times the current timings may exceed the long-term ones
+                        defaultDescription: 1.5
+                        minimum: 1
+                    long-window:
+                        type: integer
+                        description: size of the long-term timings window in seconds
+                        defaultDescription: 600
+                        minimum: 1
+            vegas:
+                type: object
+                description: settings of the `vegas` controller
+                additionalProperties: false
+                properties:
+                    smoothing:
+                        type: number
+                        description: weight of the new limit estimation, from 0 to 1
+                        defaultDescription: 1
+                        minimum: 0
+                        maximum: 1
+                    alpha:
+                        type: number
+                        description: the limit grows while fewer than alpha * log10(limit) requests are queued
+                        defaultDescription: 3
+                    beta:
+                        type: number
+                        description: the limit falls while more than beta * log10(limit) requests are queued
+                        defaultDescription: 6
+                    probe-interval:
+                        type: integer
+                        description: reset the minimal timings every that many seconds while no limit is applied
+                        defaultDescription: 30
+                        minimum: 1
 )");
 }
 
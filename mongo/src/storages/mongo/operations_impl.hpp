@@ -158,6 +158,17 @@ public:
     std::chrono::milliseconds max_server_time{kNoMaxServerTime};
 };
 
+class Watch::Impl {
+public:
+    explicit Impl(formats::bson::Value pipeline_) : pipeline(std::move(pipeline_)) {}
+
+    formats::bson::Value pipeline;
+    impl::cdriver::ReadPrefsPtr read_prefs;
+    stats::OperationKey op_key{stats::OpType::kWatch};
+    std::optional<formats::bson::impl::BsonBuilder> options;
+    bool has_comment_option{false};
+};
+
 class Drop::Impl {
 public:
     Impl() = default;
@@ -76,6 +76,13 @@ void DumpMetric(utils::statistics::Writer& writer, const Pool& pool) {
         apm_metrics["heartbeats-success"] = apm.heartbeats.success;
         apm_metrics["heartbeats-failed"] = apm.heartbeats.failed;
     }
+    if (auto traffic_metrics = writer["pool"]["traffic"]) {
+        const auto& traffic = pool.impl_->GetApmStats().traffic;
+        traffic_metrics["logical-bytes-sent"] = traffic.logical_bytes_sent;
+        traffic_metrics["logical-bytes-received"] = traffic.logical_bytes_received;
+        traffic_metrics["wire-bytes-sent"] = traffic.wire_bytes_sent;
+        traffic_metrics["wire-bytes-received"] = traffic.wire_bytes_received;
+    }
 }
 
 void Pool::SetPoolSettings(const PoolSettings& pool_settings) { impl_->SetPoolSettings(pool_settings); }
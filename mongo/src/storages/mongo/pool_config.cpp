@@ -41,6 +41,13 @@ constexpr utils::TrivialBiMap kStatsVerbosityMapping([](auto selector) {
         .Case(StatsVerbosity::kNone, "none");
 });
 
+constexpr utils::TrivialBiMap kCompressorMapping([](auto selector) {
+    return selector()
+        .Case(Compressor::kSnappy, "snappy")
+        .Case(Compressor::kZlib, "zlib")
+        .Case(Compressor::kZstd, "zstd");
+});
+
 template <typename ConfigType>
 PoolSettings ParsePoolSettings(const ConfigType& config) {
     PoolSettings result{};
@@ -75,6 +82,10 @@ static auto Parse(const yaml_config::YamlConfig& config, formats::parse::To<Stat
     return utils::ParseFromValueString<InvalidConfigException>(config, kStatsVerbosityMapping);
 }
 
+static auto Parse(const yaml_config::YamlConfig& config, formats::parse::To<Compressor>) {
+    return utils::ParseFromValueString<InvalidConfigException>(config, kCompressorMapping);
+}
+
 PoolConfig Parse(const yaml_config::YamlConfig& config, formats::parse::To<PoolConfig>) {
     PoolConfig result{};
     result.conn_timeout = config["conn_timeout"].As<std::chrono::milliseconds>(result.conn_timeout);
@@ -86,7 +97,9 @@ PoolConfig Parse(const yaml_config::YamlConfig& config, formats::parse::To<PoolC
     result.max_replication_lag = config["max_replication_lag"].As<std::optional<std::chrono::seconds>>();
     result.driver_impl = config["driver"].As<PoolConfig::DriverImpl>(result.driver_impl);
     result.stats_verbosity = config["stats_verbosity"].As<StatsVerbosity>(result.stats_verbosity);
-    result.cc_config = config["congestion_control"].As<congestion_control::v2::LinearController::StaticConfig>();
+    result.cc_config = config["congestion_control"].As<congestion_control::v2::ControllerStaticConfig>();
+    result.compressors = config["compressors"].As<std::vector<Compressor>>({});
+    result.zlib_compression_level = config["zlib_compression_level"].As<std::optional<int>>();
     result.pool_settings = config.As<PoolSettings>();
 
     return result;
@@ -124,6 +137,11 @@ void PoolConfig::Validate(const std::string& pool_id) const {
     if (!IsValidAppName(app_name)) {
         throw InvalidConfigException("Invalid appname in ") << pool_id << " pool config";
     }
+
+    if (zlib_compression_level && (*zlib_compression_level < -1 || *zlib_compression_level > 9)) {
+        throw InvalidConfigException("Invalid zlib compression level in ")
+            << pool_id << " pool config: " << *zlib_compression_level;
+    }
 }
 
 }  // namespace storages::mongo
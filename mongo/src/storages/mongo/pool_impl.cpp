@@ -2,6 +2,7 @@
 
 #include <storages/mongo/cc_config.hpp>
 #include <storages/mongo/dynamic_config.hpp>
+#include <userver/congestion_control/controllers/factory.hpp>
 #include <userver/dynamic_config/value.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,7 +15,7 @@ PoolImpl::PoolImpl(std::string&& id, const PoolConfig& static_config, dynamic_co
       config_source_(config_source),
       cc_sensor_(*this),
       cc_limiter_(*this),
-      cc_controller_(
+      cc_controller_(congestion_control::v2::MakeController(
           id_,
           cc_sensor_,
           cc_limiter_,
@@ -22,18 +23,18 @@ PoolImpl::PoolImpl(std::string&& id, const PoolConfig& static_config, dynamic_co
           static_config.cc_config,
           config_source,
           [](const dynamic_config::Snapshot& config) { return config[kCcConfig]; }
-      ) {
+      )) {
     config_subscriber_ = config_source_.UpdateAndListen(this, "mongo_pool", &PoolImpl::OnConfigUpdate);
 }
 
-void PoolImpl::Start() { cc_controller_.Start(); }
+void PoolImpl::Start() { cc_controller_->Start(); }
 
-void PoolImpl::Stop() { cc_controller_.Stop(); }
+void PoolImpl::Stop() { cc_controller_->Stop(); }
 
 void PoolImpl::OnConfigUpdate(const dynamic_config::Snapshot& config) {
     bool cc_enabled =
         config[kCongestionControlDatabasesSettings].GetOptional(id_).value_or(config[kCongestionControlEnabled]);
-    cc_controller_.SetEnabled(cc_enabled);
+    cc_controller_->SetEnabled(cc_enabled);
 
     const auto new_pool_settings = config[kPoolSettings].GetOptional(id_);
     if (new_pool_settings.has_value()) {
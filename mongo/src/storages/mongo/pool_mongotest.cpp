@@ -16,6 +16,8 @@
 #include <userver/storages/mongo/exception.hpp>
 #include <userver/storages/mongo/pool.hpp>
 #include <userver/storages/mongo/pool_config.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -128,4 +130,34 @@ UTEST_F(Pool, ListCollectionNames) {
     }
 }
 
+UTEST_F(Pool, Compression) {
+    auto config = MakeTestPoolConfig();
+    config.compressors = {mongo::Compressor::kZstd, mongo::Compressor::kSnappy, mongo::Compressor::kZlib};
+    config.zlib_compression_level = 6;
+    auto pool = MakePool({}, config);
+
+    utils::statistics::Storage storage;
+    auto statistics_holder =
+        storage.RegisterWriter("mongo", [&pool](utils::statistics::Writer& writer) { writer = pool; });
+
+    const std::string large_value(64 * 1024, 'a');
+    auto coll = pool.GetCollection("compression");
+    UEXPECT_NO_THROW(coll.InsertOne(formats::bson::MakeDoc("_id", 1, "value", large_value)));
+    const auto doc = coll.FindOne(formats::bson::MakeDoc("_id", 1));
+    ASSERT_TRUE(doc);
+    EXPECT_EQ((*doc)["value"].As<std::string>(), large_value);
+
+    const utils::statistics::Snapshot snapshot{storage, "mongo.pool.traffic"};
+    EXPECT_GE(snapshot.SingleMetric("logical-bytes-sent").AsRate().value, large_value.size());
+    EXPECT_GE(snapshot.SingleMetric("logical-bytes-received").AsRate().value, large_value.size());
+    EXPECT_GT(snapshot.SingleMetric("wire-bytes-sent").AsRate().value, 0);
+    EXPECT_GT(snapshot.SingleMetric("wire-bytes-received").AsRate().value, 0);
+}
+
+UTEST_F(Pool, BadZlibCompressionLevel) {
+    auto config = MakeTestPoolConfig();
+    config.zlib_compression_level = 10;
+    UEXPECT_THROW(config.Validate("bad_zlib_level"), mongo::InvalidConfigException);
+}
+
 USERVER_NAMESPACE_END
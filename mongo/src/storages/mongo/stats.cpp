@@ -140,6 +140,8 @@ std::string_view ToString(OpType type) {
             return "aggregate";
         case Type::kDrop:
             return "drop";
+        case Type::kWatch:
+            return "watch";
     }
 
     UINVARIANT(false, "Unexpected type");
@@ -73,6 +73,7 @@ enum class OpType {
     kCountApprox,
     kFind,
     kAggregate,
+    kWatch,
 
     kWriteMin,
     kInsertOne = kWriteMin,
@@ -127,11 +128,21 @@ struct HeartbeatsStatistics final {
     std::chrono::steady_clock::time_point hb_started{};
 };
 
+// Sizes of commands and replies vs. bytes that went through the sockets,
+// after the wire protocol compression and TLS
+struct TrafficStatistics final {
+    Counter logical_bytes_sent;
+    Counter logical_bytes_received;
+    Counter wire_bytes_sent;
+    Counter wire_bytes_received;
+};
+
 // See
 // https://mongoc.org/libmongoc/current/application-performance-monitoring.html
 struct ApmStats final {
     TopologyStatistics topology;
     HeartbeatsStatistics heartbeats;
+    TrafficStatistics traffic;
 };
 
 struct EventStats final {
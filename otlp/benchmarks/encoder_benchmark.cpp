@@ -0,0 +1,237 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <otlp/logs/encoder.hpp>
+
+#include <opentelemetry/proto/collector/logs/v1/logs_service.pb.h>
+#include <opentelemetry/proto/collector/trace/v1/trace_service.pb.h>
+
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/encoding/hex.hpp>
+#include <userver/utils/encoding/tskv_parser_read.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kLogRecord =
+    "tskv\ttimestamp=2024-01-02T03:04:05.123456\tlevel=INFO\tmodule=Handle ( handler.cpp:42 ) \t"
+    "trace_id=0123456789abcdef0123456789abcdef\tspan_id=0011223344556677\tlink=a1b2c3d4e5f6\t"
+    "http_method=POST\thttp_path=/v1/orders\ttext=Request processed successfully";
+
+constexpr std::string_view kSpanRecord =
+    "tskv\ttimestamp=2024-01-02T03:04:05.123456\ttrace_id=0123456789abcdef0123456789abcdef\t"
+    "span_id=0011223344556677\tparent_id=8899aabbccddeeff\tstopwatch_name=http/handler-orders\t"
+    "total_time=1.5\tspan_ref_type=child\tstopwatch_units=ms\tstart_timestamp=1700000000.000123\t"
+    "meta_code=200\ttext=";
+
+const std::string kTimestampFormat = "%Y-%m-%dT%H:%M:%E*S";
+
+const otlp::impl::Attributes kResourceAttributes{
+    {"telemetry.sdk.language", "cpp"},
+    {"telemetry.sdk.name", "userver"},
+    {"service.name", "benchmark"},
+};
+
+// The way the exporter used to build the protobuf objects
+opentelemetry::proto::logs::v1::LogRecord MakeLogRecordMessage(std::string_view msg) {
+    opentelemetry::proto::logs::v1::LogRecord log_record;
+    std::chrono::system_clock::time_point timestamp;
+
+    utils::encoding::TskvParser parser{msg};
+    utils::encoding::TskvReadRecord(parser, [&](std::string_view key, std::string_view value) {
+        if (key == "text") {
+            log_record.mutable_body()->set_string_value(std::string{value});
+        } else if (key == "trace_id") {
+            log_record.set_trace_id(utils::encoding::FromHex(value));
+        } else if (key == "span_id") {
+            log_record.set_span_id(utils::encoding::FromHex(value));
+        } else if (key == "timestamp") {
+            timestamp = utils::datetime::LocalTimezoneStringtime(std::string{value}, kTimestampFormat);
+        } else if (key == "level") {
+            log_record.set_severity_text(std::string{value});
+        } else {
+            auto* attributes = log_record.add_attributes();
+            attributes->set_key(std::string{key});
+            attributes->mutable_value()->set_string_value(std::string{value});
+        }
+        return true;
+    });
+
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch());
+    log_record.set_time_unix_nano(nanoseconds.count());
+    return log_record;
+}
+
+opentelemetry::proto::trace::v1::Span MakeSpanMessage(std::string_view msg) {
+    opentelemetry::proto::trace::v1::Span span;
+    std::string start_timestamp;
+    std::string total_time;
+
+    utils::encoding::TskvParser parser{msg};
+    utils::encoding::TskvReadRecord(parser, [&](std::string_view key, std::string_view value) {
+        if (key == "trace_id") {
+            span.set_trace_id(utils::encoding::FromHex(value));
+        } else if (key == "span_id") {
+            span.set_span_id(utils::encoding::FromHex(value));
+        } else if (key == "parent_id") {
+            span.set_parent_span_id(utils::encoding::FromHex(value));
+        } else if (key == "stopwatch_name") {
+            span.set_name(std::string{value});
+        } else if (key == "total_time") {
+            total_time = value;
+        } else if (key == "start_timestamp") {
+            start_timestamp = value;
+        } else if (key != "timestamp" && key != "text") {
+            auto* attributes = span.add_attributes();
+            attributes->set_key(std::string{key});
+            attributes->mutable_value()->set_string_value(std::string{value});
+        }
+        return true;
+    });
+
+    const auto start_timestamp_double = std::stod(start_timestamp);
+    span.set_start_time_unix_nano(start_timestamp_double * 1'000'000'000);
+    span.set_end_time_unix_nano((start_timestamp_double + std::stod(total_time) / 1'000) * 1'000'000'000LL);
+    return span;
+}
+
+void FillResource(opentelemetry::proto::resource::v1::Resource& resource) {
+    for (const auto& [key, value] : kResourceAttributes) {
+        auto* attr = resource.add_attributes();
+        attr->set_key(key);
+        attr->mutable_value()->set_string_value(value);
+    }
+}
+
+}  // namespace
+
+// Records are converted to protobuf objects, copied into the request and then
+// serialized by gRPC.
+void OtlpLogsProtobufObjects(benchmark::State& state) {
+    const auto batch_size = state.range(0);
+
+    opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest request;
+    auto* resource_logs = request.add_resource_logs();
+    auto* scope_logs = resource_logs->add_scope_logs();
+    FillResource(*resource_logs->mutable_resource());
+
+    std::vector<opentelemetry::proto::logs::v1::LogRecord> queue;
+    std::string serialized;
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::int64_t i = 0; i < batch_size; ++i) {
+            queue.push_back(MakeLogRecordMessage(kLogRecord));
+        }
+
+        scope_logs->clear_log_records();
+        for (const auto& record : queue) {
+            *scope_logs->add_log_records() = record;
+        }
+        queue.clear();
+
+        request.SerializeToString(&serialized);
+        benchmark::DoNotOptimize(serialized);
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(OtlpLogsProtobufObjects)->RangeMultiplier(8)->Range(1, 512);
+
+// Records are encoded into the wire format right away and then concatenated
+// into the request.
+void OtlpLogsWireEncoder(benchmark::State& state) {
+    const auto batch_size = state.range(0);
+
+    otlp::impl::RequestBuilder builder{otlp::impl::EncodeResource(kResourceAttributes)};
+    const otlp::impl::AttributesMapping mapping;
+
+    std::vector<std::string> queue;
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::int64_t i = 0; i < batch_size; ++i) {
+            queue.push_back(otlp::impl::EncodeLogRecord(kLogRecord, mapping));
+        }
+
+        for (const auto& record : queue) {
+            builder.Add(record);
+        }
+        queue.clear();
+
+        auto request = builder.Extract();
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(OtlpLogsWireEncoder)->RangeMultiplier(8)->Range(1, 512);
+
+void OtlpSpansProtobufObjects(benchmark::State& state) {
+    const auto batch_size = state.range(0);
+
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest request;
+    auto* resource_spans = request.add_resource_spans();
+    auto* scope_spans = resource_spans->add_scope_spans();
+    FillResource(*resource_spans->mutable_resource());
+
+    std::vector<opentelemetry::proto::trace::v1::Span> queue;
+    std::string serialized;
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::int64_t i = 0; i < batch_size; ++i) {
+            queue.push_back(MakeSpanMessage(kSpanRecord));
+        }
+
+        scope_spans->clear_spans();
+        for (const auto& span : queue) {
+            *scope_spans->add_spans() = span;
+        }
+        queue.clear();
+
+        request.SerializeToString(&serialized);
+        benchmark::DoNotOptimize(serialized);
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(OtlpSpansProtobufObjects)->RangeMultiplier(8)->Range(1, 512);
+
+void OtlpSpansWireEncoder(benchmark::State& state) {
+    const auto batch_size = state.range(0);
+
+    otlp::impl::RequestBuilder builder{otlp::impl::EncodeResource(kResourceAttributes)};
+    const otlp::impl::AttributesMapping mapping;
+
+    std::vector<std::string> queue;
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::int64_t i = 0; i < batch_size; ++i) {
+            queue.push_back(otlp::impl::EncodeSpan(kSpanRecord, mapping));
+        }
+
+        for (const auto& span : queue) {
+            builder.Add(span);
+        }
+        queue.clear();
+
+        auto request = builder.Extract();
+        benchmark::DoNotOptimize(request);
+    }
+    state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(OtlpSpansWireEncoder)->RangeMultiplier(8)->Range(1, 512);
+
+// What the collector has to do with the request in both cases
+void OtlpSpansCollectorParse(benchmark::State& state) {
+    otlp::impl::RequestBuilder builder{otlp::impl::EncodeResource(kResourceAttributes)};
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        builder.Add(otlp::impl::EncodeSpan(kSpanRecord, {}));
+    }
+    const auto request = builder.Extract();
+    const auto view = request.GetView();
+
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest parsed;
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(parsed.ParseFromArray(view.data(), static_cast<int>(view.size())));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(OtlpSpansCollectorParse)->Arg(512);
+
+USERVER_NAMESPACE_END
@@ -13,12 +13,11 @@
 #include <userver/logging/null_logger.hpp>
 
 #include <userver/ugrpc/client/client_factory_component.hpp>
+#include <userver/ugrpc/client/generic.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 #include "logger.hpp"
 
-#include <opentelemetry/proto/collector/logs/v1/logs_service_client.usrv.pb.hpp>
-
 USERVER_NAMESPACE_BEGIN
 
 namespace otlp {
@@ -28,17 +27,14 @@ LoggerComponent::LoggerComponent(const components::ComponentConfig& config, cons
     auto& client_factory = context.FindComponent<ugrpc::client::ClientFactoryComponent>().GetFactory();
 
     auto endpoint = config["endpoint"].As<std::string>();
-    auto client = client_factory.MakeClient<opentelemetry::proto::collector::logs::v1::LogsServiceClient>(
-        "otlp-logger", endpoint
-    );
-
-    auto trace_client = client_factory.MakeClient<opentelemetry::proto::collector::trace::v1::TraceServiceClient>(
-        "otlp-tracer", endpoint
-    );
+    auto client = client_factory.MakeClient<ugrpc::client::GenericClient>("otlp-logger", endpoint);
+    auto trace_client = client_factory.MakeClient<ugrpc::client::GenericClient>("otlp-tracer", endpoint);
 
     LoggerConfig logger_config;
     logger_config.max_queue_size = config["max-queue-size"].As<size_t>(65535);
     logger_config.max_batch_delay = config["max-batch-delay"].As<std::chrono::milliseconds>(100);
+    logger_config.max_batch_size_bytes =
+        config["max-batch-size-bytes"].As<size_t>(logger_config.max_batch_size_bytes);
     logger_config.service_name = config["service-name"].As<std::string>("unknown_service");
     logger_config.log_level = config["log-level"].As<USERVER_NAMESPACE::logging::Level>();
     logger_config.extra_attributes = config["extra-attributes"].As<std::unordered_map<std::string, std::string>>({});
@@ -119,6 +115,10 @@ properties:
     max-batch-delay:
         type: string
         description: max delay between send batches (e.g. 100ms or 1s)
+    max-batch-size-bytes:
+        type: integer
+        description: a batch is sent without waiting for max-batch-delay once it reaches this size
+        defaultDescription: 1048576
     service-name:
         type: string
         description: service name
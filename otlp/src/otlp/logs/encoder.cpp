@@ -0,0 +1,284 @@
+#include "encoder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/encoding/tskv_parser_read.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+namespace {
+
+const std::string kTimestampFormat = "%Y-%m-%dT%H:%M:%E*S";
+
+enum class WireType : std::uint32_t {
+    kVarint = 0,
+    kFixed64 = 1,
+    kLengthDelimited = 2,
+};
+
+constexpr std::size_t kMaxVarintSize = 10;
+
+// ExportLogsServiceRequest / ExportTraceServiceRequest
+constexpr std::uint32_t kRequestResource = 1;
+// ResourceLogs / ResourceSpans
+constexpr std::uint32_t kResourceResource = 1;
+constexpr std::uint32_t kResourceScope = 2;
+// ScopeLogs / ScopeSpans
+constexpr std::uint32_t kScopeRecords = 2;
+// Resource
+constexpr std::uint32_t kResourceAttributes = 1;
+// KeyValue
+constexpr std::uint32_t kKeyValueKey = 1;
+constexpr std::uint32_t kKeyValueValue = 2;
+// AnyValue
+constexpr std::uint32_t kAnyValueString = 1;
+// LogRecord
+constexpr std::uint32_t kLogRecordTime = 1;
+constexpr std::uint32_t kLogRecordSeverityText = 3;
+constexpr std::uint32_t kLogRecordBody = 5;
+constexpr std::uint32_t kLogRecordAttributes = 6;
+constexpr std::uint32_t kLogRecordTraceId = 9;
+constexpr std::uint32_t kLogRecordSpanId = 10;
+// Span
+constexpr std::uint32_t kSpanTraceId = 1;
+constexpr std::uint32_t kSpanSpanId = 2;
+constexpr std::uint32_t kSpanParentSpanId = 4;
+constexpr std::uint32_t kSpanName = 5;
+constexpr std::uint32_t kSpanStartTime = 7;
+constexpr std::uint32_t kSpanEndTime = 8;
+constexpr std::uint32_t kSpanAttributes = 9;
+
+std::size_t VarintSize(std::uint64_t value) noexcept {
+    std::size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+std::size_t EncodeVarint(std::uint64_t value, char* out) noexcept {
+    std::size_t size = 0;
+    while (value >= 0x80) {
+        out[size++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out[size++] = static_cast<char>(value);
+    return size;
+}
+
+void AppendVarint(std::string& out, std::uint64_t value) {
+    char buffer[kMaxVarintSize];
+    out.append(buffer, EncodeVarint(value, buffer));
+}
+
+std::uint64_t MakeTag(std::uint32_t field, WireType type) noexcept {
+    return (static_cast<std::uint64_t>(field) << 3) | static_cast<std::uint32_t>(type);
+}
+
+void AppendTag(std::string& out, std::uint32_t field, WireType type) { AppendVarint(out, MakeTag(field, type)); }
+
+std::size_t LengthDelimitedSize(std::uint32_t field, std::size_t size) noexcept {
+    return VarintSize(MakeTag(field, WireType::kLengthDelimited)) + VarintSize(size) + size;
+}
+
+void AppendLengthDelimitedHeader(std::string& out, std::uint32_t field, std::size_t size) {
+    AppendTag(out, field, WireType::kLengthDelimited);
+    AppendVarint(out, size);
+}
+
+void AppendString(std::string& out, std::uint32_t field, std::string_view value) {
+    AppendLengthDelimitedHeader(out, field, value.size());
+    out.append(value);
+}
+
+void AppendFixed64(std::string& out, std::uint32_t field, std::uint64_t value) {
+    AppendTag(out, field, WireType::kFixed64);
+    char buffer[8];
+    for (auto& c : buffer) {
+        c = static_cast<char>(value & 0xFF);
+        value >>= 8;
+    }
+    out.append(buffer, sizeof(buffer));
+}
+
+int HexDigitValue(char c) noexcept {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Same as utils::encoding::FromHex, but writes right into the output
+void AppendHexAsBytes(std::string& out, std::uint32_t field, std::string_view hex) {
+    std::size_t size = 0;
+    while (size * 2 + 1 < hex.size() && HexDigitValue(hex[size * 2]) >= 0 && HexDigitValue(hex[size * 2 + 1]) >= 0) {
+        ++size;
+    }
+
+    AppendLengthDelimitedHeader(out, field, size);
+    for (std::size_t i = 0; i < size; ++i) {
+        out.push_back(static_cast<char>((HexDigitValue(hex[i * 2]) << 4) | HexDigitValue(hex[i * 2 + 1])));
+    }
+}
+
+// AnyValue{string_value: value}
+void AppendStringAnyValue(std::string& out, std::uint32_t field, std::string_view value) {
+    AppendLengthDelimitedHeader(out, field, LengthDelimitedSize(kAnyValueString, value.size()));
+    AppendString(out, kAnyValueString, value);
+}
+
+// KeyValue{key: key, value: AnyValue{string_value: value}}
+void AppendStringAttribute(std::string& out, std::uint32_t field, std::string_view key, std::string_view value) {
+    const auto any_value_size = LengthDelimitedSize(kAnyValueString, value.size());
+    const auto key_value_size =
+        LengthDelimitedSize(kKeyValueKey, key.size()) + LengthDelimitedSize(kKeyValueValue, any_value_size);
+
+    AppendLengthDelimitedHeader(out, field, key_value_size);
+    AppendString(out, kKeyValueKey, key);
+    AppendStringAnyValue(out, kKeyValueValue, value);
+}
+
+std::string_view MapAttribute(std::string_view attr, const AttributesMapping& mapping) {
+    for (const auto& [key, value] : mapping) {
+        if (key == attr) return value;
+    }
+    return attr;
+}
+
+}  // namespace
+
+std::string EncodeResource(const Attributes& attributes) {
+    std::string result;
+    for (const auto& [key, value] : attributes) {
+        AppendStringAttribute(result, kResourceAttributes, key, value);
+    }
+    return result;
+}
+
+std::string EncodeLogRecord(std::string_view msg, const AttributesMapping& mapping) {
+    std::string result;
+    // Tskv is a bit more verbose than the wire format
+    result.reserve(msg.size());
+
+    std::chrono::system_clock::time_point timestamp;
+
+    utils::encoding::TskvParser parser{msg};
+    [[maybe_unused]] auto parse_ok =
+        utils::encoding::TskvReadRecord(parser, [&](std::string_view key, std::string_view value) {
+            if (key == "text") {
+                AppendStringAnyValue(result, kLogRecordBody, value);
+            } else if (key == "trace_id") {
+                AppendHexAsBytes(result, kLogRecordTraceId, value);
+            } else if (key == "span_id") {
+                AppendHexAsBytes(result, kLogRecordSpanId, value);
+            } else if (key == "timestamp") {
+                timestamp = utils::datetime::LocalTimezoneStringtime(std::string{value}, kTimestampFormat);
+            } else if (key == "level") {
+                AppendString(result, kLogRecordSeverityText, value);
+            } else {
+                AppendStringAttribute(result, kLogRecordAttributes, MapAttribute(key, mapping), value);
+            }
+            return true;
+        });
+
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch());
+    AppendFixed64(result, kLogRecordTime, nanoseconds.count());
+
+    return result;
+}
+
+std::string EncodeSpan(std::string_view msg, const AttributesMapping& mapping) {
+    std::string result;
+    result.reserve(msg.size());
+
+    std::string start_timestamp;
+    std::string total_time;
+
+    utils::encoding::TskvParser parser{msg};
+    [[maybe_unused]] auto parse_ok =
+        utils::encoding::TskvReadRecord(parser, [&](std::string_view key, std::string_view value) {
+            if (key == "trace_id") {
+                AppendHexAsBytes(result, kSpanTraceId, value);
+            } else if (key == "span_id") {
+                AppendHexAsBytes(result, kSpanSpanId, value);
+            } else if (key == "parent_id") {
+                AppendHexAsBytes(result, kSpanParentSpanId, value);
+            } else if (key == "stopwatch_name") {
+                AppendString(result, kSpanName, value);
+            } else if (key == "total_time") {
+                total_time = value;
+            } else if (key == "start_timestamp") {
+                start_timestamp = value;
+            } else if (key == "timestamp" || key == "text") {
+                // skip
+            } else {
+                AppendStringAttribute(result, kSpanAttributes, MapAttribute(key, mapping), value);
+            }
+            return true;
+        });
+
+    // Same arithmetic as in the protobuf-based encoder
+    const auto start_timestamp_double = std::stod(start_timestamp);
+    const auto total_time_double = std::stod(total_time);
+    AppendFixed64(result, kSpanStartTime, static_cast<std::uint64_t>(start_timestamp_double * 1'000'000'000));
+    AppendFixed64(
+        result,
+        kSpanEndTime,
+        static_cast<std::uint64_t>((start_timestamp_double + total_time_double / 1'000) * 1'000'000'000LL)
+    );
+
+    return result;
+}
+
+RequestBuilder::RequestBuilder(std::string encoded_resource)
+    : encoded_resource_(std::move(encoded_resource)),
+      // Export*ServiceRequest{1: Resource*{1: Resource, 2: Scope*{...}}}
+      header_reserve_(3 * (1 + kMaxVarintSize) + LengthDelimitedSize(kResourceResource, encoded_resource_.size())) {
+    Reset();
+}
+
+void RequestBuilder::Add(std::string_view encoded_record) {
+    AppendString(buffer_, kScopeRecords, encoded_record);
+    ++records_count_;
+}
+
+EncodedRequest RequestBuilder::Extract() {
+    const auto scope_size = buffer_.size() - header_reserve_;
+    const auto resource_size = LengthDelimitedSize(kResourceResource, encoded_resource_.size()) +
+                               LengthDelimitedSize(kResourceScope, scope_size);
+
+    std::string header;
+    header.reserve(header_reserve_);
+    AppendLengthDelimitedHeader(header, kRequestResource, resource_size);
+    AppendString(header, kResourceResource, encoded_resource_);
+    AppendLengthDelimitedHeader(header, kResourceScope, scope_size);
+    UASSERT(header.size() <= header_reserve_);
+
+    // Put the header right before the records
+    const auto offset = header_reserve_ - header.size();
+    std::memcpy(buffer_.data() + offset, header.data(), header.size());
+
+    EncodedRequest result{std::move(buffer_), offset};
+    last_capacity_ = result.buffer.capacity();
+    Reset();
+    return result;
+}
+
+void RequestBuilder::Reset() {
+    buffer_ = std::string{};
+    // Next batch is likely to be of the same size
+    buffer_.reserve(std::max(last_capacity_, header_reserve_));
+    buffer_.resize(header_reserve_);
+    records_count_ = 0;
+}
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace otlp::impl {
+
+// Encoders of OTLP protobuf messages straight into the wire format, without
+// constructing the intermediate protobuf objects.
+//
+// Field numbers are taken from opentelemetry-proto v1.3.2:
+// * ExportLogsServiceRequest.resource_logs, ExportTraceServiceRequest.resource_spans = 1
+// * ResourceLogs/ResourceSpans: resource = 1, scope_logs/scope_spans = 2
+// * ScopeLogs/ScopeSpans: log_records/spans = 2
+// * Resource: attributes = 1
+// * KeyValue: key = 1, value = 2; AnyValue: string_value = 1
+// * LogRecord: time_unix_nano = 1, severity_text = 3, body = 5, attributes = 6, trace_id = 9, span_id = 10
+// * Span: trace_id = 1, span_id = 2, parent_span_id = 4, name = 5, start_time_unix_nano = 7,
+//   end_time_unix_nano = 8, attributes = 9
+
+using AttributesMapping = std::unordered_map<std::string, std::string>;
+using Attributes = std::vector<std::pair<std::string, std::string>>;
+
+// Encodes `opentelemetry.proto.resource.v1.Resource` message body
+std::string EncodeResource(const Attributes& attributes);
+
+// Encodes the tskv log record `msg` as `opentelemetry.proto.logs.v1.LogRecord`
+// message body
+std::string EncodeLogRecord(std::string_view msg, const AttributesMapping& mapping);
+
+// Encodes the tskv span record `msg` as `opentelemetry.proto.trace.v1.Span`
+// message body
+std::string EncodeSpan(std::string_view msg, const AttributesMapping& mapping);
+
+// Serialized ExportLogsServiceRequest or ExportTraceServiceRequest, starting
+// at `offset` of the `buffer`.
+struct EncodedRequest final {
+    std::string buffer;
+    std::size_t offset{0};
+
+    std::string_view GetView() const noexcept { return std::string_view{buffer}.substr(offset); }
+};
+
+// Accumulates the encoded records into a batch. ExportLogsServiceRequest and
+// ExportTraceServiceRequest have the same layout, so the same builder is used
+// for both of them.
+//
+// Records are copied once into a buffer that has room for the request header
+// in front of them, so the ready request is extracted without any copying.
+class RequestBuilder final {
+public:
+    explicit RequestBuilder(std::string encoded_resource);
+
+    void Add(std::string_view encoded_record);
+
+    bool IsEmpty() const noexcept { return records_count_ == 0; }
+
+    std::size_t GetRecordsCount() const noexcept { return records_count_; }
+
+    // Size of the request in bytes, not counting the header
+    std::size_t GetSizeApprox() const noexcept { return buffer_.size() - header_reserve_; }
+
+    // Returns the ready request and resets the builder
+    EncodedRequest Extract();
+
+private:
+    void Reset();
+
+    const std::string encoded_resource_;
+    const std::size_t header_reserve_;
+    std::string buffer_;
+    std::size_t records_count_{0};
+    std::size_t last_capacity_{0};
+};
+
+}  // namespace otlp::impl
+
+USERVER_NAMESPACE_END
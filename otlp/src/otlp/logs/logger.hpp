@@ -1,18 +1,18 @@
 #pragma once
 
 #include <memory>
-#include <variant>
-
-#include <opentelemetry/proto/collector/logs/v1/logs_service_client.usrv.pb.hpp>
-#include <opentelemetry/proto/collector/trace/v1/trace_service_client.usrv.pb.hpp>
+#include <string>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/formats/yaml.hpp>
 #include <userver/logging/impl/log_stats.hpp>
 #include <userver/logging/impl/logger_base.hpp>
+#include <userver/ugrpc/client/generic.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include "encoder.hpp"
+
 USERVER_NAMESPACE_BEGIN
 
 namespace otlp {
@@ -24,6 +24,7 @@ SinkType Parse(const yaml_config::YamlConfig& value, formats::parse::To<SinkType
 struct LoggerConfig {
     size_t max_queue_size{10000};
     std::chrono::milliseconds max_batch_delay{};
+    size_t max_batch_size_bytes{1024 * 1024};
     SinkType logs_sink{SinkType::kOtlp};
     SinkType tracing_sink{SinkType::kOtlp};
     std::string service_name;
@@ -34,10 +35,11 @@ struct LoggerConfig {
 
 class Logger final : public logging::impl::LoggerBase {
 public:
-    using LogClient = opentelemetry::proto::collector::logs::v1::LogsServiceClient;
-    using TraceClient = opentelemetry::proto::collector::trace::v1::TraceServiceClient;
+    // Logs and traces are sent as pre-encoded messages to the
+    // LogsService/Export and TraceService/Export methods of the collector.
+    using Client = ugrpc::client::GenericClient;
 
-    explicit Logger(LogClient client, TraceClient trace_client, LoggerConfig&& config);
+    Logger(Client client, Client trace_client, LoggerConfig&& config);
 
     ~Logger() override;
 
@@ -57,21 +59,24 @@ protected:
     bool DoShouldLog(logging::Level level) const noexcept override;
 
 private:
-    using Action = std::variant<::opentelemetry::proto::logs::v1::LogRecord, ::opentelemetry::proto::trace::v1::Span>;
+    // Wire-format encoded LogRecord or Span. `msg` of Log() and Trace() does
+    // not outlive the call, so a record has to be copied to get into the
+    // queue anyway, and it is encoded right into that copy.
+    struct Action {
+        enum class Kind { kLog, kTrace };
+
+        Kind kind{Kind::kLog};
+        std::string encoded;
+    };
     using Queue = concurrent::NonFifoMpscQueue<Action>;
 
-    void SendingLoop(Queue::Consumer& consumer, LogClient& log_client, TraceClient& trace_client);
-
-    void FillAttributes(::opentelemetry::proto::resource::v1::Resource& resource);
+    void SendingLoop(Queue::Consumer& consumer, Client& log_client, Client& trace_client);
 
-    void DoLog(const opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest& request, LogClient& client);
+    impl::Attributes GetResourceAttributes() const;
 
-    void DoTrace(
-        const opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest& request,
-        TraceClient& trace_client
-    );
+    void Push(Action&& action);
 
-    std::string_view MapAttribute(std::string_view attr) const;
+    void DoExport(std::string_view call_name, impl::RequestBuilder& builder, Client& client);
 
     logging::impl::LogStatistics stats_;
     const LoggerConfig config_;
@@ -0,0 +1,111 @@
+#include <userver/utest/utest.hpp>
+
+#include <otlp/logs/encoder.hpp>
+
+#include <opentelemetry/proto/collector/logs/v1/logs_service.pb.h>
+#include <opentelemetry/proto/collector/trace/v1/trace_service.pb.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kLogRecord =
+    "tskv\ttimestamp=2024-01-02T03:04:05.123456\tlevel=INFO\tmodule=main ( file.cpp:1 ) \t"
+    "trace_id=0123456789abcdef0123456789abcdef\tspan_id=0011223344556677\tkey=value\ttext=some text\n";
+
+constexpr std::string_view kSpanRecord =
+    "tskv\ttimestamp=2024-01-02T03:04:05.123456\ttrace_id=0123456789abcdef0123456789abcdef\t"
+    "span_id=0011223344556677\tparent_id=8899aabbccddeeff\tstopwatch_name=some_span\ttotal_time=1.5\t"
+    "start_timestamp=1700000000.000123\tkey=value\ttext=\n";
+
+const otlp::impl::AttributesMapping kMapping{{"key", "mapped_key"}};
+
+template <typename Message>
+std::string FindAttribute(const Message& message, std::string_view key) {
+    for (const auto& attribute : message.attributes()) {
+        if (attribute.key() == key) return attribute.value().string_value();
+    }
+    return "<not found>";
+}
+
+}  // namespace
+
+TEST(OtlpEncoder, LogRecord) {
+    otlp::impl::RequestBuilder builder{otlp::impl::EncodeResource({{"service.name", "test"}})};
+    EXPECT_TRUE(builder.IsEmpty());
+
+    builder.Add(otlp::impl::EncodeLogRecord(kLogRecord, kMapping));
+    builder.Add(otlp::impl::EncodeLogRecord(kLogRecord, kMapping));
+    EXPECT_EQ(builder.GetRecordsCount(), 2);
+
+    const auto request = builder.Extract();
+    EXPECT_TRUE(builder.IsEmpty());
+
+    opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest parsed;
+    const auto view = request.GetView();
+    ASSERT_TRUE(parsed.ParseFromArray(view.data(), static_cast<int>(view.size())));
+
+    ASSERT_EQ(parsed.resource_logs_size(), 1);
+    const auto& resource_logs = parsed.resource_logs(0);
+    ASSERT_EQ(resource_logs.resource().attributes_size(), 1);
+    EXPECT_EQ(resource_logs.resource().attributes(0).key(), "service.name");
+    EXPECT_EQ(resource_logs.resource().attributes(0).value().string_value(), "test");
+
+    ASSERT_EQ(resource_logs.scope_logs_size(), 1);
+    ASSERT_EQ(resource_logs.scope_logs(0).log_records_size(), 2);
+
+    const auto& log = resource_logs.scope_logs(0).log_records(0);
+    EXPECT_EQ(log.body().string_value(), "some text");
+    EXPECT_EQ(log.severity_text(), "INFO");
+    EXPECT_EQ(log.trace_id(), std::string("\x01\x23\x45\x67\x89\xab\xcd\xef\x01\x23\x45\x67\x89\xab\xcd\xef", 16));
+    EXPECT_EQ(log.span_id(), std::string("\x00\x11\x22\x33\x44\x55\x66\x77", 8));
+    EXPECT_NE(log.time_unix_nano(), 0);
+
+    EXPECT_EQ(FindAttribute(log, "module"), "main ( file.cpp:1 ) ");
+    EXPECT_EQ(FindAttribute(log, "mapped_key"), "value");
+    EXPECT_EQ(FindAttribute(log, "key"), "<not found>");
+}
+
+TEST(OtlpEncoder, Span) {
+    otlp::impl::RequestBuilder builder{otlp::impl::EncodeResource({})};
+    builder.Add(otlp::impl::EncodeSpan(kSpanRecord, kMapping));
+
+    const auto request = builder.Extract();
+
+    opentelemetry::proto::collector::trace::v1::ExportTraceServiceRequest parsed;
+    const auto view = request.GetView();
+    ASSERT_TRUE(parsed.ParseFromArray(view.data(), static_cast<int>(view.size())));
+
+    ASSERT_EQ(parsed.resource_spans_size(), 1);
+    ASSERT_EQ(parsed.resource_spans(0).scope_spans_size(), 1);
+    ASSERT_EQ(parsed.resource_spans(0).scope_spans(0).spans_size(), 1);
+
+    const auto& span = parsed.resource_spans(0).scope_spans(0).spans(0);
+    EXPECT_EQ(span.name(), "some_span");
+    EXPECT_EQ(span.span_id(), std::string("\x00\x11\x22\x33\x44\x55\x66\x77", 8));
+    EXPECT_EQ(span.parent_span_id(), std::string("\x88\x99\xaa\xbb\xcc\xdd\xee\xff", 8));
+    EXPECT_NEAR(span.start_time_unix_nano(), 1'700'000'000'000'123'000, 1'000);
+    EXPECT_NEAR(span.end_time_unix_nano() - span.start_time_unix_nano(), 1'500'000, 1'000);
+
+    EXPECT_EQ(FindAttribute(span, "mapped_key"), "value");
+    EXPECT_EQ(FindAttribute(span, "stopwatch_name"), "<not found>");
+}
+
+TEST(OtlpEncoder, BuilderReuse) {
+    otlp::impl::RequestBuilder builder{otlp::impl::EncodeResource({})};
+
+    for (int i = 0; i < 3; ++i) {
+        const std::size_t records_count = 100 * (i + 1);
+        for (std::size_t j = 0; j < records_count; ++j) {
+            builder.Add(otlp::impl::EncodeLogRecord(kLogRecord, {}));
+        }
+
+        const auto request = builder.Extract();
+        opentelemetry::proto::collector::logs::v1::ExportLogsServiceRequest parsed;
+        const auto view = request.GetView();
+        ASSERT_TRUE(parsed.ParseFromArray(view.data(), static_cast<int>(view.size())));
+        EXPECT_EQ(parsed.resource_logs(0).scope_logs(0).log_records_size(), records_count);
+    }
+}
+
+USERVER_NAMESPACE_END
@@ -4,11 +4,11 @@
 
 #include <otlp/logs/logger.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/ugrpc/client/generic.hpp>
 
 #include <userver/ugrpc/tests/service_fixtures.hpp>
 #include <userver/utest/default_logger_fixture.hpp>
 
-#include <opentelemetry/proto/collector/logs/v1/logs_service_client.usrv.pb.hpp>
 #include <opentelemetry/proto/collector/logs/v1/logs_service_service.usrv.pb.hpp>
 #include <opentelemetry/proto/collector/trace/v1/trace_service_service.usrv.pb.hpp>
 
@@ -90,9 +90,7 @@ class LogServiceTest : public Service<LogService, TraceService>, public utest::D
 public:
     LogServiceTest() : Service({}) {
         logger_ = std::make_shared<otlp::Logger>(
-            MakeClient<opentelemetry::proto::collector::logs::v1::LogsServiceClient>(),
-            MakeClient<opentelemetry::proto::collector::trace::v1::TraceServiceClient>(),
-            otlp::LoggerConfig{}
+            MakeClient<ugrpc::client::GenericClient>(), MakeClient<ugrpc::client::GenericClient>(), otlp::LoggerConfig{}
         );
         SetDefaultLogger(logger_);
     }
@@ -82,6 +82,8 @@ Postgres::Postgres(const ComponentConfig& config, const ComponentContext& contex
                                                                       : storages::postgres::InitMode::kAsync;
     initial_settings_.db_name = db_name_;
     initial_settings_.connlimit_mode = ParseConnlimitMode(config["connlimit_mode"].As<std::string>("auto"));
+    initial_settings_.cc_config =
+        config["congestion_control"].As<congestion_control::v2::ControllerStaticConfig>(initial_settings_.cc_config);
 
     initial_settings_.topology_settings.max_replication_lag =
         config["max_replication_lag"].As<std::chrono::milliseconds>(storages::postgres::kDefaultMaxReplicationLag);
@@ -309,6 +311,72 @@ properties:
          - auto
          - manual
         description: how to learn the `max_pool_size`
+    congestion_control:
+        description: congestion control settings
+        type: object
+        additionalProperties: false
+        properties:
+            fake-mode:
+                type: boolean
+                description: whether CC limiter is actually working
+                defaultDescription: false
+            enabled:
+                type: boolean
+                description: whether CC is enabled for the database
+                defaultDescription: true
+            controller:
+                type: string
+                description: congestion control algorithm
+                defaultDescription: linear
+                enum:
+                  - linear
+                  - gradient
+                  - vegas
+            gradient:
+                type: object
+                description: settings of the `gradient` controller
+                additionalProperties: false
+                properties:
+                    smoothing:
+                        type: number
+                        description: weight of the new limit estimation, from 0 to 1
+                        defaultDescription: 0.2
+                        minimum: 0
+                        maximum: 1
+                    rtt-tolerance:
+                        type: number
+                        description: how many times the current timings may exceed the long-term ones
+                        defaultDescription: 1.5
+                        minimum: 1
+                    long-window:
+                        type: integer
+                        description: size of the long-term timings window in seconds
+                        defaultDescription: 600
+                        minimum: 1
+            vegas:
+                type: object
+                description: settings of the `vegas` controller
+                additionalProperties: false
+                properties:
+                    smoothing:
+                        type: number
+                        description: weight of the new limit estimation, from 0 to 1
+                        defaultDescription: 1
+                        minimum: 0
+                        maximum: 1
+                    alpha:
+                        type: number
+                        description: the limit grows while fewer than alpha * log10(limit) requests are queued
+                        defaultDescription: 3
+                    beta:
+                        type: number
+                        description: the limit falls while more than beta * log10(limit) requests are queued
+                        defaultDescription: 6
+                    probe-interval:
+                        type: integer
+                        description: reset the minimal timings every that many seconds while no limit is applied
+                        defaultDescription: 30
+                        minimum: 1
 )");
 }
 
@@ -22,7 +22,7 @@
 #include <storages/postgres/congestion_control/limiter.hpp>
 #include <storages/postgres/congestion_control/sensor.hpp>
 #include <storages/postgres/default_command_controls.hpp>
-#include <userver/congestion_control/controllers/linear.hpp>
+#include <userver/congestion_control/controllers/factory.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
 #include <userver/storages/postgres/notify.hpp>
@@ -55,7 +55,7 @@ public:
         const DefaultCommandControls& default_cmd_ctls,
         const testsuite::PostgresControl& testsuite_pg_ctl,
         error_injection::Settings ei_settings,
-        const congestion_control::v2::LinearController::StaticConfig& cc_config,
+        const congestion_control::v2::ControllerStaticConfig& cc_config,
         dynamic_config::Source config_source
     );
 
@@ -73,7 +73,7 @@ public:
         const DefaultCommandControls& default_cmd_ctls,
         const testsuite::PostgresControl& testsuite_pg_ctl,
         error_injection::Settings ei_settings,
-        const congestion_control::v2::LinearController::StaticConfig& cc_config,
+        const congestion_control::v2::ControllerStaticConfig& cc_config,
         dynamic_config::Source config_source
     );
 
@@ -165,7 +165,7 @@ private:
     // Congestion control stuff
     cc::Sensor cc_sensor_;
     cc::Limiter cc_limiter_;
-    congestion_control::v2::LinearController cc_controller_;
+    std::unique_ptr<congestion_control::v2::Controller> cc_controller_;
     std::atomic<std::size_t> cc_max_connections_{0};
 };
 
@@ -27,6 +27,7 @@
 
 #include <userver/storages/redis/client.hpp>
 #include <userver/storages/redis/command_control.hpp>
+#include <userver/utils/adaptive_hedging.hpp>
 #include <userver/utils/hedged_request.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -187,6 +188,82 @@ MakeBulkHedgedRedisRequestAsync(
     return utils::hedging::HedgeRequestsBulkAsync<RequestStrategy>(std::move(strategies), hedging_settings);
 }
 
+template <typename RedisRequestType>
+using AdaptiveHedgedRedisRequest = utils::hedging::HedgedRequestFuture<
+    utils::hedging::AdaptiveStrategy<impl::RedisRequestStrategy<RedisRequestType>>>;
+
+/// Same as MakeHedgedRedisRequestAsync but the hedged attempts are made after
+/// the adaptive delay of the `destination`, see
+/// utils::hedging::AdaptiveStrategy. HedgingSettings::hedging_delay is ignored.
+template <
+    typename RedisRequestType,
+    typename... Args,
+    typename M = RedisRequestType (storages::redis::Client::*)(Args..., const redis::CommandControl&)>
+AdaptiveHedgedRedisRequest<RedisRequestType> MakeAdaptiveHedgedRedisRequestAsync(
+    std::shared_ptr<storages::redis::Client> redis,
+    M method,
+    const redis::CommandControl& cc,
+    utils::hedging::HedgingSettings hedging_settings,
+    std::shared_ptr<utils::hedging::AdaptiveHedging::Destination> destination,
+    Args... args
+) {
+    auto gen_request = [redis, method, cc{std::move(cc)}, args_tuple{std::tuple(std::move(args)...)}](int try_count
+                       ) mutable -> std::optional<RedisRequestType> {
+        cc.retry_counter = try_count;
+        cc.max_retries = 1;  ///< We do retries ourselves
+
+        return std::apply(
+            [redis, method, cc](auto&&... args) { return (redis.get()->*method)(args..., cc); }, args_tuple
+        );
+    };
+    return utils::hedging::HedgeRequestAsync(
+        utils::hedging::AdaptiveStrategy{
+            impl::RedisRequestStrategy<RedisRequestType>(std::move(gen_request)), std::move(destination)},
+        hedging_settings
+    );
+}
+
+/// Same as MakeHedgedRedisRequest but the hedged attempts are made after the
+/// adaptive delay of the `destination`, see utils::hedging::AdaptiveStrategy.
+/// HedgingSettings::hedging_delay is ignored.
+///
+/// Example:
+/// auto destination = adaptive_hedging.GetDestination("profiles-redis");
+/// ...
+/// auto result =
+///     ::redis::MakeAdaptiveHedgedRedisRequest<storages::redis::RequestHGet>(
+///         redis_client_shared_ptr,
+///         &storages::redis::Client::Hget,
+///         redis_cc, hedging_settings, destination,
+///         key, field);
+template <
+    typename RedisRequestType,
+    typename... Args,
+    typename M = RedisRequestType (storages::redis::Client::*)(Args..., const redis::CommandControl&)>
+std::optional<typename RedisRequestType::Reply> MakeAdaptiveHedgedRedisRequest(
+    std::shared_ptr<storages::redis::Client> redis,
+    M method,
+    const redis::CommandControl& cc,
+    utils::hedging::HedgingSettings hedging_settings,
+    std::shared_ptr<utils::hedging::AdaptiveHedging::Destination> destination,
+    Args... args
+) {
+    auto gen_request = [redis, method, cc{std::move(cc)}, args_tuple{std::tuple(std::move(args)...)}](int try_count
+                       ) mutable -> std::optional<RedisRequestType> {
+        cc.retry_counter = try_count;
+        cc.max_retries = 1;  ///< We do retries ourselves
+
+        return std::apply(
+            [redis, method, cc](auto&&... args) { return (redis.get()->*method)(args..., cc); }, args_tuple
+        );
+    };
+    return utils::hedging::HedgeRequest(
+        utils::hedging::AdaptiveStrategy{
+            impl::RedisRequestStrategy<RedisRequestType>(std::move(gen_request)), std::move(destination)},
+        hedging_settings
+    );
+}
+
 }  // namespace redis
 
 USERVER_NAMESPACE_END
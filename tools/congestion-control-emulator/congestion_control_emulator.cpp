@@ -1,11 +1,23 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include <fmt/format.h>
 #include <boost/program_options.hpp>
 
 #include <userver/congestion_control/controller.hpp>
+#include <userver/congestion_control/controllers/factory.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/yaml/serialize.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 #include <userver/utest/using_namespace_userver.hpp>
 
@@ -14,16 +26,32 @@ using namespace congestion_control;
 struct Config {
     Policy policy;
     std::string log_level = "none";
+
+    // v2 controllers simulation
+    std::string controller = "v1";
+    std::string controller_config;
+    v2::Config v2_config;
+    std::size_t base_latency_ms = 50;
+    std::size_t timeout_ms = 1000;
+    std::size_t max_concurrency = 400;
 };
 
 Config ParseArgs(int argc, char* argv[]) {
     Config config;
     std::string policy_json;
+    std::string v2_config_json;
 
     namespace po = boost::program_options;
 
     // clang-format off
-  po::options_description desc("Allowed options");
+  po::options_description desc(
+    "Emulates congestion control.\n\n"
+    "With `--controller v1` reads the '<current_load> <overload_events_count>' lines of the RPS congestion control "
+    "sensor from stdin and prints the limits.\n\n"
+    "With `--controller linear|gradient|vegas|all` reads the '<offered_rps> <downstream_capacity_rps>' lines, "
+    "one per second, from stdin and simulates a database pool whose connections are limited by the controller. "
+    "Prints the per-second state for a single controller and the goodput and latency summary of each one.\n\n"
+    "Allowed options");
   desc.add_options()
     ("help,h", "produce help message")
     ("log-level",
@@ -31,7 +59,25 @@ Config ParseArgs(int argc, char* argv[]) {
       "log level (trace, debug, info, warning, error)")
     ("policy,p",
      po::value(&policy_json)->default_value(std::string{}),
-     "policy in JSON")
+     "policy in JSON, for v1")
+    ("controller,c",
+     po::value(&config.controller)->default_value(config.controller),
+     "controller to emulate (v1, linear, gradient, vegas, all)")
+    ("controller-config",
+     po::value(&config.controller_config)->default_value(std::string{}),
+     "static config of the v2 controllers in YAML, e.g. '{gradient: {rtt-tolerance: 2}}'")
+    ("v2-config",
+     po::value(&v2_config_json)->default_value(std::string{}),
+     "dynamic config of the v2 controllers in JSON, e.g. '{\"min-limit\": 5}'")
+    ("base-latency-ms",
+     po::value(&config.base_latency_ms)->default_value(config.base_latency_ms),
+     "downstream latency without overload")
+    ("timeout-ms",
+     po::value(&config.timeout_ms)->default_value(config.timeout_ms),
+     "requests that take longer time out")
+    ("max-concurrency",
+     po::value(&config.max_concurrency)->default_value(config.max_concurrency),
+     "pool size")
   ;
     // clang-format on
 
@@ -47,16 +93,14 @@ Config ParseArgs(int argc, char* argv[]) {
     if (!policy_json.empty()) {
         config.policy = formats::json::FromString(policy_json).As<Policy>();
     }
+    if (!v2_config_json.empty()) {
+        config.v2_config = formats::json::FromString(v2_config_json).As<v2::Config>();
+    }
 
     return config;
 }
 
-int main(int argc, char* argv[]) {
-    Config config = ParseArgs(argc, argv);
-
-    logging::DefaultLoggerGuard guard{
-        logging::MakeStderrLogger("default", logging::Format::kTskv, logging::LevelFromString(config.log_level))};
-
+void RunV1(const Config& config) {
     dynamic_config::StorageMock dynamic_config{{congestion_control::impl::kRpsCcConfig, {config.policy, true}}};
     Controller ctrl("cc", dynamic_config.GetSource());
 
@@ -76,3 +120,211 @@ int main(int argc, char* argv[]) {
         }
     }
 }
+
+struct LoadPoint {
+    double offered_rps{0};
+    double capacity_rps{0};
+};
+
+std::vector<LoadPoint> ReadLoadCurve() {
+    std::vector<LoadPoint> result;
+    for (;;) {
+        LoadPoint point;
+        std::cin >> point.offered_rps >> point.capacity_rps;
+        if (std::cin.eof()) break;
+        if (!std::cin.good() || point.capacity_rps <= 0) throw std::runtime_error("Invalid input");
+        result.push_back(point);
+    }
+    return result;
+}
+
+class SimulatedSensor final : public v2::Sensor {
+public:
+    Data GetCurrent() override { return data; }
+
+    Data data;
+};
+
+class SimulatedLimiter final : public Limiter {
+public:
+    void SetLimit(const Limit& new_limit) override { limit = new_limit.load_limit; }
+
+    std::optional<std::size_t> limit;
+};
+
+struct Summary {
+    double offered{0};
+    double goodput{0};
+    double rejected{0};
+    double timeouts{0};
+    std::size_t limited_seconds{0};
+    // latency and the number of requests that got it
+    std::vector<std::pair<double, double>> latencies;
+
+    double GetLatencyPercentile(double percentile) {
+        std::sort(latencies.begin(), latencies.end());
+        double total = 0;
+        for (const auto& [latency, count] : latencies) total += count;
+
+        double accumulated = 0;
+        for (const auto& [latency, count] : latencies) {
+            accumulated += count;
+            if (accumulated >= total * percentile / 100) return latency;
+        }
+        return 0;
+    }
+};
+
+namespace {
+
+// Requests slow each other down superlinearly above the optimal concurrency,
+// e.g. because of the lock contention and the cache thrashing in the database
+constexpr double kContentionExponent = 1.5;
+
+// Iterations to find the stable number of requests in flight
+constexpr std::size_t kInFlightIterations = 50;
+
+}  // namespace
+
+// Very rough model of a database behind a connection pool. The database
+// serves `capacity_rps` requests per second at `base_latency_ms` with the
+// optimal concurrency, and gets slower (and serves less) with more requests
+// in flight. The pool runs up to `limit` requests concurrently, the rest wait
+// for a connection and are rejected. The average latency is reported, so the
+// requests start to time out at the half of the timeout.
+Summary Simulate(
+    const std::string& name,
+    const v2::ControllerStaticConfig& static_config,
+    const Config& config,
+    const std::vector<LoadPoint>& load_curve,
+    bool print_steps
+) {
+    dynamic_config::StorageMock dynamic_config;
+    SimulatedSensor sensor;
+    SimulatedLimiter limiter;
+    v2::Stats stats;
+    auto controller = v2::MakeController(
+        name,
+        sensor,
+        limiter,
+        stats,
+        static_config,
+        dynamic_config.GetSource(),
+        [&config](const dynamic_config::Snapshot&) { return config.v2_config; }
+    );
+
+    const auto base_latency = static_cast<double>(config.base_latency_ms);
+    const auto timeout = static_cast<double>(config.timeout_ms);
+
+    Summary summary;
+
+    if (print_steps) {
+        std::cout << "second\toffered\tcapacity\tlimit\tadmitted\tlatency_ms\tgoodput\ttimeouts\n";
+    }
+
+    for (std::size_t second = 0; second < load_curve.size(); ++second) {
+        const auto [offered, capacity] = load_curve[second];
+
+        auto limit = static_cast<double>(config.max_concurrency);
+        if (limiter.limit) limit = std::min(limit, static_cast<double>(*limiter.limit));
+
+        const double optimal_in_flight = capacity * base_latency / 1000;
+        const auto get_latency = [&](double in_flight) {
+            return base_latency * std::pow(std::max(1.0, in_flight / optimal_in_flight), kContentionExponent);
+        };
+
+        // in_flight = offered * latency(in_flight), by Little's law
+        double in_flight = 0;
+        for (std::size_t i = 0; i < kInFlightIterations; ++i) {
+            in_flight = std::min(limit, offered * get_latency(in_flight) / 1000);
+        }
+
+        const double latency = get_latency(in_flight);
+        const double admitted = in_flight * 1000 / latency;
+        const double timeouts = admitted * std::clamp(2 * latency / timeout - 1, 0.0, 1.0);
+        const double goodput = admitted - timeouts;
+
+        summary.offered += offered;
+        summary.goodput += goodput;
+        summary.rejected += offered - admitted;
+        summary.timeouts += timeouts;
+        summary.latencies.emplace_back(std::min(latency, timeout), admitted);
+        if (limiter.limit) summary.limited_seconds++;
+
+        if (print_steps) {
+            std::cout << fmt::format(
+                "{}\t{:.0f}\t{:.0f}\t{}\t{:.0f}\t{:.1f}\t{:.0f}\t{:.0f}\n",
+                second,
+                offered,
+                capacity,
+                limiter.limit ? std::to_string(*limiter.limit) : std::string{"(none)"},
+                admitted,
+                latency,
+                goodput,
+                timeouts
+            );
+        }
+
+        sensor.data.total = static_cast<std::size_t>(admitted);
+        sensor.data.timeouts = static_cast<std::size_t>(timeouts);
+        sensor.data.timings_avg_ms = static_cast<std::size_t>(std::min(latency, timeout));
+        sensor.data.current_load = static_cast<std::size_t>(in_flight);
+        controller->Step();
+    }
+
+    return summary;
+}
+
+void RunV2(const Config& config) {
+    auto static_config =
+        config.controller_config.empty()
+            ? v2::ControllerStaticConfig{}
+            : yaml_config::YamlConfig{formats::yaml::FromString(config.controller_config), {}}
+                  .As<v2::ControllerStaticConfig>();
+
+    std::vector<std::pair<std::string, v2::ControllerType>> controllers;
+    if (config.controller == "all") {
+        controllers = {
+            {"linear", v2::ControllerType::kLinear},
+            {"gradient", v2::ControllerType::kGradient},
+            {"vegas", v2::ControllerType::kVegas},
+        };
+    } else {
+        static_config.type =
+            yaml_config::YamlConfig{formats::yaml::FromString(config.controller), {}}.As<v2::ControllerType>();
+        controllers = {{config.controller, static_config.type}};
+    }
+
+    const auto load_curve = ReadLoadCurve();
+    const bool print_steps = controllers.size() == 1;
+
+    std::cout << "controller\tgoodput_percent\trejected_percent\ttimeouts_percent\tlimited_seconds\tp50_ms\tp99_ms\n";
+    for (const auto& [name, type] : controllers) {
+        static_config.type = type;
+        auto summary = Simulate(name, static_config, config, load_curve, print_steps);
+        const auto offered = std::max(summary.offered, 1.0);
+        std::cout << fmt::format(
+            "{}\t{:.1f}\t{:.1f}\t{:.1f}\t{}\t{:.1f}\t{:.1f}\n",
+            name,
+            100 * summary.goodput / offered,
+            100 * summary.rejected / offered,
+            100 * summary.timeouts / offered,
+            summary.limited_seconds,
+            summary.GetLatencyPercentile(50),
+            summary.GetLatencyPercentile(99)
+        );
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Config config = ParseArgs(argc, argv);
+
+    logging::DefaultLoggerGuard guard{
+        logging::MakeStderrLogger("default", logging::Format::kTskv, logging::LevelFromString(config.log_level))};
+
+    if (config.controller == "v1") {
+        RunV1(config);
+    } else {
+        RunV2(config);
+    }
+}
@@ -0,0 +1,134 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <boost/program_options.hpp>
+
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/logging/impl/binary_format.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+namespace {
+
+namespace binary = logging::impl::binary;
+
+struct Config {
+    std::string input;
+    std::string format = "tskv";
+    size_t buffer_size = 1024 * 1024;
+};
+
+Config ParseConfig(int argc, char** argv) {
+    namespace po = boost::program_options;
+
+    Config config;
+    po::options_description desc("Converts the logs written in the `binary` format back to text.\nAllowed options");
+    desc.add_options()("help,h", "produce help message")(
+        "input,i", po::value(&config.input), "binary log file (stdin by default)"
+    )("format,f", po::value(&config.format)->default_value(config.format), "output format (tskv, json)"
+    )("buffer,b", po::value(&config.buffer_size)->default_value(config.buffer_size), "read buffer size");
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        po::notify(vm);
+    } catch (const std::exception& ex) {
+        std::cerr << "Cannot parse command line: " << ex.what() << '\n';
+        exit(1);
+    }
+
+    if (vm.count("help")) {
+        std::cout << desc << '\n';
+        exit(0);
+    }
+
+    if (config.format != "tskv" && config.format != "json") {
+        std::cerr << "Unknown output format '" << config.format << "'\n";
+        exit(1);
+    }
+
+    return config;
+}
+
+void AppendJson(std::string& out, const binary::Record& record) {
+    const auto seconds = std::chrono::time_point_cast<std::chrono::seconds>(record.timestamp);
+    const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(record.timestamp - seconds);
+
+    formats::json::StringBuilder sb;
+    {
+        const formats::json::StringBuilder::ObjectGuard guard{sb};
+        sb.Key("timestamp");
+        sb.WriteString(fmt::format(
+            "{:%FT%T}.{:06}", fmt::localtime(std::chrono::system_clock::to_time_t(record.timestamp)), microseconds.count()
+        ));
+        sb.Key("level");
+        sb.WriteString(logging::ToUpperCaseString(record.level));
+        for (const auto& [key, value] : record.fields) {
+            sb.Key(key);
+            sb.WriteString(value);
+        }
+    }
+    out.append(sb.GetStringView());
+    out.push_back('\n');
+}
+
+void Decode(std::istream& input, const Config& config) {
+    const bool is_json = (config.format == "json");
+
+    std::vector<char> buffer(config.buffer_size);
+    std::string pending;
+    std::string output;
+    bool is_eof = false;
+
+    while (!is_eof) {
+        input.read(buffer.data(), buffer.size());
+        pending.append(buffer.data(), input.gcount());
+        is_eof = !input;
+
+        std::string_view data{pending};
+        while (auto chunk = binary::ReadChunk(data, is_eof)) {
+            if (!chunk->record) {
+                // Text lines, e.g. logs written before the logger was configured
+                output.append(chunk->text);
+            } else if (is_json) {
+                AppendJson(output, *chunk->record);
+            } else {
+                binary::AppendTskv(output, *chunk->record);
+            }
+        }
+
+        std::cout.write(output.data(), output.size());
+        output.clear();
+        pending.erase(0, pending.size() - data.size());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const auto config = ParseConfig(argc, argv);
+
+    try {
+        if (config.input.empty()) {
+            Decode(std::cin, config);
+        } else {
+            std::ifstream input{config.input, std::ios::binary};
+            if (!input) {
+                std::cerr << "Cannot open '" << config.input << "'\n";
+                return 1;
+            }
+            Decode(input, config);
+        }
+    } catch (const binary::DecodeError& ex) {
+        std::cout.flush();
+        std::cerr << "Failed to decode the log: " << ex.what() << '\n';
+        return 1;
+    }
+}
@@ -10,7 +10,14 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+enum class Format {
+    kTskv,
+    kLtsv,
+    kRaw,
+    /// Compact binary records, see logging::impl::binary. Could be converted
+    /// back to TSKV or JSON with the `userver-tool-log-decoder`.
+    kBinary,
+};
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
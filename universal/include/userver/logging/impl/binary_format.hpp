@@ -0,0 +1,89 @@
+#pragma once
+
+/// @file userver/logging/impl/binary_format.hpp
+/// @brief Decoder of the binary log format
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// @brief Binary log format, see logging::Format::kBinary
+///
+/// Each record is self-contained, so that a log file can be decoded after
+/// rotation, truncation or partial reads:
+///
+/// @code
+/// record     := kRecordMagic:u8  body_size:fixed32  body
+/// body       := timestamp:varint  level:varint  field*
+/// field      := key_tag:varint  [key_bytes]  value_size:fixed32  value_bytes
+/// key_tag    := (interned_key_id << 1)      -- for the well-known keys
+///             | (key_size << 1) | 1         -- key_bytes follow
+/// @endcode
+///
+/// Fixed-width integers are little-endian. `timestamp` is the number of
+/// microseconds since the Unix epoch. Keys are escaped the same way as for
+/// TSKV, values are stored as is, without any escaping. Value sizes are
+/// fixed-width, because values are written in parts and the size is patched
+/// in place once the value ends.
+///
+/// Records may be interleaved with text lines, e.g. the logs written before
+/// the logger configuration was loaded, or the newlines that file sinks put
+/// on reopening. Decoders pass them through as is.
+namespace logging::impl::binary {
+
+inline constexpr char kRecordMagic = '\xB1';
+inline constexpr std::size_t kFixed32Size = 4;
+inline constexpr std::size_t kMaxVarintSize = 10;
+
+/// @brief Returns the id of a well-known key.
+///
+/// The ids are part of the format, new keys may only be appended.
+std::optional<std::uint64_t> FindInternedKeyId(std::string_view key) noexcept;
+
+/// Returns the well-known key by its id
+std::optional<std::string_view> FindInternedKey(std::uint64_t id) noexcept;
+
+/// Thrown on malformed binary records
+class DecodeError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Decoded binary log record, references the decoded data
+struct Record final {
+    std::chrono::system_clock::time_point timestamp;
+    Level level{Level::kInfo};
+    std::vector<std::pair<std::string_view, std::string_view>> fields;
+};
+
+/// Decoded chunk of a binary log: either a record or a text line
+struct Chunk final {
+    std::optional<Record> record;
+
+    /// The text line, including the trailing newline if any
+    std::string_view text;
+};
+
+/// @brief Decodes the first record or text line of `data` and removes it from
+/// `data`.
+/// @returns std::nullopt if `data` contains an incomplete record or an
+/// incomplete text line, while `is_eof` is `false`.
+/// @throws DecodeError if the record is malformed
+std::optional<Chunk> ReadChunk(std::string_view& data, bool is_eof);
+
+/// Appends the record to `out` in TSKV format, with a trailing newline
+void AppendTskv(std::string& out, const Record& record);
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
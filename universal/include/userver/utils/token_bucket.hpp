@@ -84,10 +84,17 @@ public:
     /// @return true if the requested number of tokens was successfully obtained
     [[nodiscard]] bool ObtainAll(size_t count);
 
+    /// @brief Obtains a token only if at least `reserve` tokens remain in
+    /// the bucket, e.g. to keep some tokens for more important consumers.
+    /// @returns true if token was successfully obtained
+    [[nodiscard]] bool ObtainWithReserve(size_t reserve);
+
     /// Get rate for specified update interval (updates per second)
     static double GetRatePs(Duration interval);
 
 private:
+    bool DoObtain(size_t count, size_t reserve);
+
     void Update();
 
     std::atomic<size_t> max_size_;
@@ -0,0 +1,191 @@
+#include <userver/logging/impl/binary_format.hpp>
+
+#include <iterator>
+
+#include <fmt/chrono.h>
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/utils/encoding/tskv.hpp>
+#include <userver/utils/trivial_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::binary {
+
+namespace {
+
+// The ids are written to the log files, never change or remove the existing
+// entries.
+constexpr utils::TrivialBiMap kInternedKeys = [](auto selector) {
+    return selector()
+        .Case("text", std::uint64_t{1})
+        .Case("module", std::uint64_t{2})
+        .Case("thread_id", std::uint64_t{3})
+        .Case("task_id", std::uint64_t{4})
+        .Case("trace_id", std::uint64_t{5})
+        .Case("span_id", std::uint64_t{6})
+        .Case("parent_id", std::uint64_t{7})
+        .Case("link", std::uint64_t{8})
+        .Case("parent_link", std::uint64_t{9})
+        .Case("stopwatch_name", std::uint64_t{10})
+        .Case("total_time", std::uint64_t{11})
+        .Case("start_timestamp", std::uint64_t{12})
+        .Case("span_ref_type", std::uint64_t{13})
+        .Case("_type", std::uint64_t{14})
+        .Case("method", std::uint64_t{15})
+        .Case("meta_code", std::uint64_t{16})
+        .Case("meta_type", std::uint64_t{17})
+        .Case("http.url", std::uint64_t{18})
+        .Case("error", std::uint64_t{19})
+        .Case("error_msg", std::uint64_t{20})
+        .Case("attempts", std::uint64_t{21})
+        .Case("max_attempts", std::uint64_t{22})
+        .Case("timeout_ms", std::uint64_t{23})
+        .Case("db.type", std::uint64_t{24})
+        .Case("db.collection", std::uint64_t{25})
+        .Case("db.instance", std::uint64_t{26})
+        .Case("db.statement", std::uint64_t{27})
+        .Case("db.statement_name", std::uint64_t{28})
+        .Case("peer.address", std::uint64_t{29})
+        .Case("body", std::uint64_t{30})
+        .Case("uri", std::uint64_t{31})
+        .Case("type", std::uint64_t{32});
+};
+
+class Reader final {
+public:
+    explicit Reader(std::string_view data) noexcept : data_(data) {}
+
+    bool IsEmpty() const noexcept { return data_.empty(); }
+
+    std::uint64_t ReadVarint() {
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < kMaxVarintSize; ++i) {
+            const auto byte = static_cast<unsigned char>(ReadBytes(1)[0]);
+            result |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+            if (!(byte & 0x80)) return result;
+        }
+        throw DecodeError("Too long varint in a binary log record");
+    }
+
+    std::uint32_t ReadFixed32() {
+        const auto bytes = ReadBytes(kFixed32Size);
+        std::uint32_t result = 0;
+        for (std::size_t i = 0; i < kFixed32Size; ++i) {
+            result |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+        }
+        return result;
+    }
+
+    std::string_view ReadBytes(std::uint64_t size) {
+        if (size > data_.size()) {
+            throw DecodeError("Truncated binary log record");
+        }
+        const auto result = data_.substr(0, size);
+        data_.remove_prefix(size);
+        return result;
+    }
+
+private:
+    std::string_view data_;
+};
+
+Record ReadRecordBody(std::string_view body) {
+    Reader reader{body};
+
+    Record record;
+    record.timestamp = std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::microseconds{reader.ReadVarint()})
+    };
+
+    const auto level = reader.ReadVarint();
+    if (level > static_cast<std::uint64_t>(Level::kNone)) {
+        throw DecodeError(fmt::format("Invalid level {} in a binary log record", level));
+    }
+    record.level = static_cast<Level>(level);
+
+    while (!reader.IsEmpty()) {
+        const auto key_tag = reader.ReadVarint();
+        std::string_view key;
+        if (key_tag & 1) {
+            key = reader.ReadBytes(key_tag >> 1);
+        } else {
+            const auto interned_key = FindInternedKey(key_tag >> 1);
+            if (!interned_key) {
+                throw DecodeError(fmt::format("Unknown key id {} in a binary log record", key_tag >> 1));
+            }
+            key = *interned_key;
+        }
+
+        const auto value = reader.ReadBytes(reader.ReadFixed32());
+        record.fields.emplace_back(key, value);
+    }
+
+    return record;
+}
+
+}  // namespace
+
+std::optional<std::uint64_t> FindInternedKeyId(std::string_view key) noexcept {
+    return kInternedKeys.TryFindByFirst(key);
+}
+
+std::optional<std::string_view> FindInternedKey(std::uint64_t id) noexcept {
+    return kInternedKeys.TryFindBySecond(id);
+}
+
+std::optional<Chunk> ReadChunk(std::string_view& data, bool is_eof) {
+    if (data.empty()) return std::nullopt;
+
+    if (data.front() != kRecordMagic) {
+        const auto line_end = data.find('\n');
+        if (line_end == std::string_view::npos && !is_eof) return std::nullopt;
+
+        const auto line_size = (line_end == std::string_view::npos ? data.size() : line_end + 1);
+        Chunk chunk{std::nullopt, data.substr(0, line_size)};
+        data.remove_prefix(line_size);
+        return chunk;
+    }
+
+    if (data.size() < 1 + kFixed32Size) {
+        if (!is_eof) return std::nullopt;
+        throw DecodeError("Truncated binary log record header");
+    }
+
+    const auto body_size = Reader{data.substr(1)}.ReadFixed32();
+    if (data.size() < 1 + kFixed32Size + body_size) {
+        if (!is_eof) return std::nullopt;
+        throw DecodeError("Truncated binary log record");
+    }
+
+    Chunk chunk{ReadRecordBody(data.substr(1 + kFixed32Size, body_size)), {}};
+    data.remove_prefix(1 + kFixed32Size + body_size);
+    return chunk;
+}
+
+void AppendTskv(std::string& out, const Record& record) {
+    const auto seconds = std::chrono::time_point_cast<std::chrono::seconds>(record.timestamp);
+    const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(record.timestamp - seconds);
+
+    fmt::format_to(
+        std::back_inserter(out),
+        FMT_COMPILE("tskv\ttimestamp={:%FT%T}.{:06}\tlevel={}"),
+        fmt::localtime(std::chrono::system_clock::to_time_t(record.timestamp)),
+        microseconds.count(),
+        ToUpperCaseString(record.level)
+    );
+
+    for (const auto& [key, value] : record.fields) {
+        out.push_back(utils::encoding::kTskvPairsSeparator);
+        // Keys are escaped by the writer, the same way as for TSKV
+        out.append(key);
+        out.push_back(utils::encoding::kTskvKeyValueSeparator);
+        utils::encoding::EncodeTskv(out, value, utils::encoding::EncodeTskvMode::kValue);
+    }
+    out.push_back('\n');
+}
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
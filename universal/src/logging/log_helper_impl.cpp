@@ -1,6 +1,7 @@
 #include "log_helper_impl.hpp"
 
 #include <array>
+#include <limits>
 
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
@@ -8,6 +9,7 @@
 
 #include <userver/compiler/impl/constexpr.hpp>
 #include <userver/compiler/thread_local.hpp>
+#include <userver/logging/impl/binary_format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/tskv.hpp>
@@ -22,6 +24,7 @@ char GetSeparatorFromLogger(LoggerRef logger) {
     switch (logger.GetFormat()) {
         case Format::kTskv:
         case Format::kRaw:
+        case Format::kBinary:
             return '=';
         case Format::kLtsv:
             return ':';
@@ -65,6 +68,26 @@ TimeString GetCurrentTimeString(TimePoint now) noexcept {
     return cached_time->string;
 }
 
+void AppendVarint(LogBuffer& buffer, std::uint64_t value) {
+    char data[impl::binary::kMaxVarintSize];
+    std::size_t size = 0;
+    while (value >= 0x80) {
+        data[size++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    data[size++] = static_cast<char>(value);
+    buffer.append(data, data + size);
+}
+
+void WriteFixed32(LogBuffer& buffer, std::size_t offset, std::size_t value) noexcept {
+    UASSERT(offset + impl::binary::kFixed32Size <= buffer.size());
+    UASSERT(value <= std::numeric_limits<std::uint32_t>::max());
+    for (std::size_t i = 0; i < impl::binary::kFixed32Size; ++i) {
+        buffer[offset + i] = static_cast<char>(value & 0xFF);
+        value >>= 8;
+    }
+}
+
 }  // namespace
 
 auto LogHelper::Impl::BufferStd::overflow(int_type c) -> int_type {
@@ -81,6 +104,7 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s, std::stre
 LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
     : logger_(&logger),
       level_(std::max(level, logger_->GetLevel())),
+      format_(logger_->GetFormat()),
       key_value_separator_(GetSeparatorFromLogger(*logger_)) {
     static_assert(
         sizeof(LogHelper::Impl) < 4096,
@@ -95,7 +119,7 @@ LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
 void LogHelper::Impl::PutMessageBegin() {
     UASSERT(msg_.size() == 0);
 
-    switch (logger_->GetFormat()) {
+    switch (format_) {
         case Format::kTskv: {
             constexpr std::string_view kTemplate = "tskv\ttimestamp=0000-00-00T00:00:00.000000\tlevel=";
             const auto now = TimePoint::clock::now();
@@ -128,15 +152,37 @@ void LogHelper::Impl::PutMessageBegin() {
             msg_.append(std::string_view{"tskv"});
             return;
         }
+        case Format::kBinary: {
+            const auto now = TimePoint::clock::now();
+            msg_.push_back(impl::binary::kRecordMagic);
+            // The size of the record is written in PutMessageEnd()
+            msg_.resize(msg_.size() + impl::binary::kFixed32Size);
+            AppendVarint(msg_, std::chrono::time_point_cast<std::chrono::microseconds>(now).time_since_epoch().count());
+            AppendVarint(msg_, static_cast<std::uint64_t>(level_));
+            return;
+        }
     }
     UASSERT_MSG(false, "Invalid value of Format enum");
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void LogHelper::Impl::PutMessageEnd() {
+    if (format_ == Format::kBinary) {
+        constexpr std::size_t kHeaderSize = 1 + impl::binary::kFixed32Size;
+        WriteFixed32(msg_, 1, msg_.size() - kHeaderSize);
+        return;
+    }
+    msg_.push_back('\n');
+}
 
 void LogHelper::Impl::PutKey(std::string_view key) {
     if (!utils::encoding::ShouldKeyBeEscaped(key)) {
         PutRawKey(key);
+    } else if (format_ == Format::kBinary) {
+        // Keys are escaped in the same way as for TSKV, so that the decoded
+        // logs are the same
+        fmt::memory_buffer escaped_key;
+        utils::encoding::EncodeTskv(escaped_key, key, utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+        PutRawKey(std::string_view{escaped_key.data(), escaped_key.size()});
     } else {
         UASSERT(!std::exchange(is_within_value_, true));
         CheckRepeatedKeys(key);
@@ -149,6 +195,20 @@ void LogHelper::Impl::PutKey(std::string_view key) {
 void LogHelper::Impl::PutRawKey(std::string_view key) {
     UASSERT(!std::exchange(is_within_value_, true));
     CheckRepeatedKeys(key);
+
+    if (format_ == Format::kBinary) {
+        if (const auto key_id = impl::binary::FindInternedKeyId(key)) {
+            AppendVarint(msg_, *key_id << 1);
+        } else {
+            AppendVarint(msg_, (key.size() << 1) | 1);
+            msg_.append(key);
+        }
+        // The size of the value is written in MarkValueEnd()
+        value_begin_ = msg_.size() + impl::binary::kFixed32Size;
+        msg_.resize(value_begin_);
+        return;
+    }
+
     const auto old_size = msg_.size();
     msg_.resize(old_size + 1 + key.size() + 1);
 
@@ -161,11 +221,19 @@ void LogHelper::Impl::PutRawKey(std::string_view key) {
 
 void LogHelper::Impl::PutValuePart(std::string_view value) {
     UASSERT(is_within_value_);
+    if (format_ == Format::kBinary) {
+        msg_.append(value);
+        return;
+    }
     utils::encoding::EncodeTskv(msg_, value, utils::encoding::EncodeTskvMode::kValue);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
     UASSERT(is_within_value_);
+    if (format_ == Format::kBinary) {
+        msg_.push_back(text_part);
+        return;
+    }
     utils::encoding::EncodeTskv(fmt::appender(msg_), text_part, utils::encoding::EncodeTskvMode::kValue);
 }
 
@@ -174,7 +242,12 @@ LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
     return msg_;
 }
 
-void LogHelper::Impl::MarkValueEnd() noexcept { UASSERT(std::exchange(is_within_value_, false)); }
+void LogHelper::Impl::MarkValueEnd() noexcept {
+    UASSERT(std::exchange(is_within_value_, false));
+    if (format_ == Format::kBinary) {
+        WriteFixed32(msg_, value_begin_ - impl::binary::kFixed32Size, msg_.size() - value_begin_);
+    }
+}
 
 void LogHelper::Impl::MarkAsTrace() noexcept { is_trace_ = true; }
 
@@ -6,6 +6,7 @@
 
 #include <fmt/format.h>
 
+#include <userver/logging/format.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
@@ -82,11 +83,15 @@ private:
 
     impl::LoggerBase* logger_;
     const Level level_;
+    const Format format_;
     const char key_value_separator_;
     LogBuffer msg_;
     std::optional<LazyInitedStream> lazy_stream_;
     LogExtra extra_;
     std::size_t initial_length_{0};
+    // Format::kBinary: the offset of the current value, its size is written
+    // right before it in MarkValueEnd()
+    std::size_t value_begin_{0};
     bool is_within_value_{false};
     bool is_trace_{false};
     std::optional<std::unordered_set<std::string>> debug_tag_keys_;
@@ -107,7 +107,11 @@ void TokenBucket::SetInstantRefillPolicy() { SetRefillPolicy(kInstantRefillPolic
 
 bool TokenBucket::Obtain() { return ObtainAll(1); }
 
-bool TokenBucket::ObtainAll(size_t count) {
+bool TokenBucket::ObtainAll(size_t count) { return DoObtain(count, 0); }
+
+bool TokenBucket::ObtainWithReserve(size_t reserve) { return DoObtain(1, reserve); }
+
+bool TokenBucket::DoObtain(size_t count, size_t reserve) {
     if (max_size_ < count) {
         // not satisfiable
         return false;
@@ -122,7 +126,7 @@ bool TokenBucket::ObtainAll(size_t count) {
 
     auto expected = tokens_.load();
     do {
-        if (expected < count) return false;
+        if (expected < count + reserve) return false;
     } while (!tokens_.compare_exchange_strong(expected, expected - count));
 
     return true;
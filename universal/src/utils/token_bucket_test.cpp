@@ -269,4 +269,30 @@ TEST(TokenBucket, MultiTokenRefill) {
     EXPECT_FALSE(tb.Obtain());
 }
 
+TEST(TokenBucket, ObtainWithReserve) {
+    utils::datetime::MockNowSet(std::chrono::system_clock::time_point{});
+
+    utils::TokenBucket tb{10, {1, std::chrono::seconds{1}}};
+    EXPECT_TRUE(tb.ObtainWithReserve(5));
+    EXPECT_EQ(9, tb.GetTokensApprox());
+    EXPECT_TRUE(tb.ObtainAll(3));
+    EXPECT_TRUE(tb.ObtainWithReserve(5));
+    EXPECT_EQ(5, tb.GetTokensApprox());
+
+    // The reserved tokens are left for the others
+    EXPECT_FALSE(tb.ObtainWithReserve(5));
+    EXPECT_EQ(5, tb.GetTokensApprox());
+    EXPECT_TRUE(tb.Obtain());
+    EXPECT_EQ(4, tb.GetTokensApprox());
+
+    utils::datetime::MockSleep(std::chrono::seconds{2});
+    EXPECT_TRUE(tb.ObtainWithReserve(5));
+    EXPECT_FALSE(tb.ObtainWithReserve(5));
+
+    EXPECT_FALSE(tb.ObtainWithReserve(10));
+
+    tb.SetInstantRefillPolicy();
+    EXPECT_TRUE(tb.ObtainWithReserve(100));
+}
+
 USERVER_NAMESPACE_END